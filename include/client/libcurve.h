@@ -25,6 +25,7 @@
 
 #include <unistd.h>
 #include <stdint.h>
+#include <sys/uio.h>
 #include <vector>
 #include <map>
 #include <string>
@@ -125,6 +126,15 @@ typedef struct CurveAioContext {
     void* buf;
 } CurveAioContext;
 
+// AioReadv/AioWritev的io上下文，iov和iovcnt描述用户的多个数据缓冲区。
+// ctx中的buf不使用，length为所有iovec长度之和；ctx是第一个成员，
+// 回调收到的CurveAioContext指针可以直接转换回CurveAioVContext指针
+typedef struct CurveAioVContext {
+    CurveAioContext ctx;
+    struct iovec* iov;
+    int iovcnt;
+} CurveAioVContext;
+
 typedef struct FileStatInfo {
     uint64_t        id;
     uint64_t        parentid;
@@ -231,6 +241,22 @@ int AioRead(int fd, CurveAioContext* aioctx);
  */
 int AioWrite(int fd, CurveAioContext* aioctx);
 
+/**
+ * 异步模式向量读，读取的数据直接分散到aioctx->iov指定的多个缓冲区中
+ * @param: fd为当前open返回的文件描述符
+ * @param: aioctx为向量读写的io上下文，iov和iovcnt描述读缓冲区
+ * @return: 成功返回 0,否则-LIBCURVE_ERROR::FAILED
+ */
+int AioReadv(int fd, CurveAioVContext* aioctx);
+
+/**
+ * 异步模式向量写，aioctx->iov指定的多个缓冲区中的数据不经拷贝直接发送
+ * @param: fd为当前open返回的文件描述符
+ * @param: aioctx为向量读写的io上下文，iov和iovcnt描述写缓冲区
+ * @return: 成功返回 0,否则-LIBCURVE_ERROR::FAILED
+ */
+int AioWritev(int fd, CurveAioVContext* aioctx);
+
 /**
  * 重命名文件
  * @param: userinfo是用户信息
@@ -473,6 +499,22 @@ class CurveClient {
      */
     virtual int AioWrite(int fd, CurveAioContext* aioctx);
 
+    /**
+     * 异步向量读
+     * @param fd 文件fd
+     * @param aioctx 向量读写的io上下文，iov和iovcnt描述读缓冲区
+     * @return 返回错误码
+     */
+    virtual int AioReadv(int fd, CurveAioVContext* aioctx);
+
+    /**
+     * 异步向量写
+     * @param fd 文件fd
+     * @param aioctx 向量读写的io上下文，iov和iovcnt描述写缓冲区
+     * @return 返回错误码
+     */
+    virtual int AioWritev(int fd, CurveAioVContext* aioctx);
+
     /**
      * 测试使用，设置fileclient
      * @param client 需要设置的fileclient
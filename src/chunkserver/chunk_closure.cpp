@@ -51,5 +51,24 @@ void ChunkClosure::Run() {
     request_->RedirectChunkRequest();
 }
 
+void BatchChunkClosure::Run() {
+    std::unique_ptr<BatchChunkClosure> selfGuard(this);
+    if (onCommitted_) {
+        onCommitted_();
+    }
+    /**
+     * status ok说明log entry已经被apply，各个op request
+     * 在apply的时候已经交由各自的ChunkClosure返回
+     */
+    if (status().ok()) {
+        return;
+    }
+
+    for (auto &request : requests_) {
+        brpc::ClosureGuard doneGuard(request->Closure());
+        request->RedirectChunkRequest();
+    }
+}
+
 }  // namespace chunkserver
 }  // namespace curve
@@ -24,7 +24,9 @@
 #define SRC_CHUNKSERVER_CHUNK_CLOSURE_H_
 
 #include <brpc/closure_guard.h>
+#include <functional>
 #include <memory>
+#include <vector>
 
 #include "src/chunkserver/op_request.h"
 
@@ -52,6 +54,34 @@ class ChunkClosure : public braft::Closure {
     std::shared_ptr<ChunkOpRequest> request_;
 };
 
+/**
+ * 多个小写请求合并成一条log entry propose时使用的closure，
+ * 正常apply的时候会为每个op request重新生成各自的ChunkClosure，
+ * 如果还没有apply就出错了，那么需要将所有的op request转发
+ */
+class BatchChunkClosure : public braft::Closure {
+ public:
+    /**
+     * @param requests: 合并在同一条log entry中的op request
+     * @param onCommitted: log entry commit或者出错之后的回调，可以为空
+     */
+    explicit BatchChunkClosure(
+        const std::vector<std::shared_ptr<ChunkOpRequest>> &requests,
+        std::function<void()> onCommitted = nullptr)
+        : requests_(requests), onCommitted_(onCommitted) {}
+
+    ~BatchChunkClosure() = default;
+
+    void Run() override;
+
+ public:
+    // 合并在同一条log entry中的op request，按propose的顺序排列
+    std::vector<std::shared_ptr<ChunkOpRequest>> requests_;
+
+ private:
+    std::function<void()> onCommitted_;
+};
+
 }  // namespace chunkserver
 }  // namespace curve
 
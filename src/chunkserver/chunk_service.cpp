@@ -25,9 +25,14 @@
 #include <glog/logging.h>
 #include <brpc/closure_guard.h>
 #include <brpc/controller.h>
+#include <bthread/bthread.h>
+#include <butil/time.h>
 
+#include <algorithm>
 #include <memory>
 #include <cerrno>
+#include <limits>
+#include <utility>
 #include <vector>
 
 #include "src/chunkserver/copyset_node.h"
@@ -35,14 +40,21 @@
 #include "src/chunkserver/chunkserver_metrics.h"
 #include "src/chunkserver/op_request.h"
 #include "src/chunkserver/chunk_service_closure.h"
+#include "src/common/crc32.h"
+#include "src/common/string_util.h"
 
 namespace curve {
 namespace chunkserver {
 
+// GetCopysetHash等待本地apply到请求指定的applied index的最长时间
+static const uint64_t kHashWaitAppliedTimeoutUs = 1000 * 1000;
+static const uint64_t kHashWaitAppliedIntervalUs = 1000;
+
 ChunkServiceImpl::ChunkServiceImpl(ChunkServiceOptions chunkServiceOptions) :
     chunkServiceOptions_(chunkServiceOptions),
     copysetNodeManager_(chunkServiceOptions.copysetNodeManager),
-    inflightThrottle_(chunkServiceOptions.inflightThrottle) {
+    inflightThrottle_(chunkServiceOptions.inflightThrottle),
+    qosScheduler_(chunkServiceOptions.qosScheduler) {
     maxChunkSize_ = copysetNodeManager_->GetCopysetNodeOptions().maxChunkSize;
 }
 
@@ -83,7 +95,8 @@ void ChunkServiceImpl::DeleteChunk(RpcController *controller,
                                                    request,
                                                    response,
                                                    doneGuard.release());
-    req->Process();
+    ProcessWithQos(QosIOType::FOREGROUND, controller, request,
+                   [req] { req->Process(); });
 }
 
 void ChunkServiceImpl::WriteChunk(RpcController *controller,
@@ -140,7 +153,9 @@ void ChunkServiceImpl::WriteChunk(RpcController *controller,
                                                   request,
                                                   response,
                                                   doneGuard.release());
-    req->Process();
+    req->SetTrace(closure->GetTrace());
+    ProcessWithQos(QosIOType::FOREGROUND, controller, request,
+                   [req] { req->Process(); });
 }
 
 void ChunkServiceImpl::CreateCloneChunk(RpcController *controller,
@@ -189,7 +204,8 @@ void ChunkServiceImpl::CreateCloneChunk(RpcController *controller,
                                                         request,
                                                         response,
                                                         doneGuard.release());
-    req->Process();
+    ProcessWithQos(QosIOType::CLONE, controller, request,
+                   [req] { req->Process(); });
 }
 
 void ChunkServiceImpl::CreateS3CloneChunk(RpcController* controller,
@@ -250,7 +266,9 @@ void ChunkServiceImpl::ReadChunk(RpcController *controller,
                                            request,
                                            response,
                                            doneGuard.release());
-    req->Process();
+    req->SetTrace(closure->GetTrace());
+    ProcessWithQos(QosIOType::FOREGROUND, controller, request,
+                   [req] { req->Process(); });
 }
 
 void ChunkServiceImpl::RecoverChunk(RpcController *controller,
@@ -302,7 +320,8 @@ void ChunkServiceImpl::RecoverChunk(RpcController *controller,
                                            request,
                                            response,
                                            doneGuard.release());
-    req->Process();
+    ProcessWithQos(QosIOType::RECOVER, controller, request,
+                   [req] { req->Process(); });
 }
 
 void ChunkServiceImpl::ReadChunkSnapshot(RpcController *controller,
@@ -348,7 +367,8 @@ void ChunkServiceImpl::ReadChunkSnapshot(RpcController *controller,
                                                     request,
                                                     response,
                                                     doneGuard.release());
-    req->Process();
+    ProcessWithQos(QosIOType::SNAPSHOT, controller, request,
+                   [req] { req->Process(); });
 }
 
 void ChunkServiceImpl::DeleteChunkSnapshotOrCorrectSn(
@@ -398,7 +418,8 @@ void ChunkServiceImpl::DeleteChunkSnapshotOrCorrectSn(
                                                       response,
                                                       doneGuard.release());
 
-    req->Process();
+    ProcessWithQos(QosIOType::SNAPSHOT, controller, request,
+                   [req] { req->Process(); });
 }
 
 /**
@@ -534,6 +555,168 @@ void ChunkServiceImpl::GetChunkHash(RpcController *controller,
     }
 }
 
+void ChunkServiceImpl::GetCopysetHash(RpcController *controller,
+                                      const GetCopysetHashRequest *request,
+                                      GetCopysetHashResponse *response,
+                                      Closure *done) {
+    brpc::ClosureGuard doneGuard(done);
+
+    // 判断copyset是否存在
+    auto nodePtr =
+        copysetNodeManager_->GetCopysetNode(request->logicpoolid(),
+                                            request->copysetid());
+    if (nullptr == nodePtr) {
+        response->set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_COPYSET_NOTEXIST);
+        LOG(WARNING) << "GetCopysetHash failed, copyset node is not found: "
+                     << request->logicpoolid() << "," << request->copysetid();
+        return;
+    }
+
+    // 续传的请求在上一次返回的hash的基础上继续计算
+    uint64_t initHash = 0;
+    if (request->has_inithash() &&
+        (!curve::common::StringToUll(request->inithash(), &initHash) ||
+         initHash > std::numeric_limits<uint32_t>::max())) {
+        LOG(WARNING) << "GetCopysetHash failed, invalid init hash: "
+                     << request->inithash();
+        response->set_status(
+            CHUNK_OP_STATUS::CHUNK_OP_STATUS_INVALID_REQUEST);
+        return;
+    }
+
+    // 单次请求计算的chunk个数有上限，避免一次请求长时间占用rpc线程，
+    // 超出时返回nextChunkId，由调用方从该chunk继续请求
+    uint32_t maxCount = chunkServiceOptions_.hashMaxChunksPerCall;
+    if (request->maxchunkcount() > 0 &&
+        (0 == maxCount || request->maxchunkcount() < maxCount)) {
+        maxCount = request->maxchunkcount();
+    }
+
+    // 巡检要求在固定的applied index上比较，先等待本地apply到该位置，
+    // 超时仍未追上或者已经超过时不计算，由调用方重试
+    uint64_t appliedIndex = nodePtr->GetAppliedIndex();
+    if (request->has_appliedindex()) {
+        uint64_t startUs = butil::gettimeofday_us();
+        while (appliedIndex < request->appliedindex() &&
+               butil::gettimeofday_us() - startUs <
+                   kHashWaitAppliedTimeoutUs) {
+            bthread_usleep(kHashWaitAppliedIntervalUs);
+            appliedIndex = nodePtr->GetAppliedIndex();
+        }
+        if (appliedIndex != request->appliedindex()) {
+            LOG(INFO) << "GetCopysetHash skipped, applied index "
+                      << appliedIndex << " not equal to requested "
+                      << request->appliedindex()
+                      << ", logic pool id: " << request->logicpoolid()
+                      << " copyset id: " << request->copysetid();
+            response->set_chunkcount(0);
+            response->set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS);
+            return;
+        }
+    }
+
+    std::vector<ChunkID> chunkIds;
+    nodePtr->GetDataStore()->GetChunkIds(&chunkIds);
+    auto begin = std::lower_bound(chunkIds.begin(), chunkIds.end(),
+                                  request->beginchunkid());
+    auto end = std::lower_bound(begin, chunkIds.end(),
+                                request->endchunkid());
+
+    HashThrottle* throttle = chunkServiceOptions_.hashThrottle.get();
+    uint64_t maxBytesPerSec = request->maxbytespersec();
+    uint64_t startUs = butil::gettimeofday_us();
+    uint32_t crc32c = static_cast<uint32_t>(initHash);
+    uint32_t chunkCount = 0;
+    for (auto iter = begin; iter != end; ++iter) {
+        if (maxCount > 0 && chunkCount >= maxCount) {
+            response->set_nextchunkid(*iter);
+            break;
+        }
+        // 按照整个chunkserver共享的速率读盘，避免影响正常的IO
+        if (throttle != nullptr) {
+            throttle->Acquire(maxChunkSize_);
+        }
+        // 同时不超过发起方当前的巡检速率，发起方因前台IO降速时副本也随之降速
+        if (maxBytesPerSec > 0) {
+            uint64_t expectUs = static_cast<uint64_t>(chunkCount) *
+                                maxChunkSize_ * 1000000 / maxBytesPerSec;
+            uint64_t elapsedUs = butil::gettimeofday_us() - startUs;
+            if (expectUs > elapsedUs) {
+                bthread_usleep(expectUs - elapsedUs);
+            }
+        }
+
+        std::string hash;
+        CSErrorCode ret = nodePtr->GetDataStore()->GetChunkHash(
+            *iter, 0, maxChunkSize_, &hash);
+        if (CSErrorCode::ChunkNotExistError == ret) {
+            // 计算过程中chunk被删除，和GetChunkHash一样当做hash为0的chunk
+            hash = "0";
+        } else if (CSErrorCode::Success != ret) {
+            LOG(ERROR) << "get copyset hash failed, "
+                       << " logic pool id: " << request->logicpoolid()
+                       << " copyset id: " << request->copysetid()
+                       << " chunk id: " << *iter
+                       << " data store return: " << ret;
+            response->set_status(
+                CHUNK_OP_STATUS::CHUNK_OP_STATUS_FAILURE_UNKNOWN);
+            return;
+        }
+
+        ChunkID chunkId = *iter;
+        crc32c = curve::common::CRC32(
+            crc32c, reinterpret_cast<const char*>(&chunkId), sizeof(chunkId));
+        crc32c = curve::common::CRC32(crc32c, hash.c_str(), hash.size());
+        if (request->withchunkhash()) {
+            ChunkHash* chunkHash = response->add_chunkhashes();
+            chunkHash->set_chunkid(chunkId);
+            chunkHash->set_hash(hash);
+        }
+        if (0 == chunkCount) {
+            response->set_minchunkid(chunkId);
+        }
+        response->set_maxchunkid(chunkId);
+        ++chunkCount;
+    }
+
+    // 计算期间没有新的apply，返回的hash对应于该applied index
+    if (nodePtr->GetAppliedIndex() == appliedIndex) {
+        response->set_appliedindex(appliedIndex);
+    }
+    response->set_hash(std::to_string(crc32c));
+    response->set_chunkcount(chunkCount);
+    response->set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS);
+}
+
+void ChunkServiceImpl::ProcessWithQos(QosIOType type,
+                                      RpcController *controller,
+                                      const ChunkRequest *request,
+                                      QosTask process) {
+    if (qosScheduler_ == nullptr) {
+        process();
+        return;
+    }
+
+    // 优先使用请求中携带的client id，否则按照client的地址区分，
+    // 地址生成的id最高位置1，避免和携带的client id冲突
+    uint64_t clientId = 0;
+    brpc::Controller *cntl = dynamic_cast<brpc::Controller *>(controller);
+    if (request->has_deltarho() && request->deltarho().has_clientid()) {
+        clientId = request->deltarho().clientid();
+    } else if (cntl != nullptr) {
+        butil::EndPoint remote = cntl->remote_side();
+        clientId = (1ULL << 63)
+                 | (static_cast<uint64_t>(butil::ip2int(remote.ip)) << 16)
+                 | static_cast<uint16_t>(remote.port);
+    }
+    qosScheduler_->Submit(type,
+                          ToGroupNid(request->logicpoolid(),
+                                     request->copysetid()),
+                          clientId,
+                          request->size(),
+                          std::move(process));
+}
+
 bool ChunkServiceImpl::CheckRequestOffsetAndLength(uint32_t offset,
                                                    uint32_t len) {
     // 检查offset+len是否越界
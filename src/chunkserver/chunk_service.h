@@ -29,6 +29,7 @@
 
 #include "proto/chunk.pb.h"
 #include "src/chunkserver/config_info.h"
+#include "src/chunkserver/qos_scheduler.h"
 
 namespace curve {
 namespace chunkserver {
@@ -91,6 +92,17 @@ class ChunkServiceImpl : public ChunkService {
                       GetChunkHashResponse *response,
                       Closure *done);
 
+    /**
+     * 按chunk id顺序逐个计算copyset中指定范围内chunk的hash，
+     * 用于副本一致性检查。读盘速率受整个chunkserver共享的hashThrottle限制，
+     * 单次请求最多计算hashMaxChunksPerCall个chunk，剩余的部分通过
+     * nextChunkId续传
+     */
+    void GetCopysetHash(RpcController *controller,
+                        const GetCopysetHashRequest *request,
+                        GetCopysetHashResponse *response,
+                        Closure *done);
+
  private:
     /**
      * 验证op request的offset和length是否越界和对齐
@@ -100,10 +112,23 @@ class ChunkServiceImpl : public ChunkService {
      */
     bool CheckRequestOffsetAndLength(uint32_t offset, uint32_t len);
 
+    /**
+     * 经过QoS调度之后执行请求，未配置QoS时直接执行
+     * @param type: 请求的IO类型
+     * @param controller: 请求的rpc controller，用于获取client地址
+     * @param request: 请求
+     * @param process: 请求被调度时执行的任务
+     */
+    void ProcessWithQos(QosIOType type,
+                        RpcController *controller,
+                        const ChunkRequest *request,
+                        QosTask process);
+
  private:
     ChunkServiceOptions chunkServiceOptions_;
     CopysetNodeManager  *copysetNodeManager_;
     std::shared_ptr<InflightThrottle> inflightThrottle_;
+    QosScheduler        *qosScheduler_;
     uint32_t            maxChunkSize_;
 };
 
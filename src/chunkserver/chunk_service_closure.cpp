@@ -40,6 +40,10 @@ void ChunkServiceClosure::Run() {
         brpc::ClosureGuard doneGuard(brpcDone_);
         // 记录请求处理结果，收集到metric中
         OnResonse();
+        // 统计采样请求各阶段的耗时
+        if (nullptr != trace_ && nullptr != response_) {
+            trace_->Finish(response_->status());
+        }
     }
 
     // closure调用的时候减1，closure创建的什么加1
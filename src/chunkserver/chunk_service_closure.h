@@ -29,6 +29,7 @@
 #include "proto/chunk.pb.h"
 #include "src/chunkserver/op_request.h"
 #include "src/chunkserver/inflight_throttle.h"
+#include "src/chunkserver/op_trace.h"
 #include "src/common/timeutility.h"
 
 namespace curve {
@@ -46,7 +47,8 @@ class ChunkServiceClosure : public braft::Closure {
         , request_(request)
         , response_(response)
         , brpcDone_(done)
-        , receivedTimeUs_(common::TimeUtility::GetTimeofDayUs()) {
+        , receivedTimeUs_(common::TimeUtility::GetTimeofDayUs())
+        , trace_(OpTrace::Create(request)) {
             // closure创建的什么加1，closure调用的时候减1
             if (nullptr != inflightThrottle_) {
                 inflightThrottle_->Increment();
@@ -64,6 +66,13 @@ class ChunkServiceClosure : public braft::Closure {
      */
     void Run() override;
 
+    /**
+     * 获取client采样的请求的trace，未被采样时返回nullptr
+     */
+    std::shared_ptr<OpTrace> GetTrace() const {
+        return trace_;
+    }
+
  private:
     /**
      * 统计请求数量和速率
@@ -85,6 +94,8 @@ class ChunkServiceClosure : public braft::Closure {
     google::protobuf::Closure *brpcDone_;
     // 接受到请求的时间
     uint64_t receivedTimeUs_;
+    // 请求各阶段的耗时记录
+    std::shared_ptr<OpTrace> trace_;
 };
 
 }  // namespace chunkserver
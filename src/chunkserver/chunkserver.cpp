@@ -38,6 +38,7 @@
 #include "src/chunkserver/braft_cli_service2.h"
 #include "src/chunkserver/chunkserver_helper.h"
 #include "src/chunkserver/uri_paser.h"
+#include "src/chunkserver/raftlog/curve_log_storage.h"
 #include "src/chunkserver/raftsnapshot/curve_snapshot_attachment.h"
 #include "src/chunkserver/raftsnapshot/curve_file_service.h"
 #include "src/chunkserver/raftsnapshot/curve_snapshot_storage.h"
@@ -74,6 +75,11 @@ void RegisterCurveSnapshotStorageOrDie() {
                                     "curve", &snapshotStorage);
 }
 
+void RegisterCurveLogStorageOrDie() {
+    static CurveLogStorage logStorage;
+    braft::log_storage_extension()->RegisterOrDie("curve", &logStorage);
+}
+
 int ChunkServer::Run(int argc, char** argv) {
     gflags::ParseCommandLineFlags(&argc, &argv, true);
 
@@ -211,6 +217,18 @@ int ChunkServer::Run(int argc, char** argv) {
     snapshotThrottle_ = snapshotThrottle;
     copysetNodeOptions.snapshotThrottle = &snapshotThrottle_;
 
+    // install snapshot时同时下载的文件个数
+    int snapshotCopyConcurrency;
+    LOG_IF(FATAL,
+           !conf.GetIntValue("chunkserver.snapshot_copy_concurrency",
+                             &snapshotCopyConcurrency));
+    // install snapshot时leader是否跳过chunk文件中全零的page
+    bool snapshotSkipZeroPage;
+    LOG_IF(FATAL,
+           !conf.GetBoolValue("chunkserver.snapshot_skip_zero_page",
+                              &snapshotSkipZeroPage));
+    kCurveFileService.set_skip_zero_page(snapshotSkipZeroPage);
+
     butil::ip_t ip;
     if (butil::str2ip(copysetNodeOptions.ip.c_str(), &ip) < 0) {
         LOG(FATAL) << "Invalid server IP provided: " << copysetNodeOptions.ip;
@@ -223,14 +241,46 @@ int ChunkServer::Run(int argc, char** argv) {
     // 注册curve snapshot storage
     RegisterCurveSnapshotStorageOrDie();
     CurveSnapshotStorage::set_server_addr(endPoint);
+    CurveSnapshotStorage::set_copy_concurrency(snapshotCopyConcurrency);
+    // 注册curve log storage，copyset.raft_log_uri使用curve://时生效
+    RegisterCurveLogStorageOrDie();
+    uint32_t raftLogInlineThreshold;
+    LOG_IF(FATAL, !conf.GetUInt32Value("copyset.raft_log_inline_threshold",
+                                       &raftLogInlineThreshold));
+    CurveLogStorage::set_inline_threshold(raftLogInlineThreshold);
+    uint64_t raftLogDataSegmentSize;
+    LOG_IF(FATAL, !conf.GetUInt64Value("copyset.raft_log_data_segment_size",
+                                       &raftLogDataSegmentSize));
+    CurveLogStorage::set_data_segment_size(raftLogDataSegmentSize);
     copysetNodeManager_ = &CopysetNodeManager::GetInstance();
     LOG_IF(FATAL, copysetNodeManager_->Init(copysetNodeOptions) != 0)
         << "Failed to initialize CopysetNodeManager.";
 
+    // 采样请求的耗时统计
+    OpTraceOptions opTraceOptions;
+    InitOpTraceOptions(&conf, &opTraceOptions);
+    OpTrace::SetOptions(opTraceOptions);
+
+    // 巡检模块初始化
+    ScrubOptions scrubOptions;
+    InitScrubOptions(&conf, &scrubOptions);
+    scrubOptions.chunkSize = copysetNodeOptions.maxChunkSize;
+    scrubOptions.copysetNodeManager = copysetNodeManager_;
+    LOG_IF(FATAL, scrubManager_.Init(scrubOptions) != 0)
+        << "Failed to init scrub manager.";
+
+    // QoS调度模块初始化
+    QosOptions qosOptions;
+    InitQosOptions(&conf, &qosOptions);
+    LOG_IF(FATAL, qosScheduler_.Init(qosOptions) != 0)
+        << "Failed to init qos scheduler.";
+
     // 心跳模块初始化
     HeartbeatOptions heartbeatOptions;
     InitHeartbeatOptions(&conf, &heartbeatOptions);
     heartbeatOptions.copysetNodeManager = copysetNodeManager_;
+    heartbeatOptions.scrubManager = &scrubManager_;
+    heartbeatOptions.qosScheduler = &qosScheduler_;
     heartbeatOptions.fs = fs;
     heartbeatOptions.chunkserverId = metadata.id();
     heartbeatOptions.chunkserverToken = metadata.token();
@@ -266,6 +316,16 @@ int ChunkServer::Run(int argc, char** argv) {
     chunkServiceOptions.copysetNodeManager = copysetNodeManager_;
     chunkServiceOptions.cloneManager = &cloneManager_;
     chunkServiceOptions.inflightThrottle = inflightThrottle;
+    chunkServiceOptions.qosScheduler = &qosScheduler_;
+    uint64_t hashThroughputBytes;
+    LOG_IF(FATAL,
+           !conf.GetUInt64Value("chunkserver.hash_throughput_bytes",
+                                &hashThroughputBytes));
+    chunkServiceOptions.hashThrottle =
+        std::make_shared<HashThrottle>(hashThroughputBytes);
+    LOG_IF(FATAL,
+           !conf.GetUInt32Value("chunkserver.hash_max_chunks_per_call",
+                                &chunkServiceOptions.hashMaxChunksPerCall));
     ChunkServiceImpl chunkService(chunkServiceOptions);
     ret = server.AddService(&chunkService,
                         brpc::SERVER_DOESNT_OWN_SERVICE);
@@ -323,6 +383,8 @@ int ChunkServer::Run(int argc, char** argv) {
      * 具体设计考虑见：
      * http://doc.hz.netease.com/pages/viewpage.action?pageId=228843072
      */
+    LOG_IF(FATAL, qosScheduler_.Run() != 0)
+        << "Failed to start qos scheduler.";
     LOG_IF(FATAL, trash_->Run() != 0)
         << "Failed to start trash.";
     LOG_IF(FATAL, cloneManager_.Run() != 0)
@@ -331,6 +393,8 @@ int ChunkServer::Run(int argc, char** argv) {
         << "Failed to start heartbeat manager.";
     LOG_IF(FATAL, copysetNodeManager_->Run() != 0)
         << "Failed to start CopysetNodeManager.";
+    LOG_IF(FATAL, scrubManager_.Run() != 0)
+        << "Failed to start scrub manager.";
 
     // =======================等待进程退出==================================//
     server.RunUntilAskedToQuit();
@@ -338,6 +402,10 @@ int ChunkServer::Run(int argc, char** argv) {
     LOG(INFO) << "ChunkServer is going to quit.";
     LOG_IF(ERROR, heartbeat_.Fini() != 0)
         << "Failed to shutdown heartbeat manager.";
+    LOG_IF(ERROR, scrubManager_.Fini() != 0)
+        << "Failed to shutdown scrub manager.";
+    LOG_IF(ERROR, qosScheduler_.Fini() != 0)
+        << "Failed to shutdown qos scheduler.";
     LOG_IF(ERROR, copysetNodeManager_->Fini() != 0)
         << "Failed to shutdown CopysetNodeManager.";
     LOG_IF(ERROR, cloneManager_.Fini() != 0)
@@ -346,6 +414,7 @@ int ChunkServer::Run(int argc, char** argv) {
         << "Failed to shutdown clone copyer.";
     LOG_IF(ERROR, trash_->Fini() != 0)
         << "Failed to shutdown trash.";
+    chunkfilePool->UnInitialize();
     concurrentapply.Stop();
 
     google::ShutdownGoogleLogging();
@@ -367,6 +436,12 @@ void ChunkServer::InitChunkFilePoolOptions(
     LOG_IF(FATAL, !conf->GetBoolValue(
         "chunkfilepool.enable_get_chunk_from_pool",
         &chunkFilePoolOptions->getChunkFromPool));
+    LOG_IF(FATAL, !conf->GetUInt32Value("chunkfilepool.low_water_mark",
+        &chunkFilePoolOptions->lowWaterMark));
+    LOG_IF(FATAL, !conf->GetUInt32Value("chunkfilepool.refill_rate_per_sec",
+        &chunkFilePoolOptions->refillRatePerSec));
+    LOG_IF(FATAL, !conf->GetBoolValue("chunkfilepool.clean_recycled_chunk",
+        &chunkFilePoolOptions->cleanRecycledChunk));
 
     if (chunkFilePoolOptions->getChunkFromPool == false) {
         std::string chunkFilePoolUri;
@@ -416,12 +491,42 @@ void ChunkServer::InitCopysetNodeOptions(
         &copysetNodeOptions->locationLimit));
     LOG_IF(FATAL, !conf->GetUInt32Value("copyset.load_concurrency",
         &copysetNodeOptions->loadConcurrency));
+    LOG_IF(FATAL, !conf->GetUInt32Value("copyset.load_disk_concurrency",
+        &copysetNodeOptions->loadDiskConcurrency));
     LOG_IF(FATAL, !conf->GetUInt32Value("copyset.check_retrytimes",
         &copysetNodeOptions->checkRetryTimes));
     LOG_IF(FATAL, !conf->GetUInt32Value("copyset.finishload_margin",
         &copysetNodeOptions->finishLoadMargin));
     LOG_IF(FATAL, !conf->GetUInt32Value("copyset.check_loadmargin_interval_ms",
         &copysetNodeOptions->checkLoadMarginIntervalMs));
+    LOG_IF(FATAL, !conf->GetBoolValue("copyset.enable_raft_batch",
+        &copysetNodeOptions->enableRaftBatch));
+    LOG_IF(FATAL, !conf->GetUInt32Value("copyset.raft_batch_max_write_size",
+        &copysetNodeOptions->raftBatchMaxWriteSize));
+    LOG_IF(FATAL, !conf->GetUInt32Value("copyset.raft_batch_max_ops",
+        &copysetNodeOptions->raftBatchMaxOps));
+    LOG_IF(FATAL, !conf->GetUInt32Value("copyset.raft_batch_max_bytes",
+        &copysetNodeOptions->raftBatchMaxBytes));
+    LOG_IF(FATAL, !conf->GetUInt32Value("copyset.raft_batch_max_inflight",
+        &copysetNodeOptions->raftBatchMaxInflight));
+    LOG_IF(FATAL, !conf->GetUInt32Value(
+        "copyset.clone_meta_flush_dirty_pages",
+        &copysetNodeOptions->cloneMetaFlushDirtyPages));
+    LOG_IF(FATAL, !conf->GetUInt32Value(
+        "copyset.clone_meta_flush_interval_ms",
+        &copysetNodeOptions->cloneMetaFlushIntervalMs));
+    LOG_IF(FATAL, !conf->GetBoolValue(
+        "copyset.enable_sparse_snapshot",
+        &copysetNodeOptions->enableSparseSnapshot));
+    LOG_IF(FATAL, !conf->GetUInt32Value(
+        "copyset.max_open_chunk_files",
+        &copysetNodeOptions->maxOpenChunkFiles));
+    LOG_IF(FATAL, !conf->GetBoolValue(
+        "copyset.enable_lease_read",
+        &copysetNodeOptions->enableLeaseRead));
+    LOG_IF(FATAL, !conf->GetBoolValue(
+        "copyset.enable_follower_read",
+        &copysetNodeOptions->enableFollowerRead));
 }
 
 void ChunkServer::InitCopyerOptions(
@@ -507,6 +612,67 @@ void ChunkServer::InitTrashOptions(
         "trash.scan_periodSec", &trashOptions->scanPeriodSec));
 }
 
+void ChunkServer::InitScrubOptions(
+    common::Configuration *conf, ScrubOptions *scrubOptions) {
+    LOG_IF(FATAL, !conf->GetBoolValue(
+        "scrub.enable", &scrubOptions->enable));
+    LOG_IF(FATAL, !conf->GetUInt32Value(
+        "scrub.interval_sec", &scrubOptions->intervalSec));
+    LOG_IF(FATAL, !conf->GetUInt64Value(
+        "scrub.max_bytes_per_sec", &scrubOptions->maxBytesPerSec));
+    LOG_IF(FATAL, !conf->GetUInt64Value(
+        "scrub.min_bytes_per_sec", &scrubOptions->minBytesPerSec));
+    LOG_IF(FATAL, !conf->GetUInt64Value(
+        "scrub.latency_threshold_us", &scrubOptions->latencyThresholdUs));
+    LOG_IF(FATAL, !conf->GetUInt32Value(
+        "scrub.rpc_timeout_ms", &scrubOptions->rpcTimeoutMs));
+}
+
+void ChunkServer::InitQosOptions(
+    common::Configuration *conf, QosOptions *qosOptions) {
+    LOG_IF(FATAL, !conf->GetBoolValue(
+        "qos.enable", &qosOptions->enable));
+    LOG_IF(FATAL, !conf->GetUInt64Value(
+        "qos.quantum_bytes", &qosOptions->quantumBytes));
+    LOG_IF(FATAL, !conf->GetUInt32Value(
+        "qos.foreground_weight", &qosOptions->foregroundWeight));
+    LOG_IF(FATAL, !conf->GetUInt32Value(
+        "qos.clone_weight", &qosOptions->cloneWeight));
+    LOG_IF(FATAL, !conf->GetUInt32Value(
+        "qos.recover_weight", &qosOptions->recoverWeight));
+    LOG_IF(FATAL, !conf->GetUInt32Value(
+        "qos.snapshot_weight", &qosOptions->snapshotWeight));
+    LOG_IF(FATAL, !conf->GetUInt64Value(
+        "qos.clone_bps", &qosOptions->cloneBps));
+    LOG_IF(FATAL, !conf->GetUInt64Value(
+        "qos.recover_bps", &qosOptions->recoverBps));
+    LOG_IF(FATAL, !conf->GetUInt64Value(
+        "qos.snapshot_bps", &qosOptions->snapshotBps));
+    LOG_IF(FATAL, !conf->GetUInt64Value(
+        "qos.chunkserver_iops", &qosOptions->limit.chunkserverIops));
+    LOG_IF(FATAL, !conf->GetUInt64Value(
+        "qos.chunkserver_bps", &qosOptions->limit.chunkserverBps));
+    LOG_IF(FATAL, !conf->GetUInt64Value(
+        "qos.copyset_iops", &qosOptions->limit.copysetIops));
+    LOG_IF(FATAL, !conf->GetUInt64Value(
+        "qos.copyset_bps", &qosOptions->limit.copysetBps));
+    LOG_IF(FATAL, !conf->GetUInt64Value(
+        "qos.client_iops", &qosOptions->limit.clientIops));
+    LOG_IF(FATAL, !conf->GetUInt64Value(
+        "qos.client_bps", &qosOptions->limit.clientBps));
+}
+
+void ChunkServer::InitOpTraceOptions(
+    common::Configuration *conf, OpTraceOptions *opTraceOptions) {
+    LOG_IF(FATAL, !conf->GetBoolValue(
+        "trace.enable", &opTraceOptions->enable));
+    LOG_IF(FATAL, !conf->GetUInt64Value(
+        "trace.slow_request_threshold_us",
+        &opTraceOptions->slowRequestThresholdUs));
+    LOG_IF(FATAL, !conf->GetUInt32Value(
+        "trace.slow_request_dump_num", &opTraceOptions->slowRequestDumpNum));
+}
+
 void ChunkServer::InitMetricOptions(
     common::Configuration *conf, ChunkServerMetricOptions *metricOptions) {
     LOG_IF(FATAL, !conf->GetUInt32Value(
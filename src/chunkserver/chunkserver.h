@@ -31,6 +31,9 @@
 #include "src/chunkserver/clone_manager.h"
 #include "src/chunkserver/register.h"
 #include "src/chunkserver/trash.h"
+#include "src/chunkserver/scrub_manager.h"
+#include "src/chunkserver/qos_scheduler.h"
+#include "src/chunkserver/op_trace.h"
 #include "src/chunkserver/chunkserver_metrics.h"
 
 namespace curve {
@@ -74,6 +77,15 @@ class ChunkServer {
     void InitTrashOptions(common::Configuration *conf,
         TrashOptions *trashOptions);
 
+    void InitScrubOptions(common::Configuration *conf,
+        ScrubOptions *scrubOptions);
+
+    void InitOpTraceOptions(common::Configuration *conf,
+        OpTraceOptions *opTraceOptions);
+
+    void InitQosOptions(common::Configuration *conf,
+        QosOptions *qosOptions);
+
     void InitMetricOptions(common::Configuration *conf,
         ChunkServerMetricOptions *metricOptions);
 
@@ -100,6 +112,12 @@ class ChunkServer {
     // trash_ 定期回收垃圾站中的物理空间
     std::shared_ptr<Trash> trash_;
 
+    // scrubManager_ 后台巡检副本间的数据一致性
+    ScrubManager scrubManager_;
+
+    // qosScheduler_ 按照copyset和client调度读写请求
+    QosScheduler qosScheduler_;
+
     // install snapshot流控
     scoped_refptr<SnapshotThrottle> snapshotThrottle_;
 };
@@ -215,10 +215,22 @@ void CSCopysetMetric::MonitorDataStore(CSDataStore* datastore) {
         cloneChunkCountPrefix, GetDatastoreCloneChunkCountFunc, datastore);
 }
 
+void CSCopysetMetric::SetLoadTime(uint64_t loadTimeMs) {
+    if (loadTimeMs_ == nullptr) {
+        loadTimeMs_ = std::make_shared<bvar::Status<uint64_t>>(
+            Prefix() + "_load_time_ms", loadTimeMs);
+        return;
+    }
+    loadTimeMs_->set_value(loadTimeMs);
+}
+
 ChunkServerMetric::ChunkServerMetric()
     : hasInited_(false)
     , leaderCount_(nullptr)
     , chunkLeft_(nullptr)
+    , chunkRefilled_(nullptr)
+    , chunkCleaned_(nullptr)
+    , chunkAllocateDebt_(nullptr)
     , chunkTrashed_(nullptr)
     , chunkCount_(nullptr)
     , snapshotCount_(nullptr)
@@ -281,6 +293,9 @@ int ChunkServerMetric::Fini() {
     ioMetrics_.Fini();
     leaderCount_ = nullptr;
     chunkLeft_ = nullptr;
+    chunkRefilled_ = nullptr;
+    chunkCleaned_ = nullptr;
+    chunkAllocateDebt_ = nullptr;
     chunkTrashed_ = nullptr;
     chunkCount_ = nullptr;
     snapshotCount_ = nullptr;
@@ -377,6 +392,16 @@ void ChunkServerMetric::MonitorChunkFilePool(ChunkfilePool* chunkfilePool) {
     std::string chunkLeftPrefix = Prefix() + "_chunkfilepool_left";
     chunkLeft_ = std::make_shared<bvar::PassiveStatus<uint32_t>>(
         chunkLeftPrefix, GetChunkLeftFunc, chunkfilePool);
+    std::string chunkRefilledPrefix = Prefix() + "_chunkfilepool_refilled";
+    chunkRefilled_ = std::make_shared<bvar::PassiveStatus<uint32_t>>(
+        chunkRefilledPrefix, GetChunkRefilledFunc, chunkfilePool);
+    std::string chunkCleanedPrefix = Prefix() + "_chunkfilepool_cleaned";
+    chunkCleaned_ = std::make_shared<bvar::PassiveStatus<uint32_t>>(
+        chunkCleanedPrefix, GetChunkCleanedFunc, chunkfilePool);
+    std::string allocateDebtPrefix =
+        Prefix() + "_chunkfilepool_allocate_debt";
+    chunkAllocateDebt_ = std::make_shared<bvar::PassiveStatus<uint32_t>>(
+        allocateDebtPrefix, GetChunkAllocateDebtFunc, chunkfilePool);
 }
 
 void ChunkServerMetric::MonitorTrash(Trash* trash) {
@@ -55,6 +55,9 @@ using PassiveStatusPtr = std::shared_ptr<bvar::PassiveStatus<Tp>>;
 template <typename Tp>
 using AdderPtr = std::shared_ptr<bvar::Adder<Tp>>;
 
+template <typename Tp>
+using StatusPtr = std::shared_ptr<bvar::Status<Tp>>;
+
 // 使用LatencyRecorder的实现来统计读写请求的size情况
 // 可以统计分位值、最大值、中位数、平均值等情况
 using IOSizeRecorder = bvar::LatencyRecorder;
@@ -183,7 +186,8 @@ class CSCopysetMetric {
         , copysetId_(0)
         , chunkCount_(nullptr)
         , snapshotCount_(nullptr)
-        , cloneChunkCount_(nullptr) {}
+        , cloneChunkCount_(nullptr)
+        , loadTimeMs_(nullptr) {}
 
     ~CSCopysetMetric() {}
 
@@ -201,6 +205,12 @@ class CSCopysetMetric {
      */
     void MonitorDataStore(CSDataStore* datastore);
 
+    /**
+     * chunkserver启动时记录copyset从开始加载到可以对外提供服务的时间
+     * @param loadTimeMs: copyset的加载时间，单位ms
+     */
+    void SetLoadTime(uint64_t loadTimeMs);
+
     /**
      * 执行请求前记录metric
      * @param type: 请求对应的metric类型
@@ -254,6 +264,13 @@ class CSCopysetMetric {
         return cloneChunkCount_->get_value();
     }
 
+    const uint64_t GetLoadTime() const {
+        if (loadTimeMs_ == nullptr) {
+            return 0;
+        }
+        return loadTimeMs_->get_value();
+    }
+
  private:
     inline std::string Prefix() {
         return "copyset_"
@@ -273,6 +290,8 @@ class CSCopysetMetric {
     PassiveStatusPtr<uint32_t> snapshotCount_;
     // copyset上的 clone chunk 的数量
     PassiveStatusPtr<uint32_t> cloneChunkCount_;
+    // chunkserver启动时copyset的加载时间
+    StatusPtr<uint64_t> loadTimeMs_;
     // copyset上的IO类型的metric统计
     CSIOMetric ioMetrics_;
 };
@@ -517,6 +536,12 @@ class ChunkServerMetric : public Uncopyable {
     AdderPtr<uint32_t> leaderCount_;
     // chunkfilepool 中剩余的 chunk 的数量
     PassiveStatusPtr<uint32_t> chunkLeft_;
+    // chunkfilepool 后台补充的 chunk 的数量
+    PassiveStatusPtr<uint32_t> chunkRefilled_;
+    // chunkfilepool 后台清零的回收 chunk 的数量
+    PassiveStatusPtr<uint32_t> chunkCleaned_;
+    // chunkfilepool 为空时在写路径上直接分配 chunk 的次数
+    PassiveStatusPtr<uint32_t> chunkAllocateDebt_;
     // trash 中的 chunk 的数量
     PassiveStatusPtr<uint32_t> chunkTrashed_;
     // chunkserver上的 chunk 的数量
@@ -29,6 +29,7 @@
 #include "src/fs/local_filesystem.h"
 #include "src/chunkserver/trash.h"
 #include "src/chunkserver/inflight_throttle.h"
+#include "src/chunkserver/hash_throttle.h"
 #include "include/chunkserver/chunkserver_common.h"
 
 namespace curve {
@@ -40,6 +41,7 @@ class ConcurrentApplyModule;
 class ChunkfilePool;
 class CopysetNodeManager;
 class CloneManager;
+class QosScheduler;
 
 /**
  * copyset node的配置选项
@@ -106,6 +108,9 @@ struct CopysetNodeOptions {
 
     // 限制chunkserver启动时copyset并发恢复加载的数量,为0表示不限制
     uint32_t loadConcurrency = 0;
+    // 同时读盘加载(datastore扫描、raft日志和快照加载)的copyset数量上限，
+    // 等待追上leader的copyset不计入，为0表示不限制
+    uint32_t loadDiskConcurrency = 0;
     // 检查copyset是否加载完成出现异常时的最大重试次数
     // 可能的异常：1.当前大多数副本还没起来；2.网络问题等导致无法获取leader
     // 3.其他的原因导致无法获取到leader的committed index
@@ -116,6 +121,32 @@ struct CopysetNodeOptions {
     // 循环判定copyset是否加载完成的内部睡眠时间
     uint32_t checkLoadMarginIntervalMs = 1000;
 
+    // 是否将短时间内到达的多个小写请求合并成一条raft log entry propose
+    bool enableRaftBatch = false;
+    // 长度不超过该值的写请求才参与合并
+    uint32_t raftBatchMaxWriteSize = 16 * 1024;
+    // 一条log entry中最多合并的op数量
+    uint32_t raftBatchMaxOps = 32;
+    // 一条log entry中合并的写数据总长度上限
+    uint32_t raftBatchMaxBytes = 256 * 1024;
+    // 已经propose但还没有commit的合并log entry的个数上限，
+    // 达到上限时没有凑满的batch等待之前的log entry commit之后再propose
+    uint32_t raftBatchMaxInflight = 2;
+
+    // clone chunk延迟持久化bitmap时未持久化的page数量上限，为0表示不延迟
+    uint32_t cloneMetaFlushDirtyPages = 0;
+    // clone chunk延迟持久化bitmap时bitmap最长的未持久化时间，为0表示不限制
+    uint32_t cloneMetaFlushIntervalMs = 0;
+    // 新建的快照文件是否使用稀疏格式，只为cow拷贝过的page分配空间
+    bool enableSparseSnapshot = false;
+    // 每个copyset同时打开的chunk文件数上限，大于0时chunk文件在第一次访问时才打开，
+    // 为0表示不限制，加载copyset时打开所有chunk文件
+    uint32_t maxOpenChunkFiles = 0;
+    // leader在租约有效期内直接读取本地数据，不再propose读请求
+    bool enableLeaseRead = false;
+    // 是否允许follower处理携带appliedindex的读请求
+    bool enableFollowerRead = false;
+
     CopysetNodeOptions();
 };
 
@@ -126,6 +157,12 @@ struct ChunkServiceOptions {
     CopysetNodeManager *copysetNodeManager;
     CloneManager *cloneManager;
     std::shared_ptr<InflightThrottle> inflightThrottle;
+    // 计算copyset hash时的读盘限速，整个chunkserver共享，为空表示不限制
+    std::shared_ptr<HashThrottle> hashThrottle;
+    // 单次GetCopysetHash请求最多计算的chunk个数，为0表示不限制
+    uint32_t hashMaxChunksPerCall = 0;
+    // 为空时请求不经过QoS调度直接执行
+    QosScheduler *qosScheduler = nullptr;
 };
 
 }  // namespace chunkserver
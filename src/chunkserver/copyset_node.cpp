@@ -25,6 +25,7 @@
 #include <glog/logging.h>
 #include <brpc/controller.h>
 #include <butil/sys_byteorder.h>
+#include <butil/time.h>
 #include <braft/closure_helper.h>
 #include <braft/snapshot.h>
 #include <braft/protobuf_file.h>
@@ -69,6 +70,8 @@ CopysetNode::CopysetNode(const LogicPoolID &logicPoolId,
 }
 
 CopysetNode::~CopysetNode() {
+    StopBatchQueue();
+
     // 移除 copyset的metric
     ChunkServerMetric::GetInstance()->RemoveCopysetMetric(logicPoolId_,
                                                           copysetId_);
@@ -112,6 +115,10 @@ int CopysetNode::Init(const CopysetNodeOptions &options) {
     dsOptions.chunkSize = options.maxChunkSize;
     dsOptions.pageSize = options.pageSize;
     dsOptions.locationLimit = options.locationLimit;
+    dsOptions.metaFlushDirtyPages = options.cloneMetaFlushDirtyPages;
+    dsOptions.metaFlushIntervalMs = options.cloneMetaFlushIntervalMs;
+    dsOptions.sparseSnapshot = options.enableSparseSnapshot;
+    dsOptions.maxOpenChunkFiles = options.maxOpenChunkFiles;
     dataStore_ = std::make_shared<CSDataStore>(options.localFileSystem,
                                                options.chunkfilePool,
                                                dsOptions);
@@ -171,6 +178,37 @@ int CopysetNode::Init(const CopysetNodeOptions &options) {
     raftNode_ = std::make_shared<RaftNode>(groupId, peerId_);
     concurrentapply_ = options.concurrentapply;
 
+    /**
+     * follower在最后一次收到leader的日志之后，至少要等待一个选举超时时间
+     * 才会发起选举，新leader的日志必须包含续约租约的那条已提交日志，
+     * 所以从这条日志propose开始的一个选举超时时间内不会有新的leader，
+     * 这里只取其中的4/5以容忍时钟速率的误差
+     */
+    enableLeaseRead_ = options.enableLeaseRead;
+    leaseDurationUs_ = static_cast<int64_t>(options.electionTimeoutMs) * 800;
+    enableFollowerRead_ = options.enableFollowerRead;
+
+    /*
+     * 初始化小写请求的合并队列
+     */
+    enableRaftBatch_ = options.enableRaftBatch;
+    raftBatchMaxWriteSize_ = options.raftBatchMaxWriteSize;
+    raftBatchMaxOps_ = options.raftBatchMaxOps;
+    raftBatchMaxBytes_ = options.raftBatchMaxBytes;
+    raftBatchMaxInflight_ = options.raftBatchMaxInflight;
+    if (enableRaftBatch_) {
+        bthread::ExecutionQueueOptions queueOptions;
+        if (0 != bthread::execution_queue_start(&batchQueueId_,
+                                                &queueOptions,
+                                                ExecuteBatchTasks,
+                                                this)) {
+            LOG(ERROR) << "Fail to start raft batch queue. "
+                       << "Copyset: " << GroupIdString();
+            return -1;
+        }
+        batchQueueStarted_.store(true);
+    }
+
     /*
      * 初始化copyset性能metrics
      */
@@ -204,6 +242,9 @@ int CopysetNode::Run() {
 }
 
 void CopysetNode::Fini() {
+    // 先将合并队列中剩余的请求propose出去，再关闭raft node
+    StopBatchQueue();
+
     if (nullptr != raftNode_) {
         // 关闭所有关于此raft node的服务
         raftNode_->shutdown(nullptr);
@@ -233,11 +274,36 @@ void CopysetNode::on_apply(::braft::Iterator &iter) {
              * 1.closure不是null，那么说明当前节点正常，直接从内存中拿到Op
              * context进行apply
              */
+            BatchChunkClosure
+                *batchClosure = dynamic_cast<BatchChunkClosure *>(closure);
+            if (nullptr != batchClosure) {
+                /**
+                 * 多个op合并在一条log entry中，为每个op生成各自的
+                 * ChunkClosure，按顺序交给并发模块apply，同一个chunk
+                 * 上的op会进入同一个队列，保证了apply的顺序
+                 */
+                // 取最早propose的请求的时间，续约的租约偏保守
+                if (!batchClosure->requests_.empty()) {
+                    RenewLease(
+                        batchClosure->requests_.front()->ProposeTimeUs());
+                }
+                for (auto &opRequest : batchClosure->requests_) {
+                    opRequest->MarkTrace(OpTraceStage::RAFT_COMMIT);
+                    auto task = std::bind(&ChunkOpRequest::OnApply,
+                                          opRequest,
+                                          iter.index(),
+                                          new ChunkClosure(opRequest));
+                    concurrentapply_->Push(opRequest->ChunkId(), task);
+                }
+                continue;
+            }
             ChunkClosure
                 *chunkClosure = dynamic_cast<ChunkClosure *>(iter.done());
             CHECK(nullptr != chunkClosure)
                 << "ChunkClosure dynamic cast failed";
             std::shared_ptr<ChunkOpRequest> opRequest = chunkClosure->request_;
+            RenewLease(opRequest->ProposeTimeUs());
+            opRequest->MarkTrace(OpTraceStage::RAFT_COMMIT);
             auto task = std::bind(&ChunkOpRequest::OnApply,
                                   opRequest,
                                   iter.index(),
@@ -251,21 +317,36 @@ void CopysetNode::on_apply(::braft::Iterator &iter) {
              * 2.1. 节点重启，回放apply，这里会将Op log entry进行反序列化，
              * 然后获取Op信息进行apply
              * 2.2. follower apply
+             * 如果是多个op合并的log entry，先拆分成单个op的log再依次apply
              */
-            ChunkRequest request;
-            butil::IOBuf data;
-            auto opReq = ChunkOpRequest::Decode(log, &request, &data);
-            auto chunkId = request.chunkid();
-            auto task = std::bind(&ChunkOpRequest::OnApplyFromLog,
-                                  opReq,
-                                  dataStore_,
-                                  std::move(request),
-                                  data);
-            concurrentapply_->Push(chunkId, task);
+            if (ChunkOpRequest::IsBatchLog(log)) {
+                std::vector<butil::IOBuf> opLogs;
+                CHECK(0 == ChunkOpRequest::DecodeBatch(log, &opLogs))
+                    << "Fail to decode batch log, index: " << iter.index()
+                    << ", copyset: " << GroupIdString();
+                for (const auto &opLog : opLogs) {
+                    ApplyOpLog(opLog);
+                }
+            } else {
+                ApplyOpLog(log);
+            }
         }
     }
 }
 
+void CopysetNode::ApplyOpLog(const butil::IOBuf &log) {
+    ChunkRequest request;
+    butil::IOBuf data;
+    auto opReq = ChunkOpRequest::Decode(log, &request, &data);
+    auto chunkId = request.chunkid();
+    auto task = std::bind(&ChunkOpRequest::OnApplyFromLog,
+                          opReq,
+                          dataStore_,
+                          std::move(request),
+                          data);
+    concurrentapply_->Push(chunkId, task);
+}
+
 void CopysetNode::on_shutdown() {
     LOG(INFO) << GroupIdString() << " is shutdown";
 }
@@ -279,6 +360,19 @@ void CopysetNode::on_snapshot_save(::braft::SnapshotWriter *writer,
      */
     concurrentapply_->Flush();
 
+    /**
+     * 持久化clone chunk延迟落盘的bitmap，快照之前的日志会被删除，
+     * 之后无法再通过回放日志恢复bitmap
+     */
+    CSErrorCode errorCode = dataStore_->SyncChunkMetaPages();
+    if (errorCode != CSErrorCode::Success) {
+        done->status().set_error(EIO, "sync chunk metapage failed");
+        LOG(ERROR) << "SyncChunkMetaPages failed. "
+                   << "Copyset: " << GroupIdString()
+                   << ", error code: " << errorCode;
+        return;
+    }
+
     /**
      * 2.保存配置版本: conf.epoch，注意conf.epoch是存放在data目录下
      */
@@ -429,6 +523,8 @@ int CopysetNode::on_snapshot_load(::braft::SnapshotReader *reader) {
 }
 
 void CopysetNode::on_leader_start(int64_t term) {
+    // 新任期的租约在本任期propose的日志apply之后才生效
+    leaseStartUs_.store(0, std::memory_order_release);
     leaderTerm_.store(term, std::memory_order_release);
     ChunkServerMetric::GetInstance()->IncreaseLeaderCount();
     LOG(INFO) << "Copyset: " << GroupIdString()
@@ -438,6 +534,7 @@ void CopysetNode::on_leader_start(int64_t term) {
 
 void CopysetNode::on_leader_stop(const butil::Status &status) {
     leaderTerm_.store(-1, std::memory_order_release);
+    leaseStartUs_.store(0, std::memory_order_release);
     ChunkServerMetric::GetInstance()->DecreaseLeaderCount();
     LOG(INFO) << "Copyset: " << GroupIdString()
               << ", peer id: " << peerId_.to_string() << " stepped down";
@@ -565,6 +662,31 @@ PeerId CopysetNode::GetLeaderId() const {
     return raftNode_->leader_id();
 }
 
+bool CopysetNode::IsLeaseValid() const {
+    if (!enableLeaseRead_ || !IsLeaderTerm()) {
+        return false;
+    }
+    int64_t leaseStart = leaseStartUs_.load(std::memory_order_acquire);
+    return leaseStart > 0
+        && butil::monotonic_time_us() - leaseStart < leaseDurationUs_;
+}
+
+void CopysetNode::RenewLease(int64_t proposeTimeUs) {
+    /**
+     * on_apply和on_leader_stop都在状态机的线程中串行执行，
+     * 这里看到的leader状态和日志的apply顺序是一致的，transfer leader
+     * 开始时braft会调用on_leader_stop，所以transfer过程中不会续约
+     */
+    if (!enableLeaseRead_ || !IsLeaderTerm() || proposeTimeUs <= 0) {
+        return;
+    }
+    int64_t leaseStart = leaseStartUs_.load(std::memory_order_acquire);
+    while (leaseStart < proposeTimeUs &&
+           !leaseStartUs_.compare_exchange_weak(leaseStart, proposeTimeUs,
+                                                std::memory_order_acq_rel)) {
+    }
+}
+
 butil::Status CopysetNode::TransferLeader(const Peer& peer) {
     butil::Status status;
     PeerId peerId(peer.address());
@@ -730,6 +852,147 @@ void CopysetNode::Propose(const braft::Task &task) {
     raftNode_->apply(task);
 }
 
+bool CopysetNode::IsBatchable(const ChunkRequest *request) const {
+    return batchQueueStarted_.load(std::memory_order_acquire)
+        && request->optype() == CHUNK_OP_TYPE::CHUNK_OP_WRITE
+        && request->size() <= raftBatchMaxWriteSize_;
+}
+
+int CopysetNode::ProposeBatch(std::shared_ptr<ChunkOpRequest> opRequest,
+                              const ChunkRequest *request,
+                              const butil::IOBuf &data) {
+    BatchOpTask task;
+    task.opRequest = opRequest;
+    task.request = request;
+    task.data = data;
+    task.term = leaderTerm_.load(std::memory_order_acquire);
+    if (0 != bthread::execution_queue_execute(batchQueueId_, task)) {
+        LOG(ERROR) << "Fail to push request to raft batch queue. "
+                   << "Copyset: " << GroupIdString();
+        return -1;
+    }
+    return 0;
+}
+
+int CopysetNode::ExecuteBatchTasks(void *meta,
+                                   bthread::TaskIterator<BatchOpTask> &iter) {
+    CopysetNode *node = static_cast<CopysetNode *>(meta);
+    if (iter.is_queue_stopped()) {
+        // 停止之前将暂缓的请求全部propose出去
+        if (!node->pendingBatch_.empty()) {
+            node->ProposePendingBatch();
+        }
+        return 0;
+    }
+
+    for (; iter; ++iter) {
+        // log entry commit之后的通知，只需要在下面判断是否propose
+        if (nullptr == iter->opRequest) {
+            continue;
+        }
+        // 凑满上限或者任期发生变化，则先将已经收集的请求propose出去
+        std::vector<BatchOpTask> &batch = node->pendingBatch_;
+        if (!batch.empty()
+            && (batch.size() >= node->raftBatchMaxOps_
+                || node->pendingBatchBytes_ + iter->data.size()
+                    > node->raftBatchMaxBytes_
+                || iter->term != batch.front().term)) {
+            node->ProposePendingBatch();
+        }
+        node->pendingBatchBytes_ += iter->data.size();
+        batch.push_back(*iter);
+    }
+    if (node->pendingBatch_.empty()) {
+        return 0;
+    }
+
+    /**
+     * 没有凑满的batch，在inflight的log entry较少时直接propose，
+     * 否则暂缓，由之前的log entry commit之后的通知触发propose。
+     * 先设置hasPendingBatch_再检查inflight，与OnBatchCommitted中
+     * 先减inflight再检查hasPendingBatch_的顺序相反，保证两边至少有
+     * 一边能看到对方的修改，暂缓的请求不会一直等待
+     */
+    node->hasPendingBatch_.store(true);
+    if (node->batchInflight_.load() < node->raftBatchMaxInflight_) {
+        node->hasPendingBatch_.store(false);
+        node->ProposePendingBatch();
+    }
+    return 0;
+}
+
+void CopysetNode::ProposePendingBatch() {
+    batchInflight_.fetch_add(1);
+    ProposeBatchTasks(&pendingBatch_);
+    pendingBatchBytes_ = 0;
+}
+
+void CopysetNode::ProposeBatchTasks(std::vector<BatchOpTask> *batch) {
+    braft::Task task;
+    butil::IOBuf log;
+    int ret = 0;
+    std::vector<std::shared_ptr<ChunkOpRequest>> requests;
+    requests.reserve(batch->size());
+    for (const auto &opTask : *batch) {
+        requests.push_back(opTask.opRequest);
+    }
+    if (batch->size() == 1) {
+        // 只有一个请求的时候保持原有的log entry格式
+        const BatchOpTask &opTask = batch->front();
+        ret = ChunkOpRequest::Encode(opTask.request, &opTask.data, &log);
+    } else {
+        std::vector<std::pair<const ChunkRequest *, const butil::IOBuf *>> ops;
+        ops.reserve(batch->size());
+        for (const auto &opTask : *batch) {
+            ops.emplace_back(opTask.request, &opTask.data);
+        }
+        ret = ChunkOpRequest::EncodeBatch(ops, &log);
+    }
+    // 单个请求也使用BatchChunkClosure，commit之后统一通知合并队列
+    task.done = new BatchChunkClosure(requests,
+                                      [this]() { OnBatchCommitted(); });
+
+    if (0 != ret) {
+        LOG(ERROR) << "chunk op request encode failure, op count: "
+                   << batch->size() << ", copyset: " << GroupIdString();
+        task.done->status().set_error(EINVAL, "encode failure");
+        task.done->Run();
+        batch->clear();
+        return;
+    }
+
+    task.data = &log;
+    /**
+     * 与单个op propose相同，设置请求进入队列时的任期，
+     * 避免leader切换过程中的ABA问题
+     */
+    task.expected_term = batch->front().term;
+    raftNode_->apply(task);
+    batch->clear();
+}
+
+void CopysetNode::OnBatchCommitted() {
+    batchInflight_.fetch_sub(1);
+    if (!hasPendingBatch_.exchange(false)) {
+        return;
+    }
+    // 合并队列已经停止时，暂缓的请求在停止时已经propose
+    BatchOpTask task;
+    task.request = nullptr;
+    task.term = 0;
+    if (batchQueueStarted_.load(std::memory_order_acquire)) {
+        bthread::execution_queue_execute(batchQueueId_, task);
+    }
+}
+
+void CopysetNode::StopBatchQueue() {
+    if (!batchQueueStarted_.exchange(false)) {
+        return;
+    }
+    bthread::execution_queue_stop(batchQueueId_);
+    bthread::execution_queue_join(batchQueueId_);
+}
+
 int CopysetNode::GetConfChange(ConfigChangeType *type,
                                Configuration *oldConf,
                                Peer *alterPeer) {
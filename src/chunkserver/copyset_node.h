@@ -24,6 +24,7 @@
 #define SRC_CHUNKSERVER_COPYSET_NODE_H_
 
 #include <butil/memory/ref_counted.h>
+#include <bthread/execution_queue.h>
 
 #include <string>
 #include <vector>
@@ -52,6 +53,7 @@ using ::curve::mds::heartbeat::ConfigChangeType;
 using ::curve::common::Peer;
 
 class CopysetNodeManager;
+class ChunkOpRequest;
 
 extern const char *kCurveConfEpochFilename;
 
@@ -98,6 +100,21 @@ class ConfigurationChangeDone : public braft::Closure {
     ConfigurationChange expectedCfgChange;
 };
 
+/**
+ * 等待合并propose的小写请求，opRequest为空时表示合并的log entry已经
+ * commit，通知合并队列propose暂缓的请求
+ */
+struct BatchOpTask {
+    // op request上下文
+    std::shared_ptr<ChunkOpRequest> opRequest;
+    // rpc请求
+    const ChunkRequest *request;
+    // 请求中包含的数据内容
+    butil::IOBuf data;
+    // 请求进入队列时leader的任期
+    int64_t term;
+};
+
 /**
  * 一个Copyset Node就是一个复制组的副本
  */
@@ -167,6 +184,20 @@ class CopysetNode : public braft::StateMachine,
      */
     virtual PeerId GetLeaderId() const;
 
+    /**
+     * 返回leader的租约是否有效，租约有效期内不会有新的leader当选，
+     * leader可以不经过raft直接读取本地已经apply的数据
+     * @return 租约有效返回true，否则返回false
+     */
+    virtual bool IsLeaseValid() const;
+
+    /**
+     * 返回是否允许follower处理携带appliedindex的读请求
+     */
+    virtual bool IsFollowerReadEnabled() const {
+        return enableFollowerRead_;
+    }
+
     /**
      * @brief 切换复制组的Leader
      * @param[in] peerId 目标Leader的成员ID
@@ -261,6 +292,25 @@ class CopysetNode : public braft::StateMachine,
      */
     virtual void Propose(const braft::Task &task);
 
+    /**
+     * 判断op request是否需要与其他请求合并成一条log entry propose
+     * @param request:Chunk Request
+     * @return 需要合并返回true，否则返回false
+     */
+    virtual bool IsBatchable(const ChunkRequest *request) const;
+
+    /**
+     * 将小写请求放入合并队列，由队列的执行函数将同一时间段内到达的
+     * 请求打包成一条log entry之后propose给raft
+     * @param opRequest:op request上下文
+     * @param request:Chunk Request
+     * @param data:请求中包含的数据内容
+     * @return 0成功，-1失败
+     */
+    virtual int ProposeBatch(std::shared_ptr<ChunkOpRequest> opRequest,
+                             const ChunkRequest *request,
+                             const butil::IOBuf &data);
+
     /**
      * 获取复制组成员
      * @param peers:返回的成员列表(输出参数)
@@ -376,6 +426,12 @@ class CopysetNode : public braft::StateMachine,
      */
     int SaveConfEpoch(const std::string &filePath);
 
+    /**
+     * leader自己propose的日志apply时续约租约，租约只会向后延长
+     * @param proposeTimeUs: 日志的propose时间
+     */
+    void RenewLease(int64_t proposeTimeUs);
+
  private:
     inline std::string GroupId() {
         return ToGroupId(logicPoolId_, copysetId_);
@@ -385,6 +441,43 @@ class CopysetNode : public braft::StateMachine,
         return ToGroupIdString(logicPoolId_, copysetId_);
     }
 
+    /**
+     * 合并队列的执行函数，取出队列中所有等待的请求追加到pendingBatch_，
+     * 凑满上限的batch立即propose；没有凑满的batch只有在inflight的合并
+     * log entry少于raftBatchMaxInflight_时才propose，否则暂缓，等之前的
+     * log entry commit之后和后续到达的请求一起propose
+     */
+    static int ExecuteBatchTasks(void *meta,
+                                 bthread::TaskIterator<BatchOpTask> &iter);
+
+    /**
+     * 将pendingBatch_打包成一条log entry propose，只在合并队列中调用
+     */
+    void ProposePendingBatch();
+
+    /**
+     * 将一组请求打包成一条log entry propose，完成之后清空batch
+     * @param batch:需要打包的请求
+     */
+    void ProposeBatchTasks(std::vector<BatchOpTask> *batch);
+
+    /**
+     * 合并的log entry commit或者出错之后调用，如果有暂缓的batch，
+     * 通知合并队列propose
+     */
+    void OnBatchCommitted();
+
+    /**
+     * 将单个op的log entry反序列化之后交给并发模块apply
+     * @param log:单个op的log entry
+     */
+    void ApplyOpLog(const butil::IOBuf &log);
+
+    /**
+     * 停止合并队列，队列中剩余的请求会在停止之前全部propose
+     */
+    void StopBatchQueue();
+
  private:
     // 逻辑池 id
     LogicPoolID logicPoolId_;
@@ -428,6 +521,35 @@ class CopysetNode : public braft::StateMachine,
     std::shared_ptr<ConfigurationChange> configChange_;
     // transfer leader的目标，状态为TRANSFERRING时有效
     Peer transferee_;
+    // 是否开启小写请求合并
+    bool enableRaftBatch_ = false;
+    // 参与合并的写请求的最大长度
+    uint32_t raftBatchMaxWriteSize_ = 0;
+    // 一条log entry中最多合并的op数量
+    uint32_t raftBatchMaxOps_ = 0;
+    // 一条log entry中合并的写数据总长度上限
+    uint32_t raftBatchMaxBytes_ = 0;
+    // 已经propose但还没有commit的合并log entry的个数上限
+    uint32_t raftBatchMaxInflight_ = 0;
+    // 已经propose但还没有commit的合并log entry的个数
+    std::atomic<uint32_t> batchInflight_{0};
+    // 暂缓propose的请求及其数据总长度，只在合并队列中访问
+    std::vector<BatchOpTask> pendingBatch_;
+    uint64_t pendingBatchBytes_ = 0;
+    // 是否有暂缓propose的请求，log entry commit之后据此决定是否通知合并队列
+    std::atomic<bool> hasPendingBatch_{false};
+    // 小写请求的合并队列
+    bthread::ExecutionQueueId<BatchOpTask> batchQueueId_ = {0};
+    // 合并队列是否已经启动
+    std::atomic<bool> batchQueueStarted_{false};
+    // 是否开启leader租约读
+    bool enableLeaseRead_ = false;
+    // 租约的长度
+    int64_t leaseDurationUs_ = 0;
+    // 租约的起始时间，即最近apply的本任期日志的propose时间，0表示没有租约
+    std::atomic<int64_t> leaseStartUs_{0};
+    // 是否允许follower处理读请求
+    bool enableFollowerRead_ = false;
 };
 
 }  // namespace chunkserver
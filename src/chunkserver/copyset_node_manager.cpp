@@ -25,7 +25,10 @@
 #include <glog/logging.h>
 #include <braft/file_service.h>
 #include <braft/node_manager.h>
+#include <fcntl.h>
+#include <sys/stat.h>
 
+#include <algorithm>
 #include <vector>
 #include <string>
 #include <utility>
@@ -44,6 +47,7 @@ namespace curve {
 namespace chunkserver {
 
 using curve::common::TimeUtility;
+using curve::common::CountDownEvent;
 
 std::once_flag addServiceFlag;
 
@@ -122,6 +126,8 @@ int CopysetNodeManager::ReloadCopysets() {
         return -1;
     }
 
+    // <预估的加载代价, groupId>
+    vector<std::pair<uint64_t, uint64_t>> copysets;
     vector<std::string>::iterator it = items.begin();
     for (; it != items.end(); ++it) {
         LOG(INFO) << "Found copyset dir " << *it;
@@ -131,29 +137,47 @@ int CopysetNodeManager::ReloadCopysets() {
             LOG(ERROR) << "parse " << *it << " to graoupId err";
             return -1;
         }
+        uint64_t cost = 0;
+        if (copysetLoader_ != nullptr) {
+            cost = EstimateLoadCost(datadir + "/" + *it);
+        }
+        copysets.emplace_back(cost, groupId);
+    }
+
+    // 并发加载时先加载代价大的copyset，避免最后剩下一个大copyset
+    // 单独加载，拖长整体的加载时间
+    std::stable_sort(copysets.begin(), copysets.end(),
+        [](const std::pair<uint64_t, uint64_t>& a,
+           const std::pair<uint64_t, uint64_t>& b) {
+            return a.first > b.first;
+        });
+
+    CountDownEvent loadDone(copysets.size());
+    for (const auto& copyset : copysets) {
+        uint64_t groupId = copyset.second;
         uint64_t poolId = GetPoolID(groupId);
         uint64_t copysetId = GetCopysetID(groupId);
         LOG(INFO) << "Parsed groupid " << groupId
-                  << " as " << ToGroupIdString(poolId, copysetId);
+                  << " as " << ToGroupIdString(poolId, copysetId)
+                  << ", estimated load cost: " << copyset.first;
 
         if (copysetLoader_ == nullptr) {
             LoadCopyset(poolId, copysetId, false);
         } else {
-            copysetLoader_->Enqueue(
-                std::bind(&CopysetNodeManager::LoadCopyset,
-                          this,
-                          poolId,
-                          copysetId,
-                          true));
+            copysetLoader_->Enqueue([this, poolId, copysetId, &loadDone] {
+                LoadCopyset(poolId, copysetId, true);
+                loadDone.Signal();
+            });
         }
     }
 
-    // 如果加载成功，则等待所有copyset加载完成，关闭线程池
+    // 等待所有copyset加载完成，关闭线程池
     if (copysetLoader_ != nullptr) {
-        while (copysetLoader_->QueueSize() != 0) {
-            ::sleep(1);
+        while (!loadDone.WaitFor(1000)) {
+            if (!running_.load(std::memory_order_acquire)) {
+                break;
+            }
         }
-        // queue size为0，但是线程池中的线程仍然可能还在执行
         // stop内部会去join thread，以此保证所有任务执行完以后再退出
         copysetLoader_->Stop();
         copysetLoader_ = nullptr;
@@ -162,6 +186,29 @@ int CopysetNodeManager::ReloadCopysets() {
     return 0;
 }
 
+uint64_t CopysetNodeManager::EstimateLoadCost(const std::string& copysetDir) {
+    // copyset加载时主要的开销是datastore扫描data目录下的chunk文件，
+    // 目录本身的大小随其中文件数量增长，只需要一次stat就可以得到，
+    // 避免启动时串行地list每个copyset的data目录
+    std::string dataDir = copysetDir + "/" + RAFT_DATA_DIR;
+    int fd = copysetNodeOptions_.localFileSystem->Open(
+        dataDir, O_RDONLY | O_DIRECTORY);
+    if (fd < 0) {
+        LOG(WARNING) << "Failed to open " << dataDir
+                     << ", treat load cost as 0";
+        return 0;
+    }
+    struct stat info;
+    int ret = copysetNodeOptions_.localFileSystem->Fstat(fd, &info);
+    copysetNodeOptions_.localFileSystem->Close(fd);
+    if (ret != 0) {
+        LOG(WARNING) << "Failed to stat " << dataDir
+                     << ", treat load cost as 0";
+        return 0;
+    }
+    return info.st_size;
+}
+
 bool CopysetNodeManager::LoadFinished() {
     return loadFinished_.load(std::memory_order_acquire);
 }
@@ -175,11 +222,25 @@ void CopysetNodeManager::LoadCopyset(const LogicPoolID &logicPoolId,
               << (needCheckLoadFinished ? "Yes." : "No.");
 
     uint64_t beginTime = TimeUtility::GetTimeofDayMs();
+    // 限制同时读盘加载的copyset数量，等待catch up的copyset不占用名额
+    {
+        UniqueLock lock(diskLoadMtx_);
+        diskLoadCond_.wait(lock, [this] {
+            return copysetNodeOptions_.loadDiskConcurrency == 0
+                || diskLoading_ < copysetNodeOptions_.loadDiskConcurrency;
+        });
+        ++diskLoading_;
+    }
     // chunkserver启动加载copyset阶段，会拒绝外部的创建copyset请求
     // 因此不会有其他线程加载或者创建相同copyset，此时不需要加锁
     Configuration conf;
     std::shared_ptr<CopysetNode> copysetNode =
         CreateCopysetNodeUnlocked(logicPoolId, copysetId, conf);
+    {
+        LockGuard lock(diskLoadMtx_);
+        --diskLoading_;
+    }
+    diskLoadCond_.notify_one();
     if (copysetNode == nullptr) {
         LOG(ERROR) << "Failed to create copyset "
                    << ToGroupIdString(logicPoolId, copysetId);
@@ -190,13 +251,21 @@ void CopysetNodeManager::LoadCopyset(const LogicPoolID &logicPoolId,
                    << ToGroupIdString(logicPoolId, copysetId);
         return;
     }
+    // 插入map之后copyset即可对外提供服务，不需要等待其他copyset加载完成
+    uint64_t loadTimeMs = TimeUtility::GetTimeofDayMs() - beginTime;
+    CopysetMetricPtr metric = ChunkServerMetric::GetInstance()
+        ->GetCopysetMetric(logicPoolId, copysetId);
+    if (metric != nullptr) {
+        metric->SetLoadTime(loadTimeMs);
+    }
     if (needCheckLoadFinished) {
         std::shared_ptr<CopysetNode> node =
             GetCopysetNode(logicPoolId, copysetId);
         CheckCopysetUntilLoadFinished(node);
     }
     LOG(INFO) << "Load copyset " << ToGroupIdString(logicPoolId, copysetId)
-              << " end, time used (ms): "
+              << " end, local load time (ms): " << loadTimeMs
+              << ", time used (ms): "
               <<  TimeUtility::GetTimeofDayMs() - beginTime;
 }
 
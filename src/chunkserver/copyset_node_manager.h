@@ -26,9 +26,11 @@
 #include <mutex>    //NOLINT
 #include <vector>
 #include <memory>
+#include <string>
 #include <unordered_map>
 
 #include "src/chunkserver/copyset_node.h"
+#include "src/common/concurrent/concurrent.h"
 #include "src/common/concurrent/rw_lock.h"
 #include "src/common/uncopyable.h"
 #include "src/common/concurrent/task_thread_pool.h"
@@ -40,6 +42,10 @@ using curve::common::RWLock;
 using curve::common::ReadLockGuard;
 using curve::common::WriteLockGuard;
 using curve::common::TaskThreadPool;
+using curve::common::Mutex;
+using curve::common::LockGuard;
+using curve::common::UniqueLock;
+using curve::common::ConditionVariable;
 
 class ChunkOpRequest;
 
@@ -61,7 +67,8 @@ class CopysetNodeManager : public curve::common::Uncopyable {
     int Fini();
 
     /**
-     * @brief 加载目录下的所有copyset
+     * @brief 加载目录下的所有copyset，并发加载时按照预估的加载代价
+     *        从大到小的顺序加载，每个copyset加载完成之后即可对外提供服务
      *
      * @return 0表示加载成功，非0表示加载失败
      */
@@ -167,9 +174,18 @@ class CopysetNodeManager : public curve::common::Uncopyable {
  protected:
     CopysetNodeManager()
         : copysetLoader_(nullptr)
+        , diskLoading_(0)
         , running_(false)
         , loadFinished_(false) {}
 
+    /**
+     * 预估copyset的加载代价，用于决定copyset的加载顺序
+     * @param copysetDir: copyset的目录
+     * @return 返回copyset data目录本身的大小，随目录下的文件数量增长，
+     *         获取失败返回0
+     */
+    virtual uint64_t EstimateLoadCost(const std::string& copysetDir);
+
  private:
     /**
      * 如果指定copyset不存在，则将copyset插入到map当中（线程安全）
@@ -206,6 +222,10 @@ class CopysetNodeManager : public curve::common::Uncopyable {
     CopysetNodeOptions copysetNodeOptions_;
     // 控制copyset并发启动的数量
     std::shared_ptr<TaskThreadPool> copysetLoader_;
+    // 当前正在读盘加载的copyset数量，受loadDiskConcurrency限制
+    uint32_t diskLoading_;
+    Mutex diskLoadMtx_;
+    ConditionVariable diskLoadCond_;
     // 表示copyset node manager当前是否正在运行
     Atomic<bool> running_;
     // 表示copyset node manager当前是否已经完成加载
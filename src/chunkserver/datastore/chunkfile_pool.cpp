@@ -38,6 +38,7 @@
 #include "src/chunkserver/datastore/chunkfile_pool.h"
 
 using curve::common::kChunkFilePoolMaigic;
+using curve::common::kChunkFilePoolTmpSuffix;
 
 namespace curve {
 namespace chunkserver {
@@ -210,6 +211,11 @@ ChunkfilePool::ChunkfilePool(std::shared_ptr<LocalFileSystem> fsptr):
     CHECK(fsptr != nullptr) << "fs ptr allocate failed!";
     fsptr_ = fsptr;
     tmpChunkvec_.clear();
+    currentState_.preallocatedChunksLeft = 0;
+    currentState_.refilledChunks = 0;
+    currentState_.cleanedChunks = 0;
+    currentState_.allocateDebt = 0;
+    isStop_.store(true);
 }
 
 bool ChunkfilePool::Initialize(const ChunkfilePoolOptions& cfopt) {
@@ -220,7 +226,22 @@ bool ChunkfilePool::Initialize(const ChunkfilePoolOptions& cfopt) {
             return false;
         }
         if (fsptr_->DirExists(currentdir_.c_str())) {
-            return ScanInternal();
+            if (!ScanInternal()) {
+                return false;
+            }
+            bool needBackground = chunkPoolOpt_.lowWaterMark > 0 ||
+                                  chunkPoolOpt_.cleanRecycledChunk;
+            if (needBackground && isStop_.exchange(false)) {
+                LOG(INFO) << "start chunkfile pool refill thread"
+                          << ", low water mark = "
+                          << chunkPoolOpt_.lowWaterMark
+                          << ", refill rate = "
+                          << chunkPoolOpt_.refillRatePerSec
+                          << ", clean recycled chunk = "
+                          << chunkPoolOpt_.cleanRecycledChunk;
+                refillThread_ = Thread(&ChunkfilePool::RefillInterval, this);
+            }
+            return true;
         } else {
             LOG(ERROR) << "chunkfile pool not exists, inited failed!"
                        << " chunkfile pool path = " << currentdir_.c_str();
@@ -264,25 +285,48 @@ int ChunkfilePool::GetChunk(const std::string& targetpath, char* metapage) {
     while (retry < chunkPoolOpt_.retryTimes) {
         uint64_t chunkID;
         std::string srcpath;
+        bool allocate = !chunkPoolOpt_.getChunkFromPool;
+        // 池子为空时在写路径上直接分配，后台线程之后会把池子补充回低水位
+        bool allocateOnDebt = false;
         if (chunkPoolOpt_.getChunkFromPool) {
             std::unique_lock<std::mutex> lk(mtx_);
-            if (tmpChunkvec_.empty()) {
-                LOG(ERROR) << "no avaliable chunk!";
-                break;
+            if (!tmpChunkvec_.empty()) {
+                chunkID = tmpChunkvec_.back();
+                tmpChunkvec_.pop_back();
+            } else if (!dirtyChunkvec_.empty()) {
+                // 后台还没来得及清零的回收chunk，和未开启清零时一样直接复用
+                chunkID = dirtyChunkvec_.back();
+                dirtyChunkvec_.pop_back();
+            } else {
+                // 开启了后台补充时，池子暂时为空就直接分配，避免写请求失败
+                if (chunkPoolOpt_.lowWaterMark == 0) {
+                    LOG(ERROR) << "no avaliable chunk!";
+                    break;
+                }
+                LOG(WARNING) << "no avaliable chunk in pool, allocate directly";
+                allocate = true;
+                allocateOnDebt = true;
             }
-            chunkID = tmpChunkvec_.back();
-            srcpath = currentdir_ + "/" + std::to_string(chunkID);
-            tmpChunkvec_.pop_back();
-            --currentState_.preallocatedChunksLeft;
-        } else {
-            currentmaxfilenum_.fetch_add(1);
-            srcpath = currentdir_ + "/" + std::to_string(currentmaxfilenum_);
+            if (!allocate) {
+                srcpath = currentdir_ + "/" + std::to_string(chunkID);
+                --currentState_.preallocatedChunksLeft;
+            }
+        }
+        if (allocate) {
+            // 使用fetch_add的返回值，避免和后台补充线程得到相同的文件名
+            uint64_t filenum = currentmaxfilenum_.fetch_add(1) + 1;
+            srcpath = currentdir_ + "/" + std::to_string(filenum);
             int r = AllocateChunk(srcpath);
             if (r < 0) {
                 LOG(ERROR) << "file allocate failed, " << srcpath.c_str();
                 retry++;
                 continue;
             }
+            // 只统计分配成功、并且有后台线程补充的直接分配
+            if (allocateOnDebt && !isStop_.load()) {
+                std::unique_lock<std::mutex> lk(mtx_);
+                ++currentState_.allocateDebt;
+            }
         }
 
         bool rc = WriteMetaPage(srcpath, metapage);
@@ -334,6 +378,11 @@ int ChunkfilePool::AllocateChunk(const std::string& chunkpath) {
     }
 
     char* data = new (std::nothrow) char[chunklen];
+    if (data == nullptr) {
+        fsptr_->Close(fd);
+        LOG(ERROR) << "allocate zero buffer failed, " << chunkpath.c_str();
+        return -1;
+    }
     memset(data, 0, chunklen);
 
     ret = fsptr_->Write(fd, data, 0, chunklen);
@@ -435,8 +484,7 @@ int ChunkfilePool::RecycleChunk(const std::string& chunkpath) {
         std::string newfilename;
         {
             std::unique_lock<std::mutex> lk(mtx_);
-            currentmaxfilenum_.fetch_add(1);
-            newfilenum = currentmaxfilenum_.load();
+            newfilenum = currentmaxfilenum_.fetch_add(1) + 1;
             newfilename = std::to_string(newfilenum);
         }
         std::string targetpath = currentdir_ + "/" + newfilename;
@@ -450,17 +498,99 @@ int ChunkfilePool::RecycleChunk(const std::string& chunkpath) {
                       << ", now chunkpool size = " << tmpChunkvec_.size() + 1;
         }
         std::unique_lock<std::mutex> lk(mtx_);
-        tmpChunkvec_.push_back(newfilenum);
+        // 回收的chunk中残留着旧数据，需要清零时先交给后台线程处理
+        if (chunkPoolOpt_.cleanRecycledChunk) {
+            dirtyChunkvec_.push_back(newfilenum);
+        } else {
+            tmpChunkvec_.push_back(newfilenum);
+        }
         ++currentState_.preallocatedChunksLeft;
     }
     return 0;
 }
 
 void ChunkfilePool::UnInitialize() {
+    if (!isStop_.exchange(true)) {
+        LOG(INFO) << "stop chunkfile pool refill thread...";
+        sleeper_.interrupt();
+        refillThread_.join();
+    }
     currentdir_         = "";
 
     std::unique_lock<std::mutex> lk(mtx_);
     tmpChunkvec_.clear();
+    dirtyChunkvec_.clear();
+}
+
+void ChunkfilePool::RefillInterval() {
+    // 每秒最多处理refillRatePerSec个chunk，优先补充到低水位
+    while (sleeper_.wait_for(std::chrono::seconds(1))) {
+        uint32_t budget = chunkPoolOpt_.refillRatePerSec;
+        budget -= RefillChunks(budget);
+        CleanRecycledChunks(budget);
+    }
+}
+
+uint32_t ChunkfilePool::RefillChunks(uint32_t budget) {
+    uint32_t count = 0;
+    while (count < budget && !isStop_.load()) {
+        uint64_t filenum = 0;
+        {
+            std::unique_lock<std::mutex> lk(mtx_);
+            size_t poolSize = tmpChunkvec_.size() + dirtyChunkvec_.size();
+            if (poolSize >= chunkPoolOpt_.lowWaterMark) {
+                break;
+            }
+            filenum = currentmaxfilenum_.fetch_add(1) + 1;
+        }
+        ++count;
+
+        std::string chunkpath = currentdir_ + "/" + std::to_string(filenum);
+        if (AllocateChunk(chunkpath) != 0) {
+            LOG(ERROR) << "refill chunk failed, " << chunkpath;
+            fsptr_->Delete(chunkpath.c_str());
+            break;
+        }
+
+        std::unique_lock<std::mutex> lk(mtx_);
+        tmpChunkvec_.push_back(filenum);
+        ++currentState_.preallocatedChunksLeft;
+        ++currentState_.refilledChunks;
+    }
+    return count;
+}
+
+uint32_t ChunkfilePool::CleanRecycledChunks(uint32_t budget) {
+    uint32_t count = 0;
+    while (count < budget && !isStop_.load()) {
+        uint64_t filenum = 0;
+        {
+            std::unique_lock<std::mutex> lk(mtx_);
+            if (dirtyChunkvec_.empty()) {
+                break;
+            }
+            filenum = dirtyChunkvec_.back();
+            dirtyChunkvec_.pop_back();
+        }
+        ++count;
+
+        // AllocateChunk对已经存在的文件同样适用，会将整个文件写零
+        std::string chunkpath = currentdir_ + "/" + std::to_string(filenum);
+        bool cleaned = AllocateChunk(chunkpath) == 0;
+        if (!cleaned) {
+            LOG(ERROR) << "clean recycled chunk failed, " << chunkpath;
+        }
+
+        // 清零失败时保持原来的行为，仍然作为可用的chunk
+        std::unique_lock<std::mutex> lk(mtx_);
+        tmpChunkvec_.push_back(filenum);
+        if (cleaned) {
+            ++currentState_.cleanedChunks;
+        } else {
+            break;
+        }
+    }
+    return count;
 }
 
 bool ChunkfilePool::ScanInternal() {
@@ -476,7 +606,24 @@ bool ChunkfilePool::ScanInternal() {
     }
 
     uint64_t chunklen = chunkPoolOpt_.chunkSize + chunkPoolOpt_.metaPageSize;
+    std::string tmpSuffix(kChunkFilePoolTmpSuffix);
+    uint64_t tmpFileNum = 0;
     for (auto& iter : tmpvec) {
+        // 格式化工具异常退出时残留的临时文件，数据和文件名都可能没有落盘
+        if (iter.size() > tmpSuffix.size() &&
+            iter.compare(iter.size() - tmpSuffix.size(),
+                         tmpSuffix.size(), tmpSuffix) == 0) {
+            std::string tmppath = currentdir_ + "/" + iter;
+            if (fsptr_->Delete(tmppath.c_str()) < 0) {
+                LOG(ERROR) << "delete tmp chunk file failed, " << tmppath;
+                return false;
+            }
+            LOG(WARNING) << "delete tmp chunk file left by format tool, "
+                         << tmppath;
+            ++tmpFileNum;
+            continue;
+        }
+
         auto it =
             std::find_if(iter.begin(), iter.end(), [](unsigned char c) {
             return !std::isdigit(c);
@@ -517,7 +664,7 @@ bool ChunkfilePool::ScanInternal() {
         }
     }
 
-    currentState_.preallocatedChunksLeft = tmpvec.size();
+    currentState_.preallocatedChunksLeft = tmpvec.size() - tmpFileNum;
 
     std::unique_lock<std::mutex> lk(mtx_);
     currentmaxfilenum_.store(maxnum + 1);
@@ -34,9 +34,14 @@
 #include <atomic>
 
 #include "src/fs/local_filesystem.h"
+#include "src/common/concurrent/concurrent.h"
+#include "src/common/interruptible_sleeper.h"
 #include "include/curve_compiler_specific.h"
 
 using curve::fs::LocalFileSystem;
+using ::curve::common::Thread;
+using ::curve::common::Atomic;
+using ::curve::common::InterruptibleSleeper;
 namespace curve {
 namespace chunkserver {
 
@@ -63,12 +68,25 @@ struct ChunkfilePoolOptions {
     // GetChunk重试次数
     uint16_t    retryTimes;
 
+    // 后台补充chunk的低水位，池中chunk个数低于该值时后台预分配新的chunk，
+    // 为0表示不开启后台补充，只在getChunkFromPool为true时生效
+    uint32_t    lowWaterMark;
+
+    // 后台每秒最多补充或清零的chunk个数，用于限制后台线程占用的磁盘带宽
+    uint32_t    refillRatePerSec;
+
+    // 回收的chunk是否由后台线程清零之后再复用，清零之前的chunk仍然可以被取用
+    bool        cleanRecycledChunk;
+
     ChunkfilePoolOptions() {
         getChunkFromPool = true;
         cpMetaFileSize = 4096;
         chunkSize = 0;
         metaPageSize = 0;
         retryTimes = 5;
+        lowWaterMark = 0;
+        refillRatePerSec = 16;
+        cleanRecycledChunk = false;
         ::memset(metaPath, 0, 256);
         ::memset(chunkFilePoolDir, 0, 256);
     }
@@ -79,6 +97,9 @@ struct ChunkfilePoolOptions {
         chunkSize    = other.chunkSize;
         retryTimes   = other.retryTimes;
         metaPageSize = other.metaPageSize;
+        lowWaterMark = other.lowWaterMark;
+        refillRatePerSec = other.refillRatePerSec;
+        cleanRecycledChunk = other.cleanRecycledChunk;
         ::memcpy(metaPath, other.metaPath, 256);
         ::memcpy(chunkFilePoolDir, other.chunkFilePoolDir, 256);
         return *this;
@@ -90,6 +111,9 @@ struct ChunkfilePoolOptions {
         chunkSize    = other.chunkSize;
         retryTimes   = other.retryTimes;
         metaPageSize = other.metaPageSize;
+        lowWaterMark = other.lowWaterMark;
+        refillRatePerSec = other.refillRatePerSec;
+        cleanRecycledChunk = other.cleanRecycledChunk;
         ::memcpy(metaPath, other.metaPath, 256);
         ::memcpy(chunkFilePoolDir, other.chunkFilePoolDir, 256);
     }
@@ -102,6 +126,13 @@ typedef struct ChunkFilePoolState {
     uint32_t    chunkSize;
     // metapage size
     uint32_t    metaPageSize;
+    // 后台线程累计补充的chunk个数
+    uint64_t    refilledChunks;
+    // 后台线程累计清零的回收chunk个数
+    uint64_t    cleanedChunks;
+    // 池中没有可用chunk，在写路径上直接分配成功、等待后台线程补充的次数，
+    // 没有开启后台补充时池子为空直接返回失败，不计入
+    uint64_t    allocateDebt;
 } ChunkFilePoolState_t;
 
 class ChunkfilePoolHelper {
@@ -183,7 +214,7 @@ class CURVE_CACHELINE_ALIGNMENT ChunkfilePool {
         return chunkPoolOpt_;
     }
     /**
-     * 析构,释放资源
+     * 析构,释放资源，开启了后台补充时会先停止后台线程
      */
     virtual void UnInitialize();
 
@@ -212,9 +243,25 @@ class CURVE_CACHELINE_ALIGNMENT ChunkfilePool {
      * @return: 成功返回0，否则返回小于0
      */
     int AllocateChunk(const std::string& chunkpath);
+    /**
+     * 后台线程，按照配置的速率补充chunk到低水位，并清零回收的chunk
+     */
+    void RefillInterval();
+    /**
+     * 池中chunk个数低于低水位时预分配新的chunk
+     * @param: budget为本轮最多处理的chunk个数
+     * @return: 本轮实际处理的chunk个数
+     */
+    uint32_t RefillChunks(uint32_t budget);
+    /**
+     * 将回收的chunk清零之后放回池中
+     * @param: budget为本轮最多处理的chunk个数
+     * @return: 本轮实际处理的chunk个数
+     */
+    uint32_t CleanRecycledChunks(uint32_t budget);
 
  private:
-    // 保护tmpChunkvec_
+    // 保护tmpChunkvec_和dirtyChunkvec_
     std::mutex mtx_;
 
     // 当前chunkfilepool的预分配文件，文件夹路径
@@ -226,6 +273,9 @@ class CURVE_CACHELINE_ALIGNMENT ChunkfilePool {
     // 内存中持有的chunkfile pool中的文件名的数字格式
     std::vector<uint64_t> tmpChunkvec_;
 
+    // 回收之后还没有清零的chunk，只在cleanRecycledChunk为true时使用
+    std::vector<uint64_t> dirtyChunkvec_;
+
     // 当前最大的文件名数字格式
     std::atomic<uint64_t> currentmaxfilenum_;
 
@@ -234,6 +284,14 @@ class CURVE_CACHELINE_ALIGNMENT ChunkfilePool {
 
     // chunkfilepool分配状态
     ChunkFilePoolState_t currentState_;
+
+    // 后台补充及清零chunk的线程
+    Thread refillThread_;
+
+    // false-开始后台任务，true-停止后台任务
+    Atomic<bool> isStop_;
+
+    InterruptibleSleeper sleeper_;
 };
 }   // namespace chunkserver
 }   // namespace curve
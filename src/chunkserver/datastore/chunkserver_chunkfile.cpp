@@ -30,6 +30,9 @@
 namespace curve {
 namespace chunkserver {
 
+// 计算chunk hash时每次读取的数据大小
+static const size_t kHashReadSize = 1024 * 1024;
+
 ChunkFileMetaPage::ChunkFileMetaPage(const ChunkFileMetaPage& metaPage) {
     version = metaPage.version;
     sn = metaPage.sn;
@@ -137,6 +140,11 @@ CSChunkFile::CSChunkFile(std::shared_ptr<LocalFileSystem> lfs,
       chunkId_(options.id),
       baseDir_(options.baseDir),
       isCloneChunk_(false),
+      firstDirtyTimeMs_(0),
+      metaFlushDirtyPages_(options.metaFlushDirtyPages),
+      metaFlushIntervalMs_(options.metaFlushIntervalMs),
+      sparseSnapshot_(options.sparseSnapshot),
+      lazyOpen_(options.lazyOpen),
       snapshot_(nullptr),
       chunkfilePool_(chunkfilePool),
       lfs_(lfs),
@@ -176,6 +184,59 @@ CSChunkFile::~CSChunkFile() {
 
 CSErrorCode CSChunkFile::Open(bool createFile) {
     WriteLockGuard writeGuard(rwLock_);
+    return openFile(createFile);
+}
+
+CSErrorCode CSChunkFile::Close() {
+    WriteLockGuard writeGuard(rwLock_);
+    if (fd_ < 0) {
+        return CSErrorCode::Success;
+    }
+    // bitmap在重新打开时会从metapage加载，关闭前必须持久化
+    CSErrorCode errorCode = flush(true);
+    if (errorCode != CSErrorCode::Success) {
+        LOG(ERROR) << "Flush metapage before close failed."
+                   << "ChunkID: " << chunkId_;
+        return errorCode;
+    }
+    if (snapshot_ != nullptr) {
+        snapshot_->Close();
+    }
+    lfs_->Close(fd_);
+    fd_ = -1;
+    metaPage_.bitmap = nullptr;
+    return CSErrorCode::Success;
+}
+
+CSErrorCode CSChunkFile::ensureOpen() {
+    // 未限制打开文件数时文件不会被关闭，不需要加锁检查
+    if (!lazyOpen_) {
+        return CSErrorCode::Success;
+    }
+    std::lock_guard<std::mutex> lock(openMtx_);
+    if (fd_ >= 0) {
+        return CSErrorCode::Success;
+    }
+    CSErrorCode errorCode = openFile(false);
+    if (errorCode == CSErrorCode::Success && snapshot_ != nullptr) {
+        errorCode = snapshot_->Open(false);
+    }
+    if (errorCode != CSErrorCode::Success) {
+        LOG(ERROR) << "Open chunk file failed."
+                   << "ChunkID: " << chunkId_;
+        // 关闭打开失败的文件，下次访问时重试
+        if (snapshot_ != nullptr) {
+            snapshot_->Close();
+        }
+        if (fd_ >= 0) {
+            lfs_->Close(fd_);
+            fd_ = -1;
+        }
+    }
+    return errorCode;
+}
+
+CSErrorCode CSChunkFile::openFile(bool createFile) {
     string chunkFilePath = path();
     // 创建新文件,如果chunk文件已经存在则不用再创建
     // chunk文件存在可能有两种情况引起:
@@ -220,7 +281,9 @@ CSErrorCode CSChunkFile::Open(bool createFile) {
     }
 
     CSErrorCode errCode = loadMetaPage();
-    // 重启后，只有重新open加载metapage后，才能知道是否为clone chunk
+    // 重启后，只有重新open加载metapage后，才能知道是否为clone chunk；
+    // lazy open时还没有访问过的chunk不会被统计，关闭之后isCloneChunk_保留，
+    // 再次打开时不会重复统计
     if (!metaPage_.location.empty() && !isCloneChunk_) {
         if (metric_ != nullptr) {
             metric_->cloneChunkCount << 1;
@@ -246,12 +309,17 @@ CSErrorCode CSChunkFile::LoadSnapshot(SequenceNum sn) {
     options.chunkSize = size_;
     options.pageSize = pageSize_;
     options.metric = metric_;
+    options.sparseSnapshot = sparseSnapshot_;
     snapshot_ = new(std::nothrow) CSSnapshot(lfs_,
                                             chunkfilePool_,
                                             options);
     CHECK(snapshot_ != nullptr) << "Failed to new CSSnapshot!"
                                 << "ChunkID:" << chunkId_
                                 << ",snapshot sn:" << sn;
+    // chunk文件延迟打开时，快照文件随chunk文件一起打开
+    if (fd_ < 0) {
+        return CSErrorCode::Success;
+    }
     CSErrorCode errorCode = snapshot_->Open(false);
     if (errorCode != CSErrorCode::Success) {
         delete snapshot_;
@@ -269,6 +337,10 @@ CSErrorCode CSChunkFile::Write(SequenceNum sn,
                                size_t length,
                                uint32_t* cost) {
     WriteLockGuard writeGuard(rwLock_);
+    CSErrorCode openCode = ensureOpen();
+    if (openCode != CSErrorCode::Success) {
+        return openCode;
+    }
     if (!CheckOffsetAndLength(offset, length)) {
         LOG(ERROR) << "Write chunk failed, invalid offset or length."
                    << "ChunkID: " << chunkId_
@@ -318,6 +390,7 @@ CSErrorCode CSChunkFile::Write(SequenceNum sn,
         options.chunkSize = size_;
         options.pageSize = pageSize_;
         options.metric = metric_;
+        options.sparseSnapshot = sparseSnapshot_;
         snapshot_ = new(std::nothrow) CSSnapshot(lfs_,
                                                  chunkfilePool_,
                                                  options);
@@ -380,6 +453,10 @@ CSErrorCode CSChunkFile::Write(SequenceNum sn,
 
 CSErrorCode CSChunkFile::Paste(const char * buf, off_t offset, size_t length) {
     WriteLockGuard writeGuard(rwLock_);
+    CSErrorCode openCode = ensureOpen();
+    if (openCode != CSErrorCode::Success) {
+        return openCode;
+    }
     if (!CheckOffsetAndLength(offset, length)) {
         LOG(ERROR) << "Paste chunk failed, invalid offset or length."
                    << "ChunkID: " << chunkId_
@@ -436,6 +513,10 @@ CSErrorCode CSChunkFile::Paste(const char * buf, off_t offset, size_t length) {
 
 CSErrorCode CSChunkFile::Read(char * buf, off_t offset, size_t length) {
     ReadLockGuard readGuard(rwLock_);
+    CSErrorCode openCode = ensureOpen();
+    if (openCode != CSErrorCode::Success) {
+        return openCode;
+    }
     if (!CheckOffsetAndLength(offset, length)) {
         LOG(ERROR) << "Read chunk failed, invalid offset or length."
                    << "ChunkID: " << chunkId_
@@ -478,6 +559,10 @@ CSErrorCode CSChunkFile::ReadSpecifiedChunk(SequenceNum sn,
                                             off_t offset,
                                             size_t length)  {
     ReadLockGuard readGuard(rwLock_);
+    CSErrorCode openCode = ensureOpen();
+    if (openCode != CSErrorCode::Success) {
+        return openCode;
+    }
     if (!CheckOffsetAndLength(offset, length)) {
         LOG(ERROR) << "Read specified chunk failed, invalid offset or length."
                    << "ChunkID: " << chunkId_
@@ -550,6 +635,10 @@ CSErrorCode CSChunkFile::ReadSpecifiedChunk(SequenceNum sn,
 
 CSErrorCode CSChunkFile::Delete(SequenceNum sn)  {
     WriteLockGuard writeGuard(rwLock_);
+    CSErrorCode openCode = ensureOpen();
+    if (openCode != CSErrorCode::Success) {
+        return openCode;
+    }
     // 如果 sn 小于当前chunk的版本号，不允许删除
     if (sn < metaPage_.sn) {
         LOG(WARNING) << "Delete chunk failed, backward request."
@@ -594,6 +683,10 @@ CSErrorCode CSChunkFile::Delete(SequenceNum sn)  {
 
 CSErrorCode CSChunkFile::DeleteSnapshotOrCorrectSn(SequenceNum correctedSn)  {
     WriteLockGuard writeGuard(rwLock_);
+    CSErrorCode openCode = ensureOpen();
+    if (openCode != CSErrorCode::Success) {
+        return openCode;
+    }
 
     // 如果是clone chunk， 理论上不应该会调这个接口，返回错误
     if (isCloneChunk_) {
@@ -660,8 +753,20 @@ CSErrorCode CSChunkFile::DeleteSnapshotOrCorrectSn(SequenceNum correctedSn)  {
     return CSErrorCode::Success;
 }
 
-void CSChunkFile::GetInfo(CSChunkInfo* info)  {
+CSErrorCode CSChunkFile::SyncMetaPage() {
+    WriteLockGuard writeGuard(rwLock_);
+    return flush(true);
+}
+
+CSErrorCode CSChunkFile::GetInfo(CSChunkInfo* info)  {
     ReadLockGuard readGuard(rwLock_);
+    // 文件关闭时bitmap已被释放，打开失败时不能返回clone chunk的信息
+    CSErrorCode openCode = ensureOpen();
+    if (openCode != CSErrorCode::Success) {
+        LOG(ERROR) << "Get chunk info failed, open chunk file failed."
+                   << "ChunkID: " << chunkId_;
+        return openCode;
+    }
     info->chunkId = chunkId_;
     info->pageSize = pageSize_;
     info->chunkSize = size_;
@@ -680,33 +785,41 @@ void CSChunkFile::GetInfo(CSChunkInfo* info)  {
                                                 metaPage_.bitmap->GetBitmap());
     else
         info->bitmap = nullptr;
+    return CSErrorCode::Success;
 }
 
 CSErrorCode CSChunkFile::GetHash(off_t offset,
                                  size_t length,
                                  std::string* hash)  {
     ReadLockGuard readGuard(rwLock_);
+    CSErrorCode openCode = ensureOpen();
+    if (openCode != CSErrorCode::Success) {
+        return openCode;
+    }
     uint32_t crc32c = 0;
 
-    char *buf = new(std::nothrow) char[length];
+    // 分段读取并累加计算crc，避免按照请求长度一次性分配大块内存
+    size_t bufSize = std::min(length, kHashReadSize);
+    std::unique_ptr<char[]> buf(new(std::nothrow) char[bufSize]);
     if (nullptr == buf) {
         return CSErrorCode::InternalError;
     }
 
-    int rc = lfs_->Read(fd_, buf, offset, length);
-    if (rc < 0) {
-        LOG(ERROR) << "Read chunk file failed."
-                   << "ChunkID: " << chunkId_
-                   << ",chunk sn: " << metaPage_.sn;
-        delete[] buf;
-        return CSErrorCode::InternalError;
+    size_t hashed = 0;
+    while (hashed < length) {
+        size_t readSize = std::min(length - hashed, bufSize);
+        int rc = lfs_->Read(fd_, buf.get(), offset + hashed, readSize);
+        if (rc < 0) {
+            LOG(ERROR) << "Read chunk file failed."
+                       << "ChunkID: " << chunkId_
+                       << ",chunk sn: " << metaPage_.sn;
+            return CSErrorCode::InternalError;
+        }
+        crc32c = curve::common::CRC32(crc32c, buf.get(), readSize);
+        hashed += readSize;
     }
-
-    crc32c = curve::common::CRC32(crc32c, buf, length);
     *hash = std::to_string(crc32c);
 
-    delete[] buf;
-
     return CSErrorCode::Success;
 }
 
@@ -838,42 +951,59 @@ CSErrorCode CSChunkFile::copy2Snapshot(off_t offset, size_t length) {
     return CSErrorCode::Success;
 }
 
-CSErrorCode CSChunkFile::flush() {
+CSErrorCode CSChunkFile::flush(bool force) {
+    if (!isCloneChunk_ || dirtyPages_.empty()) {
+        return CSErrorCode::Success;
+    }
     ChunkFileMetaPage tempMeta = metaPage_;
-    bool needUpdateMeta = dirtyPages_.size() > 0;
     bool clearClone = false;
     for (auto pageIndex : dirtyPages_) {
         tempMeta.bitmap->Set(pageIndex);
     }
-    if (isCloneChunk_) {
-        // 如果所有的page都被写过,将Chunk标记为非clone chunk
-        if (tempMeta.bitmap->NextClearBit(0) == Bitmap::NO_POS) {
-            tempMeta.location = "";
-            tempMeta.bitmap = nullptr;
-            needUpdateMeta = true;
-            clearClone = true;
-        }
+    // 如果所有的page都被写过,将Chunk标记为非clone chunk，需要立即持久化
+    if (tempMeta.bitmap->NextClearBit(0) == Bitmap::NO_POS) {
+        tempMeta.location = "";
+        tempMeta.bitmap = nullptr;
+        clearClone = true;
+    } else if (!force && !needFlushMetaPage()) {
+        // 延迟持久化，内存中的bitmap已经在写数据时更新
+        return CSErrorCode::Success;
     }
-    if (needUpdateMeta) {
-        CSErrorCode errorCode = updateMetaPage(&tempMeta);
-        if (errorCode != CSErrorCode::Success) {
-            LOG(ERROR) << "Update metapage failed."
-                        << "ChunkID: " << chunkId_
-                        << ",chunk sn: " << metaPage_.sn;
-            return errorCode;
-        }
-        metaPage_.bitmap = tempMeta.bitmap;
-        metaPage_.location = tempMeta.location;
-        dirtyPages_.clear();
-        if (clearClone) {
-            if (metric_ != nullptr) {
-                metric_->cloneChunkCount << -1;
-            }
-            isCloneChunk_ = false;
+
+    CSErrorCode errorCode = updateMetaPage(&tempMeta);
+    if (errorCode != CSErrorCode::Success) {
+        LOG(ERROR) << "Update metapage failed."
+                    << "ChunkID: " << chunkId_
+                    << ",chunk sn: " << metaPage_.sn;
+        return errorCode;
+    }
+    metaPage_.bitmap = tempMeta.bitmap;
+    metaPage_.location = tempMeta.location;
+    dirtyPages_.clear();
+    if (clearClone) {
+        if (metric_ != nullptr) {
+            metric_->cloneChunkCount << -1;
         }
+        isCloneChunk_ = false;
     }
     return CSErrorCode::Success;
 }
 
+bool CSChunkFile::needFlushMetaPage() {
+    // 未开启延迟持久化
+    if (metaFlushDirtyPages_ == 0) {
+        return true;
+    }
+    if (dirtyPages_.size() >= metaFlushDirtyPages_) {
+        return true;
+    }
+    if (metaFlushIntervalMs_ > 0 &&
+        TimeUtility::GetTimeofDayMs() - firstDirtyTimeMs_
+            >= metaFlushIntervalMs_) {
+        return true;
+    }
+    return false;
+}
+
 }  // namespace chunkserver
 }  // namespace curve
@@ -29,11 +29,13 @@
 #include <atomic>
 #include <functional>
 #include <memory>
+#include <mutex>  // NOLINT
 
 #include "include/curve_compiler_specific.h"
 #include "include/chunkserver/chunkserver_common.h"
 #include "src/common/concurrent/rw_lock.h"
 #include "src/common/crc32.h"
+#include "src/common/timeutility.h"
 #include "src/fs/local_filesystem.h"
 #include "src/chunkserver/datastore/filename_operator.h"
 #include "src/chunkserver/datastore/chunkserver_snapshot.h"
@@ -48,6 +50,7 @@ using curve::common::RWLock;
 using curve::common::WriteLockGuard;
 using curve::common::ReadLockGuard;
 using curve::common::BitRange;
+using curve::common::TimeUtility;
 
 class ChunkfilePool;
 class CSSnapshot;
@@ -102,6 +105,14 @@ struct ChunkOptions {
     PageSizeType    pageSize;
     // datastore内部统计指标
     std::shared_ptr<DataStoreMetric> metric;
+    // clone chunk延迟持久化bitmap时，未持久化的page数量上限，为0表示不延迟
+    uint32_t        metaFlushDirtyPages;
+    // clone chunk延迟持久化bitmap时，bitmap最长的未持久化时间，为0表示不限制
+    uint32_t        metaFlushIntervalMs;
+    // 新建的快照文件是否使用稀疏格式，只为cow拷贝过的page分配空间
+    bool            sparseSnapshot;
+    // chunk文件是否可能被关闭，为true时每次访问前检查文件是否已打开
+    bool            lazyOpen;
 
     ChunkOptions() : id(0)
                    , sn(0)
@@ -110,7 +121,11 @@ struct ChunkOptions {
                    , location("")
                    , chunkSize(0)
                    , pageSize(0)
-                   , metric(nullptr) {}
+                   , metric(nullptr)
+                   , metaFlushDirtyPages(0)
+                   , metaFlushIntervalMs(0)
+                   , sparseSnapshot(false)
+                   , lazyOpen(false) {}
 };
 
 class CSChunkFile {
@@ -127,9 +142,18 @@ class CSChunkFile {
       * @return 返回错误码
       */
     CSErrorCode Open(bool createFile);
+    /**
+     * 关闭chunk文件及快照文件的fd，并释放clone chunk的bitmap，
+     * 关闭前会将延迟持久化的bitmap刷盘；
+     * 之后的任何访问都会重新打开文件并加载metapage
+     * 与其他操作互斥，加写锁
+     * @return: 返回错误码
+     */
+    CSErrorCode Close();
     /**
      * Datastore初始化发现快照文件时调用
      * 函数内部加载快找文件的metapage到内存
+     * 如果chunk文件还未打开，则快照文件延迟到chunk文件打开时再加载
      * 正常情况下不存在并发，与其他操作互斥，加写锁
      * @param sn：要加载的快照文件版本号
      * @return：返回错误码
@@ -200,9 +224,11 @@ class CSChunkFile {
      */
     CSErrorCode DeleteSnapshotOrCorrectSn(SequenceNum correctedSn);
     /**
-     * 调用fsync将snapshot文件在pagecache中的数据刷盘
+     * 获取chunk的信息，chunk文件已被关闭时会重新打开
+     * @param[out] info: chunk的信息
+     * @return: 返回错误码，重新打开失败时info无效
      */
-    void GetInfo(CSChunkInfo* info);
+    CSErrorCode GetInfo(CSChunkInfo* info);
     /**
      * 获取chunk的hash值，此接口一般用于测试调用
      * @param[out]: chunk hash值
@@ -211,8 +237,27 @@ class CSChunkFile {
     CSErrorCode GetHash(off_t offset,
                         size_t length,
                         std::string *hash);
+    /**
+     * 将clone chunk延迟持久化的bitmap刷盘
+     * 写请求对应的raft日志在打快照之前不会被删除，所以bitmap可以
+     * 延迟持久化，异常重启后会通过回放日志重新标记被写过的page；
+     * 因此打raft快照之前必须调用此接口
+     * 与其他操作互斥，加写锁
+     * @return: 返回错误码
+     */
+    CSErrorCode SyncMetaPage();
 
  private:
+    /**
+     * Open的具体实现，调用者需要保证互斥
+     */
+    CSErrorCode openFile(bool createFile);
+    /**
+     * 文件未打开时打开chunk文件和快照文件，用于启动时延迟加载的chunk
+     * 或者被Close之后的chunk；持有读锁或写锁时调用
+     * @return: 返回错误码
+     */
+    CSErrorCode ensureOpen();
     /**
      * 判断是否需要创建新的快照
      * @param sn:写请求的版本号
@@ -244,10 +289,16 @@ class CSChunkFile {
      */
     CSErrorCode copy2Snapshot(off_t offset, size_t length);
     /**
-     * 更新clone chunk的bitmap
-     * 如果所有的page都已写过，则将clone chunk转成普通chunk
+     * 持久化clone chunk的bitmap
+     * 如果所有的page都已写过，则将clone chunk转成普通chunk，并立即持久化
+     * 否则只有在force为true或者达到延迟持久化的上限时才会持久化
+     * @param force: 是否强制持久化
      */
-    CSErrorCode flush();
+    CSErrorCode flush(bool force = false);
+    /**
+     * 延迟持久化的bitmap是否达到了数量或者时间上限
+     */
+    bool needFlushMetaPage();
 
     inline string path() {
         return baseDir_ + "/" +
@@ -277,12 +328,20 @@ class CSChunkFile {
         }
         // 如果是clone chunk，需要判断是否需要更改bitmap并更新metapage
         if (isCloneChunk_) {
+            if (dirtyPages_.empty()) {
+                firstDirtyTimeMs_ = TimeUtility::GetTimeofDayMs();
+            }
             uint32_t beginIndex = offset / pageSize_;
             uint32_t endIndex = (offset + length - 1) / pageSize_;
             for (uint32_t i = beginIndex; i <= endIndex; ++i) {
                 // 记录dirty page
                 if (!metaPage_.bitmap->Test(i)) {
                     dirtyPages_.insert(i);
+                    // 延迟持久化时内存中的bitmap需要立即更新，
+                    // 保证后续的读请求能够读到写入的数据
+                    if (metaFlushDirtyPages_ > 0) {
+                        metaPage_.bitmap->Set(i);
+                    }
                 }
             }
         }
@@ -323,10 +382,22 @@ class CSChunkFile {
     bool isCloneChunk_;
     // chunk的metapage
     ChunkFileMetaPage metaPage_;
-    // 被写过但还未更新到metapage中的page索引
+    // 被写过但还未持久化到metapage中的page索引
     std::set<uint32_t> dirtyPages_;
+    // dirtyPages_中第一个page被写入的时间
+    uint64_t firstDirtyTimeMs_;
+    // 未持久化的page数量上限，为0表示每次写完都立即持久化
+    uint32_t metaFlushDirtyPages_;
+    // bitmap最长的未持久化时间，为0表示不按时间触发持久化
+    uint32_t metaFlushIntervalMs_;
+    // 新建的快照文件是否使用稀疏格式
+    bool sparseSnapshot_;
+    // 为false时文件创建或加载后一直保持打开，访问时不需要检查
+    bool lazyOpen_;
     // 读写锁
     RWLock rwLock_;
+    // 持有读锁时打开文件需要互斥
+    std::mutex openMtx_;
     // 快照文件指针
     CSSnapshot* snapshot_;
     // 依赖chunkfilepool创建删除文件
@@ -22,6 +22,7 @@
 
 #include <gflags/gflags.h>
 #include <fcntl.h>
+#include <algorithm>
 #include <cstring>
 #include <iostream>
 #include <list>
@@ -41,6 +42,10 @@ CSDataStore::CSDataStore(std::shared_ptr<LocalFileSystem> lfs,
       pageSize_(options.pageSize),
       baseDir_(options.baseDir),
       locationLimit_(options.locationLimit),
+      metaFlushDirtyPages_(options.metaFlushDirtyPages),
+      metaFlushIntervalMs_(options.metaFlushIntervalMs),
+      sparseSnapshot_(options.sparseSnapshot),
+      maxOpenChunkFiles_(options.maxOpenChunkFiles),
       chunkfilePool_(chunkfilePool),
       lfs_(lfs) {
     CHECK(!baseDir_.empty()) << "Create datastore failed";
@@ -70,6 +75,11 @@ bool CSDataStore::Initialize() {
 
     // 如果之前加载过，这里要重新加载
     metaCache_.Clear();
+    {
+        std::lock_guard<std::mutex> lock(openChunkMtx_);
+        openChunkList_.clear();
+        openChunkIndex_.clear();
+    }
     metric_ = std::make_shared<DataStoreMetric>();
     for (size_t i = 0; i < files.size(); ++i) {
         FileNameOperator::FileInfo info =
@@ -122,6 +132,7 @@ CSErrorCode CSDataStore::DeleteChunk(ChunkID id, SequenceNum sn) {
             return errorCode;
         }
         metaCache_.Remove(id);
+        untouchChunkFile(id);
     }
     return CSErrorCode::Success;
 }
@@ -130,6 +141,7 @@ CSErrorCode CSDataStore::DeleteSnapshotChunkOrCorrectSn(
     ChunkID id, SequenceNum correctedSn) {
     auto chunkFile = metaCache_.Get(id);
     if (chunkFile != nullptr) {
+        touchChunkFile(id);
         CSErrorCode errorCode = chunkFile->DeleteSnapshotOrCorrectSn(correctedSn);  // NOLINT
         if (errorCode != CSErrorCode::Success) {
             LOG(WARNING) << "Delete snapshot chunk or correct sn failed."
@@ -150,6 +162,7 @@ CSErrorCode CSDataStore::ReadChunk(ChunkID id,
     if (chunkFile == nullptr) {
         return CSErrorCode::ChunkNotExistError;
     }
+    touchChunkFile(id);
 
     CSErrorCode errorCode = chunkFile->Read(buf, offset, length);
     if (errorCode != CSErrorCode::Success) {
@@ -169,6 +182,7 @@ CSErrorCode CSDataStore::ReadSnapshotChunk(ChunkID id,
     if (chunkFile == nullptr) {
         return CSErrorCode::ChunkNotExistError;
     }
+    touchChunkFile(id);
     CSErrorCode errorCode =
         chunkFile->ReadSpecifiedChunk(sn, buf, offset, length);
     if (errorCode != CSErrorCode::Success) {
@@ -231,11 +245,16 @@ CSErrorCode CSDataStore::WriteChunk(ChunkID id,
         options.location = cloneSourceLocation;
         options.pageSize = pageSize_;
         options.metric = metric_;
+        options.metaFlushDirtyPages = metaFlushDirtyPages_;
+        options.metaFlushIntervalMs = metaFlushIntervalMs_;
+        options.sparseSnapshot = sparseSnapshot_;
+        options.lazyOpen = maxOpenChunkFiles_ > 0;
         CSErrorCode errorCode = CreateChunkFile(options, &chunkFile);
         if (errorCode != CSErrorCode::Success) {
             return errorCode;
         }
     }
+    touchChunkFile(id);
     // 写chunk文件
     CSErrorCode errorCode = chunkFile->Write(sn,
                                              buf,
@@ -279,16 +298,26 @@ CSErrorCode CSDataStore::CreateCloneChunk(ChunkID id,
         options.chunkSize = chunkSize_;
         options.pageSize = pageSize_;
         options.metric = metric_;
+        options.metaFlushDirtyPages = metaFlushDirtyPages_;
+        options.metaFlushIntervalMs = metaFlushIntervalMs_;
+        options.sparseSnapshot = sparseSnapshot_;
+        options.lazyOpen = maxOpenChunkFiles_ > 0;
         CSErrorCode errorCode = CreateChunkFile(options, &chunkFile);
         if (errorCode != CSErrorCode::Success) {
             return errorCode;
         }
     }
+    touchChunkFile(id);
     // 判断指定参数与存在的Chunk中的信息是否相符
     // 不需要放到else当中，因为用户可能同时调用该接口
     // 参数中指定了不同版本或者位置信息，就可能并发冲突，也需要进行判断
     CSChunkInfo info;
-    chunkFile->GetInfo(&info);
+    CSErrorCode errorCode = chunkFile->GetInfo(&info);
+    if (errorCode != CSErrorCode::Success) {
+        LOG(ERROR) << "Get chunk info failed."
+                   << "ChunkID = " << id;
+        return errorCode;
+    }
     if (info.location.compare(location) != 0
         || info.curSn != sn
         || info.correctedSn != correctedSn) {
@@ -315,6 +344,7 @@ CSErrorCode CSDataStore::PasteChunk(ChunkID id,
                      << "ChunkID = " << id;
         return CSErrorCode::ChunkNotExistError;
     }
+    touchChunkFile(id);
     CSErrorCode errcode = chunkFile->Paste(buf, offset, length);
     if (errcode != CSErrorCode::Success) {
         LOG(WARNING) << "Paste Chunk failed, Chunk not exists."
@@ -332,8 +362,8 @@ CSErrorCode CSDataStore::GetChunkInfo(ChunkID id,
                   << "ChunkID = " << id;
         return CSErrorCode::ChunkNotExistError;
     }
-    chunkFile->GetInfo(chunkInfo);
-    return CSErrorCode::Success;
+    touchChunkFile(id);
+    return chunkFile->GetInfo(chunkInfo);
 }
 
 CSErrorCode CSDataStore::GetChunkHash(ChunkID id,
@@ -346,9 +376,20 @@ CSErrorCode CSDataStore::GetChunkHash(ChunkID id,
                   << "ChunkID = " << id;
         return CSErrorCode::ChunkNotExistError;
     }
+    touchChunkFile(id);
     return chunkFile->GetHash(offset, length, hash);
 }
 
+void CSDataStore::GetChunkIds(std::vector<ChunkID>* ids) {
+    ChunkMap chunkMap = metaCache_.GetMap();
+    ids->clear();
+    ids->reserve(chunkMap.size());
+    for (auto& iter : chunkMap) {
+        ids->push_back(iter.first);
+    }
+    std::sort(ids->begin(), ids->end());
+}
+
 DataStoreStatus CSDataStore::GetStatus() {
     DataStoreStatus status;
     status.chunkFileCount = metric_->chunkFileCount.get_value();
@@ -357,6 +398,20 @@ DataStoreStatus CSDataStore::GetStatus() {
     return status;
 }
 
+CSErrorCode CSDataStore::SyncChunkMetaPages() {
+    CSErrorCode result = CSErrorCode::Success;
+    ChunkMap chunkMap = metaCache_.GetMap();
+    for (auto& iter : chunkMap) {
+        CSErrorCode errorCode = iter.second->SyncMetaPage();
+        if (errorCode != CSErrorCode::Success) {
+            LOG(ERROR) << "Sync chunk metapage failed."
+                       << "ChunkID = " << iter.first;
+            result = errorCode;
+        }
+    }
+    return result;
+}
+
 CSErrorCode CSDataStore::loadChunkFile(ChunkID id) {
     // 如果chunk文件还未加载，则加载到metaCache当中
     if (metaCache_.Get(id) == nullptr) {
@@ -367,17 +422,73 @@ CSErrorCode CSDataStore::loadChunkFile(ChunkID id) {
         options.chunkSize = chunkSize_;
         options.pageSize = pageSize_;
         options.metric = metric_;
+        options.metaFlushDirtyPages = metaFlushDirtyPages_;
+        options.metaFlushIntervalMs = metaFlushIntervalMs_;
+        options.sparseSnapshot = sparseSnapshot_;
+        options.lazyOpen = maxOpenChunkFiles_ > 0;
         CSChunkFilePtr chunkFilePtr =
             std::make_shared<CSChunkFile>(lfs_,
                                           chunkfilePool_,
                                           options);
-        CSErrorCode errorCode = chunkFilePtr->Open(false);
-        if (errorCode != CSErrorCode::Success)
-            return errorCode;
+        // 限制了打开文件数时，chunk文件在第一次访问时才打开
+        if (maxOpenChunkFiles_ == 0) {
+            CSErrorCode errorCode = chunkFilePtr->Open(false);
+            if (errorCode != CSErrorCode::Success)
+                return errorCode;
+        }
         metaCache_.Set(id, chunkFilePtr);
     }
     return CSErrorCode::Success;
 }
 
+void CSDataStore::touchChunkFile(ChunkID id) {
+    if (maxOpenChunkFiles_ == 0) {
+        return;
+    }
+    std::vector<ChunkID> victims;
+    {
+        std::lock_guard<std::mutex> lock(openChunkMtx_);
+        auto iter = openChunkIndex_.find(id);
+        if (iter != openChunkIndex_.end()) {
+            openChunkList_.splice(openChunkList_.begin(),
+                                  openChunkList_,
+                                  iter->second);
+            return;
+        }
+        openChunkList_.push_front(id);
+        openChunkIndex_[id] = openChunkList_.begin();
+        while (openChunkList_.size() > maxOpenChunkFiles_) {
+            ChunkID victim = openChunkList_.back();
+            openChunkList_.pop_back();
+            openChunkIndex_.erase(victim);
+            victims.push_back(victim);
+        }
+    }
+    // 关闭文件时需要获取chunk的写锁，不能在持有openChunkMtx_时进行
+    for (auto victim : victims) {
+        auto chunkFile = metaCache_.Get(victim);
+        if (chunkFile == nullptr) {
+            continue;
+        }
+        CSErrorCode errorCode = chunkFile->Close();
+        if (errorCode != CSErrorCode::Success) {
+            LOG(WARNING) << "Close chunk file failed."
+                         << "ChunkID = " << victim;
+        }
+    }
+}
+
+void CSDataStore::untouchChunkFile(ChunkID id) {
+    if (maxOpenChunkFiles_ == 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(openChunkMtx_);
+    auto iter = openChunkIndex_.find(id);
+    if (iter != openChunkIndex_.end()) {
+        openChunkList_.erase(iter->second);
+        openChunkIndex_.erase(iter);
+    }
+}
+
 }  // namespace chunkserver
 }  // namespace curve
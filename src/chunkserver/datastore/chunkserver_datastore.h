@@ -27,8 +27,10 @@
 #include <glog/logging.h>
 #include <string>
 #include <vector>
+#include <list>
 #include <unordered_map>
 #include <memory>
+#include <mutex>  // NOLINT
 
 #include "include/curve_compiler_specific.h"
 #include "include/chunkserver/chunkserver_common.h"
@@ -50,19 +52,34 @@ using CSChunkFilePtr = std::shared_ptr<CSChunkFile>;
  * baseDir:DataStore管理的目录路径
  * chunkSize:DataStore中chunk文件或快照文件的大小
  * pageSize:最小读写单元的大小
+ * metaFlushDirtyPages:clone chunk延迟持久化bitmap时，未持久化的page数量上限，
+ *                     为0表示每次写完都立即持久化metapage
+ * metaFlushIntervalMs:clone chunk延迟持久化bitmap时，bitmap最长的未持久化时间，
+ *                     为0表示不按时间触发持久化
+ * sparseSnapshot:新建的快照文件是否使用稀疏格式，稀疏格式的快照文件不从chunkfilepool
+ *                中获取，只为cow拷贝过的page分配空间
+ * maxOpenChunkFiles:同时打开的chunk文件数上限，超过时按LRU关闭最久未访问的chunk，
+ *                   大于0时初始化不再打开chunk文件，而是在第一次访问时打开，
+ *                   没有打开过的chunk不会被统计为clone chunk；
+ *                   为0表示不限制，初始化时打开所有chunk文件
  */
 struct DataStoreOptions {
     std::string                         baseDir;
     ChunkSizeType                       chunkSize;
     PageSizeType                        pageSize;
     uint32_t                            locationLimit;
+    uint32_t                            metaFlushDirtyPages = 0;
+    uint32_t                            metaFlushIntervalMs = 0;
+    bool                                sparseSnapshot = false;
+    uint32_t                            maxOpenChunkFiles = 0;
 };
 
 /**
  * DataStore的内部状态,用于返回给上层
  * chunkFileCount:DataStore中chunk的数量
  * snapshotCount:DataStore中快照的数量
- * cloneChunkCount:clone chunk的数量
+ * cloneChunkCount:clone chunk的数量，限制了打开文件数时
+ *                 只包含启动之后打开过的chunk
  */
 struct DataStoreStatus {
     uint32_t chunkFileCount;
@@ -77,7 +94,8 @@ struct DataStoreStatus {
  * DataStore的内部状态信息
  * chunkFileCount:DataStore中chunk的数量
  * snapshotCount:DataStore中快照的数量
- * cloneChunkCount:clone chunk的数量
+ * cloneChunkCount:clone chunk的数量，是否为clone chunk要在打开chunk加载metapage
+ *                 之后才能知道，限制了打开文件数时只包含启动之后打开过的chunk
  */
 struct DataStoreMetric {
     bvar::Adder<uint32_t> chunkFileCount;
@@ -256,15 +274,38 @@ class CSDataStore {
                                      off_t offset,
                                      size_t length,
                                      std::string* hash);
+    /**
+     * 获取当前datastore中所有chunk的id，按从小到大排列
+     * @param ids[out]: chunk id列表
+     */
+    virtual void GetChunkIds(std::vector<ChunkID>* ids);
     /** 获取DataStore的内部统计信息
      * @return：datastore的内部统计信息
      */
     virtual DataStoreStatus GetStatus();
 
+    /**
+     * 将所有chunk延迟持久化的metapage刷盘，
+     * 打raft快照之前调用，保证快照之前的写请求对应的bitmap都已经落盘
+     * @return: 返回错误码
+     */
+    virtual CSErrorCode SyncChunkMetaPages();
+
  private:
     CSErrorCode loadChunkFile(ChunkID id);
     CSErrorCode CreateChunkFile(const ChunkOptions & ops,
                                 CSChunkFilePtr* chunkFile);
+    /**
+     * 记录chunk文件被访问，超过打开文件数上限时关闭最久未访问的chunk文件
+     * 未设置打开文件数上限时不做任何处理
+     * @param id: 被访问的chunk id
+     */
+    void touchChunkFile(ChunkID id);
+    /**
+     * chunk被删除后从LRU中移除
+     * @param id: 被删除的chunk id
+     */
+    void untouchChunkFile(ChunkID id);
 
  private:
     // 每个chunk的大小
@@ -273,10 +314,24 @@ class CSDataStore {
     PageSizeType pageSize_;
     // clone chunk location长度限制
     uint32_t locationLimit_;
+    // clone chunk延迟持久化bitmap时未持久化的page数量上限
+    uint32_t metaFlushDirtyPages_;
+    // clone chunk延迟持久化bitmap时bitmap最长的未持久化时间
+    uint32_t metaFlushIntervalMs_;
+    // 新建的快照文件是否使用稀疏格式
+    bool sparseSnapshot_;
     // datastore的管理目录
     std::string baseDir_;
     // 为chunkid->chunkfile的映射
     CSMetaCache metaCache_;
+    // 同时打开的chunk文件数上限，为0表示不限制
+    uint32_t maxOpenChunkFiles_;
+    // 按访问时间排序的已打开chunk，最近访问的在队首
+    std::list<ChunkID> openChunkList_;
+    // chunk id到openChunkList_中位置的索引
+    std::unordered_map<ChunkID, std::list<ChunkID>::iterator> openChunkIndex_;
+    // 保护openChunkList_和openChunkIndex_
+    std::mutex openChunkMtx_;
     // chunkfile池，依赖该池子创建回收chunk文件或快照文件
     std::shared_ptr<ChunkfilePool>          chunkfilePool_;
     // 本地文件系统
@@ -20,6 +20,8 @@
  * Author: yangyaokai
  */
 
+#include <fcntl.h>
+#include <linux/fs.h>
 #include <memory>
 #include "src/chunkserver/datastore/chunkserver_datastore.h"
 #include "src/chunkserver/datastore/chunkserver_snapshot.h"
@@ -69,7 +71,8 @@ CSErrorCode SnapshotMetaPage::decode(const char* buf) {
     }
 
     // TODO(yyk) 判断版本兼容性，当前简单处理，后续详细实现
-    if (version != FORMAT_VERSION) {
+    if (version != FORMAT_VERSION
+        && version != SPARSE_SNAPSHOT_FORMAT_VERSION) {
         LOG(ERROR) << "File format version incompatible."
                     << "file version: "
                     << static_cast<uint32_t>(version)
@@ -112,6 +115,7 @@ CSSnapshot::CSSnapshot(std::shared_ptr<LocalFileSystem> lfs,
       size_(options.chunkSize),
       pageSize_(options.pageSize),
       baseDir_(options.baseDir),
+      dsync_(!options.sparseSnapshot),
       lfs_(lfs),
       chunkfilePool_(chunkfilePool),
       metric_(options.metric) {
@@ -120,6 +124,9 @@ CSSnapshot::CSSnapshot(std::shared_ptr<LocalFileSystem> lfs,
     uint32_t bits = size_ / pageSize_;
     metaPage_.bitmap = std::make_shared<Bitmap>(bits);
     metaPage_.sn = options.sn;
+    if (options.sparseSnapshot) {
+        metaPage_.version = SPARSE_SNAPSHOT_FORMAT_VERSION;
+    }
     if (metric_ != nullptr) {
         metric_->snapshotCount << 1;
     }
@@ -143,16 +150,27 @@ CSErrorCode CSSnapshot::Open(bool createFile) {
     if (createFile
         && !lfs_->FileExists(snapshotPath)
         && metaPage_.sn > 0) {
-        char buf[pageSize_] = {0};
-        metaPage_.encode(buf);
-        int ret = chunkfilePool_->GetChunk(snapshotPath, buf);
-        if (ret != 0) {
-            LOG(ERROR) << "Error occured when create snapshot."
-                   << " filepath = " << snapshotPath;
-            return CSErrorCode::InternalError;
+        if (metaPage_.IsSparse()) {
+            CSErrorCode errorCode = createSparseFile(snapshotPath);
+            if (errorCode != CSErrorCode::Success) {
+                return errorCode;
+            }
+        } else {
+            char buf[pageSize_] = {0};
+            metaPage_.encode(buf);
+            int ret = chunkfilePool_->GetChunk(snapshotPath, buf);
+            if (ret != 0) {
+                LOG(ERROR) << "Error occured when create snapshot."
+                       << " filepath = " << snapshotPath;
+                return CSErrorCode::InternalError;
+            }
         }
     }
-    int rc = lfs_->Open(snapshotPath, O_RDWR|O_NOATIME|O_DSYNC);
+    int flags = O_RDWR|O_NOATIME;
+    if (dsync_) {
+        flags |= O_DSYNC;
+    }
+    int rc = lfs_->Open(snapshotPath, flags);
     if (rc < 0) {
         LOG(ERROR) << "Error occured when opening file."
                    << " filepath = "<< snapshotPath;
@@ -167,6 +185,14 @@ CSErrorCode CSSnapshot::Open(bool createFile) {
         return CSErrorCode::InternalError;
     }
     if (fileInfo.st_size != fileSize()) {
+        // 稀疏快照文件的长度取决于拷贝过的最大偏移，不要求等于fileSize
+        CSErrorCode errorCode = loadMetaPage();
+        if (errorCode == CSErrorCode::Success
+            && metaPage_.IsSparse()
+            && fileInfo.st_size >= pageSize_
+            && fileInfo.st_size <= fileSize()) {
+            return CSErrorCode::Success;
+        }
         LOG(ERROR) << "Wrong file size."
                    << " filepath = " << snapshotPath
                    << ",filesize = " << fileInfo.st_size;
@@ -175,6 +201,13 @@ CSErrorCode CSSnapshot::Open(bool createFile) {
     return loadMetaPage();
 }
 
+void CSSnapshot::Close() {
+    if (fd_ >= 0) {
+        lfs_->Close(fd_);
+        fd_ = -1;
+    }
+}
+
 CSErrorCode CSSnapshot::Read(char * buf, off_t offset, size_t length) {
     // TODO(yyk) 是否需要对比偏移对应bit状态
     int rc = readData(buf, offset, length);
@@ -191,7 +224,13 @@ CSErrorCode CSSnapshot::Delete() {
         lfs_->Close(fd_);
         fd_ = -1;
     }
-    int ret = chunkfilePool_->RecycleChunk(path());
+    int ret = 0;
+    // 稀疏快照文件没有预分配空间，不能回收到chunkfilepool中，直接删除
+    if (metaPage_.IsSparse()) {
+        ret = lfs_->Delete(path());
+    } else {
+        ret = chunkfilePool_->RecycleChunk(path());
+    }
     if (ret < 0)
         return CSErrorCode::InternalError;
     return CSErrorCode::Success;
@@ -226,7 +265,13 @@ CSErrorCode CSSnapshot::Flush() {
     for (auto pageIndex : dirtyPages_) {
         tempMeta.bitmap->Set(pageIndex);
     }
-    CSErrorCode errorCode = updateMetaPage(&tempMeta);
+    // 数据必须先于bitmap落盘，否则异常重启后bitmap标记已拷贝的page可能是空洞
+    CSErrorCode errorCode = syncFile();
+    if (errorCode != CSErrorCode::Success) {
+        dirtyPages_.clear();
+        return errorCode;
+    }
+    errorCode = updateMetaPage(&tempMeta);
     if (errorCode == CSErrorCode::Success)
         metaPage_.bitmap = tempMeta.bitmap;
     dirtyPages_.clear();
@@ -243,6 +288,52 @@ CSErrorCode CSSnapshot::updateMetaPage(SnapshotMetaPage* metaPage) {
                    << ",snapshot sn: " << metaPage_.sn;
         return CSErrorCode::InternalError;
     }
+    return syncFile();
+}
+
+CSErrorCode CSSnapshot::syncFile() {
+    if (dsync_) {
+        return CSErrorCode::Success;
+    }
+    int rc = lfs_->Fsync(fd_);
+    if (rc < 0) {
+        LOG(ERROR) << "Sync snapshot failed."
+                   << "ChunkID: " << chunkId_
+                   << ",snapshot sn: " << metaPage_.sn;
+        return CSErrorCode::InternalError;
+    }
+    return CSErrorCode::Success;
+}
+
+CSErrorCode CSSnapshot::createSparseFile(const string& snapshotPath) {
+    // 临时文件名不符合快照文件的命名格式，加载datastore时会被忽略
+    string tmpPath = snapshotPath + "_tmp";
+    int fd = lfs_->Open(tmpPath, O_RDWR|O_CREAT|O_TRUNC|O_NOATIME);
+    if (fd < 0) {
+        LOG(ERROR) << "Error occured when create snapshot."
+                   << " filepath = " << tmpPath;
+        return CSErrorCode::InternalError;
+    }
+    char buf[pageSize_] = {0};
+    metaPage_.encode(buf);
+    int rc = lfs_->Write(fd, buf, 0, pageSize_);
+    if (rc >= 0) {
+        rc = lfs_->Fsync(fd);
+    }
+    lfs_->Close(fd);
+    if (rc < 0) {
+        LOG(ERROR) << "Write snapshot metapage failed."
+                   << " filepath = " << tmpPath;
+        lfs_->Delete(tmpPath);
+        return CSErrorCode::InternalError;
+    }
+    rc = lfs_->Rename(tmpPath, snapshotPath, RENAME_NOREPLACE);
+    if (rc < 0) {
+        LOG(ERROR) << "Error occured when create snapshot."
+                   << " filepath = " << snapshotPath;
+        lfs_->Delete(tmpPath);
+        return CSErrorCode::InternalError;
+    }
     return CSErrorCode::Success;
 }
 
@@ -55,6 +55,10 @@ struct DataStoreMetric;
  * bitmap: (bits + 8 - 1) / 8 bytes
  * crc: 4 bytes
  * padding: (4096 - 18 - (bits + 8 - 1) / 8) bytes
+ *
+ * version为SPARSE_SNAPSHOT_FORMAT_VERSION时为稀疏快照文件，
+ * 文件布局与普通快照文件相同，但文件不从chunkfilepool中获取，
+ * 只有bitmap中标记为已拷贝的page才会分配磁盘空间，其余部分为空洞
  */
 struct SnapshotMetaPage {
     // 文件格式版本号
@@ -74,6 +78,10 @@ struct SnapshotMetaPage {
 
     void encode(char* buf);
     CSErrorCode decode(const char* buf);
+
+    bool IsSparse() const {
+        return version == SPARSE_SNAPSHOT_FORMAT_VERSION;
+    }
 };
 
 class CSSnapshot {
@@ -88,9 +96,14 @@ class CSSnapshot {
      * @return: 返回错误码
      */
     CSErrorCode Open(bool createFile);
+    /**
+     * 关闭快照文件的fd，内存中的metapage保留，再次访问前需要重新Open
+     */
+    void Close();
     /**
      * 将数据写入快照文件，数据写完后不立即更新bitmap，
      * 需要通过调用Flush来更新
+     * 稀疏快照文件写入的数据不会立即落盘，同样由Flush统一持久化
      * @param buf: 请求写入的数据
      * @param offset: 请求写入的其实偏移
      * @param length: 请求写入的数据长度
@@ -138,6 +151,16 @@ class CSSnapshot {
      * 将metapage加载到内存
      */
     CSErrorCode loadMetaPage();
+    /**
+     * 创建稀疏快照文件，先将metapage写入临时文件，再rename成快照文件，
+     * 保证快照文件一旦存在，其metapage就是完整的
+     * @param snapshotPath: 快照文件路径
+     */
+    CSErrorCode createSparseFile(const string& snapshotPath);
+    /**
+     * 文件以非O_DSYNC方式打开时，需要显式调用fsync持久化
+     */
+    CSErrorCode syncFile();
 
     inline string path() {
         return baseDir_ + "/" +
@@ -177,6 +200,9 @@ class CSSnapshot {
     std::string baseDir_;
     // 快照文件的metapage
     SnapshotMetaPage metaPage_;
+    // 快照文件是否以O_DSYNC方式打开，稀疏快照以非O_DSYNC方式打开，
+    // 一次cow拷贝的所有数据在Flush时统一fsync，减少同步写的次数
+    bool dsync_;
     // 被写过但还未更新到metapage中的page索引
     std::set<uint32_t> dirtyPages_;
     // 依赖本地文件系统操作文件
@@ -35,6 +35,8 @@ namespace chunkserver {
 using curve::common::Bitmap;
 
 const uint8_t FORMAT_VERSION = 1;
+// 稀疏快照文件的格式版本号，快照文件只为cow拷贝过的page分配空间
+const uint8_t SPARSE_SNAPSHOT_FORMAT_VERSION = 2;
 const SequenceNum kInvalidSeq = 0;
 
 // define error code
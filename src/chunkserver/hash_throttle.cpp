@@ -0,0 +1,61 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-19
+ * Author: agent
+ */
+
+#include "src/chunkserver/hash_throttle.h"
+
+#include <bthread/bthread.h>
+
+#include <algorithm>
+
+#include "src/common/timeutility.h"
+
+namespace curve {
+namespace chunkserver {
+
+using ::curve::common::LockGuard;
+using ::curve::common::TimeUtility;
+
+// 单次等待的上限，避免速率调整之后仍然按照旧的速率长时间等待
+const uint64_t kMaxWaitUs = 100 * 1000;
+
+HashThrottle::HashThrottle(uint64_t bytesPerSec)
+    : bucket_(bytesPerSec) {}
+
+void HashThrottle::Acquire(uint64_t bytes) {
+    while (true) {
+        uint64_t waitUs = 0;
+        {
+            LockGuard lk(mtx_);
+            uint64_t nowUs = TimeUtility::GetTimeofDayUs();
+            waitUs = bucket_.GetWaitUs(bytes, nowUs);
+            if (waitUs == 0) {
+                bucket_.Consume(bytes, nowUs);
+                return;
+            }
+        }
+        bthread_usleep(std::min(waitUs, kMaxWaitUs));
+    }
+}
+
+}  // namespace chunkserver
+}  // namespace curve
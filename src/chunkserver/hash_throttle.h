@@ -0,0 +1,65 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-19
+ * Author: agent
+ */
+
+#ifndef SRC_CHUNKSERVER_HASH_THROTTLE_H_
+#define SRC_CHUNKSERVER_HASH_THROTTLE_H_
+
+#include <cstdint>
+
+#include "src/common/concurrent/concurrent.h"
+#include "src/common/token_bucket.h"
+
+namespace curve {
+namespace chunkserver {
+
+using ::curve::common::Mutex;
+using ::curve::common::TokenBucket;
+
+/**
+ * 计算chunk hash时的读盘限速，整个chunkserver上所有的GetCopysetHash
+ * 请求共享同一个令牌桶，并发的一致性检查请求合起来也不会超过限定的速率
+ */
+class HashThrottle {
+ public:
+    /**
+     * @param bytesPerSec: 每秒最多读取的字节数，为0表示不限制
+     */
+    explicit HashThrottle(uint64_t bytesPerSec);
+    virtual ~HashThrottle() = default;
+
+    /**
+     * 获取读取指定数据量的许可，令牌不足时在锁外等待，
+     * 不阻塞其他请求获取令牌
+     * @param bytes: 需要读取的数据量
+     */
+    void Acquire(uint64_t bytes);
+
+ private:
+    Mutex mtx_;
+    TokenBucket bucket_;
+};
+
+}  // namespace chunkserver
+}  // namespace curve
+
+#endif  // SRC_CHUNKSERVER_HASH_THROTTLE_H_
@@ -157,6 +157,16 @@ int Heartbeat::BuildCopysetInfo(curve::mds::heartbeat::CopySetInfo* info,
     replica->set_address(leader.to_string());
     info->set_allocated_leaderpeer(replica);
 
+    // 上报巡检发现的不一致的chunk
+    if (options_.scrubManager != nullptr) {
+        std::vector<ChunkID> chunkIds;
+        options_.scrubManager->GetInconsistentChunks(poolId, copysetId,
+                                                     &chunkIds);
+        for (auto chunkId : chunkIds) {
+            info->add_inconsistentchunks(chunkId);
+        }
+    }
+
     curve::mds::heartbeat::CopysetStatistics* stats =
         new curve::mds::heartbeat::CopysetStatistics();
     CopysetMetricPtr copysetMetric =
@@ -383,6 +393,19 @@ int Heartbeat::SendHeartbeat(const HeartbeatRequest& request,
 }
 
 int Heartbeat::ExecTask(const HeartbeatResponse& response) {
+    // mds下发了QoS配置时以mds的配置为准
+    if (response.has_qosconf() && options_.qosScheduler != nullptr) {
+        const ChunkServerQosConf& qosConf = response.qosconf();
+        QosLimit limit;
+        limit.chunkserverIops = qosConf.chunkserveriops();
+        limit.chunkserverBps = qosConf.chunkserverbps();
+        limit.copysetIops = qosConf.copysetiops();
+        limit.copysetBps = qosConf.copysetbps();
+        limit.clientIops = qosConf.clientiops();
+        limit.clientBps = qosConf.clientbps();
+        options_.qosScheduler->UpdateLimit(limit);
+    }
+
     int count = response.needupdatecopysets_size();
     for (int i = 0; i < count; i ++) {
         CopySetConf conf = response.needupdatecopysets(i);
@@ -36,6 +36,8 @@
 
 #include "include/chunkserver/chunkserver_common.h"
 #include "src/chunkserver/copyset_node_manager.h"
+#include "src/chunkserver/scrub_manager.h"
+#include "src/chunkserver/qos_scheduler.h"
 #include "src/common/wait_interval.h"
 #include "src/common/concurrent/concurrent.h"
 #include "proto/heartbeat.pb.h"
@@ -49,6 +51,7 @@ using HeartbeatRequest  = curve::mds::heartbeat::ChunkServerHeartbeatRequest;
 using HeartbeatResponse = curve::mds::heartbeat::ChunkServerHeartbeatResponse;
 using ConfigChangeInfo  = curve::mds::heartbeat::ConfigChangeInfo;
 using CopySetConf       = curve::mds::heartbeat::CopySetConf;
+using ChunkServerQosConf = curve::mds::heartbeat::ChunkServerQosConf;
 using CandidateError    = curve::mds::heartbeat::CandidateError;
 using TaskStatus        = butil::Status;
 using CopysetNodePtr    = std::shared_ptr<CopysetNode>;
@@ -71,6 +74,10 @@ struct HeartbeatOptions {
     uint32_t                intervalSec;
     uint32_t                timeout;
     CopysetNodeManager*     copysetNodeManager;
+    // 为空时不上报巡检结果
+    ScrubManager*           scrubManager = nullptr;
+    // 为空时忽略mds下发的QoS配置
+    QosScheduler*           qosScheduler = nullptr;
 
     std::shared_ptr<LocalFileSystem> fs;
 };
@@ -25,6 +25,7 @@
 #include <glog/logging.h>
 #include <brpc/controller.h>
 #include <butil/sys_byteorder.h>
+#include <butil/time.h>
 #include <brpc/closure_guard.h>
 
 #include <memory>
@@ -72,6 +73,9 @@ void ChunkOpRequest::Process() {
     }
 }
 
+// 批量op log entry的magic，单个op request的长度不可能达到该值
+static const uint32_t kBatchLogMagic = 0xFFFFFFFF;
+
 int ChunkOpRequest::Propose(const ChunkRequest *request,
                             const butil::IOBuf *data) {
     // 检查任期和自己是不是Leader
@@ -79,6 +83,16 @@ int ChunkOpRequest::Propose(const ChunkRequest *request,
         RedirectChunkRequest();
         return -1;
     }
+    proposeTimeUs_ = butil::monotonic_time_us();
+    MarkTrace(OpTraceStage::PROPOSE);
+    // 小写请求交给copyset node与其他请求合并成一条log entry之后再propose
+    if (data != nullptr && node_->IsBatchable(request)) {
+        if (0 != node_->ProposeBatch(shared_from_this(), request, *data)) {
+            RedirectChunkRequest();
+            return -1;
+        }
+        return 0;
+    }
     // 打包op request为task
     braft::Task task;
     butil::IOBuf log;
@@ -172,6 +186,71 @@ std::shared_ptr<ChunkOpRequest> ChunkOpRequest::Decode(butil::IOBuf log,
     }
 }
 
+int ChunkOpRequest::EncodeBatch(
+    const std::vector<std::pair<const ChunkRequest *,
+                                const butil::IOBuf *>> &ops,
+    butil::IOBuf *log) {
+    // 1.append batch meta
+    const uint32_t magic = butil::HostToNet32(kBatchLogMagic);
+    log->append(&magic, sizeof(uint32_t));
+    const uint32_t count = butil::HostToNet32(ops.size());
+    log->append(&count, sizeof(uint32_t));
+
+    // 2.append each op log
+    for (const auto &op : ops) {
+        butil::IOBuf opLog;
+        if (0 != Encode(op.first, op.second, &opLog)) {
+            return -1;
+        }
+        const uint32_t opLogSize = butil::HostToNet32(opLog.size());
+        log->append(&opLogSize, sizeof(uint32_t));
+        log->append(opLog);
+    }
+
+    return 0;
+}
+
+bool ChunkOpRequest::IsBatchLog(const butil::IOBuf &log) {
+    uint32_t magic = 0;
+    if (log.copy_to(&magic, sizeof(uint32_t)) != sizeof(uint32_t)) {
+        return false;
+    }
+    return butil::NetToHost32(magic) == kBatchLogMagic;
+}
+
+int ChunkOpRequest::DecodeBatch(butil::IOBuf log,
+                                std::vector<butil::IOBuf> *opLogs) {
+    uint32_t magic = 0;
+    uint32_t count = 0;
+    if (log.cutn(&magic, sizeof(uint32_t)) != sizeof(uint32_t)
+        || butil::NetToHost32(magic) != kBatchLogMagic
+        || log.cutn(&count, sizeof(uint32_t)) != sizeof(uint32_t)) {
+        LOG(ERROR) << "invalid batch log meta";
+        return -1;
+    }
+    count = butil::NetToHost32(count);
+
+    opLogs->clear();
+    opLogs->reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t opLogSize = 0;
+        if (log.cutn(&opLogSize, sizeof(uint32_t)) != sizeof(uint32_t)) {
+            LOG(ERROR) << "invalid batch log, op index: " << i;
+            return -1;
+        }
+        opLogSize = butil::NetToHost32(opLogSize);
+        butil::IOBuf opLog;
+        if (log.cutn(&opLog, opLogSize) != opLogSize) {
+            LOG(ERROR) << "invalid batch log, op index: " << i
+                       << ", op log size: " << opLogSize;
+            return -1;
+        }
+        opLogs->push_back(std::move(opLog));
+    }
+
+    return 0;
+}
+
 void DeleteChunkRequest::OnApply(uint64_t index,
                                  ::google::protobuf::Closure *done) {
     brpc::ClosureGuard doneGuard(done);
@@ -240,19 +319,39 @@ ReadChunkRequest::ReadChunkRequest(std::shared_ptr<CopysetNode> nodePtr,
 void ReadChunkRequest::Process() {
     brpc::ClosureGuard doneGuard(done_);
 
+    bool appliedIndexOk = request_->has_appliedindex()
+        && node_->GetAppliedIndex() >= request_->appliedindex();
+
+    /**
+     * follower只处理携带了applied index的读请求，且follower的applied index
+     * 不小于请求中的applied index，说明client已经确认写成功的数据都已经
+     * apply到了本地，否则转发给leader
+     */
     if (!node_->IsLeaderTerm()) {
+        if (node_->IsFollowerReadEnabled()
+            && request_->optype() == CHUNK_OP_TYPE::CHUNK_OP_READ
+            && appliedIndexOk) {
+            auto thisPtr = std::dynamic_pointer_cast<ReadChunkRequest>(
+                shared_from_this());
+            auto task = std::bind(&ReadChunkRequest::OnApply,
+                                  thisPtr,
+                                  node_->GetAppliedIndex(),
+                                  doneGuard.release());
+            concurrentApplyModule_->Push(request_->chunkid(), task);
+            return;
+        }
         RedirectChunkRequest();
         return;
     }
 
     /**
      * 如果携带了applied index，且小于当前copyset node
-     * 的最新applied index，或者 op类型为CHUNK_OP_RECOVER
-     * 那么不需要走一致性协议
+     * 的最新applied index，或者 op类型为CHUNK_OP_RECOVER，
+     * 或者leader的租约有效，那么不需要走一致性协议
      */
-    if ((request_->has_appliedindex()
-        && node_->GetAppliedIndex() >= request_->appliedindex())
-        || request_->optype() == CHUNK_OP_TYPE::CHUNK_OP_RECOVER) {
+    if (appliedIndexOk
+        || request_->optype() == CHUNK_OP_TYPE::CHUNK_OP_RECOVER
+        || node_->IsLeaseValid()) {
         /**
          * 构造shared_ptr<ReadChunkRequest>，因为在ChunkOpRequest只指定了
          * std::enable_shared_from_this<ChunkOpRequest>，所以
@@ -297,6 +396,7 @@ void ReadChunkRequest::Process() {
 
 void ReadChunkRequest::OnApply(uint64_t index,
                                ::google::protobuf::Closure *done) {
+    MarkTrace(OpTraceStage::APPLY_QUEUE);
     // 先清除response中的status，以保证CheckForward后的判断的正确性
     response_->clear_status();
 
@@ -325,6 +425,11 @@ void ReadChunkRequest::OnApply(uint64_t index,
         }
         // 如果需要从源端拷贝数据，需要将请求转发给clone manager处理
         if ( needLazyClone || NeedClone(chunkInfo) ) {
+            // 拷贝的数据需要通过leader写入，follower上的读请求转发给leader
+            if (!node_->IsLeaderTerm()) {
+                RedirectChunkRequest();
+                break;
+            }
             applyIndex = index;
             std::shared_ptr<CloneTask> cloneTask =
             cloneMgr_->GenerateCloneTask(
@@ -405,6 +510,7 @@ void ReadChunkRequest::ReadChunk() {
                                      readBuffer,
                                      request_->offset(),
                                      size);
+    MarkTrace(OpTraceStage::DISK_IO);
     butil::IOBuf wrapper;
     wrapper.append_user_data(readBuffer, size, ReadBufferDeleter);
     if (CSErrorCode::Success == ret) {
@@ -429,6 +535,7 @@ void ReadChunkRequest::ReadChunk() {
 void WriteChunkRequest::OnApply(uint64_t index,
                                 ::google::protobuf::Closure *done) {
     brpc::ClosureGuard doneGuard(done);
+    MarkTrace(OpTraceStage::APPLY_QUEUE);
     uint32_t cost;
 
     std::string  cloneSourceLocation;
@@ -445,6 +552,7 @@ void WriteChunkRequest::OnApply(uint64_t index,
                                       request_->size(),
                                       &cost,
                                       cloneSourceLocation);
+    MarkTrace(OpTraceStage::DISK_IO);
 
     if (CSErrorCode::Success == ret) {
         response_->set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS);
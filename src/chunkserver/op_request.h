@@ -28,10 +28,13 @@
 #include <brpc/controller.h>
 
 #include <memory>
+#include <vector>
+#include <utility>
 
 #include "proto/chunk.pb.h"
 #include "include/chunkserver/chunkserver_common.h"
 #include "src/chunkserver/concurrent_apply.h"
+#include "src/chunkserver/op_trace.h"
 #include "src/chunkserver/datastore/define.h"
 
 namespace curve {
@@ -115,6 +118,25 @@ class ChunkOpRequest : public std::enable_shared_from_this<ChunkOpRequest> {
      */
     uint32_t RequestSize() { return request_->size(); }
 
+    /**
+     * 返回leader propose该请求的时间，用于leader续约租约
+     */
+    int64_t ProposeTimeUs() const { return proposeTimeUs_; }
+
+    /**
+     * 设置client采样的请求的trace，未被采样的请求不需要设置
+     */
+    void SetTrace(std::shared_ptr<OpTrace> trace) { trace_ = trace; }
+
+    /**
+     * 标记请求的一个处理阶段结束
+     */
+    void MarkTrace(OpTraceStage stage) {
+        if (nullptr != trace_) {
+            trace_->Mark(stage);
+        }
+    }
+
     /**
      * 转发request给leader
      */
@@ -152,6 +174,43 @@ class ChunkOpRequest : public std::enable_shared_from_this<ChunkOpRequest> {
                                                   ChunkRequest *request,
                                                   butil::IOBuf *data);
 
+    /**
+     * 将多个op打包序列化成一条op log entry，用于小写请求的批量propose
+     * |                       data                          |
+     * |     batch meta      |  op 1 |  op 2 |  ...  |  op n |
+     * | batch magic | count |
+     * |   32 bit    | 32 bit|
+     * 每个op的格式如下：
+     * |   op log length  |   op log   |
+     * |      32 bit      |    ....    |
+     * 其中op log与Encode序列化单个op得到的数据格式完全相同
+     * batch magic不可能是单个op request的长度，以此和单个op的log entry区分
+     * @param ops:需要打包的op request及其数据内容
+     * @param log:出参，存放序列化好的数据，用户自己保证log!=nullptr
+     * @return 0成功，-1失败
+     */
+    static int EncodeBatch(
+        const std::vector<std::pair<const ChunkRequest *,
+                                    const butil::IOBuf *>> &ops,
+        butil::IOBuf *log);
+
+    /**
+     * 判断op log entry是否是EncodeBatch打包的多个op
+     * @param log:op log entry
+     * @return 是返回true，否则返回false
+     */
+    static bool IsBatchLog(const butil::IOBuf &log);
+
+    /**
+     * 将EncodeBatch打包的op log entry拆分成单个op的log，
+     * 拆分出的每个log都可以直接使用Decode反序列化
+     * @param log:op log entry
+     * @param opLogs:出参，按顺序存放各个op的log
+     * @return 0成功，-1失败
+     */
+    static int DecodeBatch(butil::IOBuf log,
+                           std::vector<butil::IOBuf> *opLogs);
+
  protected:
     /**
      * 打包request为braft::task，propose给相应的复制组
@@ -175,6 +234,10 @@ class ChunkOpRequest : public std::enable_shared_from_this<ChunkOpRequest> {
     ChunkResponse *response_;
     // rpc done closure
     ::google::protobuf::Closure *done_;
+    // propose的时间，单调时钟
+    int64_t proposeTimeUs_ = 0;
+    // 请求各阶段的耗时记录
+    std::shared_ptr<OpTrace> trace_;
 };
 
 class DeleteChunkRequest : public ChunkOpRequest {
@@ -0,0 +1,116 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include <butil/time.h>
+
+#include <atomic>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "src/chunkserver/op_trace.h"
+
+namespace curve {
+namespace chunkserver {
+
+using ::curve::common::LatencyTracer;
+
+static const int kStageNum = static_cast<int>(OpTraceStage::STAGE_NUM);
+
+static const std::vector<std::string> kStageNames = {
+    "propose", "raft_commit", "apply_queue", "disk_io"
+};
+
+static std::atomic<bool> traceEnable(true);
+
+static LatencyTracer* GetTracer(CHUNK_OP_TYPE opType) {
+    static LatencyTracer readTracer("chunkserver_trace_read", kStageNames);
+    static LatencyTracer writeTracer("chunkserver_trace_write", kStageNames);
+    return opType == CHUNK_OP_TYPE::CHUNK_OP_READ ? &readTracer
+                                                  : &writeTracer;
+}
+
+std::shared_ptr<OpTrace> OpTrace::Create(const ChunkRequest* request) {
+    if (request == nullptr || request->traceid() == 0 ||
+        !traceEnable.load(std::memory_order_relaxed)) {
+        return nullptr;
+    }
+    if (request->optype() != CHUNK_OP_TYPE::CHUNK_OP_READ &&
+        request->optype() != CHUNK_OP_TYPE::CHUNK_OP_WRITE) {
+        return nullptr;
+    }
+    return std::make_shared<OpTrace>(request);
+}
+
+void OpTrace::SetOptions(const OpTraceOptions& options) {
+    traceEnable.store(options.enable, std::memory_order_relaxed);
+    GetTracer(CHUNK_OP_TYPE::CHUNK_OP_READ)->SetSlowRequestOption(
+        options.slowRequestThresholdUs, options.slowRequestDumpNum);
+    GetTracer(CHUNK_OP_TYPE::CHUNK_OP_WRITE)->SetSlowRequestOption(
+        options.slowRequestThresholdUs, options.slowRequestDumpNum);
+}
+
+OpTrace::OpTrace(const ChunkRequest* request)
+    : request_(request)
+    , startUs_(butil::monotonic_time_us())
+    , lastUs_(startUs_) {
+    for (int i = 0; i < kStageNum; ++i) {
+        stageUs_[i] = -1;
+    }
+}
+
+void OpTrace::Mark(OpTraceStage stage) {
+    int64_t now = butil::monotonic_time_us();
+    stageUs_[static_cast<int>(stage)] = now - lastUs_;
+    lastUs_ = now;
+}
+
+void OpTrace::Finish(CHUNK_OP_STATUS status) {
+    LatencyTracer* tracer = GetTracer(request_->optype());
+    for (int i = 0; i < kStageNum; ++i) {
+        tracer->RecordStage(i, stageUs_[i]);
+    }
+
+    int64_t totalUs = butil::monotonic_time_us() - startUs_;
+    if (!tracer->RecordTotal(totalUs)) {
+        return;
+    }
+
+    std::ostringstream oss;
+    oss << "traceId=" << request_->traceid()
+        << " logicPoolId=" << request_->logicpoolid()
+        << " copysetId=" << request_->copysetid()
+        << " chunkId=" << request_->chunkid()
+        << " offset=" << request_->offset()
+        << " size=" << request_->size()
+        << " status=" << CHUNK_OP_STATUS_Name(status)
+        << " total=" << totalUs << "us";
+    for (int i = 0; i < kStageNum; ++i) {
+        if (stageUs_[i] >= 0) {
+            oss << " " << kStageNames[i] << "=" << stageUs_[i] << "us";
+        }
+    }
+    tracer->AddSlowRequest(oss.str());
+}
+
+}  // namespace chunkserver
+}  // namespace curve
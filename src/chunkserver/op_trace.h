@@ -0,0 +1,107 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#ifndef SRC_CHUNKSERVER_OP_TRACE_H_
+#define SRC_CHUNKSERVER_OP_TRACE_H_
+
+#include <memory>
+
+#include "proto/chunk.pb.h"
+#include "src/common/latency_tracer.h"
+
+namespace curve {
+namespace chunkserver {
+
+/**
+ * 读写请求在chunkserver上依次经过的阶段，
+ * 每个阶段的耗时为上一个阶段结束到该阶段结束的时间
+ */
+enum class OpTraceStage {
+    // 从收到请求到propose给raft
+    PROPOSE = 0,
+    // 从propose到日志commit之后on_apply
+    RAFT_COMMIT = 1,
+    // 在并发apply模块的队列中等待
+    APPLY_QUEUE = 2,
+    // 读写chunk文件
+    DISK_IO = 3,
+    STAGE_NUM = 4,
+};
+
+struct OpTraceOptions {
+    // 是否统计client采样的请求
+    bool enable;
+    // 总延时超过该值的请求记为慢请求，0表示不记录慢请求
+    uint64_t slowRequestThresholdUs;
+    // 保留的最近慢请求的个数
+    uint32_t slowRequestDumpNum;
+
+    OpTraceOptions() : enable(true)
+                     , slowRequestThresholdUs(100000)
+                     , slowRequestDumpNum(64) {}
+};
+
+/**
+ * 一个被client采样的读写请求(携带非0的traceId)在chunkserver上的耗时记录，
+ * 由ChunkServiceClosure创建，请求返回时统计到chunkserver_trace_read/write_*
+ * 的bvar中，超过阈值的慢请求可以通过chunkserver_trace_*_slow_requests查看。
+ * leader上各个阶段按顺序在不同线程中标记，follower上不记录
+ */
+class OpTrace {
+ public:
+    /**
+     * 根据请求创建trace，请求未被采样或者不是读写请求时返回nullptr
+     * @param request: rpc请求，需要在Finish之前保持有效
+     */
+    static std::shared_ptr<OpTrace> Create(const ChunkRequest* request);
+
+    /**
+     * 设置trace的配置，进程启动时调用
+     */
+    static void SetOptions(const OpTraceOptions& options);
+
+    explicit OpTrace(const ChunkRequest* request);
+
+    /**
+     * 标记一个阶段结束
+     */
+    void Mark(OpTraceStage stage);
+
+    /**
+     * 请求返回时统计各阶段耗时，没有经过的阶段不统计
+     * @param status: 请求的返回状态
+     */
+    void Finish(CHUNK_OP_STATUS status);
+
+ private:
+    const ChunkRequest* request_;
+    int64_t startUs_;
+    // 上一个阶段结束的时间
+    int64_t lastUs_;
+    // 每个阶段的耗时，-1表示没有经过该阶段
+    int64_t stageUs_[static_cast<int>(OpTraceStage::STAGE_NUM)];
+};
+
+}  // namespace chunkserver
+}  // namespace curve
+
+#endif  // SRC_CHUNKSERVER_OP_TRACE_H_
@@ -38,6 +38,36 @@ uint32_t GetChunkLeftFunc(void* arg) {
     return chunkLeft;
 }
 
+uint32_t GetChunkRefilledFunc(void* arg) {
+    ChunkfilePool* chunkfilePool = reinterpret_cast<ChunkfilePool*>(arg);
+    uint32_t chunkRefilled = 0;
+    if (chunkfilePool != nullptr) {
+        ChunkFilePoolState poolState = chunkfilePool->GetState();
+        chunkRefilled = poolState.refilledChunks;
+    }
+    return chunkRefilled;
+}
+
+uint32_t GetChunkCleanedFunc(void* arg) {
+    ChunkfilePool* chunkfilePool = reinterpret_cast<ChunkfilePool*>(arg);
+    uint32_t chunkCleaned = 0;
+    if (chunkfilePool != nullptr) {
+        ChunkFilePoolState poolState = chunkfilePool->GetState();
+        chunkCleaned = poolState.cleanedChunks;
+    }
+    return chunkCleaned;
+}
+
+uint32_t GetChunkAllocateDebtFunc(void* arg) {
+    ChunkfilePool* chunkfilePool = reinterpret_cast<ChunkfilePool*>(arg);
+    uint32_t allocateDebt = 0;
+    if (chunkfilePool != nullptr) {
+        ChunkFilePoolState poolState = chunkfilePool->GetState();
+        allocateDebt = poolState.allocateDebt;
+    }
+    return allocateDebt;
+}
+
 uint32_t GetDatastoreChunkCountFunc(void* arg) {
     CSDataStore* dataStore = reinterpret_cast<CSDataStore*>(arg);
     uint32_t chunkCount = 0;
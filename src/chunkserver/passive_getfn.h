@@ -65,6 +65,21 @@ namespace chunkserver {
      * @param arg: chunkfilepool的对象指针
      */
     uint32_t GetChunkLeftFunc(void* arg);
+    /**
+     * 获取chunkfilepool后台补充的chunk的数量
+     * @param arg: chunkfilepool的对象指针
+     */
+    uint32_t GetChunkRefilledFunc(void* arg);
+    /**
+     * 获取chunkfilepool后台清零的回收chunk的数量
+     * @param arg: chunkfilepool的对象指针
+     */
+    uint32_t GetChunkCleanedFunc(void* arg);
+    /**
+     * 获取chunkfilepool为空时直接分配chunk的次数
+     * @param arg: chunkfilepool的对象指针
+     */
+    uint32_t GetChunkAllocateDebtFunc(void* arg);
     /**
      * 获取trash中chunk的数量
      * @param arg: trash的对象指针
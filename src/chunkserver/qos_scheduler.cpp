@@ -0,0 +1,428 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include "src/chunkserver/qos_scheduler.h"
+
+#include <bthread/bthread.h>
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <chrono>   //NOLINT
+
+#include "src/common/timeutility.h"
+
+namespace curve {
+namespace chunkserver {
+
+using ::curve::common::TimeUtility;
+
+// 删除等不带数据的请求在DRR中按照4KB计算代价
+const uint64_t kMinCostBytes = 4096;
+// 没有请求排队时调度线程的等待时间
+const uint64_t kIdleWaitMs = 1000;
+// 令牌不足时调度线程最长的等待时间
+const uint64_t kMaxWaitUs = 100 * 1000;
+// 超过该时间没有请求的flow和令牌桶会被清理
+const uint64_t kIdleCleanUs = 60 * 1000 * 1000;
+
+struct QosTaskArg {
+    QosScheduler* scheduler;
+    QosTask task;
+};
+
+QosScheduler::QosScheduler()
+    : queuedCount_(0)
+    , lastCleanUs_(0)
+    , running_(false)
+    , runningTasks_(0) {
+    std::fill(quantum_, quantum_ + kQosIOTypeNum, 0);
+}
+
+QosScheduler::~QosScheduler() {
+    Fini();
+}
+
+int QosScheduler::Init(const QosOptions& options) {
+    if (options.enable && options.quantumBytes == 0) {
+        LOG(ERROR) << "Init qos scheduler failed, quantumBytes is 0";
+        return -1;
+    }
+    options_ = options;
+
+    uint32_t weights[kQosIOTypeNum] = {
+        options_.foregroundWeight,
+        options_.cloneWeight,
+        options_.recoverWeight,
+        options_.snapshotWeight,
+    };
+    uint64_t bps[kQosIOTypeNum] = {
+        0,
+        options_.cloneBps,
+        options_.recoverBps,
+        options_.snapshotBps,
+    };
+    for (int i = 0; i < kQosIOTypeNum; ++i) {
+        // 权重为0时按1处理，避免该类IO永远得不到调度
+        quantum_[i] = options_.quantumBytes * std::max(weights[i], 1u);
+        typeBuckets_[i].SetRate(bps[i]);
+    }
+    chunkserverBucket_.iops.SetRate(options_.limit.chunkserverIops);
+    chunkserverBucket_.bps.SetRate(options_.limit.chunkserverBps);
+    return 0;
+}
+
+int QosScheduler::Run() {
+    if (!options_.enable) {
+        LOG(INFO) << "Qos scheduler is disabled";
+        return 0;
+    }
+    {
+        LockGuard lock(mtx_);
+        if (running_.load()) {
+            return 0;
+        }
+        running_.store(true);
+    }
+    dispatchThread_ = Thread(&QosScheduler::DispatchLoop, this);
+    LOG(INFO) << "Qos scheduler started";
+    return 0;
+}
+
+int QosScheduler::Fini() {
+    {
+        LockGuard lock(mtx_);
+        if (!running_.load()) {
+            return 0;
+        }
+        running_.store(false);
+    }
+    cond_.notify_all();
+    if (dispatchThread_.joinable()) {
+        dispatchThread_.join();
+    }
+
+    // 执行还在排队的请求，保证rpc都能够返回
+    std::vector<QosTask> tasks;
+    {
+        LockGuard lock(mtx_);
+        for (auto flow : activeFlows_) {
+            for (auto& request : flow->queue) {
+                tasks.push_back(std::move(request.task));
+            }
+            flow->queue.clear();
+            flow->active = false;
+            flow->deficit = 0;
+        }
+        activeFlows_.clear();
+        queuedCount_ = 0;
+    }
+    for (auto& task : tasks) {
+        task();
+    }
+    {
+        UniqueLock lock(taskMtx_);
+        taskCond_.wait(lock, [this] { return runningTasks_ == 0; });
+    }
+    LOG(INFO) << "Qos scheduler stopped";
+    return 0;
+}
+
+void QosScheduler::Submit(QosIOType type,
+                          GroupNid groupId,
+                          uint64_t clientId,
+                          uint32_t bytes,
+                          QosTask task) {
+    QosRequest request;
+    request.groupId = groupId;
+    request.clientId = clientId;
+    request.bytes = bytes;
+    request.cost = std::max<uint64_t>(bytes, kMinCostBytes);
+    request.task = std::move(task);
+
+    uint64_t nowUs = TimeUtility::GetTimeofDayUs();
+    UniqueLock lock(mtx_);
+    if (!running_.load()) {
+        lock.unlock();
+        request.task();
+        return;
+    }
+
+    // 没有请求在排队时不存在竞争，令牌充足的请求直接执行
+    if (activeFlows_.empty() && GetWaitUs(type, request, nowUs) == 0) {
+        Consume(type, request, nowUs);
+        lock.unlock();
+        request.task();
+        return;
+    }
+
+    QosFlow& flow =
+        flows_[std::make_tuple(static_cast<int>(type), groupId, clientId)];
+    flow.type = type;
+    flow.lastActiveUs = nowUs;
+    flow.queue.push_back(std::move(request));
+    ++queuedCount_;
+    if (!flow.active) {
+        flow.active = true;
+        activeFlows_.push_back(&flow);
+    }
+    lock.unlock();
+    cond_.notify_one();
+}
+
+void QosScheduler::UpdateLimit(const QosLimit& limit) {
+    LockGuard lock(mtx_);
+    if (options_.limit == limit) {
+        return;
+    }
+    options_.limit = limit;
+    chunkserverBucket_.iops.SetRate(limit.chunkserverIops);
+    chunkserverBucket_.bps.SetRate(limit.chunkserverBps);
+    for (auto& item : copysetBuckets_) {
+        item.second.iops.SetRate(limit.copysetIops);
+        item.second.bps.SetRate(limit.copysetBps);
+    }
+    for (auto& item : clientBuckets_) {
+        item.second.iops.SetRate(limit.clientIops);
+        item.second.bps.SetRate(limit.clientBps);
+    }
+    LOG(INFO) << "Update qos limit, chunkserver iops: "
+              << limit.chunkserverIops
+              << ", chunkserver bps: " << limit.chunkserverBps
+              << ", copyset iops: " << limit.copysetIops
+              << ", copyset bps: " << limit.copysetBps
+              << ", client iops: " << limit.clientIops
+              << ", client bps: " << limit.clientBps;
+}
+
+QosLimit QosScheduler::GetLimit() {
+    LockGuard lock(mtx_);
+    return options_.limit;
+}
+
+uint64_t QosScheduler::GetQueuedCount() {
+    LockGuard lock(mtx_);
+    return queuedCount_;
+}
+
+void QosScheduler::DispatchLoop() {
+    while (running_.load()) {
+        std::vector<QosTask> tasks;
+        {
+            UniqueLock lock(mtx_);
+            uint64_t nowUs = TimeUtility::GetTimeofDayUs();
+            CleanIdle(nowUs);
+            if (activeFlows_.empty()) {
+                cond_.wait_for(lock, std::chrono::milliseconds(kIdleWaitMs));
+                continue;
+            }
+            uint64_t minWaitUs = kMaxWaitUs;
+            bool progress = DispatchRound(nowUs, &tasks, &minWaitUs);
+            // 所有flow都因为令牌不足被跳过，等待令牌补充或者新的请求
+            if (tasks.empty() && !progress) {
+                cond_.wait_for(lock, std::chrono::microseconds(minWaitUs));
+                continue;
+            }
+        }
+        // 读请求在执行时可能因为chunk的apply队列满而阻塞，
+        // 不能在调度线程中执行，否则一个chunk会阻塞所有flow
+        for (auto& task : tasks) {
+            RunTask(std::move(task));
+        }
+    }
+}
+
+void QosScheduler::RunTask(QosTask task) {
+    QosTaskArg* arg = new (std::nothrow) QosTaskArg();
+    if (arg == nullptr) {
+        LOG(ERROR) << "allocate qos task failed, run in dispatch thread";
+        task();
+        return;
+    }
+    arg->scheduler = this;
+    arg->task = std::move(task);
+    {
+        LockGuard lock(taskMtx_);
+        ++runningTasks_;
+    }
+    bthread_t tid;
+    if (bthread_start_background(&tid, nullptr,
+                                 &QosScheduler::RunTaskInBthread, arg) != 0) {
+        LOG(ERROR) << "start bthread for qos task failed, "
+                   << "run in dispatch thread";
+        RunTaskInBthread(arg);
+    }
+}
+
+void* QosScheduler::RunTaskInBthread(void* arg) {
+    std::unique_ptr<QosTaskArg> taskArg(static_cast<QosTaskArg*>(arg));
+    taskArg->task();
+    taskArg->scheduler->OnTaskDone();
+    return nullptr;
+}
+
+void QosScheduler::OnTaskDone() {
+    LockGuard lock(taskMtx_);
+    if (--runningTasks_ == 0) {
+        taskCond_.notify_all();
+    }
+}
+
+bool QosScheduler::DispatchRound(uint64_t nowUs,
+                                 std::vector<QosTask>* tasks,
+                                 uint64_t* minWaitUs) {
+    bool progress = false;
+    // 因为令牌不足被跳过的flow下一轮优先调度，否则多个flow竞争同一个
+    // 令牌桶时，排在前面的flow总是先拿到令牌
+    std::vector<QosFlow*> skipped;
+    size_t flowNum = activeFlows_.size();
+    for (size_t i = 0; i < flowNum; ++i) {
+        QosFlow* flow = activeFlows_.front();
+        activeFlows_.pop_front();
+
+        // 令牌不足的flow本轮不增加额度，避免额度无限累积
+        uint64_t waitUs = GetWaitUs(flow->type, flow->queue.front(), nowUs);
+        if (waitUs > 0) {
+            *minWaitUs = std::min(*minWaitUs, waitUs);
+            skipped.push_back(flow);
+            continue;
+        }
+
+        progress = true;
+        flow->deficit += quantum_[static_cast<int>(flow->type)];
+        while (!flow->queue.empty()) {
+            QosRequest& request = flow->queue.front();
+            if (request.cost > flow->deficit) {
+                break;
+            }
+            waitUs = GetWaitUs(flow->type, request, nowUs);
+            if (waitUs > 0) {
+                *minWaitUs = std::min(*minWaitUs, waitUs);
+                break;
+            }
+            Consume(flow->type, request, nowUs);
+            flow->deficit -= request.cost;
+            tasks->push_back(std::move(request.task));
+            flow->queue.pop_front();
+            --queuedCount_;
+        }
+
+        if (flow->queue.empty()) {
+            flow->deficit = 0;
+            flow->active = false;
+        } else {
+            activeFlows_.push_back(flow);
+        }
+    }
+    activeFlows_.insert(activeFlows_.begin(), skipped.begin(), skipped.end());
+    return progress;
+}
+
+uint64_t QosScheduler::GetWaitUs(QosIOType type,
+                                 const QosRequest& request,
+                                 uint64_t nowUs) {
+    IopsBpsBucket* copyset = GetCopysetBucket(request.groupId);
+    IopsBpsBucket* client = GetClientBucket(request.clientId);
+    uint64_t waitUs = 0;
+    waitUs = std::max(waitUs, chunkserverBucket_.iops.GetWaitUs(1, nowUs));
+    waitUs = std::max(waitUs,
+        chunkserverBucket_.bps.GetWaitUs(request.bytes, nowUs));
+    waitUs = std::max(waitUs, typeBuckets_[static_cast<int>(type)].GetWaitUs(
+        request.bytes, nowUs));
+    waitUs = std::max(waitUs, copyset->iops.GetWaitUs(1, nowUs));
+    waitUs = std::max(waitUs, copyset->bps.GetWaitUs(request.bytes, nowUs));
+    waitUs = std::max(waitUs, client->iops.GetWaitUs(1, nowUs));
+    waitUs = std::max(waitUs, client->bps.GetWaitUs(request.bytes, nowUs));
+    return waitUs;
+}
+
+void QosScheduler::Consume(QosIOType type,
+                           const QosRequest& request,
+                           uint64_t nowUs) {
+    IopsBpsBucket* copyset = GetCopysetBucket(request.groupId);
+    IopsBpsBucket* client = GetClientBucket(request.clientId);
+    chunkserverBucket_.iops.Consume(1, nowUs);
+    chunkserverBucket_.bps.Consume(request.bytes, nowUs);
+    typeBuckets_[static_cast<int>(type)].Consume(request.bytes, nowUs);
+    copyset->iops.Consume(1, nowUs);
+    copyset->bps.Consume(request.bytes, nowUs);
+    copyset->lastActiveUs = nowUs;
+    client->iops.Consume(1, nowUs);
+    client->bps.Consume(request.bytes, nowUs);
+    client->lastActiveUs = nowUs;
+}
+
+QosScheduler::IopsBpsBucket* QosScheduler::GetCopysetBucket(
+    GroupNid groupId) {
+    auto it = copysetBuckets_.find(groupId);
+    if (it != copysetBuckets_.end()) {
+        return &it->second;
+    }
+    IopsBpsBucket* bucket = &copysetBuckets_[groupId];
+    bucket->iops.SetRate(options_.limit.copysetIops);
+    bucket->bps.SetRate(options_.limit.copysetBps);
+    return bucket;
+}
+
+QosScheduler::IopsBpsBucket* QosScheduler::GetClientBucket(
+    uint64_t clientId) {
+    auto it = clientBuckets_.find(clientId);
+    if (it != clientBuckets_.end()) {
+        return &it->second;
+    }
+    IopsBpsBucket* bucket = &clientBuckets_[clientId];
+    bucket->iops.SetRate(options_.limit.clientIops);
+    bucket->bps.SetRate(options_.limit.clientBps);
+    return bucket;
+}
+
+void QosScheduler::CleanIdle(uint64_t nowUs) {
+    if (nowUs < lastCleanUs_ + kIdleCleanUs) {
+        return;
+    }
+    lastCleanUs_ = nowUs;
+    uint64_t expireUs = nowUs > kIdleCleanUs ? nowUs - kIdleCleanUs : 0;
+    for (auto it = flows_.begin(); it != flows_.end();) {
+        if (!it->second.active && it->second.lastActiveUs < expireUs) {
+            it = flows_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for (auto it = copysetBuckets_.begin(); it != copysetBuckets_.end();) {
+        if (it->second.lastActiveUs < expireUs) {
+            it = copysetBuckets_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for (auto it = clientBuckets_.begin(); it != clientBuckets_.end();) {
+        if (it->second.lastActiveUs < expireUs) {
+            it = clientBuckets_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+}  // namespace chunkserver
+}  // namespace curve
@@ -0,0 +1,255 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#ifndef SRC_CHUNKSERVER_QOS_SCHEDULER_H_
+#define SRC_CHUNKSERVER_QOS_SCHEDULER_H_
+
+#include <deque>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "include/chunkserver/chunkserver_common.h"
+#include "src/common/concurrent/concurrent.h"
+#include "src/common/token_bucket.h"
+
+namespace curve {
+namespace chunkserver {
+
+using ::curve::common::Atomic;
+using ::curve::common::Mutex;
+using ::curve::common::LockGuard;
+using ::curve::common::UniqueLock;
+using ::curve::common::ConditionVariable;
+using ::curve::common::Thread;
+using ::curve::common::TokenBucket;
+
+/**
+ * 参与QoS调度的IO类型，各类型有独立的权重和带宽预算
+ */
+enum class QosIOType {
+    // 前台读写和删除
+    FOREGROUND = 0,
+    // 创建clone chunk
+    CLONE = 1,
+    // 恢复clone chunk
+    RECOVER = 2,
+    // 读取和删除快照
+    SNAPSHOT = 3,
+};
+
+const int kQosIOTypeNum = 4;
+
+/**
+ * 可以由mds通过心跳动态调整的限制，为0表示不限制
+ */
+struct QosLimit {
+    // 整个chunkserver的iops和带宽上限
+    uint64_t chunkserverIops = 0;
+    uint64_t chunkserverBps = 0;
+    // 每个copyset的iops和带宽上限
+    uint64_t copysetIops = 0;
+    uint64_t copysetBps = 0;
+    // 每个client的iops和带宽上限
+    uint64_t clientIops = 0;
+    uint64_t clientBps = 0;
+
+    bool operator==(const QosLimit& other) const {
+        return chunkserverIops == other.chunkserverIops
+            && chunkserverBps == other.chunkserverBps
+            && copysetIops == other.copysetIops
+            && copysetBps == other.copysetBps
+            && clientIops == other.clientIops
+            && clientBps == other.clientBps;
+    }
+};
+
+struct QosOptions {
+    // 是否开启QoS调度，关闭时请求直接执行
+    bool enable = false;
+    // DRR每一轮中每单位权重可以调度的数据量
+    uint64_t quantumBytes = 64 * 1024;
+    // 各类IO的权重
+    uint32_t foregroundWeight = 8;
+    uint32_t cloneWeight = 2;
+    uint32_t recoverWeight = 2;
+    uint32_t snapshotWeight = 1;
+    // 后台IO各自的带宽预算，为0表示不限制
+    uint64_t cloneBps = 0;
+    uint64_t recoverBps = 0;
+    uint64_t snapshotBps = 0;
+
+    QosLimit limit;
+};
+
+using QosTask = std::function<void()>;
+
+/**
+ * chunkserver上按copyset和client进行IO调度的QoS模块：
+ * 1. 请求按照(IO类型, copyset, client)划分为不同的flow，flow之间按照
+ *    IO类型的权重做deficit round robin，flow中的请求按照到达顺序调度
+ * 2. 请求被调度之前需要获取chunkserver、IO类型、copyset和client
+ *    各级令牌桶中的令牌，某一级令牌不足的flow本轮被跳过，不影响其他flow
+ * 3. 没有排队的请求且令牌充足时，请求直接在提交的线程中执行，
+ *    排队之后被调度的请求在bthread中执行，调度线程不会被某个请求阻塞
+ */
+class QosScheduler {
+ public:
+    QosScheduler();
+    virtual ~QosScheduler();
+
+    int Init(const QosOptions& options);
+
+    int Run();
+
+    int Fini();
+
+    /**
+     * 提交请求，请求被调度时执行task，未开启QoS或者未运行时直接执行
+     * @param type: 请求的IO类型
+     * @param groupId: 请求所属的copyset
+     * @param clientId: 请求所属的client
+     * @param bytes: 请求读写的数据量
+     * @param task: 请求被调度时执行的任务
+     */
+    void Submit(QosIOType type,
+                GroupNid groupId,
+                uint64_t clientId,
+                uint32_t bytes,
+                QosTask task);
+
+    /**
+     * 更新chunkserver、copyset和client级别的限制，已有的令牌桶同时生效
+     */
+    void UpdateLimit(const QosLimit& limit);
+
+    QosLimit GetLimit();
+
+    /**
+     * 获取当前排队等待调度的请求数量
+     */
+    uint64_t GetQueuedCount();
+
+ private:
+    struct QosRequest {
+        GroupNid groupId;
+        uint64_t clientId;
+        uint32_t bytes;
+        // DRR中请求的代价，不小于kMinCostBytes
+        uint64_t cost;
+        QosTask task;
+    };
+
+    struct QosFlow {
+        QosIOType type;
+        uint64_t deficit = 0;
+        // 是否在activeFlows_中
+        bool active = false;
+        uint64_t lastActiveUs = 0;
+        std::deque<QosRequest> queue;
+    };
+
+    struct IopsBpsBucket {
+        TokenBucket iops;
+        TokenBucket bps;
+        uint64_t lastActiveUs = 0;
+    };
+
+    void DispatchLoop();
+
+    /**
+     * 在bthread中执行被调度的请求，创建bthread失败时在当前线程执行
+     */
+    void RunTask(QosTask task);
+
+    static void* RunTaskInBthread(void* arg);
+
+    void OnTaskDone();
+
+    /**
+     * 从当前的active flow开始执行一轮DRR，需要持有mtx_
+     * @param nowUs: 当前时间
+     * @param[out] tasks: 本轮被调度的请求
+     * @param[out] minWaitUs: 因为令牌不足被跳过的flow需要等待的最短时间
+     * @return: 本轮是否有flow获得了调度额度
+     */
+    bool DispatchRound(uint64_t nowUs,
+                       std::vector<QosTask>* tasks,
+                       uint64_t* minWaitUs);
+
+    /**
+     * 获取请求所需的各级令牌需要等待的时间，需要持有mtx_
+     */
+    uint64_t GetWaitUs(QosIOType type, const QosRequest& request,
+                       uint64_t nowUs);
+
+    void Consume(QosIOType type, const QosRequest& request, uint64_t nowUs);
+
+    IopsBpsBucket* GetCopysetBucket(GroupNid groupId);
+
+    IopsBpsBucket* GetClientBucket(uint64_t clientId);
+
+    /**
+     * 清理长时间没有请求的flow和令牌桶，需要持有mtx_
+     */
+    void CleanIdle(uint64_t nowUs);
+
+ private:
+    QosOptions options_;
+    // 各类IO在DRR中每一轮获得的额度
+    uint64_t quantum_[kQosIOTypeNum];
+
+    Mutex mtx_;
+    ConditionVariable cond_;
+
+    // (IO类型, copyset, client) -> flow
+    std::map<std::tuple<int, GroupNid, uint64_t>, QosFlow> flows_;
+    // 有请求排队的flow，按照DRR的顺序排列
+    std::list<QosFlow*> activeFlows_;
+    uint64_t queuedCount_;
+
+    IopsBpsBucket chunkserverBucket_;
+    // 各类IO的带宽预算
+    TokenBucket typeBuckets_[kQosIOTypeNum];
+    std::unordered_map<GroupNid, IopsBpsBucket> copysetBuckets_;
+    std::unordered_map<uint64_t, IopsBpsBucket> clientBuckets_;
+    uint64_t lastCleanUs_;
+
+    Thread dispatchThread_;
+    Atomic<bool> running_;
+
+    // 已经被调度、正在bthread中执行的请求数，停止时等待其全部完成
+    Mutex taskMtx_;
+    ConditionVariable taskCond_;
+    uint64_t runningTasks_;
+};
+
+}  // namespace chunkserver
+}  // namespace curve
+
+#endif  // SRC_CHUNKSERVER_QOS_SCHEDULER_H_
@@ -0,0 +1,173 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#ifndef SRC_CHUNKSERVER_RAFTLOG_CURVE_LOG_STORAGE_H_
+#define SRC_CHUNKSERVER_RAFTLOG_CURVE_LOG_STORAGE_H_
+
+#include <braft/log.h>
+#include <braft/storage.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "src/common/concurrent/concurrent.h"
+
+namespace curve {
+namespace chunkserver {
+
+using ::curve::common::Mutex;
+using ::curve::common::LockGuard;
+
+struct DataRecord;
+
+/**
+ * 保存写请求数据的文件，文件名为data_<firstIndex>，
+ * firstIndex为文件中第一条日志的index，
+ * 文件创建时预分配空间，数据按4KB对齐写入
+ */
+struct DataSegment {
+    int64_t firstIndex;
+    std::string path;
+    int fd;
+    uint64_t size;
+    // 下一次写入的位置
+    uint64_t writeOffset;
+    // 不再追加写入
+    bool sealed;
+
+    DataSegment() : firstIndex(0), fd(-1), size(0),
+                    writeOffset(0), sealed(true) {}
+    ~DataSegment();
+};
+
+/**
+ * 写请求数据和raft log元数据分开存放的LogStorage，通过curve://注册：
+ * 1. 数据大于等于inline阈值的日志，数据以O_DIRECT方式写入data目录下的
+ *    预分配文件，元数据日志中只记录数据的位置和crc
+ * 2. 小于阈值的日志及配置变更日志原样写入元数据日志
+ * 3. 每批日志只对数据文件做一次fdatasync，之后再写元数据日志，
+ *    因此元数据日志中引用的数据一定已经落盘，两次sync的耗时分别有统计
+ * 元数据日志使用braft的SegmentLogStorage，与local://的日志格式兼容
+ */
+class CurveLogStorage : public braft::LogStorage {
+ public:
+    explicit CurveLogStorage(const std::string& path);
+    CurveLogStorage() {}
+    virtual ~CurveLogStorage() {}
+
+    int init(braft::ConfigurationManager* configurationManager) override;
+
+    int64_t first_log_index() override;
+
+    int64_t last_log_index() override;
+
+    braft::LogEntry* get_entry(const int64_t index) override;
+
+    int64_t get_term(const int64_t index) override;
+
+    int append_entry(const braft::LogEntry* entry) override;
+
+    int append_entries(const std::vector<braft::LogEntry*>& entries,
+                       braft::IOMetric* metric) override;
+
+    int truncate_prefix(const int64_t firstIndexKept) override;
+
+    int truncate_suffix(const int64_t lastIndexKept) override;
+
+    int reset(const int64_t nextLogIndex) override;
+
+    braft::LogStorage* new_instance(const std::string& uri) const override;
+
+    static void set_inline_threshold(uint32_t threshold) {
+        inlineThreshold_ = threshold;
+    }
+
+    static void set_data_segment_size(uint64_t size) {
+        dataSegmentSize_ = size;
+    }
+
+    /**
+     * 获取当前data目录下的数据文件个数，用于测试
+     */
+    size_t GetDataSegmentNum();
+
+ private:
+    /**
+     * 将一条日志的数据写入数据文件，需要时创建新的数据文件
+     * @param entry: 待写入的日志
+     * @param[out] record: 元数据日志中记录的数据位置
+     * @param[out] dirty: 写入过数据的文件，用于之后统一sync
+     * @return: 成功返回0，失败返回-1
+     */
+    int WriteData(const braft::LogEntry* entry,
+                  butil::IOBuf* record,
+                  std::vector<std::shared_ptr<DataSegment>>* dirty);
+
+    /**
+     * 根据元数据日志中的记录读取数据并校验crc
+     * @param record: 元数据日志中记录的数据位置
+     * @param[out] data: 读取到的数据
+     * @return: 成功返回0，失败返回-1
+     */
+    int ReadData(const DataRecord& record, butil::IOBuf* data);
+
+    /**
+     * 创建新的数据文件作为当前写入的文件
+     */
+    std::shared_ptr<DataSegment> CreateSegment(int64_t firstIndex,
+                                               uint64_t size);
+
+    /**
+     * 删除不再被元数据日志引用的数据文件，
+     * 每个文件覆盖[firstIndex, 下一个文件的firstIndex)范围内的日志
+     */
+    void RemoveUnusedSegments(int64_t firstIndex, int64_t lastIndex);
+
+    /**
+     * 当前写入的数据文件不再追加写入，之后的数据写入新的文件
+     */
+    void SealCurrentSegment();
+
+    int ListSegments();
+
+    std::string DataPath() const;
+
+ private:
+    std::string path_;
+
+    // raft log的元数据
+    std::unique_ptr<braft::SegmentLogStorage> meta_;
+
+    // firstIndex -> 数据文件
+    std::map<int64_t, std::shared_ptr<DataSegment>> segments_;
+    Mutex mtx_;
+
+    static uint32_t inlineThreshold_;
+    static uint64_t dataSegmentSize_;
+};
+
+}  // namespace chunkserver
+}  // namespace curve
+
+#endif  // SRC_CHUNKSERVER_RAFTLOG_CURVE_LOG_STORAGE_H_
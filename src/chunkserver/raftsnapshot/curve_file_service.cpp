@@ -43,6 +43,7 @@
 #include <brpc/closure_guard.h>
 #include <brpc/controller.h>
 #include <braft/util.h>
+#include <string.h>
 #include <stack>
 #include "src/chunkserver/raftsnapshot/curve_file_service.h"
 
@@ -51,6 +52,70 @@ namespace chunkserver {
 
 CurveFileService& kCurveFileService = CurveFileService::GetInstance();
 
+// 检查全零数据的粒度
+const size_t kZeroCheckPageSize = 4096;
+
+static bool IsZeroPage(const char* data, size_t len) {
+    return len == 0 ||
+           (data[0] == 0 && memcmp(data, data + 1, len - 1) == 0);
+}
+
+// 只有chunk文件及其快照文件会跳过全零的page，raft meta等文件保持原样传输
+static bool IsChunkFile(const std::string& filename) {
+    std::string basename = butil::FilePath(filename).BaseName().value();
+    return basename.compare(0, 6, "chunk_") == 0;
+}
+
+/**
+ * 去掉follower加在文件名后的SKIP_ZERO_PAGE_SUFFIX
+ * @param: filename 请求中的文件名，返回时去掉后缀
+ * @return: 文件名带有后缀返回true，否则返回false
+ */
+static bool StripSkipZeroPageSuffix(std::string* filename) {
+    const size_t suffixLen = strlen(SKIP_ZERO_PAGE_SUFFIX);
+    if (filename->size() <= suffixLen ||
+        filename->compare(filename->size() - suffixLen, suffixLen,
+                          SKIP_ZERO_PAGE_SUFFIX) != 0) {
+        return false;
+    }
+    filename->resize(filename->size() - suffixLen);
+    return true;
+}
+
+/**
+ * 将读到的数据按page切分，只把非全零的连续区间追加到seg_data中，
+ * 接收端按照每个segment的offset写入，跳过的区间保持为零
+ * @param: buf 从文件中读取的数据
+ * @param: offset buf在文件中的起始偏移
+ * @param: seg_data 返回给接收端的数据
+ */
+static void AppendNonZeroSegments(butil::IOBuf* buf, uint64_t offset,
+                                  braft::FileSegData* seg_data) {
+    char page[kZeroCheckPageSize];
+    butil::IOBuf run;
+    uint64_t runOffset = offset;
+    while (!buf->empty()) {
+        butil::IOBuf piece;
+        size_t len = buf->cutn(&piece, kZeroCheckPageSize);
+        piece.copy_to(page, len);
+        if (IsZeroPage(page, len)) {
+            if (!run.empty()) {
+                seg_data->append(run, runOffset);
+                run.clear();
+            }
+        } else {
+            if (run.empty()) {
+                runOffset = offset;
+            }
+            run.append(piece);
+        }
+        offset += len;
+    }
+    if (!run.empty()) {
+        seg_data->append(run, runOffset);
+    }
+}
+
 void CurveFileService::get_file(::google::protobuf::RpcController* controller,
                                const ::braft::GetFileRequest* request,
                                ::braft::GetFileResponse* response,
@@ -76,8 +141,12 @@ void CurveFileService::get_file(::google::protobuf::RpcController* controller,
     // Don't touch iter ever after
     reader = iter->second;
     lck.unlock();
+    // 只有follower在文件名上标明已经清零了新建的chunk文件，才跳过全零的page，
+    // 老版本的follower不会带这个标记，仍然完整传输
+    std::string filename = request->filename();
+    const bool zeroedByPeer = StripSkipZeroPageSuffix(&filename);
     LOG(INFO) << "get_file for " << cntl->remote_side() << " path="
-              << reader->path() << " filename=" << request->filename()
+              << reader->path() << " filename=" << filename
               << " offset=" << request->offset() << " count="
               << request->count();
 
@@ -92,7 +161,7 @@ void CurveFileService::get_file(::google::protobuf::RpcController* controller,
     bool is_eof = false;
     size_t read_count = 0;
     // 1. 如果是read attch meta file
-    if (request->filename() == BRAFT_SNAPSHOT_ATTACH_META_FILE) {
+    if (filename == BRAFT_SNAPSHOT_ATTACH_META_FILE) {
         // 如果没有设置snapshot attachment，那么read文件的长度为零
         // 表示没有 snapshot attachment文件列表
         bool snapshotAttachmentExist = false;
@@ -115,6 +184,8 @@ void CurveFileService::get_file(::google::protobuf::RpcController* controller,
                 LocalFileMeta meta;
                 attachMetaTable.add_attach_file(files[i], meta);
             }
+            // 告诉follower当前leader支持跳过全零的page
+            attachMetaTable.set_skip_zero_page(_skip_zero_page);
 
             {
                 std::unique_lock<braft::raft_mutex_t> lck(_mutex);
@@ -154,17 +225,17 @@ void CurveFileService::get_file(::google::protobuf::RpcController* controller,
     } else {
         // 2. 否则其它文件下载继续走raft原先的文件下载流程
         const int rc = reader->read_file(
-                                &buf, request->filename(),
+                                &buf, filename,
                                 request->offset(), request->count(),
                                 request->read_partly(),
                                 &read_count,
                                 &is_eof);
         if (rc != 0) {
             LOG(ERROR) << "Fail to read file " << reader->path() << "/"
-                       << request->filename() << " error code: " << rc;
+                       << filename << " error code: " << rc;
             cntl->SetFailed(rc, "Fail to read from path=%s filename=%s : %s",
                             reader->path().c_str(),
-                            request->filename().c_str(), berror(rc));
+                            filename.c_str(), berror(rc));
             return;
         }
     }
@@ -177,7 +248,11 @@ void CurveFileService::get_file(::google::protobuf::RpcController* controller,
     }
 
     braft::FileSegData seg_data;
-    seg_data.append(buf, request->offset());
+    if (_skip_zero_page && zeroedByPeer && IsChunkFile(filename)) {
+        AppendNonZeroSegments(&buf, request->offset(), &seg_data);
+    } else {
+        seg_data.append(buf, request->offset());
+    }
     cntl->response_attachment().swap(seg_data.data());
 }
 
@@ -186,7 +261,7 @@ void CurveFileService::set_snapshot_attachment(
     _snapshot_attachment = snapshot_attachment;
 }
 
-CurveFileService::CurveFileService() {
+CurveFileService::CurveFileService() : _skip_zero_page(false) {
     _next_id = ((int64_t)getpid() << 45) |
             (butil::gettimeofday_us() << 17 >> 17);
 }
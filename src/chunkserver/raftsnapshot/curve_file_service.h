@@ -72,6 +72,15 @@ class BAIDU_CACHELINE_ALIGNMENT CurveFileService : public braft::FileService {
         BAIDU_SCOPED_LOCK(_mutex);
         auto ret = _snapshot_attachment.release();
     }
+    /**
+     * 设置下载chunk文件时是否跳过全零的page。开启后leader会在attach meta中
+     * 通告该能力，只有在文件名上带有SKIP_ZERO_PAGE_SUFFIX的请求才跳过全零的
+     * page，这类请求的follower已经在创建chunk文件时将其清零
+     * @param: skip 是否跳过全零的page
+     */
+    void set_skip_zero_page(bool skip) {
+        _skip_zero_page = skip;
+    }
 
  private:
     CurveFileService();
@@ -81,6 +90,7 @@ class BAIDU_CACHELINE_ALIGNMENT CurveFileService : public braft::FileService {
     int64_t _next_id;
     Map _reader_map;
     scoped_refptr<SnapshotAttachment> _snapshot_attachment;
+    bool _skip_zero_page;
 };
 
 extern CurveFileService &kCurveFileService;
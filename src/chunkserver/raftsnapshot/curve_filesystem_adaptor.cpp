@@ -21,6 +21,10 @@
  */
 
 #include <butil/fd_utility.h>
+#include <fcntl.h>
+#include <linux/falloc.h>
+#include <algorithm>
+#include <memory>
 #include <vector>
 
 #include "src/chunkserver/raftsnapshot/curve_filesystem_adaptor.h"
@@ -29,7 +33,8 @@ namespace curve {
 namespace chunkserver {
 CurveFilesystemAdaptor::CurveFilesystemAdaptor(
                                 std::shared_ptr<ChunkfilePool> chunkfilePool,
-                                std::shared_ptr<LocalFileSystem> lfs) {
+                                std::shared_ptr<LocalFileSystem> lfs)
+    : zeroNewChunkFile_(false) {
     lfs_ = lfs;
     chunkfilePool_ = chunkfilePool;
     uint64_t metapageSize = chunkfilePool_->GetChunkFilePoolOpt().metaPageSize;
@@ -39,7 +44,8 @@ CurveFilesystemAdaptor::CurveFilesystemAdaptor(
 }
 
 CurveFilesystemAdaptor::CurveFilesystemAdaptor()
-    : tempMetaPageContent(nullptr) {
+    : tempMetaPageContent(nullptr),
+      zeroNewChunkFile_(false) {
 }
 
 CurveFilesystemAdaptor::~CurveFilesystemAdaptor() {
@@ -75,18 +81,25 @@ braft::FileAdaptor* CurveFilesystemAdaptor::open(const std::string& path,
     // 先判断当前文件是否需要过滤，如果需要过滤，就直接走下面逻辑，不走chunkfilepool
     // 如果open操作携带create标志，则从chunkfilepool取，否则保持原来语意
     // 如果待打开的文件已经存在，则直接使用原有语意
-    if (!NeedFilter(path) &&
-        (oflag & O_CREAT) &&
-        false == lfs_->FileExists(path)) {
-        // 从chunkfile pool中取出chunk返回
-        int rc = chunkfilePool_->GetChunk(path, tempMetaPageContent);
-        // 如果从chunkfilepool中取失败，返回错误。
-        if (rc != 0) {
-            LOG(ERROR) << "get chunk from chunkfile pool failed!";
-            return NULL;
+    // 与leader协商好跳过全零page时，新创建或者被截断的chunk文件需要清零，
+    // 保证下载时跳过的全零page读出来为零
+    bool needZero = false;
+    bool zeroNewChunkFile = zeroNewChunkFile_.load(std::memory_order_acquire);
+    if (!NeedFilter(path) && (oflag & O_CREAT)) {
+        if (false == lfs_->FileExists(path)) {
+            // 从chunkfile pool中取出chunk返回
+            int rc = chunkfilePool_->GetChunk(path, tempMetaPageContent);
+            // 如果从chunkfilepool中取失败，返回错误。
+            if (rc != 0) {
+                LOG(ERROR) << "get chunk from chunkfile pool failed!";
+                return NULL;
+            } else {
+                oflag &= (~O_CREAT);
+                oflag &= (~O_TRUNC);
+            }
+            needZero = zeroNewChunkFile;
         } else {
-            oflag &= (~O_CREAT);
-            oflag &= (~O_TRUNC);
+            needZero = zeroNewChunkFile && (oflag & O_TRUNC);
         }
     }
 
@@ -110,10 +123,46 @@ braft::FileAdaptor* CurveFilesystemAdaptor::open(const std::string& path,
     if (cloexec && !local_s_support_cloexec_on_open) {
         butil::make_close_on_exec(fd);
     }
+    if (needZero && ZeroChunkFile(fd, path) != 0) {
+        lfs_->Close(fd);
+        if (e) {
+            *e = butil::File::FILE_ERROR_IO;
+        }
+        return NULL;
+    }
 
     return new CurveFileAdaptor(fd);
 }
 
+int CurveFilesystemAdaptor::ZeroChunkFile(int fd, const std::string& path) {
+    const ChunkfilePoolOptions& opt = chunkfilePool_->GetChunkFilePoolOpt();
+    uint64_t size = opt.chunkSize + opt.metaPageSize;
+    // 优先使用zero range，只修改元数据，不需要真正写盘
+    if (lfs_->Fallocate(fd, FALLOC_FL_ZERO_RANGE, 0, size) == 0) {
+        return 0;
+    }
+
+    // 文件系统不支持zero range时退化为写零
+    LOG(WARNING) << "zero range chunkfile failed, fallback to write zero, "
+                 << "filename = " << path << ", errno = " << errno;
+    const uint64_t kZeroBufSize = 1024 * 1024;
+    std::unique_ptr<char[]> zero(new (std::nothrow) char[kZeroBufSize]);
+    if (zero == nullptr) {
+        LOG(ERROR) << "allocate zero buffer failed, filename = " << path;
+        return -1;
+    }
+    memset(zero.get(), 0, kZeroBufSize);
+    for (uint64_t offset = 0; offset < size; offset += kZeroBufSize) {
+        int len = static_cast<int>(std::min(kZeroBufSize, size - offset));
+        if (lfs_->Write(fd, zero.get(), offset, len) != len) {
+            LOG(ERROR) << "write zero to chunkfile failed, filename = "
+                       << path << ", errno = " << errno;
+            return -1;
+        }
+    }
+    return 0;
+}
+
 bool CurveFilesystemAdaptor::delete_file(const std::string& path,
                                                 bool recursive) {
     // 1. 如果是目录且recursive=true，那么遍历目录内容回收
@@ -25,6 +25,7 @@
 #include <braft/file_system_adaptor.h>
 #include <google/protobuf/message.h>
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <vector>
@@ -125,6 +126,15 @@ class CurveFilesystemAdaptor : public braft::PosixFileSystemAdaptor {
     // 回收的时候也直接删除这些文件，不进入chunkfilepool
     void SetFilterList(const std::vector<std::string>& filter);
 
+    /**
+     * 设置open新建或者截断chunk文件时是否将其清零，由snapshot copier在与
+     * leader协商好跳过全零的page后开启，下载结束后关闭
+     * @param: zero 是否清零
+     */
+    void SetZeroNewChunkFile(bool zero) {
+        zeroNewChunkFile_.store(zero, std::memory_order_release);
+    }
+
  private:
    /**
     * 递归回收目录内容
@@ -138,6 +148,15 @@ class CurveFilesystemAdaptor : public braft::PosixFileSystemAdaptor {
      */
     bool NeedFilter(const std::string& filename);
 
+    /**
+     * 将新创建的chunk文件内容清零。chunkfilepool中回收的chunk可能残留旧数据，
+     * 而leader在下载时可能跳过全零的page，所以需要保证未传输的区间为零
+     * @param: fd 文件描述符
+     * @param: path 文件路径，用于打印日志
+     * @return: 成功返回0，否则返回-1
+     */
+    int ZeroChunkFile(int fd, const std::string& path);
+
  private:
     // 由于chunkfile pool获取新的chunk时需要传入metapage信息
     // 这里创建一个临时的metapage，其内容无关紧要，因为快照会覆盖这部分内容
@@ -150,6 +169,8 @@ class CurveFilesystemAdaptor : public braft::PosixFileSystemAdaptor {
     // 过滤名单，在当前vector中的文件名，都不从chunkfilepool中取文件
     // 回收的时候也直接删除这些文件，不进入chunkfilepool
     std::vector<std::string> filterList_;
+    // open新建或者截断chunk文件时是否将其清零
+    std::atomic<bool> zeroNewChunkFile_;
 };
 }  // namespace chunkserver
 }  // namespace curve
@@ -40,6 +40,7 @@
 //          Xiong,Kai(xiongkai@baidu.com)
 
 #include "src/chunkserver/raftsnapshot/curve_snapshot_copier.h"
+#include "src/chunkserver/raftsnapshot/curve_filesystem_adaptor.h"
 
 namespace curve {
 namespace chunkserver {
@@ -47,7 +48,8 @@ namespace chunkserver {
 CurveSnapshotCopier::CurveSnapshotCopier(CurveSnapshotStorage* storage,
                                          bool filter_before_copy_remote,
                                          braft::FileSystemAdaptor* fs,
-                                         braft::SnapshotThrottle* throttle)
+                                         braft::SnapshotThrottle* throttle,
+                                         int copy_concurrency)
     : _tid(INVALID_BTHREAD)
     , _cancelled(false)
     , _filter_before_copy_remote(filter_before_copy_remote)
@@ -57,6 +59,8 @@ CurveSnapshotCopier::CurveSnapshotCopier(CurveSnapshotStorage* storage,
     , _storage(storage)
     , _reader(NULL)
     , _cur_session(NULL)
+    , _copy_concurrency(copy_concurrency < 1 ? 1 : copy_concurrency)
+    , _skip_zero_page(false)
 {}
 
 CurveSnapshotCopier::~CurveSnapshotCopier() {
@@ -70,12 +74,26 @@ void *CurveSnapshotCopier::start_copy(void* arg) {
 }
 
 void CurveSnapshotCopier::copy() {
+    // 只有CurveFilesystemAdaptor能在创建chunk文件时将其清零
+    CurveFilesystemAdaptor* curveFs =
+        dynamic_cast<CurveFilesystemAdaptor*>(_fs);
     do {
         // 下载snapshot meta中记录的文件
         load_meta_table();
         if (!ok()) {
             break;
         }
+        // attach meta中带有leader是否支持跳过全零page的信息，
+        // 需要在下载chunk文件之前获取
+        load_attach_meta_table();
+        if (!ok()) {
+            break;
+        }
+        if (curveFs != nullptr &&
+            _remote_snapshot._attach_meta_table.skip_zero_page()) {
+            curveFs->SetZeroNewChunkFile(true);
+            _skip_zero_page = true;
+        }
         filter();
         if (!ok()) {
             break;
@@ -85,18 +103,22 @@ void CurveSnapshotCopier::copy() {
         for (size_t i = 0; i < files.size() && ok(); ++i) {
             copy_file(files[i]);
         }
-
-        // 下载snapshot attachment文件
-        load_attach_meta_table();
+        wait_all_files();
         if (!ok()) {
             break;
         }
+
+        // 下载snapshot attachment文件
         std::vector<std::string> attachFiles;
         _remote_snapshot.list_attach_files(&attachFiles);
         for (size_t i = 0; i < attachFiles.size() && ok(); ++i) {
             copy_file(attachFiles[i], true);
         }
+        wait_all_files();
     } while (0);
+    if (_skip_zero_page) {
+        curveFs->SetZeroNewChunkFile(false);
+    }
     if (!ok() && _writer && _writer->ok()) {
         LOG(WARNING) << "Fail to copy, error_code " << error_code()
                      << " error_msg " << error_cstr()
@@ -335,44 +357,75 @@ void CurveSnapshotCopier::copy_file(const std::string& filename, bool attch) {
     }
     braft::LocalFileMeta meta;
     _remote_snapshot.get_file_meta(filename, &meta);
+    // 下载窗口已满，先等待最早启动的文件下载完成。
+    // _copying_files只会在copy线程中修改，这里读取不需要加锁
+    while (ok() && _copying_files.size() >= _copy_concurrency) {
+        wait_oldest_file();
+    }
+    if (!ok()) {
+        return;
+    }
     std::unique_lock<braft::raft_mutex_t> lck(_mutex);
     if (_cancelled) {
         set_error(ECANCELED, "%s", berror(ECANCELED));
         return;
     }
+    // 告诉leader新建的chunk文件已经清零，可以跳过全零的page
+    std::string source = filename;
+    if (_skip_zero_page) {
+        source += SKIP_ZERO_PAGE_SUFFIX;
+    }
     scoped_refptr<braft::RemoteFileCopier::Session> session
-        = _copier.start_to_copy_to_file(filename, file_path, NULL);
+        = _copier.start_to_copy_to_file(source, file_path, NULL);
     if (session == NULL) {
         LOG(WARNING) << "Fail to copy " << filename
                      << " path: " << _writer->get_path();
         set_error(-1, "Fail to copy %s", filename.c_str());
         return;
     }
-    _cur_session = session.get();
+    CopyingFile file;
+    file.filename = filename;
+    file.file_path = file_path;
+    file.attach = attch;
+    file.meta = meta;
+    file.session = session;
+    _copying_files.push_back(file);
+}
+
+void CurveSnapshotCopier::wait_oldest_file() {
+    std::unique_lock<braft::raft_mutex_t> lck(_mutex);
+    if (_copying_files.empty()) {
+        return;
+    }
+    CopyingFile file = _copying_files.front();
     lck.unlock();
-    session->join();
+    file.session->join();
     lck.lock();
-    _cur_session = NULL;
+    _copying_files.pop_front();
     lck.unlock();
-    if (!session->status().ok()) {
+    // 之前的文件已经下载失败，writer会被丢弃，不再记录后续文件
+    if (!ok()) {
+        return;
+    }
+    if (!file.session->status().ok()) {
         // 如果是文件不存在，那么删除刚开始open的文件
-        if (session->status().error_code() == ENOENT) {
-            bool rc = _fs->delete_file(file_path, false);
+        if (file.session->status().error_code() == ENOENT) {
+            bool rc = _fs->delete_file(file.file_path, false);
             if (!rc) {
-                LOG(ERROR) << "Fail to delete file" << file_path
+                LOG(ERROR) << "Fail to delete file" << file.file_path
                            << " : " << ::berror(errno);
                 set_error(errno,
-                          "Fail to create delete file " + file_path);
+                          "Fail to create delete file " + file.file_path);
             }
             return;
         }
 
-        set_error(session->status().error_code(),
-                  session->status().error_cstr());
+        set_error(file.session->status().error_code(),
+                  file.session->status().error_cstr());
         return;
     }
     // 如果是attach file，那么不需要持久化file meta信息
-    if (!attch && _writer->add_file(filename, &meta) != 0) {
+    if (!file.attach && _writer->add_file(file.filename, &file.meta) != 0) {
         set_error(EIO, "Fail to add file to writer");
         return;
     }
@@ -382,6 +435,24 @@ void CurveSnapshotCopier::copy_file(const std::string& filename, bool attch) {
     }
 }
 
+void CurveSnapshotCopier::wait_all_files() {
+    while (true) {
+        {
+            BAIDU_SCOPED_LOCK(_mutex);
+            if (_copying_files.empty()) {
+                return;
+            }
+            // 已经出错，剩余的文件没有必要继续下载
+            if (!ok()) {
+                for (auto& file : _copying_files) {
+                    file.session->cancel();
+                }
+            }
+        }
+        wait_oldest_file();
+    }
+}
+
 std::string CurveSnapshotCopier::get_rfilename(const std::string& filename) {
     std::string rfilename;
     auto pos = filename.rfind("../");
@@ -414,6 +485,9 @@ void CurveSnapshotCopier::cancel() {
     if (_cur_session) {
         _cur_session->cancel();
     }
+    for (auto& file : _copying_files) {
+        file.session->cancel();
+    }
 }
 
 int CurveSnapshotCopier::init(const std::string& uri) {
@@ -43,6 +43,7 @@
 #define SRC_CHUNKSERVER_RAFTSNAPSHOT_CURVE_SNAPSHOT_COPIER_H_
 
 #include <braft/storage.h>
+#include <deque>
 #include <vector>
 #include <string>
 #include "src/chunkserver/raftsnapshot/curve_snapshot.h"
@@ -58,7 +59,8 @@ class CurveSnapshotCopier : public braft::SnapshotCopier {
     CurveSnapshotCopier(CurveSnapshotStorage* storage,
                         bool filter_before_copy_remote,
                         braft::FileSystemAdaptor* fs,
-                        braft::SnapshotThrottle* throttle);
+                        braft::SnapshotThrottle* throttle,
+                        int copy_concurrency = 1);
     ~CurveSnapshotCopier();
     virtual void cancel();
     virtual void join();
@@ -74,10 +76,24 @@ class CurveSnapshotCopier : public braft::SnapshotCopier {
     int filter_before_copy(CurveSnapshotWriter* writer,
                            braft::SnapshotReader* last_snapshot);
     void filter();
+    // 启动文件的下载，正在下载的文件个数达到并发上限时先等待最早的文件下载完成
     void copy_file(const std::string& filename, bool attach = false);
+    // 等待最早启动的文件下载完成，并将文件信息记录到writer中
+    void wait_oldest_file();
+    // 等待所有正在下载的文件完成，出错时取消剩余的下载
+    void wait_all_files();
     // 这里的filename是相对于快照目录的路径，为了先把文件下载到临时目录，需要把前面的..去掉
     std::string get_rfilename(const std::string& filename);
 
+    // 正在下载中的文件
+    struct CopyingFile {
+        std::string filename;
+        std::string file_path;
+        bool attach;
+        braft::LocalFileMeta meta;
+        scoped_refptr<braft::RemoteFileCopier::Session> session;
+    };
+
     braft::raft_mutex_t _mutex;
     bthread_t _tid;
     bool _cancelled;
@@ -88,6 +104,12 @@ class CurveSnapshotCopier : public braft::SnapshotCopier {
     CurveSnapshotStorage* _storage;
     braft::SnapshotReader* _reader;
     braft::RemoteFileCopier::Session* _cur_session;
+    // 同时下载的文件个数上限
+    size_t _copy_concurrency;
+    // 按启动顺序排列的正在下载的文件，由_mutex保护
+    std::deque<CopyingFile> _copying_files;
+    // 是否已与leader协商好跳过chunk文件中全零的page
+    bool _skip_zero_page;
     CurveSnapshot _remote_snapshot;
     braft::RemoteFileCopier _copier;
 };
@@ -44,7 +44,8 @@
 namespace curve {
 namespace chunkserver {
 
-CurveSnapshotAttachMetaTable::CurveSnapshotAttachMetaTable() {}
+CurveSnapshotAttachMetaTable::CurveSnapshotAttachMetaTable()
+    : _skip_zero_page(false) {}
 
 CurveSnapshotAttachMetaTable::~CurveSnapshotAttachMetaTable() {}
 
@@ -71,6 +72,7 @@ int CurveSnapshotAttachMetaTable::load_from_iobuf_as_remote(
         const CurveSnapshotPbAttachMeta::File& f = pb_attach_meta.files(i);
         _file_map[f.name()] = f.meta();
     }
+    _skip_zero_page = pb_attach_meta.skip_zero_page();
     return 0;
 }
 
@@ -84,6 +86,9 @@ int CurveSnapshotAttachMetaTable::save_to_iobuf_as_remote(
         *f->mutable_meta() = iter->second;
         f->mutable_meta()->clear_source();
     }
+    if (_skip_zero_page) {
+        pb_attach_meta.set_skip_zero_page(true);
+    }
     buf->clear();
     butil::IOBufAsZeroCopyOutputStream wrapper(buf);
     return pb_attach_meta.SerializeToZeroCopyStream(&wrapper) ? 0 : -1;
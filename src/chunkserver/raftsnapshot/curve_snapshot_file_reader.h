@@ -75,11 +75,15 @@ class CurveSnapshotAttachMetaTable {
     int load_from_iobuf_as_remote(const butil::IOBuf& buf);
     // serialize
     int save_to_iobuf_as_remote(butil::IOBuf* buf) const;
+    // leader是否支持下载chunk文件时跳过全零的page
+    void set_skip_zero_page(bool skip) { _skip_zero_page = skip; }
+    bool skip_zero_page() const { return _skip_zero_page; }
 
  private:
     typedef std::map<std::string, LocalFileMeta> Map;
     // file -> file meta
     Map    _file_map;
+    bool   _skip_zero_page;
 };
 
 class CurveSnapshotFileReader : public braft::LocalDirReader {
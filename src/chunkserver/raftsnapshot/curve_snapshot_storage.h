@@ -86,6 +86,13 @@ friend class CurveSnapshotCopier;
         _addr = server_addr;
     }
     static bool has_server_addr() { return _addr != butil::EndPoint(); }
+    /**
+     * 设置install snapshot时同时下载的文件个数
+     * @param: concurrency 并发下载的文件个数，小于1时按1处理
+     */
+    static void set_copy_concurrency(int concurrency) {
+        _copy_concurrency = concurrency < 1 ? 1 : concurrency;
+    }
 
  private:
     braft::SnapshotWriter* create(bool from_empty) WARN_UNUSED_RESULT;
@@ -102,6 +109,7 @@ friend class CurveSnapshotCopier;
     scoped_refptr<braft::FileSystemAdaptor> _fs;
     scoped_refptr<braft::SnapshotThrottle> _snapshot_throttle;
     static butil::EndPoint _addr;
+    static int _copy_concurrency;
 };
 
 }  // namespace chunkserver
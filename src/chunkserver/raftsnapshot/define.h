@@ -36,6 +36,9 @@ const char RAFT_SNAP_DIR[] = "raft_snapshot";
 const char RAFT_LOG_DIR[]  = "log";
 #define BRAFT_SNAPSHOT_PATTERN "snapshot_%020" PRId64
 #define BRAFT_SNAPSHOT_ATTACH_META_FILE "__raft_snapshot_attach_meta"
+// install snapshot时follower在下载的文件名后加上该后缀，表示自己已经将新建的
+// chunk文件清零，leader可以跳过全零的page
+const char SKIP_ZERO_PAGE_SUFFIX[] = "@skip_zero_page";
 
 }  // namespace chunkserver
 }  // namespace curve
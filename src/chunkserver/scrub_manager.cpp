@@ -0,0 +1,434 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include <brpc/channel.h>
+#include <brpc/controller.h>
+#include <butil/time.h>
+#include <glog/logging.h>
+
+#include <algorithm>
+
+#include "src/chunkserver/scrub_manager.h"
+#include "src/chunkserver/copyset_node_manager.h"
+#include "src/chunkserver/chunkserver_metrics.h"
+#include "proto/chunk.pb.h"
+
+namespace curve {
+namespace chunkserver {
+
+// 每次向其他副本获取hash的chunk个数
+static const size_t kScrubBatchChunkNum = 16;
+// 在固定的applied index上重新比较可疑chunk的最大次数
+static const uint32_t kScrubConfirmRetryTimes = 3;
+
+ScrubThrottle::ScrubThrottle(uint64_t maxBytesPerSec,
+                             uint64_t minBytesPerSec,
+                             uint64_t latencyThresholdUs)
+    : maxBytesPerSec_(maxBytesPerSec),
+      minBytesPerSec_(std::min(minBytesPerSec, maxBytesPerSec)),
+      latencyThresholdUs_(latencyThresholdUs),
+      bytesPerSec_(maxBytesPerSec) {}
+
+void ScrubThrottle::Adjust(int64_t latencyUs) {
+    if (latencyUs > static_cast<int64_t>(latencyThresholdUs_)) {
+        bytesPerSec_ = std::max(minBytesPerSec_, bytesPerSec_ / 2);
+    } else {
+        uint64_t step = std::max<uint64_t>(1, maxBytesPerSec_ / 10);
+        bytesPerSec_ = std::min(maxBytesPerSec_, bytesPerSec_ + step);
+    }
+}
+
+uint64_t ScrubThrottle::GetCostUs(uint64_t bytes) const {
+    // 速率为0表示不限速
+    if (bytesPerSec_ == 0) {
+        return 0;
+    }
+    return bytes * 1000000 / bytesPerSec_;
+}
+
+ScrubManager::ScrubManager() : scrubbedBytes_(0), isStop_(true) {}
+
+int ScrubManager::Init(const ScrubOptions& options) {
+    if (options.copysetNodeManager == nullptr) {
+        LOG(ERROR) << "Init scrub manager failed, copyset node manager is null";
+        return -1;
+    }
+    options_ = options;
+    throttle_.reset(new ScrubThrottle(options.maxBytesPerSec,
+                                      options.minBytesPerSec,
+                                      options.latencyThresholdUs));
+    return 0;
+}
+
+int ScrubManager::Run() {
+    if (!options_.enable) {
+        LOG(INFO) << "Scrub is disabled.";
+        return 0;
+    }
+
+    if (isStop_.exchange(false)) {
+        scrubThread_ = Thread(&ScrubManager::ScrubInterval, this);
+        LOG(INFO) << "Start scrub thread ok.";
+        return 0;
+    }
+
+    return -1;
+}
+
+int ScrubManager::Fini() {
+    if (!isStop_.exchange(true)) {
+        LOG(INFO) << "stop scrub manager...";
+        sleeper_.interrupt();
+        scrubThread_.join();
+    }
+    LOG(INFO) << "stop scrub manager ok.";
+    return 0;
+}
+
+void ScrubManager::ScrubInterval() {
+    while (sleeper_.wait_for(std::chrono::seconds(options_.intervalSec))) {
+        std::vector<CopysetNodePtr> nodes;
+        options_.copysetNodeManager->GetAllCopysetNodes(&nodes);
+
+        std::set<GroupNid> groups;
+        for (auto& node : nodes) {
+            if (isStop_.load()) {
+                return;
+            }
+            groups.insert(ToGroupNid(node->GetLogicPoolId(),
+                                     node->GetCopysetId()));
+            ScrubCopyset(node->GetLogicPoolId(), node->GetCopysetId());
+        }
+
+        // 已经不在本chunkserver上的copyset不再上报
+        LockGuard lockGuard(mtx_);
+        for (auto iter = inconsistentChunks_.begin();
+             iter != inconsistentChunks_.end();) {
+            if (groups.count(iter->first) == 0) {
+                iter = inconsistentChunks_.erase(iter);
+            } else {
+                ++iter;
+            }
+        }
+    }
+}
+
+void ScrubManager::ScrubCopyset(const LogicPoolID& logicPoolId,
+                                const CopysetID& copysetId) {
+    GroupNid groupId = ToGroupNid(logicPoolId, copysetId);
+    auto node = options_.copysetNodeManager->GetCopysetNode(logicPoolId,
+                                                            copysetId);
+    // 只有leader负责巡检和上报，避免同一个copyset被重复读取
+    if (node == nullptr || !node->IsLeaderTerm()) {
+        LockGuard lockGuard(mtx_);
+        inconsistentChunks_.erase(groupId);
+        return;
+    }
+
+    std::vector<Peer> peers;
+    node->ListPeers(&peers);
+    PeerId leaderId = node->GetLeaderId();
+    std::vector<PeerId> others;
+    for (const auto& peer : peers) {
+        PeerId peerId;
+        if (peerId.parse(peer.address()) != 0) {
+            LOG(ERROR) << "Scrub copyset " << ToGroupIdString(logicPoolId,
+                                                              copysetId)
+                       << " failed, invalid peer: " << peer.address();
+            return;
+        }
+        if (peerId.addr == leaderId.addr) {
+            continue;
+        }
+        others.push_back(peerId);
+    }
+    if (others.empty()) {
+        return;
+    }
+
+    std::vector<ChunkID> chunkIds;
+    node->GetDataStore()->GetChunkIds(&chunkIds);
+    std::set<ChunkID> inconsistent;
+    for (size_t i = 0; i < chunkIds.size(); i += kScrubBatchChunkNum) {
+        if (isStop_.load()) {
+            return;
+        }
+        size_t end = std::min(chunkIds.size(), i + kScrubBatchChunkNum);
+        std::vector<ChunkID> batch(chunkIds.begin() + i,
+                                   chunkIds.begin() + end);
+        int ret = CompareChunks(logicPoolId, copysetId,
+                                node->GetDataStore(), others, batch,
+                                &inconsistent);
+        if (ret != 0) {
+            // 本轮巡检没有完成，保留上一轮的结果
+            LOG(WARNING) << "Scrub copyset "
+                         << ToGroupIdString(logicPoolId, copysetId)
+                         << " stopped at chunk " << batch.front();
+            return;
+        }
+    }
+
+    if (!inconsistent.empty()) {
+        LOG(ERROR) << "Scrub found " << inconsistent.size()
+                   << " inconsistent chunks in copyset "
+                   << ToGroupIdString(logicPoolId, copysetId);
+    }
+    LockGuard lockGuard(mtx_);
+    if (inconsistent.empty()) {
+        inconsistentChunks_.erase(groupId);
+    } else {
+        inconsistentChunks_[groupId] = std::move(inconsistent);
+    }
+}
+
+int ScrubManager::CompareChunks(const LogicPoolID& logicPoolId,
+                                const CopysetID& copysetId,
+                                std::shared_ptr<CSDataStore> datastore,
+                                const std::vector<PeerId>& peers,
+                                const std::vector<ChunkID>& chunkIds,
+                                std::set<ChunkID>* inconsistentChunks) {
+    if (chunkIds.empty()) {
+        return 0;
+    }
+
+    std::vector<ChunkID> suspects;
+    int ret = FindInconsistentChunks(logicPoolId, copysetId, datastore,
+                                     peers, chunkIds, 0, &suspects);
+    if (ret != 0) {
+        return -1;
+    }
+
+    // 正在写入的chunk在各个副本上apply的进度不同，hash可能暂时不一致，
+    // 逐个在固定的applied index上重新比较，此时仍不一致才是数据不一致
+    for (auto chunkId : suspects) {
+        ret = -1;
+        std::vector<ChunkID> confirmed;
+        for (uint32_t i = 0; i < kScrubConfirmRetryTimes; ++i) {
+            if (isStop_.load()) {
+                return -1;
+            }
+            uint64_t appliedIndex = GetAppliedIndex(logicPoolId, copysetId);
+            ret = FindInconsistentChunks(logicPoolId, copysetId, datastore,
+                                         peers, {chunkId}, appliedIndex,
+                                         &confirmed);
+            if (ret <= 0) {
+                break;
+            }
+        }
+        if (ret < 0) {
+            return -1;
+        } else if (ret > 0) {
+            // 写入一直没有停止，本轮无法确认，留到下一轮巡检
+            LOG(WARNING) << "Scrub can not compare chunk " << chunkId
+                         << " at a fixed applied index in copyset "
+                         << ToGroupIdString(logicPoolId, copysetId);
+            continue;
+        }
+        for (auto id : confirmed) {
+            LOG(ERROR) << "Scrub found inconsistent chunk " << id
+                       << " in copyset "
+                       << ToGroupIdString(logicPoolId, copysetId);
+            inconsistentChunks->insert(id);
+        }
+    }
+    return 0;
+}
+
+int ScrubManager::FindInconsistentChunks(
+    const LogicPoolID& logicPoolId,
+    const CopysetID& copysetId,
+    std::shared_ptr<CSDataStore> datastore,
+    const std::vector<PeerId>& peers,
+    const std::vector<ChunkID>& chunkIds,
+    uint64_t appliedIndex,
+    std::vector<ChunkID>* inconsistentChunks) {
+    std::map<ChunkID, std::string> localHashes;
+    int ret = GetLocalChunkHash(logicPoolId, copysetId, datastore, chunkIds,
+                                appliedIndex, &localHashes);
+    if (ret != 0) {
+        return ret;
+    }
+
+    // 本地不存在的chunk跳过了计算，只在副本上存在时同样认为不一致，
+    // 限定在本次请求的chunk中，范围内的其他chunk留给它们所在的批次比较
+    std::set<ChunkID> requested(chunkIds.begin(), chunkIds.end());
+    std::set<ChunkID> inconsistent;
+    for (const auto& peer : peers) {
+        std::map<ChunkID, std::string> peerHashes;
+        ret = GetPeerChunkHash(peer, logicPoolId, copysetId,
+                               chunkIds.front(), chunkIds.back() + 1,
+                               appliedIndex, &peerHashes);
+        if (ret != 0) {
+            return ret;
+        }
+        for (const auto& item : localHashes) {
+            auto iter = peerHashes.find(item.first);
+            if (iter == peerHashes.end() || iter->second != item.second) {
+                inconsistent.insert(item.first);
+            }
+        }
+        for (const auto& item : peerHashes) {
+            if (requested.count(item.first) > 0 &&
+                localHashes.count(item.first) == 0) {
+                inconsistent.insert(item.first);
+            }
+        }
+    }
+    inconsistentChunks->assign(inconsistent.begin(), inconsistent.end());
+    return 0;
+}
+
+int ScrubManager::GetLocalChunkHash(const LogicPoolID& logicPoolId,
+                                    const CopysetID& copysetId,
+                                    std::shared_ptr<CSDataStore> datastore,
+                                    const std::vector<ChunkID>& chunkIds,
+                                    uint64_t appliedIndex,
+                                    std::map<ChunkID, std::string>* hashes) {
+    for (auto chunkId : chunkIds) {
+        throttle_->Adjust(GetForegroundLatencyUs());
+        uint64_t startUs = butil::gettimeofday_us();
+        std::string hash;
+        CSErrorCode errorCode =
+            datastore->GetChunkHash(chunkId, 0, options_.chunkSize, &hash);
+        if (errorCode == CSErrorCode::ChunkNotExistError) {
+            // 巡检过程中chunk被删除，不需要比较
+            continue;
+        } else if (errorCode != CSErrorCode::Success) {
+            LOG(ERROR) << "Scrub get hash of chunk " << chunkId
+                       << " failed, error code: " << errorCode;
+            return -1;
+        }
+        scrubbedBytes_.fetch_add(options_.chunkSize);
+        // 读取期间有新的apply，本地的hash不对应于appliedIndex
+        bool applied = appliedIndex > 0 &&
+            GetAppliedIndex(logicPoolId, copysetId) != appliedIndex;
+
+        // 按照当前的巡检速率等待，避免影响前台IO
+        uint64_t costUs = throttle_->GetCostUs(options_.chunkSize);
+        uint64_t elapsedUs = butil::gettimeofday_us() - startUs;
+        if (costUs > elapsedUs &&
+            !sleeper_.wait_for(std::chrono::microseconds(costUs - elapsedUs))) {
+            return -1;
+        }
+        if (applied) {
+            return 1;
+        }
+        (*hashes)[chunkId] = hash;
+    }
+    return 0;
+}
+
+int ScrubManager::GetPeerChunkHash(const PeerId& peer,
+                                   const LogicPoolID& logicPoolId,
+                                   const CopysetID& copysetId,
+                                   ChunkID beginId,
+                                   ChunkID endId,
+                                   uint64_t appliedIndex,
+                                   std::map<ChunkID, std::string>* hashes) {
+    brpc::Channel channel;
+    if (channel.Init(peer.addr, NULL) != 0) {
+        LOG(ERROR) << "Scrub init channel to " << peer.addr << " failed";
+        return -1;
+    }
+    ChunkService_Stub stub(&channel);
+    GetCopysetHashRequest request;
+    request.set_logicpoolid(logicPoolId);
+    request.set_copysetid(copysetId);
+    request.set_beginchunkid(beginId);
+    request.set_endchunkid(endId);
+    request.set_withchunkhash(true);
+    // 副本按照本地当前的巡检速率读盘，前台IO繁忙降速时副本也随之降速
+    request.set_maxbytespersec(throttle_->GetBytesPerSec());
+    if (appliedIndex > 0) {
+        request.set_appliedindex(appliedIndex);
+    }
+    // 副本单次计算的chunk个数有上限，返回nextChunkId时继续请求剩余的部分
+    while (true) {
+        brpc::Controller cntl;
+        cntl.set_timeout_ms(options_.rpcTimeoutMs);
+        GetCopysetHashResponse response;
+        stub.GetCopysetHash(&cntl, &request, &response, nullptr);
+        if (cntl.Failed()) {
+            LOG(WARNING) << "Scrub get copyset hash from " << peer.addr
+                         << " failed, " << cntl.ErrorText();
+            return -1;
+        }
+        if (response.status() != CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS) {
+            LOG(WARNING) << "Scrub get copyset hash from " << peer.addr
+                         << " failed, status: " << response.status();
+            return -1;
+        }
+        // 副本没有在指定的applied index上计算hash，由调用方重试
+        if (appliedIndex > 0 && (!response.has_appliedindex() ||
+                                 response.appliedindex() != appliedIndex)) {
+            return 1;
+        }
+        for (const auto& chunkHash : response.chunkhashes()) {
+            (*hashes)[chunkHash.chunkid()] = chunkHash.hash();
+        }
+        if (!response.has_nextchunkid()) {
+            break;
+        }
+        if (isStop_.load()) {
+            return -1;
+        }
+        request.set_beginchunkid(response.nextchunkid());
+    }
+    return 0;
+}
+
+uint64_t ScrubManager::GetAppliedIndex(const LogicPoolID& logicPoolId,
+                                       const CopysetID& copysetId) {
+    auto node = options_.copysetNodeManager->GetCopysetNode(logicPoolId,
+                                                            copysetId);
+    if (node == nullptr) {
+        return 0;
+    }
+    return node->GetAppliedIndex();
+}
+
+int64_t ScrubManager::GetForegroundLatencyUs() {
+    int64_t latencyUs = 0;
+    ChunkServerMetric* metric = ChunkServerMetric::GetInstance();
+    for (auto type : {CSIOMetricType::READ_CHUNK,
+                      CSIOMetricType::WRITE_CHUNK}) {
+        IOMetricPtr ioMetric = metric->GetIOMetric(type);
+        if (ioMetric != nullptr) {
+            latencyUs = std::max(
+                latencyUs, ioMetric->latencyRecorder_.latency_percentile(0.99));
+        }
+    }
+    return latencyUs;
+}
+
+void ScrubManager::GetInconsistentChunks(const LogicPoolID& logicPoolId,
+                                         const CopysetID& copysetId,
+                                         std::vector<ChunkID>* chunkIds) {
+    LockGuard lockGuard(mtx_);
+    auto iter = inconsistentChunks_.find(ToGroupNid(logicPoolId, copysetId));
+    if (iter != inconsistentChunks_.end()) {
+        chunkIds->assign(iter->second.begin(), iter->second.end());
+    }
+}
+
+}  // namespace chunkserver
+}  // namespace curve
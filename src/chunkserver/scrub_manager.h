@@ -0,0 +1,247 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#ifndef SRC_CHUNKSERVER_SCRUB_MANAGER_H_
+#define SRC_CHUNKSERVER_SCRUB_MANAGER_H_
+
+#include <braft/raft.h>
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "include/chunkserver/chunkserver_common.h"
+#include "src/chunkserver/datastore/chunkserver_datastore.h"
+#include "src/common/concurrent/concurrent.h"
+#include "src/common/interruptible_sleeper.h"
+
+using ::curve::common::Thread;
+using ::curve::common::Atomic;
+using ::curve::common::Mutex;
+using ::curve::common::LockGuard;
+using ::curve::common::InterruptibleSleeper;
+
+namespace curve {
+namespace chunkserver {
+
+class CopysetNodeManager;
+
+struct ScrubOptions {
+    // 是否开启后台巡检
+    bool enable;
+    // 两轮巡检之间的间隔
+    uint32_t intervalSec;
+    // 巡检读盘的最大速率
+    uint64_t maxBytesPerSec;
+    // 巡检读盘的最小速率
+    uint64_t minBytesPerSec;
+    // 前台IO的p99延时超过该值时降低巡检速率
+    uint64_t latencyThresholdUs;
+    // 向其他副本获取chunk hash的rpc超时时间
+    uint32_t rpcTimeoutMs;
+    // chunk的大小
+    uint32_t chunkSize;
+
+    CopysetNodeManager* copysetNodeManager;
+
+    ScrubOptions() : enable(false)
+                   , intervalSec(86400)
+                   , maxBytesPerSec(8 * 1024 * 1024)
+                   , minBytesPerSec(1024 * 1024)
+                   , latencyThresholdUs(20000)
+                   , rpcTimeoutMs(60000)
+                   , chunkSize(16 * 1024 * 1024)
+                   , copysetNodeManager(nullptr) {}
+};
+
+/**
+ * 巡检读盘的限速，根据前台IO的延时调整：
+ * 延时超过阈值时速率减半，否则每次增加最大速率的1/10，
+ * 速率始终在[minBytesPerSec, maxBytesPerSec]之间
+ */
+class ScrubThrottle {
+ public:
+    ScrubThrottle(uint64_t maxBytesPerSec,
+                  uint64_t minBytesPerSec,
+                  uint64_t latencyThresholdUs);
+
+    /**
+     * 根据前台IO最近的延时调整巡检速率
+     * @param latencyUs: 前台IO的p99延时
+     */
+    void Adjust(int64_t latencyUs);
+
+    /**
+     * 按照当前速率读取指定大小的数据需要的时间
+     * @param bytes: 读取的数据量
+     * @return: 需要的时间，单位us
+     */
+    uint64_t GetCostUs(uint64_t bytes) const;
+
+    uint64_t GetBytesPerSec() const {
+        return bytesPerSec_;
+    }
+
+ private:
+    uint64_t maxBytesPerSec_;
+    uint64_t minBytesPerSec_;
+    uint64_t latencyThresholdUs_;
+    uint64_t bytesPerSec_;
+};
+
+/**
+ * 后台巡检，定期遍历本chunkserver上为leader的copyset，
+ * 读取chunk计算crc并和其他副本上的crc比较，
+ * 不一致的chunk通过心跳上报给mds
+ */
+class ScrubManager {
+ public:
+    ScrubManager();
+    virtual ~ScrubManager() = default;
+
+    int Init(const ScrubOptions& options);
+
+    int Run();
+
+    int Fini();
+
+    /**
+     * 巡检一个copyset，只有leader会进行巡检，由巡检线程调用
+     * @param logicPoolId: copyset所属逻辑池的id
+     * @param copysetId: copyset的id
+     */
+    void ScrubCopyset(const LogicPoolID& logicPoolId,
+                      const CopysetID& copysetId);
+
+    /**
+     * 比较本地和其他副本上chunk的hash，为了排除正在写入的chunk的干扰，
+     * 不一致的chunk会在固定的applied index上重新比较，
+     * 写入一直没有停止而无法确认的chunk不认为不一致
+     * @param logicPoolId: copyset所属逻辑池的id
+     * @param copysetId: copyset的id
+     * @param datastore: copyset的datastore
+     * @param peers: 除了本地以外的其他副本
+     * @param chunkIds: 需要比较的chunk，按照id从小到大排列
+     * @param[out] inconsistentChunks: 不一致的chunk
+     * @return: 成功返回0，本地读取或rpc失败返回-1
+     */
+    int CompareChunks(const LogicPoolID& logicPoolId,
+                      const CopysetID& copysetId,
+                      std::shared_ptr<CSDataStore> datastore,
+                      const std::vector<PeerId>& peers,
+                      const std::vector<ChunkID>& chunkIds,
+                      std::set<ChunkID>* inconsistentChunks);
+
+    /**
+     * 获取copyset中最近一次巡检发现的不一致的chunk，用于心跳上报
+     * @param logicPoolId: copyset所属逻辑池的id
+     * @param copysetId: copyset的id
+     * @param[out] chunkIds: 不一致的chunk
+     */
+    void GetInconsistentChunks(const LogicPoolID& logicPoolId,
+                               const CopysetID& copysetId,
+                               std::vector<ChunkID>* chunkIds);
+
+    uint64_t GetScrubbedBytes() const {
+        return scrubbedBytes_.load();
+    }
+
+ protected:
+    /**
+     * 获取其他副本上[beginId, endId)范围内每个chunk的hash，
+     * 副本按照本地当前的巡检速率读盘
+     * @param peer: 副本的地址
+     * @param appliedIndex: 要求副本在该applied index上计算，0表示不要求
+     * @param[out] hashes: chunk id到hash的映射，副本上不存在的chunk不会返回
+     * @return: 成功返回0，失败返回-1，副本没有在appliedIndex上计算返回1
+     */
+    virtual int GetPeerChunkHash(const PeerId& peer,
+                                 const LogicPoolID& logicPoolId,
+                                 const CopysetID& copysetId,
+                                 ChunkID beginId,
+                                 ChunkID endId,
+                                 uint64_t appliedIndex,
+                                 std::map<ChunkID, std::string>* hashes);
+
+    /**
+     * 获取本地copyset当前的applied index，copyset不存在返回0
+     */
+    virtual uint64_t GetAppliedIndex(const LogicPoolID& logicPoolId,
+                                     const CopysetID& copysetId);
+
+    /**
+     * 获取前台读写IO的p99延时，用于调整巡检速率
+     */
+    virtual int64_t GetForegroundLatencyUs();
+
+ private:
+    void ScrubInterval();
+
+    /**
+     * 计算本地chunk的hash，并按照限速等待，等待期间停止巡检会返回失败，
+     * appliedIndex不为0时读取期间有新的apply返回1
+     */
+    int GetLocalChunkHash(const LogicPoolID& logicPoolId,
+                          const CopysetID& copysetId,
+                          std::shared_ptr<CSDataStore> datastore,
+                          const std::vector<ChunkID>& chunkIds,
+                          uint64_t appliedIndex,
+                          std::map<ChunkID, std::string>* hashes);
+
+    /**
+     * 找出本地和其他副本上hash不一致的chunk，包括只在一方存在的chunk，
+     * appliedIndex不为0时要求各个副本都在该applied index上计算，否则返回1
+     */
+    int FindInconsistentChunks(const LogicPoolID& logicPoolId,
+                               const CopysetID& copysetId,
+                               std::shared_ptr<CSDataStore> datastore,
+                               const std::vector<PeerId>& peers,
+                               const std::vector<ChunkID>& chunkIds,
+                               uint64_t appliedIndex,
+                               std::vector<ChunkID>* inconsistentChunks);
+
+ private:
+    ScrubOptions options_;
+
+    std::unique_ptr<ScrubThrottle> throttle_;
+
+    // copyset -> 最近一次巡检发现的不一致的chunk
+    std::map<GroupNid, std::set<ChunkID>> inconsistentChunks_;
+    Mutex mtx_;
+
+    // 巡检读取的数据量
+    Atomic<uint64_t> scrubbedBytes_;
+
+    Thread scrubThread_;
+
+    // false-开始后台任务，true-停止后台任务
+    Atomic<bool> isStop_;
+
+    InterruptibleSleeper sleeper_;
+};
+
+}  // namespace chunkserver
+}  // namespace curve
+
+#endif  // SRC_CHUNKSERVER_SCRUB_MANAGER_H_
@@ -36,6 +36,7 @@
 #include "src/client/request_closure.h"
 #include "src/client/request_context.h"
 #include "src/client/io_tracker.h"
+#include "src/client/request_tracer.h"
 
 // TODO(tongguangxun) :优化重试逻辑，将重试逻辑与RPC返回逻辑拆开
 namespace curve {
@@ -291,6 +292,13 @@ void ClientClosure::Run() {
         }
     }
 
+    // 统计采样请求的rpc耗时，请求结束时统计总耗时
+    RequestTracer::OnRpcReturn(reqCtx_, reqDone_->GetStartTime());
+    if (!needRetry) {
+        RequestTracer::OnFinish(reqCtx_, status_,
+                                reqDone_->GetRetriedTimes(), remoteAddress_);
+    }
+
     if (needRetry) {
         doneGuard.release();
         OnRetry();
@@ -412,6 +420,20 @@ void ClientClosure::OnRedirected() {
         }
     }
 
+    // follower read发往的副本不是leader，或者副本的appliedindex落后，
+    // leader信息没有变化，直接重试到leader即可
+    if (reqCtx_->optype_ == OpType::READ) {
+        ChunkServerID leaderId = 0;
+        butil::EndPoint leaderAddr;
+        if (0 == metaCache_->GetLeader(chunkIdInfo_.lpid_, chunkIdInfo_.cpid_,
+                                       &leaderId, &leaderAddr, false,
+                                       fileMetric_) &&
+            leaderId != chunkserverID_) {
+            retryDirectly_ = true;
+            return;
+        }
+    }
+
     RefreshLeader();
 }
 
@@ -502,6 +524,16 @@ void ClientClosure::OnInvalidRequest() {
 }
 
 void WriteChunkClosure::SendRetryRequest() {
+    if (!reqCtx_->writeData_.empty()) {
+        client_->WriteChunk(reqCtx_->idinfo_, reqCtx_->seq_,
+                            reqCtx_->writeData_,
+                            reqCtx_->offset_,
+                            reqCtx_->rawlength_,
+                            reqCtx_->sourceInfo_,
+                            done_);
+        return;
+    }
+
     client_->WriteChunk(reqCtx_->idinfo_, reqCtx_->seq_,
                         reqCtx_->writeBuffer_,
                         reqCtx_->offset_,
@@ -531,9 +563,17 @@ void ReadChunkClosure::SendRetryRequest() {
 void ReadChunkClosure::OnSuccess() {
     ClientClosure::OnSuccess();
 
-    cntl_->response_attachment().copy_to(
-        reqCtx_->readBuffer_,
-        cntl_->response_attachment().size());
+    if (!reqCtx_->readIov_.empty()) {
+        // 向量读直接将返回数据分散到用户的各个缓冲区中
+        butil::IOBuf& attachment = cntl_->response_attachment();
+        for (const auto& iov : reqCtx_->readIov_) {
+            attachment.cutn(iov.iov_base, iov.iov_len);
+        }
+    } else {
+        cntl_->response_attachment().copy_to(
+            reqCtx_->readBuffer_,
+            cntl_->response_attachment().size());
+    }
 
     metaCache_->UpdateAppliedIndex(
         reqCtx_->idinfo_.lpid_,
@@ -545,7 +585,13 @@ void ReadChunkClosure::OnChunkNotExist() {
     ClientClosure::OnChunkNotExist();
 
     reqDone_->SetFailed(0);
-    memset(reqCtx_->readBuffer_, 0, reqCtx_->rawlength_);
+    if (!reqCtx_->readIov_.empty()) {
+        for (const auto& iov : reqCtx_->readIov_) {
+            memset(iov.iov_base, 0, iov.iov_len);
+        }
+    } else {
+        memset(reqCtx_->readBuffer_, 0, reqCtx_->rawlength_);
+    }
     metaCache_->UpdateAppliedIndex(chunkIdInfo_.lpid_, chunkIdInfo_.cpid_,
                                    response_->appliedindex());
 }
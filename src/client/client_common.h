@@ -30,9 +30,11 @@
 #include <unistd.h>
 #include <string>
 #include <atomic>
+#include <mutex>  // NOLINT
 #include <vector>
 
 #include "include/client/libcurve.h"
+#include "src/client/config_info.h"
 #include "src/common/net_common.h"
 
 namespace curve {
@@ -117,6 +119,16 @@ typedef struct LeaseSession {
     uint64_t createTime;
 } LeaseSession_t;
 
+// 批量续约中一个文件的信息，mds通过parentId和文件名直接获取文件
+typedef struct LeaseRefreshItem {
+    std::string filename;
+    uint64_t fileId;
+    uint64_t parentId;
+    std::string sessionId;
+    // 当前持有的文件访问token，mds校验通过后返回新的token
+    std::string fileToken;
+} LeaseRefreshItem_t;
+
 // 保存logicalpool中segment对应的copysetid信息
 typedef struct LogicalPoolCopysetIDInfo {
     LogicPoolID lpid;
@@ -137,6 +149,34 @@ typedef struct SegmentInfo {
     LogicalPoolCopysetIDInfo lpcpIDInfo;
 } SegmentInfo_t;
 
+// 文件访问token，io线程读取时lease续约线程可能同时更新，需要加锁保护
+class FileToken {
+ public:
+    FileToken() = default;
+    FileToken(const FileToken& other) : token_(other.Get()) {}
+
+    FileToken& operator=(const FileToken& other) {
+        if (this != &other) {
+            Set(other.Get());
+        }
+        return *this;
+    }
+
+    std::string Get() const {
+        std::lock_guard<std::mutex> lk(mtx_);
+        return token_;
+    }
+
+    void Set(const std::string& token) {
+        std::lock_guard<std::mutex> lk(mtx_);
+        token_ = token;
+    }
+
+ private:
+    mutable std::mutex mtx_;
+    std::string token_;
+};
+
 typedef struct FInfo {
     uint64_t        id;
     uint64_t        parentid;
@@ -155,6 +195,11 @@ typedef struct FInfo {
     FileStatus      filestatus;
     std::string     cloneSource;
     uint64_t        cloneLength{0};
+    // 打开文件和续约时mds返回的token，之后通过inode id访问文件
+    FileToken       fileToken;
+    // mds中是否设置了文件的QoS限制
+    bool            hasThrottleParams{false};
+    FileThrottleOption_t throttleParams;
 
     FInfo() {
         id = 0;
@@ -59,6 +59,12 @@ int ClientConfig::Init(const char* configpath) {
     LOG_IF(ERROR, ret == false) << "config no chunkserver.enableAppliedIndexRead info";     // NOLINT
     RETURN_IF_FALSE(ret)
 
+    ret = conf_.GetBoolValue("chunkserver.enableFollowerRead",
+          &fileServiceOption_.ioOpt.ioSenderOpt.chunkserverEnableFollowerRead);
+    LOG_IF(WARNING, ret == false)
+        << "config no chunkserver.enableFollowerRead info, using default value "
+        << fileServiceOption_.ioOpt.ioSenderOpt.chunkserverEnableFollowerRead;
+
     ret = conf_.GetUInt32Value("chunkserver.opMaxRetry",
           &fileServiceOption_.ioOpt.ioSenderOpt.failRequestOpt.chunkserverOPMaxRetry);    // NOLINT
     LOG_IF(ERROR, ret == false) << "config no chunkserver.opMaxRetry info";
@@ -137,11 +143,59 @@ int ClientConfig::Init(const char* configpath) {
     LOG_IF(ERROR, ret == false) << "config no schedule.threadpoolSize info";
     RETURN_IF_FALSE(ret)
 
+    ret = conf_.GetBoolValue("schedule.enableRequestMerge",
+        &fileServiceOption_.ioOpt.reqSchdulerOpt.mergeOpt.enableRequestMerge);
+    LOG_IF(WARNING, ret == false)
+        << "config no schedule.enableRequestMerge info, using default value "
+        << fileServiceOption_.ioOpt.reqSchdulerOpt.mergeOpt.enableRequestMerge;
+
+    ret = conf_.GetUInt32Value("schedule.mergeMaxSizeKB",
+        &fileServiceOption_.ioOpt.reqSchdulerOpt.mergeOpt.mergeMaxSizeKB);
+    LOG_IF(WARNING, ret == false)
+        << "config no schedule.mergeMaxSizeKB info, using default value "
+        << fileServiceOption_.ioOpt.reqSchdulerOpt.mergeOpt.mergeMaxSizeKB;
+
+    ret = conf_.GetUInt32Value("schedule.mergeMaxRequestNum",
+        &fileServiceOption_.ioOpt.reqSchdulerOpt.mergeOpt.mergeMaxRequestNum);
+    LOG_IF(WARNING, ret == false)
+        << "config no schedule.mergeMaxRequestNum info, using default value "
+        << fileServiceOption_.ioOpt.reqSchdulerOpt.mergeOpt.mergeMaxRequestNum;
+
+    ret = conf_.GetUInt32Value("trace.sampleRate",
+        &fileServiceOption_.ioOpt.reqSchdulerOpt.traceOpt.sampleRate);
+    LOG_IF(WARNING, ret == false)
+        << "config no trace.sampleRate info, using default value "
+        << fileServiceOption_.ioOpt.reqSchdulerOpt.traceOpt.sampleRate;
+
+    ret = conf_.GetUInt64Value("trace.slowRequestThresholdUs",
+        &fileServiceOption_.ioOpt.reqSchdulerOpt.traceOpt.slowRequestThresholdUs);   // NOLINT
+    LOG_IF(WARNING, ret == false)
+        << "config no trace.slowRequestThresholdUs info, using default value "
+        << fileServiceOption_.ioOpt.reqSchdulerOpt.traceOpt.slowRequestThresholdUs;   // NOLINT
+
+    ret = conf_.GetUInt32Value("trace.slowRequestDumpNum",
+        &fileServiceOption_.ioOpt.reqSchdulerOpt.traceOpt.slowRequestDumpNum);
+    LOG_IF(WARNING, ret == false)
+        << "config no trace.slowRequestDumpNum info, using default value "
+        << fileServiceOption_.ioOpt.reqSchdulerOpt.traceOpt.slowRequestDumpNum;
+
     ret = conf_.GetUInt32Value("mds.refreshTimesPerLease",
         &fileServiceOption_.leaseOpt.mdsRefreshTimesPerLease);
     LOG_IF(ERROR, ret == false) << "config no mds.refreshTimesPerLease info";
     RETURN_IF_FALSE(ret)
 
+    ret = conf_.GetBoolValue("mds.enableBatchRefreshSession",
+        &fileServiceOption_.leaseOpt.enableBatchRefresh);
+    LOG_IF(WARNING, ret == false)
+        << "config no mds.enableBatchRefreshSession info, using default value "
+        << fileServiceOption_.leaseOpt.enableBatchRefresh;
+
+    ret = conf_.GetUInt32Value("mds.batchRefreshSessionMaxNum",
+        &fileServiceOption_.leaseOpt.batchRefreshMaxNum);
+    LOG_IF(WARNING, ret == false)
+        << "config no mds.batchRefreshSessionMaxNum info, using default value "
+        << fileServiceOption_.leaseOpt.batchRefreshMaxNum;
+
     fileServiceOption_.ioOpt.reqSchdulerOpt.ioSenderOpt
     = fileServiceOption_.ioOpt.ioSenderOpt;
 
@@ -156,6 +210,48 @@ int ClientConfig::Init(const char* configpath) {
     LOG_IF(ERROR, ret == false) << "config no isolation.taskThreadPoolSize info";   // NOLINT
     RETURN_IF_FALSE(ret)
 
+    ret = conf_.GetBoolValue("engine.enableShared",
+        &fileServiceOption_.ioOpt.engineOpt.enable);
+    LOG_IF(WARNING, ret == false)
+        << "config no engine.enableShared info, using default value "
+        << fileServiceOption_.ioOpt.engineOpt.enable;
+
+    ret = conf_.GetUInt32Value("engine.workerNum",
+        &fileServiceOption_.ioOpt.engineOpt.workerNum);
+    LOG_IF(WARNING, ret == false)
+        << "config no engine.workerNum info, using default value "
+        << fileServiceOption_.ioOpt.engineOpt.workerNum;
+
+    ret = conf_.GetUInt32Value("engine.quantum",
+        &fileServiceOption_.ioOpt.engineOpt.quantum);
+    LOG_IF(WARNING, ret == false)
+        << "config no engine.quantum info, using default value "
+        << fileServiceOption_.ioOpt.engineOpt.quantum;
+
+    ret = conf_.GetUInt64Value("throttle.iopsTotal",
+        &fileServiceOption_.ioOpt.throttleOpt.iopsTotal);
+    LOG_IF(WARNING, ret == false)
+        << "config no throttle.iopsTotal info, using default value "
+        << fileServiceOption_.ioOpt.throttleOpt.iopsTotal;
+
+    ret = conf_.GetUInt64Value("throttle.bpsTotal",
+        &fileServiceOption_.ioOpt.throttleOpt.bpsTotal);
+    LOG_IF(WARNING, ret == false)
+        << "config no throttle.bpsTotal info, using default value "
+        << fileServiceOption_.ioOpt.throttleOpt.bpsTotal;
+
+    ret = conf_.GetUInt64Value("throttle.iopsBurst",
+        &fileServiceOption_.ioOpt.throttleOpt.iopsBurst);
+    LOG_IF(WARNING, ret == false)
+        << "config no throttle.iopsBurst info, using default value "
+        << fileServiceOption_.ioOpt.throttleOpt.iopsBurst;
+
+    ret = conf_.GetUInt64Value("throttle.bpsBurst",
+        &fileServiceOption_.ioOpt.throttleOpt.bpsBurst);
+    LOG_IF(WARNING, ret == false)
+        << "config no throttle.bpsBurst info, using default value "
+        << fileServiceOption_.ioOpt.throttleOpt.bpsBurst;
+
     std::string metaAddr;
     ret = conf_.GetStringValue("mds.listen.addr", &metaAddr);
     LOG_IF(ERROR, ret == false) << "config no mds.listen.addr info";
@@ -150,6 +150,8 @@ struct MDSClientMetric {
     InterfaceMetric getFile;
     // RefreshSession接口统计信息
     InterfaceMetric refreshSession;
+    // BatchRefreshSession接口统计信息
+    InterfaceMetric batchRefreshSession;
     // GetServerList接口统计信息
     InterfaceMetric getServerList;
     // GetOrAllocateSegment接口统计信息
@@ -183,6 +185,7 @@ struct MDSClientMetric {
           closeFile(prefix, "closeFile"),
           getFile(prefix, "getFileInfo"),
           refreshSession(prefix, "refreshSession"),
+          batchRefreshSession(prefix, "batchRefreshSession"),
           getServerList(prefix, "getServerList"),
           getOrAllocateSegment(prefix, "getOrAllocateSegment"),
           renameFile(prefix, "renameFile"),
@@ -87,11 +87,18 @@ typedef struct MetaServerOption {
  *                           发送mdsRefreshTimesPerLease次心跳，如果连续失败，
  *                           那么client认为当前mds存在异常，会阻塞后续的IO，直到
  *                           续约成功。
+ * @enableBatchRefresh: 是否开启批量续约，开启后进程内所有文件由一个线程续约，
+ *                      同一owner的文件合并到一个rpc中
+ * @batchRefreshMaxNum: 一个批量续约rpc中最多包含的文件数
  */
 typedef struct LeaseOption {
     uint32_t mdsRefreshTimesPerLease;
+    bool enableBatchRefresh;
+    uint32_t batchRefreshMaxNum;
     LeaseOption() {
         mdsRefreshTimesPerLease = 5;
+        enableBatchRefresh = false;
+        batchRefreshMaxNum = 256;
     }
 } LeaseOption_t;
 
@@ -168,25 +175,72 @@ typedef struct FailureRequestOption {
 /**
  * 发送rpc给chunkserver的配置
  * @chunkserverEnableAppliedIndexRead: 是否开启使用appliedindex read
+ * @chunkserverEnableFollowerRead: 是否允许携带appliedindex的读请求
+ *                                 首次发送时轮流发往copyset的各个副本
  * @inflightOpt: 一个文件向chunkserver发送请求时的inflight 请求控制配置
  * @failRequestOpt: rpc发送失败之后，需要进行rpc重试的相关配置
  */
 typedef struct IOSenderOption {
     bool chunkserverEnableAppliedIndexRead;
+    bool chunkserverEnableFollowerRead;
     InFlightIOCntlInfo_t inflightOpt;
     FailureRequestOption_t failRequestOpt;
+    IOSenderOption() {
+        chunkserverEnableFollowerRead = false;
+    }
 } IOSenderOption_t;
 
+/**
+ * scheduler模块请求合并的配置信息，schedule线程从队列取出读写请求时，
+ * 会将队列中紧随其后的同一chunk上地址连续的同类型请求合并成一个rpc发送。
+ * 合并只针对已经在队列中排队的请求，不会为了等待合并而额外增加时延。
+ * @enableRequestMerge: 是否开启请求合并
+ * @mergeMaxSizeKB: 合并之后单个请求的最大长度
+ * @mergeMaxRequestNum: 单个合并请求最多包含的原始请求数量
+ */
+typedef struct RequestMergeOption {
+    bool enableRequestMerge;
+    uint32_t mergeMaxSizeKB;
+    uint32_t mergeMaxRequestNum;
+    RequestMergeOption() {
+        enableRequestMerge = false;
+        mergeMaxSizeKB = 64;
+        mergeMaxRequestNum = 32;
+    }
+} RequestMergeOption_t;
+
+/**
+ * 读写请求的采样trace配置，采样的请求携带trace id发送给chunkserver，
+ * client和chunkserver分别统计该请求在各阶段的耗时
+ * @sampleRate: 每sampleRate个读写请求采样一个，0表示不采样
+ * @slowRequestThresholdUs: 采样请求的总耗时超过该值时记为慢请求
+ * @slowRequestDumpNum: 通过metric导出的最近慢请求的个数
+ */
+typedef struct RequestTraceOption {
+    uint32_t sampleRate;
+    uint64_t slowRequestThresholdUs;
+    uint32_t slowRequestDumpNum;
+    RequestTraceOption() {
+        sampleRate = 0;
+        slowRequestThresholdUs = 100000;
+        slowRequestDumpNum = 64;
+    }
+} RequestTraceOption_t;
+
 /**
  * scheduler模块基本配置信息，schedule模块是用于分发用户请求，每个文件有自己的schedule
  * 线程池，线程池中的线程各自配置一个队列
  * @scheduleQueueCapacity: schedule模块配置的队列深度
  * @scheduleThreadpoolSize: schedule模块线程池大小
+ * @mergeOpt: 请求合并配置
+ * @traceOpt: 请求采样trace配置
  */
 typedef struct RequestScheduleOption {
     uint32_t scheduleQueueCapacity;
     uint32_t scheduleThreadpoolSize;
     IOSenderOption_t ioSenderOpt;
+    RequestMergeOption_t mergeOpt;
+    RequestTraceOption_t traceOpt;
     RequestScheduleOption() {
         scheduleQueueCapacity = 1024;
         scheduleThreadpoolSize = 2;
@@ -254,6 +308,52 @@ typedef struct TaskThreadOption {
     }
 } TaskThreadOption_t;
 
+/**
+ * 共享IO引擎配置信息，开启后进程内所有文件共用固定数量的调度线程、
+ * 隔离线程和一个lease续约定时器线程，线程数量不再随打开的文件数增长
+ * @enable: 是否开启共享IO引擎
+ * @workerNum: 调度线程和隔离线程的数量，0表示使用cpu核数
+ * @quantum: 调度线程每轮从一个文件的队列中最多取出的请求数，
+ *           文件之间按轮转的方式调度，保证公平
+ */
+typedef struct IOEngineOption {
+    bool        enable;
+    uint32_t    workerNum;
+    uint32_t    quantum;
+    IOEngineOption() {
+        enable = false;
+        workerNum = 0;
+        quantum = 32;
+    }
+} IOEngineOption_t;
+
+/**
+ * 文件的QoS限制，mds中的文件信息设置了限制时以mds为准
+ * @iopsTotal: 每秒允许下发的IO数量，0表示不限制
+ * @bpsTotal: 每秒允许下发的字节数，0表示不限制
+ * @iopsBurst: IO数量的突发上限，0表示等于iopsTotal
+ * @bpsBurst: 字节数的突发上限，0表示等于bpsTotal
+ */
+typedef struct FileThrottleOption {
+    uint64_t    iopsTotal;
+    uint64_t    bpsTotal;
+    uint64_t    iopsBurst;
+    uint64_t    bpsBurst;
+    FileThrottleOption() {
+        iopsTotal = 0;
+        bpsTotal = 0;
+        iopsBurst = 0;
+        bpsBurst = 0;
+    }
+
+    bool operator==(const FileThrottleOption& other) const {
+        return iopsTotal == other.iopsTotal &&
+               bpsTotal == other.bpsTotal &&
+               iopsBurst == other.iopsBurst &&
+               bpsBurst == other.bpsBurst;
+    }
+} FileThrottleOption_t;
+
 /**
  * IOOption存储了当前io 操作所需要的所有配置信息
  */
@@ -263,6 +363,8 @@ typedef struct IOOption {
     MetaCacheOption_t       metaCacheOpt;
     TaskThreadOption_t      taskThreadOpt;
     RequestScheduleOption_t reqSchdulerOpt;
+    IOEngineOption_t        engineOpt;
+    FileThrottleOption_t    throttleOpt;
 } IOOption_t;
 
 /**
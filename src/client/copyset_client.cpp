@@ -23,6 +23,8 @@
 #include "src/client/copyset_client.h"
 
 #include <glog/logging.h>
+#include <bthread/unstable.h>
+#include <butil/time.h>
 #include <unistd.h>
 #include <memory>
 #include <utility>
@@ -36,6 +38,10 @@
 using google::protobuf::Closure;
 namespace curve {
 namespace client {
+
+// 写请求的数据由上层管理，IOBuf释放时不需要做任何处理
+static void EmptyDeleter(void* ptr) {}
+
 int CopysetClient::Init(MetaCache *metaCache,
     const IOSenderOption_t& ioSenderOpt, RequestScheduler* scheduler,
     FileMetric* fileMetric) {
@@ -82,6 +88,21 @@ bool CopysetClient::FetchLeader(LogicPoolID lpid, CopysetID cpid,
     return true;
 }
 
+bool CopysetClient::FetchReadPeer(LogicPoolID lpid, CopysetID cpid,
+    ChunkServerID* csid, butil::EndPoint* csaddr) {
+    CopysetInfo_t cpinfo = metaCache_->GetCopysetinfo(lpid, cpid);
+    if (cpinfo.csinfos_.empty()) {
+        return false;
+    }
+
+    uint64_t index = readPeerIndex_.fetch_add(1, std::memory_order_relaxed);
+    const CopysetPeerInfo_t& peer =
+        cpinfo.csinfos_[index % cpinfo.csinfos_.size()];
+    *csid = peer.chunkserverid_;
+    *csaddr = peer.csaddr_.addr_;
+    return true;
+}
+
 // 因为这里的CopysetClient::ReadChunk(会在两个逻辑里调用
 // 1. 从request scheduler下发的新的请求
 // 2. clientclosure再重试逻辑里调用copyset client重试
@@ -129,6 +150,24 @@ int CopysetClient::ReadChunk(const ChunkIDInfo& idinfo, uint64_t sn,
                              appliedindex, sourceInfo, readDone);
     };
 
+    // 携带了appliedindex的读请求首次发送时可以发往任一副本，
+    // 副本的appliedindex落后时会返回redirect，重试时再发往leader
+    if (iosenderopt_.chunkserverEnableFollowerRead &&
+        iosenderopt_.chunkserverEnableAppliedIndexRead &&
+        appliedindex > 0 && reqclosure->GetRetriedTimes() == 0) {
+        ChunkServerID csId;
+        butil::EndPoint csAddr;
+        if (FetchReadPeer(idinfo.lpid_, idinfo.cpid_, &csId, &csAddr)) {
+            auto senderPtr = senderManager_->GetOrCreateSender(csId,
+                                            csAddr, iosenderopt_);
+            if (nullptr != senderPtr) {
+                reqclosure->IncremRetriedTimes();
+                task(doneGuard.release(), senderPtr);
+                return 0;
+            }
+        }
+    }
+
     return DoRPCTask(idinfo, task, doneGuard.release());
 }
 
@@ -136,10 +175,16 @@ int CopysetClient::WriteChunk(const ChunkIDInfo& idinfo, uint64_t sn,
                               const char* buf, off_t offset, size_t length,
                               const RequestSourceInfo& sourceInfo,
                               google::protobuf::Closure* done) {
-    std::shared_ptr<RequestSender> senderPtr = nullptr;
-    ChunkServerID leaderId;
-    butil::EndPoint leaderAddr;
+    butil::IOBuf data;
+    data.append_user_data(const_cast<char*>(buf), length, EmptyDeleter);
+    return WriteChunk(idinfo, sn, data, offset, length, sourceInfo, done);
+}
 
+int CopysetClient::WriteChunk(const ChunkIDInfo& idinfo, uint64_t sn,
+                              const butil::IOBuf& data, off_t offset,
+                              size_t length,
+                              const RequestSourceInfo& sourceInfo,
+                              google::protobuf::Closure* done) {
     RequestClosure* reqclosure = static_cast<RequestClosure*>(done);
 
     brpc::ClosureGuard doneGuard(done);
@@ -173,7 +218,7 @@ int CopysetClient::WriteChunk(const ChunkIDInfo& idinfo, uint64_t sn,
 
     auto task = [&](Closure* done, std::shared_ptr<RequestSender> senderPtr) {
         WriteChunkClosure* writeDone = new WriteChunkClosure(this, done);
-        senderPtr->WriteChunk(idinfo, sn, buf, offset, length, sourceInfo,
+        senderPtr->WriteChunk(idinfo, sn, data, offset, length, sourceInfo,
                               writeDone);
     };
 
@@ -254,6 +299,10 @@ int CopysetClient::DoRPCTask(const ChunkIDInfo& idinfo,
         reqclosure->IncremRetriedTimes();
         if (false == FetchLeader(idinfo.lpid_, idinfo.cpid_,
             &leaderId, &leaderAddr)) {
+            if (DelayReSchedule(reqclosure)) {
+                doneGuard.release();
+                return 0;
+            }
             bthread_usleep(
             iosenderopt_.failRequestOpt.chunkserverOPRetryIntervalUS);
             continue;
@@ -267,6 +316,10 @@ int CopysetClient::DoRPCTask(const ChunkIDInfo& idinfo,
         } else {
             LOG(WARNING) << "create or reset sender failed, "
                 << ", leaderId = " << leaderId;
+            if (DelayReSchedule(reqclosure)) {
+                doneGuard.release();
+                return 0;
+            }
             bthread_usleep(
             iosenderopt_.failRequestOpt.chunkserverOPRetryIntervalUS);
             continue;
@@ -275,5 +328,57 @@ int CopysetClient::DoRPCTask(const ChunkIDInfo& idinfo,
 
     return 0;
 }
+
+namespace {
+
+struct DelayReScheduleArg {
+    RequestScheduler* scheduler;
+    RequestClosure* done;
+};
+
+void DelayReScheduleFunc(void* arg) {
+    DelayReScheduleArg* delayArg = static_cast<DelayReScheduleArg*>(arg);
+    RequestClosure* done = delayArg->done;
+    RequestScheduler* scheduler = delayArg->scheduler;
+    delete delayArg;
+
+    // 重新进队之前释放inflight令牌，调度线程下发时会重新获取
+    done->ReleaseInflightRPCToken();
+    if (scheduler->ReSchedule(done->GetReqCtx()) != 0) {
+        // scheduler已经停止，直接返回失败，Run中会再释放一次令牌
+        LOG(WARNING) << "scheduler stopped, delayed retry rpc return directly";
+        done->GetInflightRPCToken();
+        done->Run();
+    }
+}
+
+}  // namespace
+
+bool CopysetClient::DelayReSchedule(RequestClosure* reqclosure) {
+    // 共享IO引擎的调度线程由所有文件共用，在其上睡眠会阻塞其他文件的IO，
+    // 因此通过定时器在重试间隔之后将请求重新放回队列头部
+    if (scheduler_ == nullptr || !scheduler_->IsIOEngineEnabled() ||
+        reqclosure->GetReqCtx() == nullptr) {
+        return false;
+    }
+
+    DelayReScheduleArg* arg = new (std::nothrow) DelayReScheduleArg;
+    if (arg == nullptr) {
+        return false;
+    }
+    arg->scheduler = scheduler_;
+    arg->done = reqclosure;
+
+    bthread_timer_t timer;
+    int ret = bthread_timer_add(&timer, butil::microseconds_from_now(
+        iosenderopt_.failRequestOpt.chunkserverOPRetryIntervalUS),
+        DelayReScheduleFunc, arg);
+    if (ret != 0) {
+        LOG(WARNING) << "add delay reschedule timer failed, ret = " << ret;
+        delete arg;
+        return false;
+    }
+    return true;
+}
 }   // namespace client
 }   // namespace curve
@@ -27,7 +27,9 @@
 #include <gflags/gflags.h>
 #include <glog/logging.h>
 #include <brpc/channel.h>
+#include <butil/iobuf.h>
 
+#include <atomic>
 #include <string>
 #include <memory>
 
@@ -52,6 +54,7 @@ using ::google::protobuf::Closure;
 // TODO(tongguangxun) :后续除了read、write的接口也需要调整重试逻辑
 class MetaCache;
 class RequestScheduler;
+class RequestClosure;
 /**
  * 负责管理 ChunkServer 的链接，向上层提供访问
  * 指定 copyset 的 chunk 的 read/write 等接口
@@ -63,7 +66,8 @@ class CopysetClient : public Uncopyable {
         metaCache_(nullptr),
         senderManager_(nullptr),
         scheduler_(nullptr),
-        exitFlag_(false) {}
+        exitFlag_(false),
+        readPeerIndex_(0) {}
 
     virtual ~CopysetClient() {
         delete senderManager_;
@@ -115,6 +119,25 @@ class CopysetClient : public Uncopyable {
                   const RequestSourceInfo& sourceInfo,
                   Closure *done);
 
+    /**
+    * 写Chunk，数据以IOBuf的形式传入，用于向量写，
+    * IOBuf直接作为rpc的attachment发送，不会拷贝数据
+    * @param idinfo为chunk相关的id信息
+    * @param sn:文件版本号
+    * @param data:要写入的数据
+    * @param offset:写的偏移
+    * @param length:写的长度
+    * @param sourceInfo chunk克隆源信息
+    * @param done:上一层异步回调的closure
+    */
+    int WriteChunk(const ChunkIDInfo& idinfo,
+                  uint64_t sn,
+                  const butil::IOBuf& data,
+                  off_t offset,
+                  size_t length,
+                  const RequestSourceInfo& sourceInfo,
+                  Closure *done);
+
     /**
      * 读Chunk快照文件
      * @param idinfo为chunk相关的id信息
@@ -223,6 +246,17 @@ class CopysetClient : public Uncopyable {
                      ChunkServerID* leaderid,
                      butil::EndPoint* leaderaddr);
 
+    /**
+     * follower read时轮流选择copyset中的一个副本
+     * @param[out]: csid为选中副本的chunkserver id
+     * @param[out]: csaddr为选中副本的地址
+     * @return: 成功返回true，metacache中没有copyset的副本信息时返回false
+     */
+    bool FetchReadPeer(LogicPoolID lpid,
+                       CopysetID cpid,
+                       ChunkServerID* csid,
+                       butil::EndPoint* csaddr);
+
     /**
      * 执行发送rpc task，并进行错误重试
      * @param[in]: idinfo为当前rpc task的id信息
@@ -234,6 +268,14 @@ class CopysetClient : public Uncopyable {
         std::function<void(Closure*, std::shared_ptr<RequestSender>)> task,
         Closure *done);
 
+    /**
+     * 共享IO引擎模式下获取leader或者创建sender失败时，不在调度线程上睡眠，
+     * 而是在重试间隔之后将请求重新放回scheduler队列头部
+     * @param[in]: reqclosure为本次rpc任务的回调
+     * @return: 已经设置定时器返回true，否则返回false，调用者继续原地重试
+     */
+    bool DelayReSchedule(RequestClosure* reqclosure);
+
  private:
     // 元数据缓存
     MetaCache            *metaCache_;
@@ -255,6 +297,9 @@ class CopysetClient : public Uncopyable {
 
     // 是否在停止状态中，如果是在关闭过程中且session失效，需要将rpc直接返回不下发
     bool exitFlag_;
+
+    // follower read时用于轮流选择副本
+    std::atomic<uint64_t> readPeerIndex_;
 };
 
 }   // namespace client
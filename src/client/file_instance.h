@@ -111,6 +111,18 @@ class CURVE_CACHELINE_ALIGNMENT FileInstance {
      * @return: 0为成功，小于0为失败
      */
     int AioWrite(CurveAioContext* aioctx);
+    /**
+     * 异步模式向量读
+     * @param: aioctx为向量读写的io上下文，iov和iovcnt描述读缓冲区
+     * @return: 0为成功，小于0为失败
+     */
+    int AioReadv(CurveAioVContext* aioctx);
+    /**
+     * 异步模式向量写
+     * @param: aioctx为向量读写的io上下文，iov和iovcnt描述写缓冲区
+     * @return: 0为成功，小于0为失败
+     */
+    int AioWritev(CurveAioVContext* aioctx);
 
     int Close();
 
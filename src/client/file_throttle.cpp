@@ -0,0 +1,182 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-19
+ * Author: agent
+ */
+
+#include "src/client/file_throttle.h"
+
+#include <bthread/bthread.h>
+#include <glog/logging.h>
+
+#include <algorithm>
+
+#include "src/common/timeutility.h"
+
+namespace curve {
+namespace client {
+
+using curve::common::LockGuard;
+using curve::common::TimeUtility;
+
+namespace {
+
+// 每次从令牌桶中取出限制的1/kRefillPerSec，即10ms的令牌
+const uint64_t kRefillPerSec = 100;
+
+// 单次等待的上限，限制被调大或者关闭之后，等待中的IO最多在这个时间之后生效
+const uint64_t kMaxWaitUs = 100 * 1000;
+
+bool TakeCredit(std::atomic<int64_t>* credit, int64_t tokens) {
+    int64_t cur = credit->load(std::memory_order_relaxed);
+    while (cur >= tokens) {
+        if (credit->compare_exchange_weak(cur, cur - tokens,
+                                          std::memory_order_acq_rel)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint64_t RefillBatch(uint64_t need, uint64_t rate, uint64_t burst) {
+    uint64_t batch = std::min(rate / kRefillPerSec, burst == 0 ? rate : burst);
+    return std::max(need, batch);
+}
+
+}  // namespace
+
+FileThrottle::FileThrottle()
+    : enable_(false)
+    , iopsLimited_(false)
+    , bpsLimited_(false)
+    , iopsCredit_(0)
+    , bpsCredit_(0) {}
+
+void FileThrottle::UpdateThrottleParams(const FileThrottleOption_t& params) {
+    LockGuard paramsLk(paramsMtx_);
+    if (params == params_) {
+        return;
+    }
+    params_ = params;
+
+    {
+        LockGuard lk(mtx_);
+        iopsBucket_.SetRate(params.iopsTotal, params.iopsBurst);
+        bpsBucket_.SetRate(params.bpsTotal, params.bpsBurst);
+        bucketParams_ = params;
+        iopsCredit_.store(0, std::memory_order_release);
+        bpsCredit_.store(0, std::memory_order_release);
+        iopsLimited_.store(params.iopsTotal != 0, std::memory_order_release);
+        bpsLimited_.store(params.bpsTotal != 0, std::memory_order_release);
+        enable_.store(params.iopsTotal != 0 || params.bpsTotal != 0,
+                      std::memory_order_release);
+    }
+
+    LOG(INFO) << "update file throttle params, iopsTotal = "
+              << params.iopsTotal << ", bpsTotal = " << params.bpsTotal
+              << ", iopsBurst = " << params.iopsBurst
+              << ", bpsBurst = " << params.bpsBurst;
+}
+
+FileThrottleOption_t FileThrottle::GetThrottleParams() {
+    LockGuard lk(paramsMtx_);
+    return params_;
+}
+
+void FileThrottle::Add(uint64_t length) {
+    uint64_t waitUs = 0;
+    while ((waitUs = TryAdd(length)) > 0) {
+        // TryAdd返回时已经释放锁，等待期间不阻塞参数更新和其他IO扣减令牌
+        bthread_usleep(waitUs);
+    }
+}
+
+uint64_t FileThrottle::TryAdd(uint64_t length) {
+    if (!Enabled() || TryAcquire(length)) {
+        return 0;
+    }
+
+    LockGuard lk(mtx_);
+    // 其他IO可能已经补充了令牌，补充之后的令牌也可能被不加锁的IO抢先扣减
+    while (Enabled() && !TryAcquire(length)) {
+        uint64_t waitUs = Refill(length);
+        if (waitUs > 0) {
+            return std::min(waitUs, kMaxWaitUs);
+        }
+    }
+    return 0;
+}
+
+bool FileThrottle::TryAcquire(uint64_t length) {
+    bool iopsLimited = iopsLimited_.load(std::memory_order_acquire);
+    bool bpsLimited = bpsLimited_.load(std::memory_order_acquire);
+    if (iopsLimited && !TakeCredit(&iopsCredit_, 1)) {
+        return false;
+    }
+    if (bpsLimited && !TakeCredit(&bpsCredit_, length)) {
+        if (iopsLimited) {
+            iopsCredit_.fetch_add(1, std::memory_order_acq_rel);
+        }
+        return false;
+    }
+    return true;
+}
+
+uint64_t FileThrottle::Refill(uint64_t length) {
+    uint64_t nowUs = TimeUtility::GetTimeofDayUs();
+    uint64_t iopsNeed = 0;
+    uint64_t bpsNeed = 0;
+    if (iopsLimited_.load(std::memory_order_acquire) &&
+        iopsCredit_.load(std::memory_order_acquire) < 1) {
+        iopsNeed = RefillBatch(1, bucketParams_.iopsTotal,
+                               bucketParams_.iopsBurst);
+    }
+    if (bpsLimited_.load(std::memory_order_acquire) &&
+        bpsCredit_.load(std::memory_order_acquire) <
+            static_cast<int64_t>(length)) {
+        bpsNeed = RefillBatch(length, bucketParams_.bpsTotal,
+                              bucketParams_.bpsBurst);
+    }
+
+    // 两个令牌桶都足够时才取出，避免一个桶的令牌被取出之后长时间闲置
+    uint64_t waitUs = 0;
+    if (iopsNeed > 0) {
+        waitUs = std::max(waitUs, iopsBucket_.GetWaitUs(iopsNeed, nowUs));
+    }
+    if (bpsNeed > 0) {
+        waitUs = std::max(waitUs, bpsBucket_.GetWaitUs(bpsNeed, nowUs));
+    }
+    if (waitUs > 0) {
+        return waitUs;
+    }
+
+    if (iopsNeed > 0) {
+        iopsBucket_.Consume(iopsNeed, nowUs);
+        iopsCredit_.fetch_add(iopsNeed, std::memory_order_acq_rel);
+    }
+    if (bpsNeed > 0) {
+        bpsBucket_.Consume(bpsNeed, nowUs);
+        bpsCredit_.fetch_add(bpsNeed, std::memory_order_acq_rel);
+    }
+    return 0;
+}
+
+}   // namespace client
+}   // namespace curve
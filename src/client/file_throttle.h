@@ -0,0 +1,113 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-19
+ * Author: agent
+ */
+
+#ifndef SRC_CLIENT_FILE_THROTTLE_H_
+#define SRC_CLIENT_FILE_THROTTLE_H_
+
+#include <atomic>
+
+#include "src/client/config_info.h"
+#include "src/common/concurrent/concurrent.h"
+#include "src/common/token_bucket.h"
+
+namespace curve {
+namespace client {
+
+/**
+ * 文件级别的IOPS和带宽限制，每个IO下发之前调用Add获取令牌。
+ * 令牌从令牌桶中按批取出放入原子计数中，计数足够时IO直接扣减计数返回，
+ * 不需要加锁；计数不足时加锁从令牌桶中补充，令牌桶中不足时在锁内计算
+ * 需要等待的时间，释放锁之后再等待并重试，等待期间不持有任何锁。
+ * 未设置限制时Add只检查一次原子变量
+ */
+class FileThrottle {
+ public:
+    FileThrottle();
+
+    /**
+     * 更新限制，参数与当前相同时不做任何修改，
+     * 参数改变时丢弃已经取出的令牌。lease续约时每次都会调用，
+     * 参数未改变时只获取paramsMtx_，不会与补充令牌的IO竞争
+     */
+    void UpdateThrottleParams(const FileThrottleOption_t& params);
+
+    FileThrottleOption_t GetThrottleParams();
+
+    /**
+     * 获取一个IO需要的令牌，令牌不足时阻塞等待
+     * @param length: IO的长度
+     */
+    void Add(uint64_t length);
+
+    /**
+     * 不阻塞地获取一个IO需要的令牌
+     * @param length: IO的长度
+     * @return: 获取成功返回0，否则返回需要等待的时间，单位us，
+     *          调用者在等待之后需要重新调用
+     */
+    uint64_t TryAdd(uint64_t length);
+
+    bool Enabled() const {
+        return enable_.load(std::memory_order_acquire);
+    }
+
+ private:
+    /**
+     * 不加锁从已经取出的令牌中扣减，
+     * iops和bps的令牌都足够时才会扣减，否则返回false
+     */
+    bool TryAcquire(uint64_t length);
+
+    /**
+     * 从令牌桶中取出一批令牌，令牌桶中不足时返回需要等待的时间，
+     * 调用时需要持有mtx_
+     * @return: 需要等待的时间，单位us，为0表示已经取出
+     */
+    uint64_t Refill(uint64_t length);
+
+ private:
+    // 是否设置了限制
+    std::atomic<bool> enable_;
+    std::atomic<bool> iopsLimited_;
+    std::atomic<bool> bpsLimited_;
+
+    // 已经从令牌桶中取出，还没有被IO使用的令牌
+    std::atomic<int64_t> iopsCredit_;
+    std::atomic<int64_t> bpsCredit_;
+
+    // 保护当前生效的参数，只在更新和获取参数时使用
+    curve::common::Mutex paramsMtx_;
+    FileThrottleOption_t params_;
+
+    // 保护下面的令牌桶和补充令牌使用的参数，只在补充令牌和参数改变时短暂持有，
+    // 等待令牌时不持有该锁。加锁顺序为paramsMtx_ -> mtx_
+    curve::common::Mutex mtx_;
+    curve::common::TokenBucket iopsBucket_;
+    curve::common::TokenBucket bpsBucket_;
+    FileThrottleOption_t bucketParams_;
+};
+
+}   // namespace client
+}   // namespace curve
+
+#endif  // SRC_CLIENT_FILE_THROTTLE_H_
@@ -106,6 +106,15 @@ class InflightControl {
         DecremInflightNum();
     }
 
+    /**
+     * 当前inflight数量是否小于限制，不阻塞，共享IO引擎的调度线程
+     * 在取令牌之前检查，避免因为一个文件的inflight满了而阻塞其他文件
+     */
+    bool HasInflightToken() const {
+        return curInflightIONum_.load(std::memory_order_acquire) <
+               maxInflightNum_;
+    }
+
  private:
     uint64_t              maxInflightNum_;
     std::atomic<uint64_t> curInflightIONum_;
@@ -0,0 +1,184 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include "src/client/io_engine.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+
+#include "src/client/request_scheduler.h"
+
+namespace curve {
+namespace client {
+
+IOEngineWorker::IOEngineWorker(uint32_t quantum)
+    : quantum_(std::max(quantum, 1u)),
+      running_(nullptr),
+      stop_(false) {}
+
+IOEngineWorker::~IOEngineWorker() {
+    Stop();
+}
+
+void IOEngineWorker::Start() {
+    thread_ = std::thread(&IOEngineWorker::Run, this);
+}
+
+void IOEngineWorker::Stop() {
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        stop_ = true;
+        readyCv_.notify_all();
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void IOEngineWorker::Attach(RequestScheduler* scheduler) {
+    std::lock_guard<std::mutex> lk(mtx_);
+    attached_.insert(scheduler);
+}
+
+void IOEngineWorker::Detach(RequestScheduler* scheduler) {
+    std::unique_lock<std::mutex> lk(mtx_);
+    attached_.erase(scheduler);
+    if (queued_.erase(scheduler) > 0) {
+        ready_.erase(std::find(ready_.begin(), ready_.end(), scheduler));
+    }
+    idleCv_.wait(lk, [&]() { return running_ != scheduler; });
+}
+
+void IOEngineWorker::Schedule(RequestScheduler* scheduler) {
+    std::lock_guard<std::mutex> lk(mtx_);
+    if (attached_.count(scheduler) == 0) {
+        return;
+    }
+    if (queued_.insert(scheduler).second) {
+        ready_.push_back(scheduler);
+        readyCv_.notify_one();
+    }
+}
+
+void IOEngineWorker::Run() {
+    while (true) {
+        RequestScheduler* scheduler = nullptr;
+        {
+            std::unique_lock<std::mutex> lk(mtx_);
+            readyCv_.wait(lk, [this]() { return stop_ || !ready_.empty(); });
+            if (ready_.empty()) {
+                break;
+            }
+            scheduler = ready_.front();
+            ready_.pop_front();
+            queued_.erase(scheduler);
+            running_ = scheduler;
+        }
+
+        // 处理期间新到的请求会将scheduler重新放回就绪队列
+        bool hasMore = scheduler->ProcessPending(quantum_);
+
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            running_ = nullptr;
+            if (hasMore && attached_.count(scheduler) > 0 &&
+                queued_.insert(scheduler).second) {
+                ready_.push_back(scheduler);
+            }
+            idleCv_.notify_all();
+        }
+    }
+}
+
+int IOEngine::Start(const IOEngineOption_t& option) {
+    std::lock_guard<std::mutex> lk(mtx_);
+    if (refCount_++ > 0) {
+        return 0;
+    }
+
+    uint32_t workerNum = option.workerNum;
+    if (workerNum == 0) {
+        workerNum = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    taskPool_.reset(new (std::nothrow) TaskThreadPool());
+    timerTaskWorker_.reset(new (std::nothrow) TimerTaskWorker());
+    if (taskPool_ == nullptr || timerTaskWorker_ == nullptr) {
+        LOG(ERROR) << "allocate io engine failed!";
+        taskPool_.reset();
+        timerTaskWorker_.reset();
+        --refCount_;
+        return -1;
+    }
+
+    if (taskPool_->Start(workerNum) != 0) {
+        LOG(ERROR) << "io engine task thread pool start failed!";
+        taskPool_.reset();
+        timerTaskWorker_.reset();
+        --refCount_;
+        return -1;
+    }
+
+    for (uint32_t i = 0; i < workerNum; ++i) {
+        workers_.emplace_back(new IOEngineWorker(option.quantum));
+        workers_.back()->Start();
+    }
+    timerTaskWorker_->Start();
+
+    LOG(INFO) << "shared io engine started, workerNum = " << workerNum
+              << ", quantum = " << option.quantum;
+    return 0;
+}
+
+void IOEngine::Stop() {
+    std::lock_guard<std::mutex> lk(mtx_);
+    if (refCount_ == 0 || --refCount_ > 0) {
+        return;
+    }
+
+    timerTaskWorker_->Stop();
+    taskPool_->Stop();
+    for (auto& worker : workers_) {
+        worker->Stop();
+    }
+    workers_.clear();
+    taskPool_.reset();
+    timerTaskWorker_.reset();
+    nextWorker_ = 0;
+
+    LOG(INFO) << "shared io engine stopped";
+}
+
+IOEngineWorker* IOEngine::Attach(RequestScheduler* scheduler) {
+    std::lock_guard<std::mutex> lk(mtx_);
+    if (workers_.empty()) {
+        return nullptr;
+    }
+    IOEngineWorker* worker = workers_[nextWorker_++ % workers_.size()].get();
+    worker->Attach(scheduler);
+    return worker;
+}
+
+}   // namespace client
+}   // namespace curve
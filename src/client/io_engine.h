@@ -0,0 +1,164 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#ifndef SRC_CLIENT_IO_ENGINE_H_
+#define SRC_CLIENT_IO_ENGINE_H_
+
+#include <condition_variable>   // NOLINT
+#include <deque>
+#include <memory>
+#include <mutex>    // NOLINT
+#include <thread>   // NOLINT
+#include <unordered_set>
+#include <vector>
+
+#include "src/client/config_info.h"
+#include "src/client/timertask_worker.h"
+#include "src/common/concurrent/task_thread_pool.h"
+#include "src/common/uncopyable.h"
+
+namespace curve {
+namespace client {
+
+using curve::common::TaskThreadPool;
+using curve::common::Uncopyable;
+
+class RequestScheduler;
+
+/**
+ * 共享IO引擎的调度线程，每个线程负责一部分文件的RequestScheduler，
+ * 有请求待下发的scheduler放在就绪队列中，线程按轮转的方式每次从一个
+ * scheduler中最多取quantum个请求下发，一个scheduler同一时刻只会被
+ * 一个线程处理
+ */
+class IOEngineWorker {
+ public:
+    explicit IOEngineWorker(uint32_t quantum);
+    ~IOEngineWorker();
+
+    void Start();
+
+    /**
+     * 停止线程，调用前所有scheduler都需要已经Detach
+     */
+    void Stop();
+
+    void Attach(RequestScheduler* scheduler);
+
+    /**
+     * 将scheduler从线程中移除，如果线程正在处理该scheduler，
+     * 等待处理结束之后再返回
+     */
+    void Detach(RequestScheduler* scheduler);
+
+    /**
+     * scheduler有新的请求或者从阻塞状态恢复时调用，将其加入就绪队列
+     */
+    void Schedule(RequestScheduler* scheduler);
+
+ private:
+    void Run();
+
+ private:
+    uint32_t quantum_;
+
+    std::mutex mtx_;
+    std::condition_variable readyCv_;
+    std::condition_variable idleCv_;
+
+    // 当前挂在该线程上的scheduler
+    std::unordered_set<RequestScheduler*> attached_;
+    // 就绪队列以及已经在就绪队列中的scheduler
+    std::deque<RequestScheduler*> ready_;
+    std::unordered_set<RequestScheduler*> queued_;
+    // 正在被处理的scheduler
+    RequestScheduler* running_;
+
+    bool stop_;
+    std::thread thread_;
+};
+
+/**
+ * 进程内共享的IO引擎，开启后所有文件共用：
+ * 1. workerNum个调度线程，取代每个文件的scheduler线程池
+ * 2. 一个workerNum个线程的隔离线程池，取代每个文件的隔离线程池
+ * 3. 一个lease续约定时器线程，取代每个文件的定时器线程
+ * 引擎按引用计数启停，第一个使用者Start时创建线程，最后一个使用者Stop时退出
+ */
+class IOEngine : public Uncopyable {
+ public:
+    static IOEngine& GetInstance() {
+        static IOEngine engine;
+        return engine;
+    }
+
+    /**
+     * 增加引用计数，引擎未启动时按照option启动
+     * @param: option为引擎的配置，引擎已经启动时忽略
+     * @return: 成功返回0，失败返回-1
+     */
+    int Start(const IOEngineOption_t& option);
+
+    /**
+     * 减少引用计数，计数为0时停止所有线程
+     */
+    void Stop();
+
+    /**
+     * 为scheduler分配一个调度线程，文件按轮转的方式分散到各个线程
+     */
+    IOEngineWorker* Attach(RequestScheduler* scheduler);
+
+    TaskThreadPool* GetTaskPool() {
+        return taskPool_.get();
+    }
+
+    TimerTaskWorker* GetTimerTaskWorker() {
+        return timerTaskWorker_.get();
+    }
+
+    /**
+     * 测试使用
+     */
+    uint32_t GetWorkerNum() {
+        std::lock_guard<std::mutex> lk(mtx_);
+        return workers_.size();
+    }
+
+ private:
+    IOEngine() : refCount_(0), nextWorker_(0) {}
+
+ private:
+    std::mutex mtx_;
+    uint32_t refCount_;
+    uint32_t nextWorker_;
+
+    std::vector<std::unique_ptr<IOEngineWorker>> workers_;
+    std::unique_ptr<TaskThreadPool> taskPool_;
+    std::unique_ptr<TimerTaskWorker> timerTaskWorker_;
+};
+
+}   // namespace client
+}   // namespace curve
+
+#endif  // SRC_CLIENT_IO_ENGINE_H_
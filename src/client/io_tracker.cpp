@@ -38,6 +38,9 @@ namespace client {
 
 std::atomic<uint64_t> IOTracker::tracekerID_(1);
 
+// 用户内存由用户自己管理，IOBuf释放时不需要做任何处理
+static void EmptyDeleter(void* ptr) {}
+
 IOTracker::IOTracker(IOManager* iomanager,
                         MetaCache* mc,
                         RequestScheduler* scheduler,
@@ -73,6 +76,9 @@ void IOTracker::StartRead(CurveAioContext* aioctx, char* buf,
     int ret = Splitor::IO2ChunkRequests(this, mc_, &reqlist_, data_,
                                         offset_, length_, mdsclient, fi);
     if (ret == 0) {
+        if (IsVectorIO()) {
+            AssignIOVecToRequests();
+        }
         reqcount_.store(reqlist_.size(), std::memory_order_release);
         std::for_each(reqlist_.begin(), reqlist_.end(), [&](RequestContext* r) {
             r->done_->SetFileMetric(fileMetric_);
@@ -104,6 +110,9 @@ void IOTracker::StartWrite(CurveAioContext* aioctx, const char* buf,
     int ret = Splitor::IO2ChunkRequests(this, mc_, &reqlist_, data_, offset_,
                                         length_, mdsclient, fi);
     if (ret == 0) {
+        if (IsVectorIO()) {
+            AssignIOVecToRequests();
+        }
         reqcount_.store(reqlist_.size(), std::memory_order_release);
         std::for_each(reqlist_.begin(), reqlist_.end(), [&](RequestContext* r) {
             r->done_->SetFileMetric(fileMetric_);
@@ -122,6 +131,20 @@ void IOTracker::StartWrite(CurveAioContext* aioctx, const char* buf,
     }
 }
 
+void IOTracker::StartReadv(CurveAioContext* aioctx, const struct iovec* iov,
+    int iovcnt, off_t offset, size_t length, MDSClient* mdsclient,
+    const FInfo_t* fi) {
+    iov_.assign(iov, iov + iovcnt);
+    StartRead(aioctx, nullptr, offset, length, mdsclient, fi);
+}
+
+void IOTracker::StartWritev(CurveAioContext* aioctx, const struct iovec* iov,
+    int iovcnt, off_t offset, size_t length, MDSClient* mdsclient,
+    const FInfo_t* fi) {
+    iov_.assign(iov, iov + iovcnt);
+    StartWrite(aioctx, nullptr, offset, length, mdsclient, fi);
+}
+
 void IOTracker::ReadSnapChunk(const ChunkIDInfo &cinfo,
     uint64_t seq, uint64_t offset, uint64_t len,
     char *buf, SnapCloneClosure* scc) {
@@ -369,6 +392,32 @@ void IOTracker::ChunkServerErr2LibcurveErr(CHUNK_OP_STATUS errcode,
     }
 }
 
+void IOTracker::AssignIOVecToRequests() {
+    // splitor按照用户IO的偏移顺序生成request，且各request的数据是连续的，
+    // 所以这里只需要顺序遍历iovec即可
+    size_t iovIdx = 0;
+    size_t iovOff = 0;
+    for (auto req : reqlist_) {
+        size_t left = req->rawlength_;
+        while (left > 0 && iovIdx < iov_.size()) {
+            char* base = static_cast<char*>(iov_[iovIdx].iov_base) + iovOff;
+            size_t len = std::min(left, iov_[iovIdx].iov_len - iovOff);
+            if (len > 0 && type_ == OpType::WRITE) {
+                req->writeData_.append_user_data(base, len, EmptyDeleter);
+            } else if (len > 0) {
+                req->readIov_.push_back({base, len});
+            }
+
+            left -= len;
+            iovOff += len;
+            if (iovOff == iov_[iovIdx].iov_len) {
+                ++iovIdx;
+                iovOff = 0;
+            }
+        }
+    }
+}
+
 RequestContext* IOTracker::GetInitedRequestContext() const {
     RequestContext* reqNode = new (std::nothrow) RequestContext();
     if (reqNode != nullptr && reqNode->Init()) {
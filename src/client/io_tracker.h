@@ -22,10 +22,13 @@
 #ifndef SRC_CLIENT_IO_TRACKER_H_
 #define SRC_CLIENT_IO_TRACKER_H_
 
+#include <sys/uio.h>
+
 #include <set>
 #include <list>
 #include <atomic>
 #include <string>
+#include <vector>
 
 #include "src/client/metacache.h"
 #include "src/client/mds_client.h"
@@ -82,6 +85,41 @@ class CURVE_CACHELINE_ALIGNMENT IOTracker {
                      size_t length,
                      MDSClient* mdsclient,
                      const FInfo_t* fi);
+
+    /**
+     * 向量读写接口，用户数据分散在iov描述的多个缓冲区中。
+     * 写请求拆分后的数据以IOBuf引用用户内存，读请求的返回数据
+     * 直接拷贝到用户缓冲区，避免上层将iovec拷贝成连续缓冲区
+     * @param: aioctx异步io上下文，为空的时候代表同步IO
+     * @param: iov是读写缓冲区数组
+     * @param: iovcnt是iov数组的长度
+     * @param: offset是读写偏移
+     * @param: length是读写长度，需要等于所有iovec长度之和
+     * @param: mdsclient透传给splitor，与mds通信
+     * @param: fi是当前io对应文件的基本信息
+     */
+    void StartReadv(CurveAioContext* aioctx,
+                    const struct iovec* iov,
+                    int iovcnt,
+                    off_t offset,
+                    size_t length,
+                    MDSClient* mdsclient,
+                    const FInfo_t* fi);
+    void StartWritev(CurveAioContext* aioctx,
+                     const struct iovec* iov,
+                     int iovcnt,
+                     off_t offset,
+                     size_t length,
+                     MDSClient* mdsclient,
+                     const FInfo_t* fi);
+
+    /**
+     * 当前IO是否是通过向量接口下发的
+     */
+    bool IsVectorIO() const {
+        return !iov_.empty();
+    }
+
     /**
      * chunk相关接口是提供给snapshot使用的，上层的snapshot和file
      * 接口是分开的，在IOTracker这里会将其统一，这样对下层来说不用
@@ -209,6 +247,12 @@ class CURVE_CACHELINE_ALIGNMENT IOTracker {
      */
     RequestContext* GetInitedRequestContext() const;
 
+    /**
+     * 向量IO拆分之后，按照request在用户IO中的先后顺序
+     * 将用户iovec切分到各个request上
+     */
+    void AssignIOVecToRequests();
+
  private:
     // io 类型
     OpType  type_;
@@ -218,6 +262,9 @@ class CURVE_CACHELINE_ALIGNMENT IOTracker {
     uint64_t   length_;
     mutable const char*   data_;
 
+    // 向量IO的用户缓冲区，非向量IO时为空
+    std::vector<iovec> iov_;
+
     // 当用户下发的是同步IO的时候，其需要在上层进行等待，因为client的
     // IO发送流程全部是异步的，因此这里需要用条件变量等待，待异步IO返回
     // 之后才将这个等待的条件变量唤醒，然后向上返回。
@@ -22,6 +22,8 @@
 
 #include <gflags/gflags.h>
 #include <glog/logging.h>
+#include <bthread/unstable.h>
+#include <butil/time.h>
 
 #include <chrono>   // NOLINT
 
@@ -34,7 +36,8 @@
 namespace curve {
 namespace client {
 Atomic<uint64_t> IOManager::idRecorder_(1);
-IOManager4File::IOManager4File(): scheduler_(nullptr), exit_(false) {
+IOManager4File::IOManager4File(): scheduler_(nullptr), taskPool_(nullptr),
+    engineStarted_(false), exit_(false) {
 }
 
 bool IOManager4File::Initialize(const std::string& filename,
@@ -48,6 +51,8 @@ bool IOManager4File::Initialize(const std::string& filename,
     inflightRpcCntl_.SetMaxInflightNum(
         ioopt_.ioSenderOpt.inflightOpt.fileMaxInFlightRPCNum);
 
+    throttle_.UpdateThrottleParams(ioopt_.throttleOpt);
+
     fileMetric_ = new (std::nothrow) FileMetric(filename);
     if (fileMetric_ == nullptr) {
         LOG(ERROR) << "allocate client metric failed!";
@@ -58,6 +63,15 @@ bool IOManager4File::Initialize(const std::string& filename,
     // 但是IO Manager需要控制所有inflight IO在关闭的时候都被回收掉
     inflightCntl_.SetMaxInflightNum(UINT64_MAX);
 
+    // 开启共享IO引擎时，scheduler和隔离线程池都使用进程内共享的线程
+    if (ioopt_.engineOpt.enable) {
+        if (IOEngine::GetInstance().Start(ioopt_.engineOpt) != 0) {
+            LOG(ERROR) << "start shared io engine failed!";
+            return false;
+        }
+        engineStarted_ = true;
+    }
+
     scheduler_ = new (std::nothrow) RequestScheduler();
     if (scheduler_ == nullptr) {
         return false;
@@ -70,12 +84,23 @@ bool IOManager4File::Initialize(const std::string& filename,
         scheduler_ = nullptr;
         return false;
     }
-    scheduler_->Run();
 
-    ret = taskPool_.Start(ioopt_.taskThreadOpt.isolationTaskThreadPoolSize,
-                          ioopt_.taskThreadOpt.isolationTaskQueueCapacity);
-    if (ret != 0) {
-        LOG(ERROR) << "task thread pool start failed!";
+    if (ioopt_.engineOpt.enable) {
+        scheduler_->SetIOEngine(&IOEngine::GetInstance(), &inflightRpcCntl_);
+        taskPool_ = IOEngine::GetInstance().GetTaskPool();
+    } else {
+        ret = privateTaskPool_.Start(
+            ioopt_.taskThreadOpt.isolationTaskThreadPoolSize,
+            ioopt_.taskThreadOpt.isolationTaskQueueCapacity);
+        if (ret != 0) {
+            LOG(ERROR) << "task thread pool start failed!";
+            return false;
+        }
+        taskPool_ = &privateTaskPool_;
+    }
+
+    if (scheduler_->Run() != 0) {
+        LOG(ERROR) << "run scheduler_ failed!";
         return false;
     }
 
@@ -83,7 +108,10 @@ bool IOManager4File::Initialize(const std::string& filename,
               << "isolationTaskThreadPoolSize = "
               << ioopt_.taskThreadOpt.isolationTaskThreadPoolSize
               << ", isolationTaskQueueCapacity = "
-              << ioopt_.taskThreadOpt.isolationTaskQueueCapacity;
+              << ioopt_.taskThreadOpt.isolationTaskQueueCapacity
+              << ", enableSharedEngine = " << ioopt_.engineOpt.enable
+              << ", throttle iopsTotal = " << ioopt_.throttleOpt.iopsTotal
+              << ", throttle bpsTotal = " << ioopt_.throttleOpt.bpsTotal;
     return true;
 }
 
@@ -97,14 +125,18 @@ void IOManager4File::UnInitialize() {
         exitCv.notify_one();
     };
 
-    taskPool_.Enqueue(task);
+    if (taskPool_ != nullptr) {
+        taskPool_->Enqueue(task);
 
-    {
-        std::unique_lock<std::mutex> lk(exitMtx);
-        exitCv.wait(lk, [&](){ return exitFlag; });
-    }
+        {
+            std::unique_lock<std::mutex> lk(exitMtx);
+            exitCv.wait(lk, [&](){ return exitFlag; });
+        }
 
-    taskPool_.Stop();
+        if (taskPool_ == &privateTaskPool_) {
+            taskPool_->Stop();
+        }
+    }
 
     if (scheduler_ != nullptr) {
         scheduler_->WakeupBlockQueueAtExit();
@@ -124,12 +156,18 @@ void IOManager4File::UnInitialize() {
         scheduler_ = nullptr;
         fileMetric_ = nullptr;
     }
+
+    if (engineStarted_) {
+        IOEngine::GetInstance().Stop();
+        engineStarted_ = false;
+    }
 }
 
 int IOManager4File::Read(char* buf, off_t offset,
     size_t length, MDSClient* mdsclient) {
     MetricHelper::IncremUserRPSCount(fileMetric_, OpType::READ);
     FlightIOGuard guard(this);
+    throttle_.Add(length);
 
     IOTracker temp(this, &mc_, scheduler_, fileMetric_);
     temp.StartRead(nullptr, buf, offset, length, mdsclient,
@@ -143,6 +181,7 @@ int IOManager4File::Write(const char* buf, off_t offset,
     size_t length, MDSClient* mdsclient) {
     MetricHelper::IncremUserRPSCount(fileMetric_, OpType::WRITE);
     FlightIOGuard guard(this);
+    throttle_.Add(length);
 
     IOTracker temp(this, &mc_, scheduler_, fileMetric_);
     temp.StartWrite(nullptr, buf, offset, length, mdsclient,
@@ -171,7 +210,7 @@ int IOManager4File::AioRead(CurveAioContext* ctx, MDSClient* mdsclient) {
                         this->GetFileInfo());
     };
 
-    taskPool_.Enqueue(task);
+    EnqueueAioTask(ctx->length, task);
     return LIBCURVE_ERROR::OK;
 }
 
@@ -194,12 +233,128 @@ int IOManager4File::AioWrite(CurveAioContext* ctx, MDSClient* mdsclient) {
                          this->GetFileInfo());
     };
 
-    taskPool_.Enqueue(task);
+    EnqueueAioTask(ctx->length, task);
+    return LIBCURVE_ERROR::OK;
+}
+
+int IOManager4File::AioReadv(CurveAioVContext* vctx,
+                              MDSClient* mdsclient) {
+    CurveAioContext* ctx = &vctx->ctx;
+    MetricHelper::IncremUserRPSCount(fileMetric_, OpType::READ);
+
+    IOTracker* temp = new (std::nothrow) IOTracker(this, &mc_,
+                                                   scheduler_, fileMetric_);
+    if (temp == nullptr) {
+        ctx->ret = -LIBCURVE_ERROR::FAILED;
+        ctx->cb(ctx);
+        LOG(ERROR) << "allocate tracker failed!";
+        return LIBCURVE_ERROR::OK;
+    }
+
+    inflightCntl_.IncremInflightNum();
+    auto task = [this, vctx, ctx, mdsclient, temp]() {
+        temp->StartReadv(ctx, vctx->iov, vctx->iovcnt,
+                         ctx->offset, ctx->length, mdsclient,
+                         this->GetFileInfo());
+    };
+
+    EnqueueAioTask(ctx->length, task);
+    return LIBCURVE_ERROR::OK;
+}
+
+int IOManager4File::AioWritev(CurveAioVContext* vctx,
+                              MDSClient* mdsclient) {
+    CurveAioContext* ctx = &vctx->ctx;
+    MetricHelper::IncremUserRPSCount(fileMetric_, OpType::WRITE);
+
+    IOTracker* temp = new (std::nothrow) IOTracker(this, &mc_,
+                                                   scheduler_, fileMetric_);
+    if (temp == nullptr) {
+        ctx->ret = -LIBCURVE_ERROR::FAILED;
+        ctx->cb(ctx);
+        LOG(ERROR) << "allocate tracker failed!";
+        return LIBCURVE_ERROR::OK;
+    }
+
+    inflightCntl_.IncremInflightNum();
+    auto task = [this, vctx, ctx, mdsclient, temp]() {
+        temp->StartWritev(ctx, vctx->iov, vctx->iovcnt,
+                          ctx->offset, ctx->length, mdsclient,
+                          this->GetFileInfo());
+    };
+
+    EnqueueAioTask(ctx->length, task);
     return LIBCURVE_ERROR::OK;
 }
 
+namespace {
+
+struct DelayAioTaskArg {
+    IOManager4File* iomanager;
+    uint64_t length;
+    std::function<void()> task;
+};
+
+void DelayAioTaskFunc(void* arg) {
+    DelayAioTaskArg* delayArg = static_cast<DelayAioTaskArg*>(arg);
+    delayArg->iomanager->EnqueueAioTask(delayArg->length, delayArg->task);
+    delete delayArg;
+}
+
+}  // namespace
+
+void IOManager4File::EnqueueAioTask(uint64_t length,
+                                    const std::function<void()>& task) {
+    taskPool_->Enqueue([this, length, task]() {
+        RunAioTask(length, task);
+    });
+}
+
+void IOManager4File::RunAioTask(uint64_t length,
+                                const std::function<void()>& task) {
+    // 隔离线程池由当前文件独占，令牌不足时直接在线程池中等待
+    if (!ioopt_.engineOpt.enable) {
+        throttle_.Add(length);
+        task();
+        return;
+    }
+
+    // 共享IO引擎的线程池由所有文件共用，在其上等待令牌会阻塞其他文件的IO，
+    // 因此令牌不足时通过定时器在等待之后将请求重新放回线程池
+    uint64_t waitUs = throttle_.TryAdd(length);
+    if (waitUs == 0) {
+        task();
+        return;
+    }
+
+    DelayAioTaskArg* arg = new (std::nothrow) DelayAioTaskArg;
+    if (arg != nullptr) {
+        arg->iomanager = this;
+        arg->length = length;
+        arg->task = task;
+
+        bthread_timer_t timer;
+        int ret = bthread_timer_add(&timer,
+            butil::microseconds_from_now(waitUs), DelayAioTaskFunc, arg);
+        if (ret == 0) {
+            return;
+        }
+        LOG(WARNING) << "add throttle delay timer failed, ret = " << ret;
+        delete arg;
+    }
+
+    throttle_.Add(length);
+    task();
+}
+
 void IOManager4File::UpdateFileInfo(const FInfo_t& fi) {
     mc_.UpdateFileInfo(fi);
+    UpdateFileThrottleParams(fi);
+}
+
+void IOManager4File::UpdateFileThrottleParams(const FInfo_t& fi) {
+    throttle_.UpdateThrottleParams(
+        fi.hasThrottleParams ? fi.throttleParams : ioopt_.throttleOpt);
 }
 
 void IOManager4File::HandleAsyncIOResponse(IOTracker* iotracker) {
@@ -227,6 +382,9 @@ void IOManager4File::RefeshSuccAndResumeIO() {
 
 void IOManager4File::ReleaseInflightRpcToken() {
     inflightRpcCntl_.ReleaseInflightToken();
+    if (ioopt_.engineOpt.enable) {
+        scheduler_->OnInflightRpcTokenReleased();
+    }
 }
 
 void IOManager4File::GetInflightRpcToken() {
@@ -25,6 +25,7 @@
 
 #include <string>
 #include <atomic>
+#include <functional>
 #include <mutex>  // NOLINT
 #include <condition_variable>   // NOLINT
 
@@ -37,6 +38,8 @@
 #include "src/client/request_scheduler.h"
 #include "include/curve_compiler_specific.h"
 #include "src/client/inflight_controller.h"
+#include "src/client/io_engine.h"
+#include "src/client/file_throttle.h"
 
 using curve::common::Atomic;
 
@@ -93,6 +96,20 @@ class IOManager4File : public IOManager {
    */
   int AioWrite(CurveAioContext* aioctx,
                       MDSClient* mdsclient);
+  /**
+   * 异步模式向量读，数据直接读入aioctx->iov描述的用户缓冲区
+   * @param: mdsclient透传给底层，在必要的时候与mds通信
+   * @param: aioctx为向量读写的io上下文，iov和iovcnt描述读缓冲区
+   * @return： 0为成功，小于0为失败
+   */
+  int AioReadv(CurveAioVContext* aioctx, MDSClient* mdsclient);
+  /**
+   * 异步模式向量写，aioctx->iov描述的用户缓冲区直接作为rpc的attachment
+   * @param: mdsclient透传给底层，在必要的时候与mds通信
+   * @param: aioctx为向量读写的io上下文，iov和iovcnt描述写缓冲区
+   * @return： 0为成功，小于0为失败
+   */
+  int AioWritev(CurveAioVContext* aioctx, MDSClient* mdsclient);
 
   /**
    * 析构，回收资源
@@ -134,6 +151,10 @@ class IOManager4File : public IOManager {
      ioopt_ = opt;
   }
 
+  const IOOption_t& GetIOOpt() const {
+     return ioopt_;
+  }
+
   /**
    * 测试使用，获取request scheduler
    */
@@ -149,6 +170,36 @@ class IOManager4File : public IOManager {
     return mc_.GetFileInfo();
   }
 
+  /**
+   * 更新文件的QoS限制，mds中的文件信息没有设置限制时使用配置文件中的限制，
+   * 打开文件和lease续约成功时调用
+   * @param: fi为mds返回的文件信息
+   */
+  void UpdateFileThrottleParams(const FInfo_t& fi);
+
+  /**
+   * 将异步IO放入隔离线程池，在线程池中获取限流令牌之后下发，
+   * 令牌不足的IO在等待之后也通过该接口重新放回线程池
+   * @param: length为IO的长度
+   * @param: task为获取令牌之后下发IO的任务
+   */
+  void EnqueueAioTask(uint64_t length, const std::function<void()>& task);
+
+  /**
+   * 更新文件的访问token，lease续约成功并且mds返回了新的token时调用
+   * @param: token为mds返回的token
+   */
+  void UpdateFileToken(const std::string& token) {
+    mc_.UpdateFileToken(token);
+  }
+
+  /**
+   * 获取文件的限流模块，测试代码使用
+   */
+  FileThrottle* GetFileThrottle() {
+    return &throttle_;
+  }
+
   /**
    * 返回文件最新版本号
    */
@@ -190,6 +241,12 @@ class IOManager4File : public IOManager {
    */
   void HandleAsyncIOResponse(IOTracker* iotracker) override;
 
+  /**
+   * 在隔离线程池中获取令牌并下发IO。开启共享IO引擎时令牌不足不在线程池中
+   * 等待，而是设置定时器，在需要等待的时间之后将IO重新放回线程池
+   */
+  void RunAioTask(uint64_t length, const std::function<void()>& task);
+
   class FlightIOGuard {
    public:
     explicit FlightIOGuard(IOManager4File* iomana) {
@@ -218,8 +275,13 @@ class IOManager4File : public IOManager {
   // client端metric统计信息
   FileMetric*        fileMetric_;
 
-  // task thread pool为了将qemu线程与curve线程隔离
-  curve::common::TaskThreadPool taskPool_;
+  // task thread pool为了将qemu线程与curve线程隔离，
+  // 开启共享IO引擎时指向引擎的线程池，否则指向privateTaskPool_
+  curve::common::TaskThreadPool* taskPool_;
+  curve::common::TaskThreadPool privateTaskPool_;
+
+  // 是否持有共享IO引擎的引用
+  bool engineStarted_;
 
   // inflight IO控制
   InflightControl  inflightCntl_;
@@ -227,6 +289,9 @@ class IOManager4File : public IOManager {
   // inflight rpc控制
   InflightControl inflightRpcCntl_;
 
+  // 文件的IOPS和带宽限制，IO在下发到splitor之前获取令牌
+  FileThrottle throttle_;
+
   // 是否退出
   bool exit_;
 
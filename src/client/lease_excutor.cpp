@@ -33,6 +33,11 @@ LeaseExcutor::LeaseExcutor(const LeaseOption_t& leaseOpt,
                            UserInfo_t userinfo,
                            MDSClient* mdsclient,
                            IOManager4File* iomanager):
+                           fileId_(0),
+                           parentId_(0),
+                           batchRegistered_(false),
+                           timerTaskWorker_(&privateTimerTaskWorker_),
+                           engineStarted_(false),
                            isleaseAvaliable_(true),
                            failedrefreshcount_(0) {
     userinfo_    = userinfo;
@@ -44,6 +49,8 @@ LeaseExcutor::LeaseExcutor(const LeaseOption_t& leaseOpt,
 
 bool LeaseExcutor::Start(const FInfo_t& fi, const LeaseSession_t&  lease) {
     fullFileName_ = fi.fullPathName;
+    fileId_ = fi.id;
+    parentId_ = fi.parentid;
 
     leasesession_ = lease;
     if (leasesession_.leaseTime <= 0) {
@@ -56,21 +63,43 @@ bool LeaseExcutor::Start(const FInfo_t& fi, const LeaseSession_t&  lease) {
     }
 
     iomanager_->UpdateFileInfo(fi);
-    timerTaskWorker_.Start();
+
+    auto interval = leasesession_.leaseTime/leaseoption_.mdsRefreshTimesPerLease;  // NOLINT
+
+    // 批量续约时由进程内共用的续约线程续约，不需要定时器
+    if (leaseoption_.enableBatchRefresh) {
+        LeaseRefreshBatcher::GetInstance().Register(this, interval,
+            leaseoption_.batchRefreshMaxNum);
+        batchRegistered_ = true;
+        LOG(INFO) << "register lease refresh for " << fullFileName_
+                  << " to batcher!";
+        return true;
+    }
+
+    // 共享IO引擎模式下所有文件的续约任务由同一个定时器线程执行
+    const IOEngineOption_t& engineOpt = iomanager_->GetIOOpt().engineOpt;
+    if (engineOpt.enable) {
+        if (IOEngine::GetInstance().Start(engineOpt) != 0) {
+            LOG(ERROR) << "start shared io engine failed!";
+            return false;
+        }
+        engineStarted_ = true;
+        timerTaskWorker_ = IOEngine::GetInstance().GetTimerTaskWorker();
+    } else {
+        timerTaskWorker_->Start();
+    }
 
     auto refreshleasetask = [this]() {
         this->RefreshLease();
     };
 
-    auto interval = leasesession_.leaseTime/leaseoption_.mdsRefreshTimesPerLease;  // NOLINT
-
     refreshTask_ = new (std::nothrow) TimerTask(interval);
     if (refreshTask_ == nullptr) {
         LOG(ERROR) << "allocate failed!";
         return false;
     }
     refreshTask_->AddCallback(refreshleasetask);
-    timerTaskWorker_.AddTimerTask(refreshTask_);
+    timerTaskWorker_->AddTimerTask(refreshTask_);
     LOG(INFO) << "add timer task "
               << refreshTask_->GetTimerID()
               << " for lease refresh!";
@@ -78,40 +107,68 @@ bool LeaseExcutor::Start(const FInfo_t& fi, const LeaseSession_t&  lease) {
 }
 
 void LeaseExcutor::RefreshLease() {
-    if (!LeaseValid()) {
-        LOG(INFO) << "lease not valid!";
-        iomanager_->LeaseTimeoutBlockIO();
-    }
+    CheckLeaseValid();
     LeaseRefreshResult response;
     LIBCURVE_ERROR ret = mdsclient_->RefreshSession(fullFileName_,
                                                     userinfo_,
                                                     leasesession_.sessionID,
                                                     &response);
+    HandleRefreshResult(ret, response);
+}
+
+void LeaseExcutor::CheckLeaseValid() {
+    if (!LeaseValid()) {
+        LOG(INFO) << "lease not valid!";
+        iomanager_->LeaseTimeoutBlockIO();
+    }
+}
+
+LeaseRefreshItem_t LeaseExcutor::GetRefreshItem() const {
+    LeaseRefreshItem_t item;
+    item.filename = fullFileName_;
+    item.fileId = fileId_;
+    item.parentId = parentId_;
+    item.sessionId = leasesession_.sessionID;
+    item.fileToken = iomanager_->GetFileInfo()->fileToken.Get();
+    return item;
+}
+
+bool LeaseExcutor::HandleRefreshResult(LIBCURVE_ERROR ret,
+                                       const LeaseRefreshResult& response) {
     if (LIBCURVE_ERROR::FAILED == ret) {
         LOG(WARNING) << "refresh session rpc failed!";
-        return;
+        return true;
     } else if (LIBCURVE_ERROR::AUTHFAIL == ret) {
         iomanager_->LeaseTimeoutBlockIO();
         LOG(WARNING) << "refresh session auth fail, block io. "
                      << "session id = " << leasesession_.sessionID;
-        return;
+        return true;
     }
 
     if (response.status == LeaseRefreshResult::Status::OK) {
         CheckNeedUpdateVersion(response.finfo.seqnum);
+        iomanager_->UpdateFileThrottleParams(response.finfo);
+        // 续约时mds签发新的token，token即将过期时也能继续通过inode id访问
+        std::string fileToken = response.finfo.fileToken.Get();
+        if (!fileToken.empty()) {
+            iomanager_->UpdateFileToken(fileToken);
+        }
         failedrefreshcount_.store(0);
         isleaseAvaliable_.store(true);
         iomanager_->RefeshSuccAndResumeIO();
     } else if (response.status == LeaseRefreshResult::Status::NOT_EXIST) {
         iomanager_->LeaseTimeoutBlockIO();
-        refreshTask_->SetDeleteSelf();
+        if (refreshTask_ != nullptr) {
+            refreshTask_->SetDeleteSelf();
+        }
         isleaseAvaliable_.store(false);
         LOG(WARNING) << "session or file not exists, no longer refresh!"
                      << ", sessionid = " << leasesession_.sessionID;
+        return false;
     } else {
         LOG(WARNING) << leasesession_.sessionID << " lease refresh failed!";
     }
-    return;
+    return true;
 }
 
 std::string LeaseExcutor::GetLeaseSessionID() {
@@ -119,12 +176,24 @@ std::string LeaseExcutor::GetLeaseSessionID() {
 }
 
 void LeaseExcutor::Stop() {
+    if (batchRegistered_) {
+        LeaseRefreshBatcher::GetInstance().Unregister(this);
+        batchRegistered_ = false;
+    }
+
     if (refreshTask_ != nullptr) {
-        timerTaskWorker_.CancelTimerTask(refreshTask_);
+        timerTaskWorker_->CancelTimerTask(refreshTask_);
         delete refreshTask_;
         refreshTask_ = nullptr;
     }
-    timerTaskWorker_.Stop();
+
+    if (engineStarted_) {
+        timerTaskWorker_ = &privateTimerTaskWorker_;
+        IOEngine::GetInstance().Stop();
+        engineStarted_ = false;
+    } else {
+        timerTaskWorker_->Stop();
+    }
 }
 
 bool LeaseExcutor::LeaseValid() {
@@ -30,6 +30,7 @@
 #include "src/client/client_common.h"
 #include "src/client/iomanager4file.h"
 #include "src/client/timertask_worker.h"
+#include "src/client/lease_refresh_batcher.h"
 
 namespace curve {
 namespace client {
@@ -57,6 +58,8 @@ struct LeaseRefreshResult {
  */
 class LeaseExcutor {
  public:
+    friend class LeaseRefreshBatcher;
+
     /**
      * 构造函数
      * @param: leaseopt为当前lease续约的option配置
@@ -101,6 +104,33 @@ class LeaseExcutor {
         }
     }
 
+    /**
+     * 批量续约使用，获取续约需要的文件信息
+     */
+    LeaseRefreshItem_t GetRefreshItem() const;
+
+    MDSClient* GetMDSClient() const {
+        return mdsclient_;
+    }
+
+    const UserInfo_t& GetUserInfo() const {
+        return userinfo_;
+    }
+
+    /**
+     * 续约之前检查lease是否有效，无效时阻塞IO
+     */
+    void CheckLeaseValid();
+
+    /**
+     * 处理续约结果
+     * @param: ret为续约rpc的返回值
+     * @param: response为续约结果
+     * @return: 需要继续续约返回true，session或者文件不存在返回false
+     */
+    bool HandleRefreshResult(LIBCURVE_ERROR ret,
+                             const LeaseRefreshResult& response);
+
     // 测试使用
     TimerTask* GetTimerTask() const {
         return refreshTask_;
@@ -108,7 +138,7 @@ class LeaseExcutor {
 
     // 测试使用
     void SetTimerTask(TimerTask* task) {
-        timerTaskWorker_.AddTimerTask(refreshTask_);
+        timerTaskWorker_->AddTimerTask(refreshTask_);
         LOG(INFO) << "add timer task "
               << refreshTask_->GetTimerID()
               << " for lease refresh!";
@@ -137,6 +167,13 @@ class LeaseExcutor {
     // 与mds进行lease续约的文件名
     std::string             fullFileName_;
 
+    // 文件及其所在目录的inode id，批量续约时mds通过inode id获取文件
+    uint64_t                fileId_;
+    uint64_t                parentId_;
+
+    // 是否加入了批量续约
+    bool                    batchRegistered_;
+
     // 用于续约的client
     MDSClient*              mdsclient_;
 
@@ -155,8 +192,13 @@ class LeaseExcutor {
     // mds端传过来的lease信息，包含当前文件的lease时长，及sessionid
     LeaseSession_t          leasesession_;
 
-    // 执行定时任务的定时器
-    TimerTaskWorker         timerTaskWorker_;
+    // 执行定时任务的定时器，开启共享IO引擎时使用引擎的定时器，
+    // 否则使用自己的privateTimerTaskWorker_
+    TimerTaskWorker*        timerTaskWorker_;
+    TimerTaskWorker         privateTimerTaskWorker_;
+
+    // 是否持有共享IO引擎的引用
+    bool                    engineStarted_;
 
     // 记录当前lease是否可用
     std::atomic<bool>       isleaseAvaliable_;
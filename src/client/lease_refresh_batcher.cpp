@@ -0,0 +1,157 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include "src/client/lease_refresh_batcher.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <utility>
+
+#include "src/client/lease_excutor.h"
+#include "src/client/mds_client.h"
+
+namespace curve {
+namespace client {
+
+void LeaseRefreshBatcher::Register(LeaseExcutor* excutor,
+                                   uint64_t intervalUs,
+                                   uint32_t batchMaxNum) {
+    LockGuard lifeGuard(lifeMtx_);
+    {
+        LockGuard lk(mtx_);
+        excutors_.insert(excutor);
+        intervalUs_ = running_ ? std::min(intervalUs_, intervalUs)
+                               : intervalUs;
+        batchMaxNum_ = std::max(batchMaxNum, 1u);
+    }
+
+    if (!running_) {
+        sleeper_.reset(new InterruptibleSleeper());
+        thread_ = Thread(&LeaseRefreshBatcher::RefreshInterval, this);
+        running_ = true;
+        LOG(INFO) << "lease refresh batcher started, interval us = "
+                  << intervalUs;
+    }
+}
+
+void LeaseRefreshBatcher::Unregister(LeaseExcutor* excutor) {
+    LockGuard lifeGuard(lifeMtx_);
+    bool stop = false;
+    {
+        LockGuard refreshGuard(refreshMtx_);
+        LockGuard lk(mtx_);
+        excutors_.erase(excutor);
+        stop = excutors_.empty() && running_;
+    }
+
+    if (stop) {
+        sleeper_->interrupt();
+        thread_.join();
+        running_ = false;
+        LOG(INFO) << "lease refresh batcher stopped";
+    }
+}
+
+void LeaseRefreshBatcher::RefreshInterval() {
+    while (true) {
+        uint64_t intervalUs;
+        {
+            LockGuard lk(mtx_);
+            intervalUs = intervalUs_;
+        }
+        if (!sleeper_->wait_for(std::chrono::microseconds(intervalUs))) {
+            break;
+        }
+        RefreshAll();
+    }
+}
+
+void LeaseRefreshBatcher::RefreshAll() {
+    LockGuard refreshGuard(refreshMtx_);
+
+    // 同一个mds client、同一个owner的文件才能合并续约
+    std::map<std::pair<MDSClient*, std::string>,
+             std::vector<LeaseExcutor*>> groups;
+    uint32_t batchMaxNum;
+    {
+        LockGuard lk(mtx_);
+        for (auto excutor : excutors_) {
+            groups[std::make_pair(excutor->GetMDSClient(),
+                                  excutor->GetUserInfo().owner)]
+                .push_back(excutor);
+        }
+        batchMaxNum = batchMaxNum_;
+    }
+
+    for (auto& group : groups) {
+        auto& excutors = group.second;
+        for (size_t begin = 0; begin < excutors.size(); begin += batchMaxNum) {
+            size_t end = std::min(excutors.size(),
+                                  begin + static_cast<size_t>(batchMaxNum));
+            RefreshBatch(group.first.first,
+                         std::vector<LeaseExcutor*>(excutors.begin() + begin,
+                                                    excutors.begin() + end));
+        }
+    }
+}
+
+void LeaseRefreshBatcher::RefreshBatch(
+    MDSClient* mdsclient, const std::vector<LeaseExcutor*>& excutors) {
+    std::vector<LeaseRefreshItem_t> items;
+    items.reserve(excutors.size());
+    for (auto excutor : excutors) {
+        excutor->CheckLeaseValid();
+        items.push_back(excutor->GetRefreshItem());
+    }
+
+    std::vector<LIBCURVE_ERROR> retCodes;
+    std::vector<LeaseRefreshResult> results;
+    LIBCURVE_ERROR ret = mdsclient->BatchRefreshSession(
+        excutors[0]->GetUserInfo(), items, &retCodes, &results);
+
+    if (ret == LIBCURVE_ERROR::NOT_SUPPORT) {
+        for (auto excutor : excutors) {
+            excutor->RefreshLease();
+        }
+        return;
+    }
+
+    LeaseRefreshResult failed;
+    failed.status = LeaseRefreshResult::Status::FAILED;
+    for (size_t i = 0; i < excutors.size(); ++i) {
+        bool goOn = (ret == LIBCURVE_ERROR::OK)
+                    ? excutors[i]->HandleRefreshResult(retCodes[i], results[i])
+                    : excutors[i]->HandleRefreshResult(ret, failed);
+        // session或者文件不存在，不再续约
+        if (!goOn) {
+            LockGuard lk(mtx_);
+            excutors_.erase(excutors[i]);
+        }
+    }
+}
+
+}   // namespace client
+}   // namespace curve
@@ -0,0 +1,110 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#ifndef SRC_CLIENT_LEASE_REFRESH_BATCHER_H_
+#define SRC_CLIENT_LEASE_REFRESH_BATCHER_H_
+
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "src/common/concurrent/concurrent.h"
+#include "src/common/interruptible_sleeper.h"
+#include "src/common/uncopyable.h"
+
+namespace curve {
+namespace client {
+
+using curve::common::Mutex;
+using curve::common::LockGuard;
+using curve::common::Thread;
+using curve::common::InterruptibleSleeper;
+using curve::common::Uncopyable;
+
+class LeaseExcutor;
+class MDSClient;
+
+/**
+ * 进程内所有开启批量续约的文件共用一个续约线程，每个续约周期内
+ * 将同一个mds client、同一个owner的文件合并成BatchRefreshSession rpc，
+ * 每个rpc最多包含batchMaxNum个文件。mds不支持批量续约时退化为逐个续约
+ */
+class LeaseRefreshBatcher : public Uncopyable {
+ public:
+    static LeaseRefreshBatcher& GetInstance() {
+        static LeaseRefreshBatcher batcher;
+        return batcher;
+    }
+
+    /**
+     * 加入批量续约，第一个文件加入时启动续约线程
+     * @param: excutor为文件的lease excutor
+     * @param: intervalUs为文件的续约间隔，续约线程使用所有文件中最小的间隔
+     * @param: batchMaxNum为一个rpc中最多续约的文件数
+     */
+    void Register(LeaseExcutor* excutor,
+                  uint64_t intervalUs,
+                  uint32_t batchMaxNum);
+
+    /**
+     * 退出批量续约，如果正在续约则等待本轮续约结束，
+     * 最后一个文件退出时停止续约线程
+     */
+    void Unregister(LeaseExcutor* excutor);
+
+    /**
+     * 执行一轮续约，由续约线程调用，测试使用
+     */
+    void RefreshAll();
+
+ private:
+    LeaseRefreshBatcher()
+        : running_(false), intervalUs_(0), batchMaxNum_(0) {}
+
+    void RefreshInterval();
+
+    void RefreshBatch(MDSClient* mdsclient,
+                      const std::vector<LeaseExcutor*>& excutors);
+
+ private:
+    // 保证续约线程的启停是串行的
+    Mutex lifeMtx_;
+    // 续约期间持有，保证退出批量续约之后不再访问excutor
+    Mutex refreshMtx_;
+    // 保护excutors_和配置
+    Mutex mtx_;
+
+    std::set<LeaseExcutor*> excutors_;
+
+    bool running_;
+    uint64_t intervalUs_;
+    uint32_t batchMaxNum_;
+
+    Thread thread_;
+    std::unique_ptr<InterruptibleSleeper> sleeper_;
+};
+
+}   // namespace client
+}   // namespace curve
+
+#endif  // SRC_CLIENT_LEASE_REFRESH_BATCHER_H_
@@ -116,6 +116,14 @@ int CurveClient::AioWrite(int fd, CurveAioContext* aioctx) {
     return fileClient_->AioWrite(fd, aioctx);
 }
 
+int CurveClient::AioReadv(int fd, CurveAioVContext* aioctx) {
+    return fileClient_->AioReadv(fd, aioctx);
+}
+
+int CurveClient::AioWritev(int fd, CurveAioVContext* aioctx) {
+    return fileClient_->AioWritev(fd, aioctx);
+}
+
 void CurveClient::SetFileClient(FileClient* client) {
     delete fileClient_;
     fileClient_ = client;
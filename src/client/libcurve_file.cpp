@@ -24,6 +24,7 @@
 #include <gflags/gflags.h>
 #include <glog/logging.h>
 
+#include <climits>
 #include <thread>   // NOLINT
 #include <mutex>    // NOLINT
 #include <memory>
@@ -347,6 +348,58 @@ int FileClient::AioWrite(int fd, CurveAioContext* aioctx) {
     return ret;
 }
 
+int FileClient::AioReadv(int fd, CurveAioVContext* aioctx) {
+    // 长度为0，直接返回，不做任何操作
+    if (aioctx->ctx.length == 0) {
+        return -LIBCURVE_ERROR::OK;
+    }
+
+    if (CheckAligned(aioctx->ctx.offset, aioctx->ctx.length) == false) {
+        return -LIBCURVE_ERROR::NOT_ALIGNED;
+    }
+
+    if (CheckIOVec(aioctx) == false) {
+        return -LIBCURVE_ERROR::PARAM_ERROR;
+    }
+
+    int ret = -LIBCURVE_ERROR::FAILED;
+    ReadLockGuard lk(rwlock_);
+    if (CURVE_UNLIKELY(fileserviceMap_.find(fd) == fileserviceMap_.end())) {
+        LOG(ERROR) << "invalid fd!";
+        ret = -LIBCURVE_ERROR::BAD_FD;
+    } else {
+        ret = fileserviceMap_[fd]->AioReadv(aioctx);
+    }
+
+    return ret;
+}
+
+int FileClient::AioWritev(int fd, CurveAioVContext* aioctx) {
+    // 长度为0，直接返回，不做任何操作
+    if (aioctx->ctx.length == 0) {
+        return -LIBCURVE_ERROR::OK;
+    }
+
+    if (CheckAligned(aioctx->ctx.offset, aioctx->ctx.length) == false) {
+        return -LIBCURVE_ERROR::NOT_ALIGNED;
+    }
+
+    if (CheckIOVec(aioctx) == false) {
+        return -LIBCURVE_ERROR::PARAM_ERROR;
+    }
+
+    int ret = -LIBCURVE_ERROR::FAILED;
+    ReadLockGuard lk(rwlock_);
+    if (CURVE_UNLIKELY(fileserviceMap_.find(fd) == fileserviceMap_.end())) {
+        LOG(ERROR) << "invalid fd!";
+        ret = -LIBCURVE_ERROR::BAD_FD;
+    } else {
+        ret = fileserviceMap_[fd]->AioWritev(aioctx);
+    }
+
+    return ret;
+}
+
 int FileClient::Rename(const UserInfo_t& userinfo,
     const std::string& oldpath, const std::string& newpath) {
     LIBCURVE_ERROR ret;
@@ -495,6 +548,30 @@ bool FileClient::CheckAligned(off_t offset, size_t length) {
            (length % IO_ALIGNED_BLOCK_SIZE == 0);
 }
 
+bool FileClient::CheckIOVec(const CurveAioVContext* aioctx) {
+    if (aioctx->iov == nullptr || aioctx->iovcnt <= 0 ||
+        aioctx->iovcnt > IOV_MAX) {
+        LOG(ERROR) << "invalid iovec, iovcnt = " << aioctx->iovcnt;
+        return false;
+    }
+
+    size_t total = 0;
+    for (int i = 0; i < aioctx->iovcnt; ++i) {
+        if (aioctx->iov[i].iov_len != 0 && aioctx->iov[i].iov_base == nullptr) {
+            LOG(ERROR) << "invalid iovec, iov[" << i << "] base is null";
+            return false;
+        }
+        total += aioctx->iov[i].iov_len;
+    }
+
+    if (total != aioctx->ctx.length) {
+        LOG(ERROR) << "iovec length not match, iovec total = " << total
+                   << ", aio length = " << aioctx->ctx.length;
+        return false;
+    }
+    return true;
+}
+
 FileInstance* FileClient::GetInitedFileInstance(const std::string& filename,
     const UserInfo& userinfo, bool readonly) {
     FileInstance* fileserv = new (std::nothrow) FileInstance();
@@ -709,6 +786,32 @@ int AioWrite(int fd, CurveAioContext* aioctx) {
     return globalclient->AioWrite(fd, aioctx);
 }
 
+int AioReadv(int fd, CurveAioVContext* aioctx) {
+    if (globalclient == nullptr) {
+        LOG(ERROR) << "not inited!";
+        return -LIBCURVE_ERROR::FAILED;
+    }
+
+    DVLOG(9) << "offset: " << aioctx->ctx.offset
+        << " length: " << aioctx->ctx.length
+        << " iovcnt: " << aioctx->iovcnt
+        << " op: " << aioctx->ctx.op;
+    return globalclient->AioReadv(fd, aioctx);
+}
+
+int AioWritev(int fd, CurveAioVContext* aioctx) {
+    if (globalclient == nullptr) {
+        LOG(ERROR) << "not inited!";
+        return -LIBCURVE_ERROR::FAILED;
+    }
+
+    DVLOG(9) << "offset: " << aioctx->ctx.offset
+        << " length: " << aioctx->ctx.length
+        << " iovcnt: " << aioctx->iovcnt
+        << " op: " << aioctx->ctx.op;
+    return globalclient->AioWritev(fd, aioctx);
+}
+
 int Create(const char* filename, const C_UserInfo_t* userinfo, size_t size) {
     if (globalclient == nullptr) {
         LOG(ERROR) << "not inited!";
@@ -149,6 +149,22 @@ class FileClient {
      */
     virtual int AioWrite(int fd, CurveAioContext* aioctx);
 
+    /**
+     * 异步模式向量读
+     * @param: fd为当前open返回的文件描述符
+     * @param: aioctx为向量读写的io上下文，iov和iovcnt描述读缓冲区
+     * @return: 成功返回0,否则返回小于0的错误码
+     */
+    virtual int AioReadv(int fd, CurveAioVContext* aioctx);
+
+    /**
+     * 异步模式向量写
+     * @param: fd为当前open返回的文件描述符
+     * @param: aioctx为向量读写的io上下文，iov和iovcnt描述写缓冲区
+     * @return: 成功返回0,否则返回小于0的错误码
+     */
+    virtual int AioWritev(int fd, CurveAioVContext* aioctx);
+
     /**
      * 重命名文件
      * @param: userinfo是用户信息
@@ -272,6 +288,11 @@ class FileClient {
 
     inline bool CheckAligned(off_t offset, size_t length);
 
+    /**
+     * 检查向量IO的iovec是否合法，iovec长度之和需要等于aioctx->ctx.length
+     */
+    bool CheckIOVec(const CurveAioVContext* aioctx);
+
     // 获取一个初始化的FileInstance对象
     // return: 成功返回指向对象的指针,否则返回nullptr
     FileInstance* GetInitedFileInstance(const std::string& filename,
@@ -62,6 +62,8 @@ using curve::mds::ProtoSession;
 using curve::mds::OpenFileResponse;
 using curve::mds::CloseFileResponse;
 using curve::mds::ReFreshSessionResponse;
+using curve::mds::BatchRefreshSessionResponse;
+using curve::mds::RefreshSessionResult;
 using curve::mds::CreateCloneFileResponse;
 using curve::mds::SetCloneFileStatusResponse;
 using curve::mds::topology::CopySetServerInfo;
@@ -281,6 +283,9 @@ LIBCURVE_ERROR MDSClient::OpenFile(const std::string& filename,
 
             FileInfo finfo = response.fileinfo();
             ServiceHelper::ProtoFileInfo2Local(&finfo, fi);
+            if (response.has_filetoken()) {
+                fi->fileToken.Set(response.filetoken());
+            }
         } else {
             LOG(ERROR) << "mds response has no file info or session info!";
             return LIBCURVE_ERROR::FAILED;
@@ -623,6 +628,9 @@ LIBCURVE_ERROR MDSClient::RefreshSession(const std::string& filename,
                 if (response.has_fileinfo()) {
                     FileInfo finfo = response.fileinfo();
                     ServiceHelper::ProtoFileInfo2Local(&finfo, &resp->finfo);
+                    if (response.has_filetoken()) {
+                        resp->finfo.fileToken.Set(response.filetoken());
+                    }
                     resp->status = LeaseRefreshResult::Status::OK;
                 } else {
                     LOG(WARNING) << "session response has no fileinfo!";
@@ -649,6 +657,91 @@ LIBCURVE_ERROR MDSClient::RefreshSession(const std::string& filename,
     return rpcExcutor.DoRPCTask(task, metaServerOpt_.mdsMaxRetryMS);
 }
 
+LIBCURVE_ERROR MDSClient::BatchRefreshSession(const UserInfo_t& userinfo,
+    const std::vector<LeaseRefreshItem_t>& items,
+    std::vector<LIBCURVE_ERROR>* retCodes,
+    std::vector<LeaseRefreshResult>* results) {
+    auto task = RPCTaskDefine {
+        BatchRefreshSessionResponse response;
+        mdsClientMetric_.batchRefreshSession.qps.count << 1;
+        LatencyGuard lg(&mdsClientMetric_.batchRefreshSession.latency);
+        mdsClientBase_.BatchRefreshSession(userinfo, items, &response,
+                                           cntl, channel);
+        if (cntl->Failed()) {
+            // 老版本的mds没有批量续约接口，不需要重试
+            if (cntl->ErrorCode() == brpc::ENOMETHOD) {
+                LOG(WARNING) << "mds not support BatchRefreshSession, "
+                             << cntl->ErrorText();
+                return LIBCURVE_ERROR::NOT_SUPPORT;
+            }
+            mdsClientMetric_.batchRefreshSession.eps.count << 1;
+            LOG(WARNING) << "Fail to send BatchRefreshSessionRequest, "
+                << cntl->ErrorText()
+                << ", owner = " << userinfo.owner
+                << ", file num = " << items.size();
+            return -cntl->ErrorCode();
+        }
+
+        StatusCode stcode = response.statuscode();
+        if (stcode != StatusCode::kOK) {
+            LOG(WARNING) << "BatchRefreshSession NOT OK: owner = "
+                << userinfo.owner << ", status code = "
+                << StatusCode_Name(stcode);
+            return stcode == StatusCode::kOwnerAuthFail ?
+                   LIBCURVE_ERROR::AUTHFAIL : LIBCURVE_ERROR::FAILED;
+        }
+
+        if (response.results_size() != static_cast<int>(items.size())) {
+            LOG(WARNING) << "BatchRefreshSession result num not match, "
+                << "file num = " << items.size()
+                << ", result num = " << response.results_size();
+            return LIBCURVE_ERROR::FAILED;
+        }
+
+        retCodes->assign(items.size(), LIBCURVE_ERROR::OK);
+        results->assign(items.size(), LeaseRefreshResult());
+        for (size_t i = 0; i < items.size(); ++i) {
+            const RefreshSessionResult& result = response.results(i);
+            LeaseRefreshResult* resp = &(*results)[i];
+            switch (result.statuscode()) {
+                case StatusCode::kSessionNotExist:
+                case StatusCode::kFileNotExists:
+                    resp->status = LeaseRefreshResult::Status::NOT_EXIST;
+                    break;
+                case StatusCode::kOwnerAuthFail:
+                    resp->status = LeaseRefreshResult::Status::FAILED;
+                    (*retCodes)[i] = LIBCURVE_ERROR::AUTHFAIL;
+                    break;
+                case StatusCode::kOK:
+                    if (result.has_fileinfo()) {
+                        FileInfo finfo = result.fileinfo();
+                        ServiceHelper::ProtoFileInfo2Local(&finfo,
+                                                           &resp->finfo);
+                        if (result.has_filetoken()) {
+                            resp->finfo.fileToken.Set(result.filetoken());
+                        }
+                        resp->status = LeaseRefreshResult::Status::OK;
+                    } else {
+                        LOG(WARNING) << "session result has no fileinfo!";
+                        resp->status = LeaseRefreshResult::Status::FAILED;
+                        (*retCodes)[i] = LIBCURVE_ERROR::FAILED;
+                    }
+                    break;
+                default:
+                    LOG(WARNING) << "RefreshSession NOT OK: filename = "
+                        << items[i].filename << ", sessionid = "
+                        << items[i].sessionId << ", status code = "
+                        << StatusCode_Name(result.statuscode());
+                    resp->status = LeaseRefreshResult::Status::FAILED;
+                    (*retCodes)[i] = LIBCURVE_ERROR::FAILED;
+                    break;
+            }
+        }
+        return LIBCURVE_ERROR::OK;
+    };
+    return rpcExcutor.DoRPCTask(task, metaServerOpt_.mdsMaxRetryMS);
+}
+
 LIBCURVE_ERROR MDSClient::CheckSnapShotStatus(const std::string& filename,
     const UserInfo_t& userinfo, uint64_t seq, FileStatus* filestatus) {
     auto task = RPCTaskDefine {
@@ -843,11 +936,12 @@ LIBCURVE_ERROR MDSClient::SetCloneFileStatus(const std::string &filename,
 
 LIBCURVE_ERROR MDSClient::GetOrAllocateSegment(bool allocate, uint64_t offset,
     const FInfo_t* fi, SegmentInfo *segInfo) {
+    const FInfo_t* reqInfo = fi;
     auto task = RPCTaskDefine {
         GetOrAllocateSegmentResponse response;
         mdsClientMetric_.getOrAllocateSegment.qps.count << 1;
         LatencyGuard lg(&mdsClientMetric_.getOrAllocateSegment.latency);
-        mdsClientBase_.GetOrAllocateSegment(allocate, offset, fi,
+        mdsClientBase_.GetOrAllocateSegment(allocate, offset, reqInfo,
                                             &response, cntl, channel);
         if (cntl->Failed()) {
             mdsClientMetric_.getOrAllocateSegment.eps.count << 1;
@@ -893,6 +987,17 @@ LIBCURVE_ERROR MDSClient::GetOrAllocateSegment(bool allocate, uint64_t offset,
         }
         return LIBCURVE_ERROR::OK;
     };
+    LIBCURVE_ERROR ret = rpcExcutor.DoRPCTask(task, IOPathMaxRetryMS);
+    if (ret != LIBCURVE_ERROR::AUTHFAIL || fi->fileToken.Get().empty()) {
+        return ret;
+    }
+
+    // token过期或者文件被rename之后token校验失败，不携带token通过路径重试
+    LOG(WARNING) << "GetOrAllocateSegment with file token auth failed, "
+                 << "retry with file name, filename = " << fi->fullPathName;
+    FInfo_t byNameInfo = *fi;
+    byNameInfo.fileToken.Set("");
+    reqInfo = &byNameInfo;
     return rpcExcutor.DoRPCTask(task, IOPathMaxRetryMS);
 }
 
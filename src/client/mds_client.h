@@ -236,6 +236,19 @@ class MDSClient {
                             const std::string& sessionid,
                             LeaseRefreshResult* resp,
                             LeaseSession* lease = nullptr);
+    /**
+     * 在一个rpc中为同一个owner的多个文件续约，mds通过inode id获取文件
+     * @param: userinfo是文件的owner信息
+     * @param: items是需要续约的文件
+     * @param[out]: retCodes是每个文件的续约返回值，含义同RefreshSession
+     * @param[out]: results是每个文件的续约结果，与items一一对应
+     * @return: rpc成功返回LIBCURVE_ERROR::OK，认证失败返回AUTHFAIL，
+     *          mds不支持批量续约返回NOT_SUPPORT，否则返回FAILED
+     */
+    LIBCURVE_ERROR BatchRefreshSession(const UserInfo_t& userinfo,
+                            const std::vector<LeaseRefreshItem_t>& items,
+                            std::vector<LIBCURVE_ERROR>* retCodes,
+                            std::vector<LeaseRefreshResult>* results);
     /**
      * 关闭文件，需要携带sessionid，这样mds端会在数据库删除该session信息
      * @param: filename是要续约的文件名
@@ -235,6 +235,44 @@ void MDSClientBase::RefreshSession(const std::string& filename,
     stub.RefreshSession(cntl, &request, response, nullptr);
 }
 
+void MDSClientBase::BatchRefreshSession(
+    const UserInfo_t& userinfo,
+    const std::vector<LeaseRefreshItem_t>& items,
+    BatchRefreshSessionResponse* response,
+    brpc::Controller* cntl,
+    brpc::Channel* channel) {
+    BatchRefreshSessionRequest request;
+    for (const auto& item : items) {
+        curve::mds::RefreshSessionItem* protoItem = request.add_items();
+        protoItem->set_filename(item.filename);
+        protoItem->set_fileid(item.fileId);
+        protoItem->set_parentid(item.parentId);
+        protoItem->set_sessionid(item.sessionId);
+        if (!item.fileToken.empty()) {
+            protoItem->set_filetoken(item.fileToken);
+        }
+    }
+    request.set_clientversion(curve::common::CurveVersion());
+
+    static ClientDummyServerInfo& clientInfo =
+        ClientDummyServerInfo::GetInstance();
+
+    if (clientInfo.GetRegister()) {
+        request.set_clientip(clientInfo.GetIP());
+        request.set_clientport(clientInfo.GetPort());
+    }
+
+    FillUserInfo<BatchRefreshSessionRequest>(&request, userinfo);
+
+    LOG_EVERY_N(INFO, 10) << "BatchRefreshSession: owner = "
+                          << userinfo.owner
+                          << ", file num = " << items.size()
+                          << ", log id = " << cntl->log_id();
+
+    curve::mds::CurveFSService_Stub stub(channel);
+    stub.BatchRefreshSession(cntl, &request, response, nullptr);
+}
+
 void MDSClientBase::CheckSnapShotStatus(const std::string& filename,
                                 const UserInfo_t& userinfo,
                                 uint64_t seq,
@@ -348,6 +386,13 @@ void MDSClientBase::GetOrAllocateSegment(bool allocate,
     request.set_offset(seg_offset);
     request.set_allocateifnotexist(allocate);
     FillUserInfo<GetOrAllocateSegmentRequest>(&request, fi->userinfo);
+    // 打开文件时获取到了token，mds可以通过inode id直接获取文件
+    std::string fileToken = fi->fileToken.Get();
+    if (!fileToken.empty()) {
+        request.set_fileid(fi->id);
+        request.set_parentid(fi->parentid);
+        request.set_filetoken(fileToken);
+    }
 
     LOG(INFO) << "GetOrAllocateSegment: allocate = " << allocate
                 << ", owner = " << fi->owner.c_str()
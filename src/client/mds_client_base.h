@@ -59,6 +59,8 @@ using curve::mds::DeleteSnapShotRequest;
 using curve::mds::DeleteSnapShotResponse;
 using curve::mds::ReFreshSessionRequest;
 using curve::mds::ReFreshSessionResponse;
+using curve::mds::BatchRefreshSessionRequest;
+using curve::mds::BatchRefreshSessionResponse;
 using curve::mds::ListDirRequest;
 using curve::mds::ListDirResponse;
 using curve::mds::ChangeOwnerRequest;
@@ -236,6 +238,19 @@ class MDSClientBase {
                         ReFreshSessionResponse* response,
                         brpc::Controller* cntl,
                         brpc::Channel* channel);
+    /**
+     * 在一个rpc中为同一个owner的多个文件续约
+     * @param: userinfo是文件的owner信息
+     * @param: items是需要续约的文件
+     * @param[out]: response为该rpc的response，提供给外部处理
+     * @param[in|out]: cntl既是入参，也是出参，返回RPC状态
+     * @param[in]:channel是当前与mds建立的通道
+     */
+    void BatchRefreshSession(const UserInfo_t& userinfo,
+                             const std::vector<LeaseRefreshItem_t>& items,
+                             BatchRefreshSessionResponse* response,
+                             brpc::Controller* cntl,
+                             brpc::Channel* channel);
     /**
      * 获取快照状态
      * @param: filenam文件名
@@ -231,6 +231,10 @@ class MetaCache {
         return &fileInfo_;
     }
 
+    void UpdateFileToken(const std::string& token) {
+        fileInfo_.fileToken.Set(token);
+    }
+
     uint64_t GetLatestFileSn() const {
         return fileInfo_.seqnum;
     }
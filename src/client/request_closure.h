@@ -83,6 +83,13 @@ class RequestClosure : public ::google::protobuf::Closure {
      */
     void SetIOManager(IOManager* ioManager);
 
+    /**
+     * @brief 获取所属的iomanager
+     */
+    IOManager* GetIOManager() {
+       return ioManager_;
+    }
+
     /**
      * 设置当前closure重试次数
      */
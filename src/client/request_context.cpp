@@ -43,6 +43,9 @@ RequestContext::RequestContext() {
     rawlength_  = 0;
 
     appliedindex_ = 0;
+
+    traceId_        = 0;
+    scheduleTimeUs_ = 0;
 }
 bool RequestContext::Init() {
     done_ = new (std::nothrow) RequestClosure(this);
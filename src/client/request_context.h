@@ -23,8 +23,12 @@
 #ifndef SRC_CLIENT_REQUEST_CONTEXT_H_
 #define SRC_CLIENT_REQUEST_CONTEXT_H_
 
+#include <butil/iobuf.h>
+#include <sys/uio.h>
+
 #include <atomic>
 #include <string>
+#include <vector>
 
 #include "src/client/client_common.h"
 #include "src/client/request_closure.h"
@@ -71,6 +75,12 @@ class RequestContext {
     char*               readBuffer_;
     const char*         writeBuffer_;
 
+    // 用户通过readv/writev下发的IO，数据分散在多个用户缓冲区中
+    // 写请求的数据以IOBuf的形式直接引用用户内存，发送时不需要拷贝
+    // 读请求返回的数据直接从rpc的attachment分散拷贝到readIov_中
+    butil::IOBuf        writeData_;
+    std::vector<iovec>  readIov_;
+
     // 因为RPC都是异步发送，因此在一个Request结束时，RPC回调调用当前的done
     // 来告知当前的request结束了
     RequestClosure*     done_;
@@ -93,6 +103,11 @@ class RequestContext {
     // 当前request context id
     uint64_t            id_;
 
+    // 被采样的读写请求的trace id，0表示未被采样，随rpc发送给chunkserver
+    uint64_t            traceId_;
+    // 被采样的请求进入schedule队列的时间
+    uint64_t            scheduleTimeUs_;
+
     // request context id生成器
     static std::atomic<uint64_t> reqCtxID_;
 };
@@ -0,0 +1,148 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <memory>
+
+#include "src/client/request_merger.h"
+#include "src/client/io_tracker.h"
+
+namespace curve {
+namespace client {
+
+// 原始请求的数据由上层管理，IOBuf释放时不需要做任何处理
+static void EmptyDeleter(void* ptr) {}
+
+void MergedRequestClosure::Run() {
+    std::unique_ptr<RequestContext> ctxGuard(GetReqCtx());
+    std::unique_ptr<MergedRequestClosure> selfGuard(this);
+
+    ReleaseInflightRPCToken();
+    if (IsSuspendRPC()) {
+        MetricHelper::DecremIOSuspendNum(GetMetric());
+    }
+
+    int errcode = GetErrorCode();
+    for (auto req : requests_) {
+        req->done_->SetFailed(errcode);
+        req->done_->GetIOTracker()->HandleResponse(req);
+    }
+}
+
+bool RequestMerger::IsMergeable(RequestContext* req) {
+    if (req->optype_ != OpType::READ && req->optype_ != OpType::WRITE) {
+        return false;
+    }
+
+    // 重试之后重新进队的请求不参与合并，避免合并后的请求重试次数被重置
+    if (req->done_->GetRetriedTimes() > 0) {
+        return false;
+    }
+
+    return dynamic_cast<MergedRequestClosure*>(req->done_) == nullptr;
+}
+
+bool RequestMerger::IsAdjacent(RequestContext* prev, RequestContext* next) {
+    return IsMergeable(next) &&
+           prev->optype_ == next->optype_ &&
+           prev->idinfo_.lpid_ == next->idinfo_.lpid_ &&
+           prev->idinfo_.cpid_ == next->idinfo_.cpid_ &&
+           prev->idinfo_.cid_ == next->idinfo_.cid_ &&
+           prev->seq_ == next->seq_ &&
+           prev->sourceInfo_.cloneFileSource ==
+               next->sourceInfo_.cloneFileSource &&
+           prev->sourceInfo_.cloneFileOffset ==
+               next->sourceInfo_.cloneFileOffset &&
+           prev->offset_ + static_cast<off_t>(prev->rawlength_) ==
+               next->offset_;
+}
+
+RequestContext* RequestMerger::Merge(
+    const std::vector<RequestContext*>& requests) {
+    RequestContext* merged = new (std::nothrow) RequestContext();
+    if (merged == nullptr) {
+        LOG(ERROR) << "allocate merged request context failed!";
+        return nullptr;
+    }
+
+    MergedRequestClosure* done =
+        new (std::nothrow) MergedRequestClosure(merged, requests);
+    if (done == nullptr) {
+        LOG(ERROR) << "allocate merged request closure failed!";
+        delete merged;
+        return nullptr;
+    }
+
+    RequestContext* first = requests.front();
+    merged->done_        = done;
+    merged->optype_      = first->optype_;
+    merged->idinfo_      = first->idinfo_;
+    merged->offset_      = first->offset_;
+    merged->seq_         = first->seq_;
+    merged->sourceInfo_  = first->sourceInfo_;
+    merged->rawlength_   = 0;
+
+    for (auto req : requests) {
+        merged->rawlength_ += req->rawlength_;
+        merged->appliedindex_ =
+            std::max(merged->appliedindex_, req->appliedindex_);
+        // 沿用第一个被采样的原始请求的trace
+        if (merged->traceId_ == 0 && req->traceId_ != 0) {
+            merged->traceId_ = req->traceId_;
+            merged->scheduleTimeUs_ = req->scheduleTimeUs_;
+        }
+
+        if (req->optype_ == OpType::WRITE) {
+            if (!req->writeData_.empty()) {
+                merged->writeData_.append(req->writeData_);
+            } else {
+                merged->writeData_.append_user_data(
+                    const_cast<char*>(req->writeBuffer_), req->rawlength_,
+                    EmptyDeleter);
+            }
+        } else {
+            if (!req->readIov_.empty()) {
+                merged->readIov_.insert(merged->readIov_.end(),
+                                        req->readIov_.begin(),
+                                        req->readIov_.end());
+            } else {
+                merged->readIov_.push_back({req->readBuffer_,
+                                            req->rawlength_});
+            }
+        }
+    }
+
+    // 日志及metric沿用第一个原始请求的信息
+    RequestClosure* firstDone = first->done_;
+    done->SetIOTracker(firstDone->GetIOTracker());
+    done->SetFileMetric(firstDone->GetMetric());
+    done->SetIOManager(firstDone->GetIOManager());
+
+    DVLOG(9) << "merge " << requests.size() << " requests into one, "
+             << *merged;
+    return merged;
+}
+
+}   // namespace client
+}   // namespace curve
@@ -0,0 +1,89 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#ifndef SRC_CLIENT_REQUEST_MERGER_H_
+#define SRC_CLIENT_REQUEST_MERGER_H_
+
+#include <vector>
+
+#include "src/client/request_context.h"
+#include "src/client/request_closure.h"
+
+namespace curve {
+namespace client {
+
+/**
+ * 合并请求的closure，合并请求的rpc返回之后，
+ * 将结果依次返回给被合并的各个原始请求所属的IOTracker
+ */
+class MergedRequestClosure : public RequestClosure {
+ public:
+    MergedRequestClosure(RequestContext* mergedCtx,
+                         const std::vector<RequestContext*>& requests)
+        : RequestClosure(mergedCtx), requests_(requests) {}
+    virtual ~MergedRequestClosure() = default;
+
+    /**
+     * 将合并请求的返回值扇出给原始请求，并释放合并请求的资源
+     */
+    void Run() override;
+
+    const std::vector<RequestContext*>& GetMergedRequests() const {
+        return requests_;
+    }
+
+ private:
+    // 被合并的原始请求，按照offset从小到大排列
+    std::vector<RequestContext*> requests_;
+};
+
+/**
+ * 将同一个chunk上地址连续的同类型读写请求合并成一个请求，
+ * 减少小IO场景下发往chunkserver的rpc数量
+ */
+class RequestMerger {
+ public:
+    /**
+     * 请求是否可以参与合并，只有读写请求可以合并，
+     * 已经合并过的请求和重试过的请求不会再次参与合并
+     */
+    static bool IsMergeable(RequestContext* req);
+
+    /**
+     * next是否可以追加到prev之后合并发送
+     * 要求两者属于同一个chunk、op类型、版本号及克隆源相同，且地址连续
+     */
+    static bool IsAdjacent(RequestContext* prev, RequestContext* next);
+
+    /**
+     * 将多个相邻请求合并成一个请求，写请求的数据以IOBuf的形式
+     * 引用原始请求的数据，读请求的返回数据直接拷贝到原始请求的缓冲区
+     * @param requests: 待合并的请求，需要满足两两相邻
+     * @return: 成功返回合并之后的请求，失败返回nullptr
+     */
+    static RequestContext* Merge(const std::vector<RequestContext*>& requests);
+};
+
+}   // namespace client
+}   // namespace curve
+
+#endif  // SRC_CLIENT_REQUEST_MERGER_H_
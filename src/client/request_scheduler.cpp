@@ -28,6 +28,9 @@
 #include "src/client/request_context.h"
 #include "src/client/request_closure.h"
 #include "src/client/chunk_closure.h"
+#include "src/client/request_merger.h"
+#include "src/client/request_tracer.h"
+#include "src/client/io_engine.h"
 
 namespace curve {
 namespace client {
@@ -58,24 +61,50 @@ int RequestScheduler::Init(const RequestScheduleOption_t& reqSchdulerOpt,
         return -1;
     }
 
+    RequestTracer::SetOptions(reqschopt_.traceOpt);
+
     LOG(INFO) << "RequestScheduler conf info: "
               << "scheduleQueueCapacity = "
               << reqschopt_.scheduleQueueCapacity
               << ", scheduleThreadpoolSize = "
-              << reqschopt_.scheduleThreadpoolSize;
+              << reqschopt_.scheduleThreadpoolSize
+              << ", enableRequestMerge = "
+              << reqschopt_.mergeOpt.enableRequestMerge
+              << ", mergeMaxSizeKB = "
+              << reqschopt_.mergeOpt.mergeMaxSizeKB
+              << ", mergeMaxRequestNum = "
+              << reqschopt_.mergeOpt.mergeMaxRequestNum
+              << ", traceSampleRate = "
+              << reqschopt_.traceOpt.sampleRate;
     return 0;
 }
 
 int RequestScheduler::Run() {
     if (!running_.exchange(true, std::memory_order_acq_rel)) {
         stop_.store(false, std::memory_order_release);
-        threadPool_.Start();
+        if (engine_ != nullptr) {
+            IOEngineWorker* worker = engine_->Attach(this);
+            if (worker == nullptr) {
+                LOG(ERROR) << "attach to shared io engine failed!";
+                running_.store(false, std::memory_order_release);
+                return -1;
+            }
+            engineWorker_.store(worker, std::memory_order_release);
+            Kick();
+        } else {
+            threadPool_.Start();
+        }
     }
     return 0;
 }
 
 int RequestScheduler::Fini() {
     if (running_.exchange(false, std::memory_order_acq_rel)) {
+        IOEngineWorker* worker = engineWorker_.exchange(nullptr);
+        if (worker != nullptr) {
+            worker->Detach(this);
+            return 0;
+        }
         for (int i = 0; i < threadPool_.NumOfThreads(); ++i) {
             // notify the wait thread
             BBQItem<RequestContext *> stopReq(nullptr, true);
@@ -91,9 +120,11 @@ int RequestScheduler::ScheduleRequest(const std::list<RequestContext *> requests
     if (running_.load(std::memory_order_acquire)) {
         /* TODO(wudemiao): 后期考虑 qos */
         for (auto it : requests) {
+            RequestTracer::Sample(it);
             BBQItem<RequestContext *> req(it);
             queue_.PutBack(req);
         }
+        Kick();
         return 0;
     }
     return -1;
@@ -101,8 +132,10 @@ int RequestScheduler::ScheduleRequest(const std::list<RequestContext *> requests
 
 int RequestScheduler::ScheduleRequest(RequestContext *request) {
     if (running_.load(std::memory_order_acquire)) {
+        RequestTracer::Sample(request);
         BBQItem<RequestContext *> req(request);
         queue_.PutBack(req);
+        Kick();
         return 0;
     }
     return -1;
@@ -112,6 +145,7 @@ int RequestScheduler::ReSchedule(RequestContext *request) {
     if (running_.load(std::memory_order_acquire)) {
         BBQItem<RequestContext *> req(request);
         queue_.PutFront(req);
+        Kick();
         return 0;
     }
     return -1;
@@ -130,6 +164,7 @@ void RequestScheduler::WakeupBlockQueueAtExit() {
     blockingQueue_ = false;
     std::atomic_thread_fence(std::memory_order_acquire);
     leaseRefreshcv_.notify_all();
+    Kick();
 }
 
 void RequestScheduler::Process() {
@@ -139,71 +174,7 @@ void RequestScheduler::Process() {
         WaitValidSession();
         BBQItem<RequestContext *> item = queue_.TakeFront();
         if (!item.IsStop()) {
-            RequestContext *req = item.Item();
-            brpc::ClosureGuard guard(req->done_);
-            switch (req->optype_) {
-                case OpType::READ:
-                    DVLOG(9) << "Processing read request, buf header: "
-                             << " buf: " << *(unsigned int*)req->readBuffer_;
-                    {
-                        req->done_->GetInflightRPCToken();
-                        client_.ReadChunk(req->idinfo_,
-                                        req->seq_,
-                                        req->offset_,
-                                        req->rawlength_,
-                                        req->appliedindex_,
-                                        req->sourceInfo_,
-                                        guard.release());
-                    }
-                    break;
-                case OpType::WRITE:
-                    DVLOG(9) << "Processing write request, buf header: "
-                             << " buf: " << *(unsigned int*)req->writeBuffer_;
-                    {
-                        req->done_->GetInflightRPCToken();
-                        client_.WriteChunk(req->idinfo_,
-                                        req->seq_,
-                                        req->writeBuffer_,
-                                        req->offset_,
-                                        req->rawlength_,
-                                        req->sourceInfo_,
-                                        guard.release());
-                    }
-                    break;
-                case OpType::READ_SNAP:
-                    client_.ReadChunkSnapshot(req->idinfo_,
-                                        req->seq_,
-                                        req->offset_,
-                                        req->rawlength_,
-                                        guard.release());
-                    break;
-                case OpType::DELETE_SNAP:
-                    client_.DeleteChunkSnapshotOrCorrectSn(req->idinfo_,
-                                        req->correctedSeq_,
-                                        guard.release());
-                    break;
-                case OpType::GET_CHUNK_INFO:
-                    client_.GetChunkInfo(req->idinfo_,
-                                        guard.release());
-                    break;
-                case OpType::CREATE_CLONE:
-                    client_.CreateCloneChunk(req->idinfo_,
-                                        req->location_,
-                                        req->seq_,
-                                        req->correctedSeq_,
-                                        req->chunksize_,
-                                        guard.release());
-                    break;
-                case OpType::RECOVER_CHUNK:
-                    client_.RecoverChunk(req->idinfo_,
-                                         req->offset_, req->rawlength_,
-                                         guard.release());
-                    break;
-                default:
-                    /* TODO(wudemiao) 后期整个链路错误发统一了在处理 */
-                    req->done_->SetFailed(-1);
-                    LOG(ERROR) << "unknown op type: OpType::UNKNOWN";
-            }
+            ProcessRequest(item.Item());
         } else {
             /**
              * 一旦遇到stop item，所有线程都可以退出，因为此时
@@ -214,5 +185,170 @@ void RequestScheduler::Process() {
     }
 }
 
+void RequestScheduler::ProcessRequest(RequestContext* req) {
+    RequestTracer::OnDequeue(req);
+    if (reqschopt_.mergeOpt.enableRequestMerge) {
+        req = MergeAdjacentRequests(req);
+    }
+    brpc::ClosureGuard guard(req->done_);
+    switch (req->optype_) {
+        case OpType::READ:
+            DVLOG(9) << "Processing read request, " << *req;
+            {
+                req->done_->GetInflightRPCToken();
+                client_.ReadChunk(req->idinfo_,
+                                req->seq_,
+                                req->offset_,
+                                req->rawlength_,
+                                req->appliedindex_,
+                                req->sourceInfo_,
+                                guard.release());
+            }
+            break;
+        case OpType::WRITE:
+            DVLOG(9) << "Processing write request, " << *req;
+            {
+                req->done_->GetInflightRPCToken();
+                if (!req->writeData_.empty()) {
+                    client_.WriteChunk(req->idinfo_,
+                                req->seq_,
+                                req->writeData_,
+                                req->offset_,
+                                req->rawlength_,
+                                req->sourceInfo_,
+                                guard.release());
+                } else {
+                    client_.WriteChunk(req->idinfo_,
+                                req->seq_,
+                                req->writeBuffer_,
+                                req->offset_,
+                                req->rawlength_,
+                                req->sourceInfo_,
+                                guard.release());
+                }
+            }
+            break;
+        case OpType::READ_SNAP:
+            client_.ReadChunkSnapshot(req->idinfo_,
+                                req->seq_,
+                                req->offset_,
+                                req->rawlength_,
+                                guard.release());
+            break;
+        case OpType::DELETE_SNAP:
+            client_.DeleteChunkSnapshotOrCorrectSn(req->idinfo_,
+                                req->correctedSeq_,
+                                guard.release());
+            break;
+        case OpType::GET_CHUNK_INFO:
+            client_.GetChunkInfo(req->idinfo_,
+                                guard.release());
+            break;
+        case OpType::CREATE_CLONE:
+            client_.CreateCloneChunk(req->idinfo_,
+                                req->location_,
+                                req->seq_,
+                                req->correctedSeq_,
+                                req->chunksize_,
+                                guard.release());
+            break;
+        case OpType::RECOVER_CHUNK:
+            client_.RecoverChunk(req->idinfo_,
+                                 req->offset_, req->rawlength_,
+                                 guard.release());
+            break;
+        default:
+            /* TODO(wudemiao) 后期整个链路错误发统一了在处理 */
+            req->done_->SetFailed(-1);
+            LOG(ERROR) << "unknown op type: OpType::UNKNOWN";
+    }
+}
+
+bool RequestScheduler::ProcessPending(uint32_t quantum) {
+    auto notStop = [](const BBQItem<RequestContext*>& item) -> bool {
+        return !item.IsStop();
+    };
+
+    for (uint32_t i = 0; i < quantum; ++i) {
+        // lease续约失败时不下发，续约成功或者文件关闭时会重新调度
+        if (blockIO_.load(std::memory_order_acquire) && blockingQueue_) {
+            return false;
+        }
+        if (!HasInflightRpcToken()) {
+            return false;
+        }
+        BBQItem<RequestContext*> item(nullptr);
+        if (!queue_.TakeFrontIf(notStop, &item)) {
+            return false;
+        }
+        ProcessRequest(item.Item());
+    }
+
+    return !queue_.Empty();
+}
+
+void RequestScheduler::Kick() {
+    IOEngineWorker* worker = engineWorker_.load(std::memory_order_acquire);
+    if (worker != nullptr) {
+        worker->Schedule(this);
+    }
+}
+
+bool RequestScheduler::HasInflightRpcToken() {
+    if (inflightRpcCntl_ == nullptr || inflightRpcCntl_->HasInflightToken()) {
+        return true;
+    }
+    // 先设置等待标记再检查一次，避免检查之后令牌释放时没有重新调度
+    waitInflightToken_.store(true);
+    if (inflightRpcCntl_->HasInflightToken()) {
+        waitInflightToken_.store(false);
+        return true;
+    }
+    return false;
+}
+
+RequestContext* RequestScheduler::MergeAdjacentRequests(RequestContext* req) {
+    if (!RequestMerger::IsMergeable(req)) {
+        return req;
+    }
+
+    const uint64_t maxBytes =
+        static_cast<uint64_t>(reqschopt_.mergeOpt.mergeMaxSizeKB) * 1024;
+    const uint32_t maxNum = reqschopt_.mergeOpt.mergeMaxRequestNum;
+
+    std::vector<RequestContext*> requests{req};
+    uint64_t totalBytes = req->rawlength_;
+
+    auto pred = [&](const BBQItem<RequestContext*>& item) -> bool {
+        if (item.IsStop()) {
+            return false;
+        }
+        RequestContext* next = item.Item();
+        return RequestMerger::IsAdjacent(requests.back(), next) &&
+               totalBytes + next->rawlength_ <= maxBytes;
+    };
+
+    BBQItem<RequestContext*> next(nullptr);
+    while (requests.size() < maxNum && queue_.TakeFrontIf(pred, &next)) {
+        requests.push_back(next.Item());
+        totalBytes += next.Item()->rawlength_;
+    }
+
+    if (requests.size() == 1) {
+        return req;
+    }
+
+    RequestContext* merged = RequestMerger::Merge(requests);
+    if (merged == nullptr) {
+        // 合并失败，将取出的请求按原顺序放回队列头部，逐个下发
+        for (auto it = requests.rbegin(); it + 1 != requests.rend(); ++it) {
+            queue_.PutFront(BBQItem<RequestContext*>(*it));
+        }
+        return req;
+    }
+
+    return merged;
+}
+
 }   // namespace client
 }   // namespace curve
@@ -31,6 +31,7 @@
 #include "src/common/concurrent/thread_pool.h"
 #include "src/client/client_common.h"
 #include "src/client/copyset_client.h"
+#include "src/client/inflight_controller.h"
 #include "include/curve_compiler_specific.h"
 
 namespace curve {
@@ -42,6 +43,8 @@ using curve::common::BBQItem;
 using curve::common::Uncopyable;
 
 class RequestContext;
+class IOEngine;
+class IOEngineWorker;
 /**
  * 请求调度器，上层拆分的I/O会交给Scheduler的线程池
  * 分发到具体的ChunkServer，后期QoS也会放在这里处理
@@ -52,7 +55,11 @@ class RequestScheduler : public Uncopyable {
         : running_(false),
           stop_(true),
           blockingQueue_(true),
-          client_() {}
+          client_(),
+          engine_(nullptr),
+          engineWorker_(nullptr),
+          inflightRpcCntl_(nullptr),
+          waitInflightToken_(false) {}
     virtual ~RequestScheduler();
 
     /**
@@ -64,6 +71,24 @@ class RequestScheduler : public Uncopyable {
     virtual int Init(const RequestScheduleOption_t& reqSchdulerOpt,
                      MetaCache *metaCache,
                      FileMetric* fileMetric = nullptr);
+
+    /**
+     * 使用共享IO引擎的调度线程下发请求，不再创建自己的线程池，需要在Run之前调用
+     * @param: engine为进程内共享的IO引擎
+     * @param: inflightRpcCntl为文件的inflight rpc控制，inflight达到上限时
+     *         调度线程跳过该文件，令牌释放之后再继续调度
+     */
+    void SetIOEngine(IOEngine* engine, InflightControl* inflightRpcCntl) {
+        engine_ = engine;
+        inflightRpcCntl_ = inflightRpcCntl;
+    }
+    /**
+     * 是否使用共享IO引擎的调度线程下发请求
+     */
+    bool IsIOEngineEnabled() const {
+        return engine_ != nullptr;
+    }
+
     /**
      * 启动Scheduler的线程池开始处理request
      * 启动之后才能push request，除此之外，只有当
@@ -123,6 +148,26 @@ class RequestScheduler : public Uncopyable {
        blockIO_.store(false);
        leaseRefreshcv_.notify_all();
        client_.ResumeRPCRetry();
+       lk.unlock();
+       Kick();
+    }
+
+    /**
+     * 共享IO引擎模式下由调度线程调用，从队列中最多取出quantum个请求下发，
+     * lease续约失败或者inflight rpc达到上限时停止下发
+     * @param: quantum为本轮最多下发的请求数
+     * @return: 队列中还有可以继续下发的请求返回true，否则返回false
+     */
+    bool ProcessPending(uint32_t quantum);
+
+    /**
+     * inflight rpc令牌释放之后调用，共享IO引擎模式下如果调度线程
+     * 因为令牌不足跳过了该文件，重新将其加入调度
+     */
+    void OnInflightRpcTokenReleased() {
+        if (waitInflightToken_.exchange(false)) {
+            Kick();
+        }
     }
 
     /**
@@ -138,6 +183,30 @@ class RequestScheduler : public Uncopyable {
      */
     void Process();
 
+    /**
+     * 下发一个从队列中取出的请求
+     */
+    void ProcessRequest(RequestContext* req);
+
+    /**
+     * 共享IO引擎模式下通知调度线程有请求需要处理
+     */
+    void Kick();
+
+    /**
+     * 共享IO引擎模式下检查文件的inflight rpc是否达到上限，
+     * 达到上限时记录等待标记，令牌释放之后重新调度
+     */
+    bool HasInflightRpcToken();
+
+    /**
+     * 开启请求合并时，从队列头部取出与req相邻的读写请求，与req合并成一个请求
+     * 只合并已经在队列中的请求，不会为了等待合并而阻塞
+     * @param: req为刚从队列中取出的请求
+     * @return: 没有可合并的请求或者合并失败时返回req本身，否则返回合并之后的请求
+     */
+    RequestContext* MergeAdjacentRequests(RequestContext* req);
+
     inline void WaitValidSession() {
       // lease续约失败的时候需要阻塞IO直到续约成功
       if (blockIO_.load(std::memory_order_acquire) && blockingQueue_) {
@@ -172,6 +241,14 @@ class RequestScheduler : public Uncopyable {
     std::condition_variable leaseRefreshcv_;
     // 阻塞队列
     bool blockingQueue_;
+    // 共享IO引擎，为nullptr时使用自己的线程池
+    IOEngine* engine_;
+    // 共享IO引擎中负责该scheduler的调度线程
+    std::atomic<IOEngineWorker*> engineWorker_;
+    // 文件的inflight rpc控制，共享IO引擎模式下使用
+    InflightControl* inflightRpcCntl_;
+    // 调度线程因为inflight rpc达到上限跳过了该scheduler
+    std::atomic<bool> waitInflightToken_;
 };
 
 }   // namespace client
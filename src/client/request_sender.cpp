@@ -35,8 +35,6 @@ using curve::common::TimeUtility;
 namespace curve {
 namespace client {
 
-static void EmptyDeleter(void* ptr) {}
-
 int RequestSender::Init(const IOSenderOption_t& ioSenderOpt) {
     if (0 != channel_.Init(serverEndPoint_, NULL)) {
         LOG(ERROR) << "failed to init channel to server, id: " << chunkServerId_
@@ -88,6 +86,9 @@ int RequestSender::ReadChunk(ChunkIDInfo idinfo,
     if (iosenderopt_.chunkserverEnableAppliedIndexRead && appliedindex > 0) {
         request.set_appliedindex(appliedindex);
     }
+    if (rc->GetReqCtx()->traceId_ != 0) {
+        request.set_traceid(rc->GetReqCtx()->traceId_);
+    }
     ChunkService_Stub stub(&channel_);
     stub.ReadChunk(cntl, &request, response, doneGuard.release());
 
@@ -96,7 +97,7 @@ int RequestSender::ReadChunk(ChunkIDInfo idinfo,
 
 int RequestSender::WriteChunk(ChunkIDInfo idinfo,
                               uint64_t sn,
-                              const char *buf,
+                              const butil::IOBuf& data,
                               off_t offset,
                               size_t length,
                               const RequestSourceInfo& sourceInfo,
@@ -107,8 +108,6 @@ int RequestSender::WriteChunk(ChunkIDInfo idinfo,
     MetricHelper::IncremRPCRPSCount(rc->GetMetric(), OpType::WRITE);
     rc->SetStartTime(TimeUtility::GetTimeofDayUs());
 
-    DVLOG(9) << "Sending request, buf header: "
-             << " buf: " << *(unsigned int *)buf;
     brpc::Controller *cntl = new brpc::Controller();
     cntl->set_timeout_ms(
     std::max(rc->GetNextTimeoutMS(),
@@ -133,8 +132,11 @@ int RequestSender::WriteChunk(ChunkIDInfo idinfo,
         request.set_clonefileoffset(sourceInfo.cloneFileOffset);
     }
 
-    cntl->request_attachment().append_user_data(
-        const_cast<char*>(buf), length, EmptyDeleter);
+    if (rc->GetReqCtx()->traceId_ != 0) {
+        request.set_traceid(rc->GetReqCtx()->traceId_);
+    }
+
+    cntl->request_attachment().append(data);
     ChunkService_Stub stub(&channel_);
     stub.WriteChunk(cntl, &request, response, doneGuard.release());
 
@@ -0,0 +1,121 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include <butil/fast_rand.h>
+
+#include <atomic>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "src/client/request_tracer.h"
+#include "src/common/latency_tracer.h"
+#include "src/common/timeutility.h"
+
+namespace curve {
+namespace client {
+
+using ::curve::common::LatencyTracer;
+using ::curve::common::TimeUtility;
+
+static const std::vector<std::string> kStageNames = {
+    "schedule_queue", "rpc"
+};
+
+static std::atomic<uint32_t> sampleRate(0);
+
+static LatencyTracer* GetTracer(OpType opType) {
+    static LatencyTracer readTracer("client_trace_read", kStageNames);
+    static LatencyTracer writeTracer("client_trace_write", kStageNames);
+    return opType == OpType::READ ? &readTracer : &writeTracer;
+}
+
+void RequestTracer::SetOptions(const RequestTraceOption_t& option) {
+    sampleRate.store(option.sampleRate, std::memory_order_relaxed);
+    GetTracer(OpType::READ)->SetSlowRequestOption(
+        option.slowRequestThresholdUs, option.slowRequestDumpNum);
+    GetTracer(OpType::WRITE)->SetSlowRequestOption(
+        option.slowRequestThresholdUs, option.slowRequestDumpNum);
+}
+
+void RequestTracer::Sample(RequestContext* req) {
+    uint32_t rate = sampleRate.load(std::memory_order_relaxed);
+    if (rate == 0) {
+        return;
+    }
+    if (req->optype_ != OpType::READ && req->optype_ != OpType::WRITE) {
+        return;
+    }
+    if (butil::fast_rand_less_than(rate) != 0) {
+        return;
+    }
+
+    uint64_t traceId = butil::fast_rand();
+    req->traceId_ = (traceId == 0 ? 1 : traceId);
+    req->scheduleTimeUs_ = TimeUtility::GetTimeofDayUs();
+}
+
+void RequestTracer::OnDequeue(RequestContext* req) {
+    if (req->traceId_ == 0) {
+        return;
+    }
+    GetTracer(req->optype_)->RecordStage(
+        static_cast<size_t>(RequestTraceStage::SCHEDULE_QUEUE),
+        TimeUtility::GetTimeofDayUs() - req->scheduleTimeUs_);
+}
+
+void RequestTracer::OnRpcReturn(RequestContext* req, uint64_t rpcStartUs) {
+    if (req->traceId_ == 0) {
+        return;
+    }
+    GetTracer(req->optype_)->RecordStage(
+        static_cast<size_t>(RequestTraceStage::RPC),
+        TimeUtility::GetTimeofDayUs() - rpcStartUs);
+}
+
+void RequestTracer::OnFinish(RequestContext* req,
+                             int status,
+                             uint64_t retriedTimes,
+                             const std::string& remote) {
+    if (req->traceId_ == 0) {
+        return;
+    }
+    LatencyTracer* tracer = GetTracer(req->optype_);
+    int64_t totalUs = TimeUtility::GetTimeofDayUs() - req->scheduleTimeUs_;
+    if (!tracer->RecordTotal(totalUs)) {
+        return;
+    }
+
+    std::ostringstream oss;
+    oss << "traceId=" << req->traceId_
+        << " " << OpTypeToString(req->optype_)
+        << " " << *req
+        << " status=" << status
+        << " retried=" << retriedTimes
+        << " remote=" << remote
+        << " total=" << totalUs << "us";
+    tracer->AddSlowRequest(oss.str());
+}
+
+}   // namespace client
+}   // namespace curve
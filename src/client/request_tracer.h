@@ -0,0 +1,91 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#ifndef SRC_CLIENT_REQUEST_TRACER_H_
+#define SRC_CLIENT_REQUEST_TRACER_H_
+
+#include <string>
+
+#include "src/client/config_info.h"
+#include "src/client/request_context.h"
+
+namespace curve {
+namespace client {
+
+/**
+ * 读写请求在client上依次经过的阶段
+ */
+enum class RequestTraceStage {
+    // 在schedule队列中等待
+    SCHEDULE_QUEUE = 0,
+    // 发送rpc到rpc返回，重试的请求每次发送都会统计
+    RPC = 1,
+    STAGE_NUM = 2,
+};
+
+/**
+ * 按比例采样读写请求，采样的请求携带trace id发送给chunkserver，
+ * chunkserver据此统计该请求在raft及落盘等阶段的耗时。
+ * client上各阶段的耗时统计到client_trace_read/write_*的bvar中，
+ * 超过阈值的慢请求可以通过client_trace_*_slow_requests查看，
+ * 并以trace id为关键字打印日志，用于和chunkserver上的慢请求关联
+ */
+class RequestTracer {
+ public:
+    /**
+     * 设置采样配置，进程内所有文件共享
+     */
+    static void SetOptions(const RequestTraceOption_t& option);
+
+    /**
+     * 请求进入schedule队列时按比例采样，为采样的请求生成trace id
+     */
+    static void Sample(RequestContext* req);
+
+    /**
+     * 请求从schedule队列中取出
+     */
+    static void OnDequeue(RequestContext* req);
+
+    /**
+     * 请求的一次rpc返回
+     * @param rpcStartUs: rpc发送的时间
+     */
+    static void OnRpcReturn(RequestContext* req, uint64_t rpcStartUs);
+
+    /**
+     * 请求结束，统计总耗时，慢请求记录各阶段的耗时
+     * @param status: 请求的返回状态
+     * @param retriedTimes: 请求的重试次数
+     * @param remote: 最后一次rpc的chunkserver地址
+     */
+    static void OnFinish(RequestContext* req,
+                         int status,
+                         uint64_t retriedTimes,
+                         const std::string& remote);
+};
+
+}   // namespace client
+}   // namespace curve
+
+#endif  // SRC_CLIENT_REQUEST_TRACER_H_
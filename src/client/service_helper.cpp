@@ -79,6 +79,15 @@ void ServiceHelper::ProtoFileInfo2Local(const curve::mds::FileInfo* finfo,
     if (finfo->has_clonelength()) {
         fi->cloneLength = finfo->clonelength();
     }
+    if (finfo->has_throttleparams()) {
+        const curve::mds::FileThrottleParams& params =
+            finfo->throttleparams();
+        fi->hasThrottleParams = true;
+        fi->throttleParams.iopsTotal = params.iopstotal();
+        fi->throttleParams.bpsTotal = params.bpstotal();
+        fi->throttleParams.iopsBurst = params.iopsburst();
+        fi->throttleParams.bpsBurst = params.bpsburst();
+    }
 }
 
 class GetLeaderProxy : public std::enable_shared_from_this<GetLeaderProxy> {
@@ -47,11 +47,16 @@ int Splitor::IO2ChunkRequests(IOTracker* iotracker,
                               size_t length,
                               MDSClient* mdsclient,
                               const FInfo_t* fi) {
-    if (targetlist == nullptr|| data == nullptr || mdsclient == nullptr ||
+    if (targetlist == nullptr || mdsclient == nullptr ||
         mc == nullptr || iotracker == nullptr || fi == nullptr) {
         return -1;
     }
 
+    // 向量IO的数据在拆分之后由iotracker按iovec设置，此时data为空
+    if (data == nullptr && !iotracker->IsVectorIO()) {
+        return -1;
+    }
+
     uint64_t chunksize = fi->chunksize;
 
     uint64_t startchunkindex = offset / chunksize;
@@ -77,7 +82,8 @@ int Splitor::IO2ChunkRequests(IOTracker* iotracker,
                  << ", chunkindex = " << startchunkindex
                  << ", endchunkindex = " << endchunkindex;
 
-        if (!AssignInternal(iotracker, mc, targetlist, data + dataoff,
+        const char* buf = data == nullptr ? nullptr : data + dataoff;
+        if (!AssignInternal(iotracker, mc, targetlist, buf,
                             off, len, mdsclient, fi, startchunkindex)) {
             LOG(ERROR)  << "request split failed"
                         << ", off = " << off
@@ -109,9 +115,12 @@ int Splitor::SingleChunkIO2ChunkRequests(IOTracker* iotracker,
                                         off_t offset,
                                         uint64_t length,
                                         uint64_t seq) {
-    if (targetlist == nullptr || mc == nullptr ||
-        iotracker == nullptr   || data == nullptr) {
-            return -1;
+    if (targetlist == nullptr || mc == nullptr || iotracker == nullptr) {
+        return -1;
+    }
+
+    if (data == nullptr && !iotracker->IsVectorIO()) {
+        return -1;
     }
 
     auto max_split_size_bytes = 1024 * iosplitopt_.fileIOSplitMaxSizeKB;
@@ -130,10 +139,11 @@ int Splitor::SingleChunkIO2ChunkRequests(IOTracker* iotracker,
         }
 
         newreqNode->seq_         = seq;
+        const char* buf = data == nullptr ? nullptr : data + off;
         if (iotracker->Optype() == OpType::WRITE) {
-            newreqNode->writeBuffer_ = data + off;
+            newreqNode->writeBuffer_ = buf;
         } else {
-            newreqNode->readBuffer_  = const_cast<char*>(data + off);
+            newreqNode->readBuffer_  = const_cast<char*>(buf);
         }
         // newreqNode->data_        = data + off;
         newreqNode->offset_      = tempoff;
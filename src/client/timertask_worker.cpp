@@ -58,6 +58,11 @@ bool TimerTaskWorker::AddTimerTask(TimerTask* tt) {
     TimePoint key = MicroSeconds(tt->LeaseTime()) + SteadyClock::now();
     taskmap_.insert(std::make_pair(key, tt));
     notemptycv_.notify_one();
+    lk.unlock();
+
+    // 多个文件共用一个worker时，新加入的任务可能早于当前的唤醒时间
+    std::lock_guard<std::mutex> sleeplk(sleepmtx_);
+    sleepcv_.notify_one();
     return true;
 }
 
@@ -124,7 +129,10 @@ void TimerTaskWorker::Run() {
             iter++;
         }
         taskmap_.insert(tempmap.begin(), tempmap.end());
-        nextwakeuptime = taskmap_.begin()->first;
+        // 任务可能在睡眠期间全部被取消
+        if (!taskmap_.empty()) {
+            nextwakeuptime = taskmap_.begin()->first;
+        }
         tempmap.clear();
     }
     taskmap_.clear();
@@ -24,6 +24,7 @@
 #endif
 
 #include <openssl/sha.h>
+#include <openssl/crypto.h>
 
 #include <string.h>
 
@@ -44,6 +45,14 @@ std::string Authenticator::CalcString2Signature(const std::string& in,
     return signature;
 }
 
+bool Authenticator::SignatureEqual(const std::string& lhs,
+                                   const std::string& rhs) {
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+    return CRYPTO_memcmp(lhs.data(), rhs.data(), lhs.size()) == 0;
+}
+
 std::string Authenticator::GetString2Signature(uint64_t date,
                                         const std::string& owner) {
     std::string ret;
@@ -55,6 +55,13 @@ class Authenticator {
     static std::string CalcString2Signature(const std::string& String2Signature,
                                             const std::string& secretKey);
 
+    /**
+     * bref: 比较两个签名是否相同，比较时间与内容无关，避免通过时间猜测签名
+     * @return: 相同返回true，否则返回false
+     */
+    static bool SignatureEqual(const std::string& lhs,
+                               const std::string& rhs);
+
  private:
     static void HMacSha256(
         const unsigned char *text,      /* pointer to data stream        */
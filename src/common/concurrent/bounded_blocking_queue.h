@@ -59,7 +59,7 @@ class BBQItem {
         return stop_.load(std::memory_order_acquire);
     }
 
-    T Item() {
+    T Item() const {
         return item_;
     }
 
@@ -130,6 +130,24 @@ class BoundedBlockingDeque : public Uncopyable {
         return back;
     }
 
+    /**
+     * 如果队首元素满足条件则将其取出，队列为空或者条件不满足时直接返回，不会阻塞
+     * @param pred: 判断队首元素是否需要取出
+     * @param[out] x: 取出的队首元素
+     * @return 取出成功返回true，否则返回false
+     */
+    template<typename Pred>
+    bool TakeFrontIf(Pred pred, T *x) {
+        std::unique_lock<std::mutex> guard(mutex_);
+        if (deque_.empty() || !pred(deque_.front())) {
+            return false;
+        }
+        *x = deque_.front();
+        deque_.pop_front();
+        notFull_.notify_one();
+        return true;
+    }
+
     bool Empty() const {
         std::lock_guard<std::mutex> guard(mutex_);
         return deque_.empty();
@@ -54,6 +54,9 @@ const uint32_t kGB      = 1024*kMB;
 
 // maigic number用于chunkfilepool_meta file计算crc
 const char kChunkFilePoolMaigic[3] = "01";
+
+// 格式化工具分配chunk时临时文件的后缀，数据和rename落盘之后才是可用的chunk
+const char kChunkFilePoolTmpSuffix[] = ".tmp";
 }  // namespace common
 }  // namespace curve
 
@@ -0,0 +1,98 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include <glog/logging.h>
+
+#include "src/common/latency_tracer.h"
+
+namespace curve {
+namespace common {
+
+LatencyTracer::LatencyTracer(const std::string& prefix,
+                             const std::vector<std::string>& stageNames)
+    : prefix_(prefix)
+    , stageNames_(stageNames)
+    , totalLatency_(prefix, "total")
+    , slowThresholdUs_(0)
+    , slowDumpNum_(0)
+    , slowRequestStatus_(prefix + "_slow_requests",
+                         &LatencyTracer::PrintSlowRequests, this) {
+    for (auto& name : stageNames_) {
+        stageLatency_.emplace_back(new bvar::LatencyRecorder(prefix, name));
+    }
+}
+
+void LatencyTracer::SetSlowRequestOption(uint64_t thresholdUs,
+                                         uint32_t dumpNum) {
+    slowThresholdUs_.store(thresholdUs, std::memory_order_relaxed);
+    slowDumpNum_.store(dumpNum, std::memory_order_relaxed);
+
+    LockGuard lk(mtx_);
+    while (slowRequests_.size() > dumpNum) {
+        slowRequests_.pop_front();
+    }
+}
+
+void LatencyTracer::RecordStage(size_t stage, int64_t latencyUs) {
+    if (stage >= stageLatency_.size() || latencyUs < 0) {
+        return;
+    }
+    *stageLatency_[stage] << latencyUs;
+}
+
+bool LatencyTracer::RecordTotal(int64_t latencyUs) {
+    if (latencyUs < 0) {
+        return false;
+    }
+    totalLatency_ << latencyUs;
+
+    uint64_t threshold = slowThresholdUs_.load(std::memory_order_relaxed);
+    return threshold > 0 && static_cast<uint64_t>(latencyUs) >= threshold;
+}
+
+void LatencyTracer::AddSlowRequest(const std::string& desc) {
+    LOG(WARNING) << prefix_ << " slow request, " << desc;
+
+    uint32_t dumpNum = slowDumpNum_.load(std::memory_order_relaxed);
+    LockGuard lk(mtx_);
+    slowRequests_.push_back(desc);
+    while (slowRequests_.size() > dumpNum) {
+        slowRequests_.pop_front();
+    }
+}
+
+std::string LatencyTracer::DumpSlowRequests() {
+    std::string dump;
+    LockGuard lk(mtx_);
+    for (auto& desc : slowRequests_) {
+        dump.append(desc);
+        dump.append("\n");
+    }
+    return dump;
+}
+
+void LatencyTracer::PrintSlowRequests(std::ostream& os, void* arg) {
+    os << static_cast<LatencyTracer*>(arg)->DumpSlowRequests();
+}
+
+}  // namespace common
+}  // namespace curve
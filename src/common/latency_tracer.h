@@ -0,0 +1,116 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#ifndef SRC_COMMON_LATENCY_TRACER_H_
+#define SRC_COMMON_LATENCY_TRACER_H_
+
+#include <bvar/bvar.h>
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "src/common/concurrent/concurrent.h"
+
+namespace curve {
+namespace common {
+
+/**
+ * 采样请求的分阶段延时统计，通过brpc内置服务(/vars)导出：
+ * 1. <prefix>_<stage>: 每个阶段的延时分布
+ * 2. <prefix>_total: 请求的总延时分布
+ * 3. <prefix>_slow_requests: 最近的慢请求，每行一个请求的各阶段耗时
+ * 慢请求同时以WARNING级别打印到日志中，便于按trace id在client和
+ * chunkserver的日志中关联同一个请求
+ */
+class LatencyTracer {
+ public:
+    /**
+     * @param prefix: 导出的bvar的前缀
+     * @param stageNames: 各阶段的名字，阶段按下标记录
+     */
+    LatencyTracer(const std::string& prefix,
+                  const std::vector<std::string>& stageNames);
+
+    /**
+     * 设置慢请求的判定阈值及保留的慢请求个数
+     * @param thresholdUs: 总延时超过该值的请求为慢请求，0表示不记录慢请求
+     * @param dumpNum: 保留的最近慢请求的个数
+     */
+    void SetSlowRequestOption(uint64_t thresholdUs, uint32_t dumpNum);
+
+    /**
+     * 记录一个请求在某个阶段的耗时
+     * @param stage: 阶段的下标
+     * @param latencyUs: 耗时，单位us
+     */
+    void RecordStage(size_t stage, int64_t latencyUs);
+
+    /**
+     * 记录一个请求的总延时
+     * @param latencyUs: 总延时，单位us
+     * @return: 是否为慢请求，是慢请求时调用者需要通过AddSlowRequest记录
+     */
+    bool RecordTotal(int64_t latencyUs);
+
+    /**
+     * 记录一个慢请求
+     * @param desc: 慢请求的描述，包括trace id及各阶段的耗时
+     */
+    void AddSlowRequest(const std::string& desc);
+
+    /**
+     * 获取最近的慢请求，从旧到新每行一个
+     */
+    std::string DumpSlowRequests();
+
+    const std::string& GetStageName(size_t stage) const {
+        return stageNames_[stage];
+    }
+
+ private:
+    static void PrintSlowRequests(std::ostream& os, void* arg);
+
+ private:
+    std::string prefix_;
+    std::vector<std::string> stageNames_;
+
+    std::vector<std::unique_ptr<bvar::LatencyRecorder>> stageLatency_;
+    bvar::LatencyRecorder totalLatency_;
+
+    std::atomic<uint64_t> slowThresholdUs_;
+    std::atomic<uint32_t> slowDumpNum_;
+
+    // 最近的慢请求，超过slowDumpNum_时淘汰最早的
+    std::deque<std::string> slowRequests_;
+    Mutex mtx_;
+
+    bvar::PassiveStatus<std::string> slowRequestStatus_;
+};
+
+}  // namespace common
+}  // namespace curve
+
+#endif  // SRC_COMMON_LATENCY_TRACER_H_
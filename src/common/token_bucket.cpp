@@ -0,0 +1,74 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include "src/common/token_bucket.h"
+
+#include <algorithm>
+
+namespace curve {
+namespace common {
+
+TokenBucket::TokenBucket(uint64_t rate, uint64_t burst)
+    : rate_(rate)
+    , burst_(burst == 0 ? rate : burst)
+    , tokens_(burst_)
+    , lastRefillUs_(0) {}
+
+void TokenBucket::SetRate(uint64_t rate, uint64_t burst) {
+    rate_ = rate;
+    burst_ = (burst == 0 ? rate : burst);
+    tokens_ = std::min(tokens_, static_cast<double>(burst_));
+}
+
+void TokenBucket::Refill(uint64_t nowUs) {
+    if (nowUs <= lastRefillUs_) {
+        return;
+    }
+    tokens_ += static_cast<double>(nowUs - lastRefillUs_) * rate_ / 1000000;
+    tokens_ = std::min(tokens_, static_cast<double>(burst_));
+    lastRefillUs_ = nowUs;
+}
+
+uint64_t TokenBucket::GetWaitUs(uint64_t tokens, uint64_t nowUs) {
+    if (Unlimited()) {
+        return 0;
+    }
+    Refill(nowUs);
+    double need = std::min(tokens, burst_);
+    if (tokens_ >= need) {
+        return 0;
+    }
+    // 向上取整，避免醒来之后令牌仍然不足
+    return static_cast<uint64_t>((need - tokens_) * 1000000 / rate_) + 1;
+}
+
+void TokenBucket::Consume(uint64_t tokens, uint64_t nowUs) {
+    if (Unlimited()) {
+        return;
+    }
+    Refill(nowUs);
+    tokens_ -= tokens;
+}
+
+}  // namespace common
+}  // namespace curve
@@ -0,0 +1,91 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#ifndef SRC_COMMON_TOKEN_BUCKET_H_
+#define SRC_COMMON_TOKEN_BUCKET_H_
+
+#include <cstdint>
+
+namespace curve {
+namespace common {
+
+/**
+ * 令牌桶，令牌以rate个每秒的速度生成，桶中最多保存burst个令牌。
+ * 一次获取的令牌数大于burst时，桶满即可获取，之后令牌数变为负数，
+ * 由后续的请求等待补齐，避免大请求永远无法获取令牌。
+ * 非线程安全，由调用者加锁，时间由调用者传入便于测试
+ */
+class TokenBucket {
+ public:
+    TokenBucket() : TokenBucket(0) {}
+
+    /**
+     * @param rate: 每秒生成的令牌数，为0表示不限制
+     * @param burst: 桶的容量，为0时使用rate
+     */
+    explicit TokenBucket(uint64_t rate, uint64_t burst = 0);
+
+    /**
+     * 修改令牌生成速度和桶的容量，桶中已有的令牌数不超过新的容量
+     */
+    void SetRate(uint64_t rate, uint64_t burst = 0);
+
+    /**
+     * 获取指定数量的令牌还需要等待的时间
+     * @param tokens: 需要的令牌数
+     * @param nowUs: 当前时间，单位us
+     * @return: 需要等待的时间，单位us，为0表示可以立即获取
+     */
+    uint64_t GetWaitUs(uint64_t tokens, uint64_t nowUs);
+
+    /**
+     * 扣除令牌，调用前需要通过GetWaitUs确认可以获取
+     */
+    void Consume(uint64_t tokens, uint64_t nowUs);
+
+    bool Unlimited() const {
+        return rate_ == 0;
+    }
+
+    uint64_t GetRate() const {
+        return rate_;
+    }
+
+ private:
+    void Refill(uint64_t nowUs);
+
+ private:
+    // 每秒生成的令牌数
+    uint64_t rate_;
+    // 桶的容量
+    uint64_t burst_;
+    // 桶中当前的令牌数，可能为负数
+    double tokens_;
+    // 上一次补充令牌的时间
+    uint64_t lastRefillUs_;
+};
+
+}  // namespace common
+}  // namespace curve
+
+#endif  // SRC_COMMON_TOKEN_BUCKET_H_
@@ -21,6 +21,7 @@
  */
 
 #include <glog/logging.h>
+#include <vector>
 #include "src/mds/heartbeat/chunkserver_healthy_checker.h"
 #include "src/mds/topology/topology_item.h"
 #include "proto/topology.pb.h"
@@ -36,28 +37,45 @@ namespace curve {
 namespace mds {
 namespace heartbeat {
 void ChunkserverHealthyChecker::CheckHeartBeatInterval() {
-    ::curve::common::WriteLockGuard lk(hbinfoLock_);
-    auto iter = heartbeatInfos_.begin();
-    while (iter != heartbeatInfos_.end()) {
+    // 读锁下获取心跳信息的快照，更新topology时不持有锁，避免阻塞心跳
+    std::vector<HeartbeatInfo> infos;
+    {
+        ::curve::common::ReadLockGuard lk(hbinfoLock_);
+        infos.reserve(heartbeatInfos_.size());
+        for (const auto &item : heartbeatInfos_) {
+            infos.emplace_back(item.second->ToHeartbeatInfo());
+        }
+    }
+
+    std::vector<ChunkServerIdType> retired;
+    for (auto &info : infos) {
         // 检测状态是否需要更新
         OnlineState newState;
-        bool needUpdate = ChunkServerStateNeedUpdate(iter->second, &newState);
+        bool needUpdate = ChunkServerStateNeedUpdate(info, &newState);
 
         // 将chunkserver的状态更新到topology中
         if (needUpdate) {
-            UpdateChunkServerOnlineState(iter->first, newState);
-            iter->second.state = newState;
+            UpdateChunkServerOnlineState(info.csId, newState);
+            info.state = newState;
         }
 
         // 如果是offline状态，并且chunkserver上没有copyset，设置为retired状态
         // 一般换盘的场景会出现
-        bool iterNeedMove = TrySetChunkServerRetiredIfNeed(iter->second);
-        if (iterNeedMove) {
-            iter = heartbeatInfos_.erase(iter);
-        } else {
-            iter++;
+        if (TrySetChunkServerRetiredIfNeed(info)) {
+            retired.emplace_back(info.csId);
+        }
+    }
+
+    ::curve::common::WriteLockGuard lk(hbinfoLock_);
+    for (const auto &info : infos) {
+        auto iter = heartbeatInfos_.find(info.csId);
+        if (iter != heartbeatInfos_.end()) {
+            iter->second->state = info.state;
         }
     }
+    for (auto csId : retired) {
+        heartbeatInfos_.erase(csId);
+    }
 }
 
 bool ChunkserverHealthyChecker::ChunkServerStateNeedUpdate(
@@ -103,22 +121,35 @@ bool ChunkserverHealthyChecker::ChunkServerStateNeedUpdate(
 
 void ChunkserverHealthyChecker::UpdateLastReceivedHeartbeatTime(
     ChunkServerIdType csId, const steady_clock::time_point &time) {
+    {
+        ::curve::common::ReadLockGuard lk(hbinfoLock_);
+        auto iter = heartbeatInfos_.find(csId);
+        if (iter != heartbeatInfos_.end()) {
+            iter->second->lastReceivedTime.store(
+                time.time_since_epoch().count());
+            return;
+        }
+    }
+
     ::curve::common::WriteLockGuard lk(hbinfoLock_);
-    if (heartbeatInfos_.find(csId) == heartbeatInfos_.end()) {
-        heartbeatInfos_.emplace(
-            csId, HeartbeatInfo(csId, time, OnlineState::UNSTABLE));
+    auto iter = heartbeatInfos_.find(csId);
+    if (iter == heartbeatInfos_.end()) {
+        heartbeatInfos_.emplace(csId, std::unique_ptr<HeartbeatSlot>(
+            new HeartbeatSlot(csId, time, OnlineState::UNSTABLE)));
         return;
     }
-    heartbeatInfos_[csId].lastReceivedTime = time;
+    iter->second->lastReceivedTime.store(time.time_since_epoch().count());
 }
 
 bool ChunkserverHealthyChecker::GetHeartBeatInfo(
     ChunkServerIdType id, HeartbeatInfo *info) {
-    if (heartbeatInfos_.find(id) == heartbeatInfos_.end()) {
+    ::curve::common::ReadLockGuard lk(hbinfoLock_);
+    auto iter = heartbeatInfos_.find(id);
+    if (iter == heartbeatInfos_.end()) {
         return false;
     }
 
-    *info = heartbeatInfos_[id];
+    *info = iter->second->ToHeartbeatInfo();
     return true;
 }
 
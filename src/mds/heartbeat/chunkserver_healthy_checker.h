@@ -23,6 +23,7 @@
 #ifndef SRC_MDS_HEARTBEAT_CHUNKSERVER_HEALTHY_CHECKER_H_
 #define SRC_MDS_HEARTBEAT_CHUNKSERVER_HEALTHY_CHECKER_H_
 
+#include <atomic>
 #include <chrono> //NOLINT
 #include <memory>
 #include <map>
@@ -46,6 +47,14 @@ struct HeartbeatOption {
         this->heartbeatIntervalMs = heartbeatInterval;
         this->heartbeatMissTimeOutMs = heartbeatMissTimeout;
         this->offLineTimeOutMs = offLineTimeout;
+        this->cleanFollowerAfterMs = 0;
+        this->enableChunkServerQos = false;
+        this->chunkserverQosIops = 0;
+        this->chunkserverQosBps = 0;
+        this->copysetQosIops = 0;
+        this->copysetQosBps = 0;
+        this->clientQosIops = 0;
+        this->clientQosBps = 0;
     }
 
     // heartbeatIntervalMs: 正常心跳间隔.
@@ -68,6 +77,16 @@ struct HeartbeatOption {
 
     // mdsStartTime: mds启动时间
     steady_clock::time_point mdsStartTime;
+
+    // enableChunkServerQos: 是否在心跳中给chunkserver下发QoS限制
+    bool enableChunkServerQos;
+    // chunkserver、copyset和client级别的iops和带宽上限，0表示不限制
+    uint64_t chunkserverQosIops;
+    uint64_t chunkserverQosBps;
+    uint64_t copysetQosIops;
+    uint64_t copysetQosBps;
+    uint64_t clientQosIops;
+    uint64_t clientQosBps;
 };
 
 struct HeartbeatInfo {
@@ -86,6 +105,28 @@ struct HeartbeatInfo {
     OnlineState state;
 };
 
+/**
+ * @brief 每个chunkserver的心跳信息，心跳到达时只原子的更新lastReceivedTime，
+ *        state只由检查线程修改
+ */
+struct HeartbeatSlot {
+    HeartbeatSlot(ChunkServerIdType id,
+                  const steady_clock::time_point& time,
+                  const OnlineState& state)
+        : csId(id), lastReceivedTime(time.time_since_epoch().count()),
+          state(state) {}
+
+    HeartbeatInfo ToHeartbeatInfo() const {
+        steady_clock::duration d(lastReceivedTime.load());
+        return HeartbeatInfo(csId, steady_clock::time_point(d), state);
+    }
+
+    ChunkServerIdType csId;
+    // steady_clock::time_point的计数
+    std::atomic<steady_clock::rep> lastReceivedTime;
+    OnlineState state;
+};
+
 class ChunkserverHealthyChecker {
  public:
     explicit ChunkserverHealthyChecker(
@@ -134,8 +175,10 @@ class ChunkserverHealthyChecker {
     HeartbeatOption option_;
     std::shared_ptr<Topology> topo_;
 
+    // 只有增加或删除chunkserver时加写锁，心跳到达时加读锁
     mutable RWLock hbinfoLock_;
-    std::map<ChunkServerIdType, HeartbeatInfo> heartbeatInfos_;
+    std::map<ChunkServerIdType, std::unique_ptr<HeartbeatSlot>>
+        heartbeatInfos_;
 };
 
 }  // namespace heartbeat
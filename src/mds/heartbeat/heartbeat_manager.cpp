@@ -58,6 +58,14 @@ HeartbeatManager::HeartbeatManager(HeartbeatOption option,
 
     isStop_ = true;
     chunkserverHealthyCheckerRunInter_ = option.heartbeatMissTimeOutMs;
+
+    enableChunkServerQos_ = option.enableChunkServerQos;
+    qosConf_.set_chunkserveriops(option.chunkserverQosIops);
+    qosConf_.set_chunkserverbps(option.chunkserverQosBps);
+    qosConf_.set_copysetiops(option.copysetQosIops);
+    qosConf_.set_copysetbps(option.copysetQosBps);
+    qosConf_.set_clientiops(option.clientQosIops);
+    qosConf_.set_clientbps(option.clientQosBps);
 }
 
 void HeartbeatManager::Init() {
@@ -169,6 +177,20 @@ void HeartbeatManager::UpdateChunkServerStatistics(
                              << ", " << cstat.copysetId << "} "
                              << "do not have CopysetStatistics";
             }
+            cstat.inconsistentChunkNum =
+                request.copysetinfos(i).inconsistentchunks_size();
+            if (cstat.inconsistentChunkNum > 0) {
+                std::string chunks;
+                for (auto chunkId :
+                    request.copysetinfos(i).inconsistentchunks()) {
+                    chunks += std::to_string(chunkId) + " ";
+                }
+                LOG(ERROR) << "chunkserver(id:" << request.chunkserverid()
+                           << ",ip:" << request.ip() << ",port:"
+                           << request.port() << ") report copyset("
+                           << cstat.logicalPoolId << "," << cstat.copysetId
+                           << ") has inconsistent chunks: " << chunks;
+            }
             stat.copysetStats.push_back(cstat);
         }
 
@@ -204,6 +226,11 @@ void HeartbeatManager::ChunkServerHeartbeat(
     UpdateChunkServerDiskStatus(request);
 
     UpdateChunkServerStatistics(request);
+
+    if (enableChunkServerQos_) {
+        *response->mutable_qosconf() = qosConf_;
+    }
+
     // request里面没有copyset信息
     if (request.copysetinfos_size() == 0) {
         response->set_statuscode(HeartbeatStatusCode::hbRequestNoCopyset);
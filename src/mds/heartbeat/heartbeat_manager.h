@@ -179,6 +179,10 @@ class HeartbeatManager {
     Atomic<bool> isStop_;
     InterruptibleSleeper sleeper_;
     int chunkserverHealthyCheckerRunInter_;
+
+    // 是否在心跳回复中下发QoS限制
+    bool enableChunkServerQos_;
+    ChunkServerQosConf qosConf_;
 };
 
 }  // namespace heartbeat
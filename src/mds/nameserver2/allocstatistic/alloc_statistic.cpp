@@ -122,6 +122,45 @@ void AllocStatistic::DeAllocSpace(
     }
 }
 
+RWLock &AllocStatistic::GetFileAllocLock(uint64_t fileId) {
+    return fileChangeLocks_[fileId % kFileAllocLockNum];
+}
+
+bool AllocStatistic::GetAllocByFile(
+    uint64_t fileId, std::map<PoolIdType, int64_t> *alloc) {
+    ReadLockGuard guard(fileAllocLock_);
+    auto iter = fileAlloc_.find(fileId);
+    if (iter == fileAlloc_.end()) {
+        return false;
+    }
+    *alloc = iter->second;
+    return true;
+}
+
+void AllocStatistic::SetFileAlloc(
+    uint64_t fileId, const std::map<PoolIdType, int64_t> &alloc) {
+    WriteLockGuard guard(fileAllocLock_);
+    fileAlloc_[fileId] = alloc;
+}
+
+void AllocStatistic::UpdateFileAlloc(
+    uint64_t fileId, PoolIdType lid, int64_t changeSize) {
+    WriteLockGuard guard(fileAllocLock_);
+    auto iter = fileAlloc_.find(fileId);
+    if (iter == fileAlloc_.end()) {
+        return;
+    }
+    iter->second[lid] += changeSize;
+    if (iter->second[lid] == 0) {
+        iter->second.erase(lid);
+    }
+}
+
+void AllocStatistic::RemoveFileAlloc(uint64_t fileId) {
+    WriteLockGuard guard(fileAllocLock_);
+    fileAlloc_.erase(fileId);
+}
+
 void AllocStatistic::CalculateSegmentAlloc() {
     // 从etcd中获取revision之前的alloc数据
     int res;
@@ -27,6 +27,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include "src/kvstorageclient/etcd_client.h"
 #include "src/mds/common/mds_define.h"
 #include "src/common/concurrent/concurrent.h"
@@ -61,6 +62,10 @@ using ::curve::kvstorage::EtcdClientImp;
  * 根据当前的统计状态给外部提供segment分配量:
  * 1. 如果part1部分全部完成，从mergeMap_中获取数据
  * 2. 如果part1部分未完成，从existSegmentAllocValues_中获取数据
+ *
+ * 此外在内存中统计每个文件在各logicalPool上的segment分配量:
+ * 文件创建或第一次查询时加入统计，之后随segment的分配和释放更新，
+ * 查询文件的分配量时不需要再list文件的所有segment
  */
 class AllocStatistic {
  public:
@@ -134,6 +139,53 @@ class AllocStatistic {
     virtual void DeAllocSpace(
         PoolIdType, int64_t changeSize, int64_t revision);
 
+    /**
+     * @brief GetFileAllocLock 获取文件对应的锁，
+     *        写入或删除文件的segment时持有读锁，加载文件的统计值时持有写锁，
+     *        保证加载时没有正在进行的segment变化
+     *
+     * @param[in] fileId 文件的inode id
+     */
+    RWLock &GetFileAllocLock(uint64_t fileId);
+
+    /**
+     * @brief GetAllocByFile 获取文件在各logicalPool上已分配的segment大小
+     *
+     * @param[in] fileId 文件的inode id
+     * @param[out] alloc logicalPoolId到已分配segment大小的映射
+     *
+     * @return true表示获取成功，false表示文件的统计值还未加载
+     */
+    bool GetAllocByFile(uint64_t fileId, std::map<PoolIdType, int64_t> *alloc);
+
+    /**
+     * @brief SetFileAlloc 设置文件的统计值，用于创建文件和加载文件的统计值，
+     *        加载时需要持有GetFileAllocLock的写锁
+     *
+     * @param[in] fileId 文件的inode id
+     * @param[in] alloc logicalPoolId到已分配segment大小的映射
+     */
+    void SetFileAlloc(uint64_t fileId,
+                      const std::map<PoolIdType, int64_t> &alloc);
+
+    /**
+     * @brief UpdateFileAlloc 写入或删除segment后更新文件的统计值，
+     *        文件的统计值未加载时不做处理，需要持有GetFileAllocLock的读锁
+     *
+     * @param[in] fileId 文件的inode id
+     * @param[in] lid segment所在的logicalpoolId
+     * @param[in] changeSize segment的变化量
+     */
+    void UpdateFileAlloc(uint64_t fileId, PoolIdType lid, int64_t changeSize);
+
+    /**
+     * @brief RemoveFileAlloc 清除文件的统计值，文件删除后调用，
+     *        segment变化结果不确定时也调用，下次查询时重新加载
+     *
+     * @param[in] fileId 文件的inode id
+     */
+    void RemoveFileAlloc(uint64_t fileId);
+
  private:
      /**
      * @brief CalculateSegmentAlloc 从etcd中获取指定revision的所有segment记录
@@ -223,6 +275,14 @@ class AllocStatistic {
 
     // 统计指定revision下已分配segment大小的线程
     Thread calculateAlloc_;
+
+    // 文件的inode id -> 文件在各logicalPool上已分配的segment大小
+    std::unordered_map<uint64_t, std::map<PoolIdType, int64_t>> fileAlloc_;
+    RWLock fileAllocLock_;
+
+    // 按照文件inode id分段的锁，用于segment变化和加载文件统计值之间的互斥
+    static const int kFileAllocLockNum = 256;
+    RWLock fileChangeLocks_[kFileAllocLockNum];
 };
 }  // namespace mds
 }  // namespace curve
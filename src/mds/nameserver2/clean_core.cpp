@@ -22,6 +22,8 @@
 
 #include "src/mds/nameserver2/clean_core.h"
 
+using ::curve::common::ReadLockGuard;
+
 namespace curve {
 namespace mds {
 StatusCode CleanCore::CleanSnapShotFile(const FileInfo & fileInfo,
@@ -143,6 +145,8 @@ StatusCode CleanCore::CleanFile(const FileInfo & commonFile,
 
         // delete segment
         int64_t revision;
+        ReadLockGuard guard(
+            allocStatistic_->GetFileAllocLock(commonFile.id()));
         storeRet = storage_->DeleteSegment(
             commonFile.id(), i * segmentSize, &revision);
         if (storeRet != StoreStatus::OK) {
@@ -151,11 +155,14 @@ StatusCode CleanCore::CleanFile(const FileInfo & commonFile,
             << ", filename = " << commonFile.filename()
             << ", offset = " << i * segmentSize
             << ", sequenceNum = " << commonFile.seqnum();
+            allocStatistic_->RemoveFileAlloc(commonFile.id());
             progress->SetStatus(TaskStatus::FAILED);
             return StatusCode::kCommonFileDeleteError;
         }
         allocStatistic_->DeAllocSpace(segment.logicalpoolid(),
             segment.segmentsize(), revision);
+        allocStatistic_->UpdateFileAlloc(commonFile.id(),
+            segment.logicalpoolid(), 0L - segment.segmentsize());
         progress->SetProgress(100 * (i + 1) / segmentNum);
     }
 
@@ -167,6 +174,7 @@ StatusCode CleanCore::CleanFile(const FileInfo & commonFile,
         progress->SetStatus(TaskStatus::FAILED);
         return StatusCode::kCommonFileDeleteError;
     } else {
+        allocStatistic_->RemoveFileAlloc(commonFile.id());
         LOG(INFO) << "inodeid = " << commonFile.id()
             << ", filename = " << commonFile.filename()
             << ", seq = " << commonFile.seqnum() << ", deleted";
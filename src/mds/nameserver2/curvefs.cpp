@@ -36,6 +36,8 @@ using curve::common::TimeUtility;
 using ::std::chrono::steady_clock;
 using ::std::chrono::microseconds;
 using curve::mds::topology::LogicalPool;
+using curve::common::ReadLockGuard;
+using curve::common::WriteLockGuard;
 
 namespace curve {
 namespace mds {
@@ -98,9 +100,13 @@ bool CurveFS::Init(std::shared_ptr<NameServerStorage> storage,
     allocStatistic_ = allocStatistic;
     fileRecordManager_ = fileRecordManager;
     rootAuthOptions_ = curveFSOptions.authOptions;
+    fileTokenKey_ = Authenticator::CalcString2Signature(
+        "curve_file_token_key", rootAuthOptions_.rootPassword);
+    fileTokenExpiredTimeSec_ = curveFSOptions.fileTokenExpiredTimeSec;
 
     defaultChunkSize_ = curveFSOptions.defaultChunkSize;
     topology_ = topology;
+    dentryCache_.SetMaxCount(curveFSOptions.dentryCacheSize);
 
     InitRootFile();
     bool ret = InitRecycleBinDir();
@@ -148,25 +154,56 @@ StatusCode CurveFS::WalkPath(const std::string &fileName,
     }
 
     *lastEntry = paths.back();
-    uint64_t parentID = rootFileInfo_.id();
+    if (paths.size() == 1) {
+        return StatusCode::kOK;
+    }
 
-    for (uint32_t i = 0; i < paths.size() - 1; i++) {
-        auto ret = storage_->GetFile(parentID, paths[i], fileInfo);
+    // 先查找父目录的完整路径，命中时不需要逐级解析
+    std::string parentPath;
+    if (dentryCache_.Enabled()) {
+        for (uint32_t i = 0; i < paths.size() - 1; i++) {
+            parentPath += "/" + paths[i];
+        }
+        if (dentryCache_.GetPath(parentPath, fileInfo)) {
+            return StatusCode::kOK;
+        }
+    }
 
-        if (ret ==  StoreStatus::OK) {
-            if (fileInfo->filetype() !=  FileType::INODE_DIRECTORY) {
-                LOG(INFO) << fileInfo->filename() << " is not an directory";
-                return StatusCode::kNotDirectory;
-            }
-        } else if (ret == StoreStatus::KeyNotExist) {
-            return StatusCode::kFileNotExists;
-        } else {
-            LOG(ERROR) << "GetFile error, errcode = " << ret;
-            return StatusCode::kStorageError;
+    uint64_t generation = dentryCache_.GetGeneration();
+    uint64_t parentID = rootFileInfo_.id();
+    for (uint32_t i = 0; i < paths.size() - 1; i++) {
+        auto ret = LookUpDir(parentID, paths[i], generation, fileInfo);
+        if (ret != StatusCode::kOK) {
+            return ret;
         }
         // assert(fileInfo->parentid() != parentID);
         parentID =  fileInfo->id();
     }
+    if (dentryCache_.Enabled()) {
+        dentryCache_.PutPath(parentPath, *fileInfo, generation);
+    }
+    return StatusCode::kOK;
+}
+
+StatusCode CurveFS::LookUpDir(uint64_t parentId, const std::string &dirName,
+                              uint64_t generation, FileInfo *fileInfo) const {
+    if (dentryCache_.GetDentry(parentId, dirName, fileInfo)) {
+        return StatusCode::kOK;
+    }
+
+    auto ret = storage_->GetFile(parentId, dirName, fileInfo);
+    if (ret ==  StoreStatus::OK) {
+        if (fileInfo->filetype() !=  FileType::INODE_DIRECTORY) {
+            LOG(INFO) << fileInfo->filename() << " is not an directory";
+            return StatusCode::kNotDirectory;
+        }
+    } else if (ret == StoreStatus::KeyNotExist) {
+        return StatusCode::kFileNotExists;
+    } else {
+        LOG(ERROR) << "GetFile " << dirName << " error, errcode = " << ret;
+        return StatusCode::kStorageError;
+    }
+    dentryCache_.PutDentry(parentId, dirName, *fileInfo, generation);
     return StatusCode::kOK;
 }
 
@@ -278,6 +315,10 @@ StatusCode CurveFS::CreateFile(const std::string & fileName,
         fileInfo.set_filestatus(FileStatus::kFileCreated);
 
         ret = PutFile(fileInfo);
+        if (ret == StatusCode::kOK && filetype == FileType::INODE_PAGEFILE) {
+            // 新文件没有segment，之后的查询不需要list segment
+            allocStatistic_->SetFileAlloc(inodeID, {});
+        }
         return ret;
     }
 }
@@ -342,25 +383,48 @@ StatusCode CurveFS::GetAllocatedSize(const std::string& fileName,
 StatusCode CurveFS::GetFileAllocSize(const std::string& fileName,
                                      const FileInfo& fileInfo,
                                      AllocatedSize* allocSize) {
-    std::vector<PageFileSegment> segments;
-    auto listSegmentRet = storage_->ListSegment(fileInfo.id(), &segments);
-
-    if (listSegmentRet != StoreStatus::OK) {
-        return StatusCode::kStorageError;
+    std::map<PoolIdType, int64_t> alloc;
+    if (!allocStatistic_->GetAllocByFile(fileInfo.id(), &alloc)) {
+        auto ret = LoadFileAlloc(fileInfo, &alloc);
+        if (ret != StatusCode::kOK) {
+            return ret;
+        }
     }
-    for (const auto& segment : segments) {
-        const auto & logicPoolId = segment.logicalpoolid();
+
+    allocSize->allocatedSize = 0;
+    allocSize->physicalAllocatedSize = 0;
+    for (const auto& item : alloc) {
         LogicalPool logicPool;
-        if (!topology_->GetLogicalPool(logicPoolId, &logicPool)) {
-            LOG(ERROR) << "Get logical pool " << logicPoolId
+        if (!topology_->GetLogicalPool(item.first, &logicPool)) {
+            LOG(ERROR) << "Get logical pool " << item.first
                        << " from topology failed!";
             return StatusCode::KInternalError;
         }
         uint64_t replicasNum = logicPool.GetReplicaNum();
-        allocSize->physicalAllocatedSize +=
-                    fileInfo.segmentsize() * replicasNum;
+        allocSize->allocatedSize += item.second;
+        allocSize->physicalAllocatedSize += item.second * replicasNum;
     }
-    allocSize->allocatedSize = fileInfo.segmentsize() * segments.size();
+    return StatusCode::kOK;
+}
+
+StatusCode CurveFS::LoadFileAlloc(const FileInfo& fileInfo,
+                                  std::map<PoolIdType, int64_t>* alloc) {
+    // 持有写锁，加载期间文件没有正在进行的segment变化
+    WriteLockGuard guard(allocStatistic_->GetFileAllocLock(fileInfo.id()));
+    if (allocStatistic_->GetAllocByFile(fileInfo.id(), alloc)) {
+        return StatusCode::kOK;
+    }
+
+    std::vector<PageFileSegment> segments;
+    auto listSegmentRet = storage_->ListSegment(fileInfo.id(), &segments);
+    if (listSegmentRet != StoreStatus::OK) {
+        return StatusCode::kStorageError;
+    }
+    alloc->clear();
+    for (const auto& segment : segments) {
+        (*alloc)[segment.logicalpoolid()] += fileInfo.segmentsize();
+    }
+    allocStatistic_->SetFileAlloc(fileInfo.id(), *alloc);
     return StatusCode::kOK;
 }
 
@@ -498,6 +562,7 @@ StatusCode CurveFS::DeleteFile(const std::string & filename, uint64_t fileId,
             return StatusCode::kStorageError;
         }
 
+        dentryCache_.Invalidate();
         LOG(INFO) << "delete file success, file is directory"
                   << ", filename = " << filename;
         return StatusCode::kOK;
@@ -866,6 +931,35 @@ StatusCode CurveFS::ChangeOwner(const std::string &filename,
 
     // 修改文件owner
     fileInfo.set_owner(newOwner);
+    ret = PutFile(fileInfo);
+    if (ret == StatusCode::kOK &&
+        fileInfo.filetype() == FileType::INODE_DIRECTORY) {
+        // 缓存中的目录owner用于路径校验，需要失效
+        dentryCache_.Invalidate();
+    }
+    return ret;
+}
+
+StatusCode CurveFS::UpdateFileThrottleParams(const std::string &filename,
+                                             const FileThrottleParams *params) {
+    FileInfo  fileInfo;
+    StatusCode ret = GetFileInfo(filename, &fileInfo);
+    if (ret != StatusCode::kOK) {
+        LOG(INFO) << "get source file error, errCode = " << ret;
+        return  ret;
+    }
+
+    if (fileInfo.filetype() != FileType::INODE_PAGEFILE) {
+        LOG(WARNING) << "file type not support update throttle params"
+                     << ", filename = " << filename;
+        return StatusCode::kNotSupported;
+    }
+
+    if (params == nullptr) {
+        fileInfo.clear_throttleparams();
+    } else {
+        fileInfo.mutable_throttleparams()->CopyFrom(*params);
+    }
     return PutFile(fileInfo);
 }
 
@@ -881,6 +975,36 @@ StatusCode CurveFS::GetOrAllocateSegment(const std::string & filename,
         return  ret;
     }
 
+    return GetOrAllocateSegmentInternal(filename, fileInfo, offset,
+                                        allocateIfNoExist, segment);
+}
+
+StatusCode CurveFS::GetOrAllocateSegmentById(InodeID fileId,
+        InodeID parentId, const std::string & filename,
+        const std::string & owner, offset_t offset, bool allocateIfNoExist,
+        PageFileSegment *segment) {
+    assert(segment != nullptr);
+
+    FileInfo  fileInfo;
+    auto ret = LookUpFileById(fileId, parentId, filename, &fileInfo);
+    if (ret != StatusCode::kOK) {
+        return  ret;
+    }
+
+    if (owner != GetRootOwner() && fileInfo.owner() != owner) {
+        LOG(WARNING) << "GetOrAllocateSegmentById owner not match"
+                     << ", fileName = " << filename << ", owner = " << owner
+                     << ", file owner = " << fileInfo.owner();
+        return StatusCode::kOwnerAuthFail;
+    }
+
+    return GetOrAllocateSegmentInternal(filename, fileInfo, offset,
+                                        allocateIfNoExist, segment);
+}
+
+StatusCode CurveFS::GetOrAllocateSegmentInternal(const std::string &filename,
+        const FileInfo &fileInfo, offset_t offset, bool allocateIfNoExist,
+        PageFileSegment *segment) {
     if (fileInfo.filetype() != FileType::INODE_PAGEFILE) {
         LOG(INFO) << "not pageFile, can't do this";
         return StatusCode::kParaError;
@@ -914,17 +1038,24 @@ StatusCode CurveFS::GetOrAllocateSegment(const std::string & filename,
                 return StatusCode::kSegmentAllocateError;
             }
             int64_t revision;
+            // 写入segment和更新文件的分配统计期间不能加载文件的统计值
+            ReadLockGuard guard(
+                allocStatistic_->GetFileAllocLock(fileInfo.id()));
             if (storage_->PutSegment(fileInfo.id(), offset, segment, &revision)
                 != StoreStatus::OK) {
                 LOG(ERROR) << "PutSegment fail, fileInfo.id() = "
                            << fileInfo.id()
                            << ", offset = "
                            << offset;
+                // segment可能已经写入，下次查询时重新加载
+                allocStatistic_->RemoveFileAlloc(fileInfo.id());
                 return StatusCode::kStorageError;
             }
             allocStatistic_->AllocSpace(segment->logicalpoolid(),
                     segment->segmentsize(),
                     revision);
+            allocStatistic_->UpdateFileAlloc(fileInfo.id(),
+                    segment->logicalpoolid(), segment->segmentsize());
 
             LOG(INFO) << "alloc segment success, fileInfo.id() = "
                       << fileInfo.id()
@@ -1339,6 +1470,140 @@ StatusCode CurveFS::RefreshSession(const std::string &fileName,
     return StatusCode::kOK;
 }
 
+StatusCode CurveFS::CheckRefreshSessionOwner(const std::string &owner,
+                                             const std::string &signature,
+                                             uint64_t date) {
+    if (owner.empty()) {
+        LOG(ERROR) << "refresh session owner is empty";
+        return StatusCode::kOwnerAuthFail;
+    }
+
+    if (!CheckDate(date)) {
+        LOG(ERROR) << "check date fail, request is staled.";
+        return StatusCode::kOwnerAuthFail;
+    }
+
+    if (owner == GetRootOwner() && !CheckSignature(owner, signature, date)) {
+        LOG(ERROR) << "check root owner fail, signature auth fail.";
+        return StatusCode::kOwnerAuthFail;
+    }
+
+    return StatusCode::kOK;
+}
+
+StatusCode CurveFS::RefreshSessionById(InodeID fileId,
+                                       InodeID parentId,
+                                       const std::string &fileName,
+                                       const std::string &owner,
+                                       const std::string &clientIP,
+                                       uint32_t clientPort,
+                                       const std::string &clientVersion,
+                                       FileInfo *fileInfo) {
+    auto ret = LookUpFileById(fileId, parentId, fileName, fileInfo);
+    if (ret != StatusCode::kOK) {
+        return ret;
+    }
+
+    if (owner != GetRootOwner() && fileInfo->owner() != owner) {
+        LOG(WARNING) << "RefreshSessionById owner not match, fileName = "
+                     << fileName << ", owner = " << owner
+                     << ", file owner = " << fileInfo->owner();
+        return StatusCode::kOwnerAuthFail;
+    }
+
+    fileRecordManager_->UpdateFileRecord(fileName, clientVersion, clientIP,
+                                         clientPort);
+
+    return StatusCode::kOK;
+}
+
+StatusCode CurveFS::LookUpFileById(InodeID fileId, InodeID parentId,
+                                   const std::string &fileName,
+                                   FileInfo *fileInfo) const {
+    std::string lastEntry = fileName.substr(fileName.rfind('/') + 1);
+    auto storeStatus = storage_->GetFile(parentId, lastEntry, fileInfo);
+    if (storeStatus == StoreStatus::KeyNotExist) {
+        LOG(WARNING) << "LookUpFileById file not exist, fileName = "
+                     << fileName << ", fileId = " << fileId
+                     << ", parentId = " << parentId;
+        return StatusCode::kFileNotExists;
+    } else if (storeStatus != StoreStatus::OK) {
+        LOG(ERROR) << "LookUpFileById get file info error, fileName = "
+                   << fileName << ", fileId = " << fileId
+                   << ", parentId = " << parentId
+                   << ", storeStatus = " << storeStatus;
+        return StatusCode::kStorageError;
+    }
+
+    // 文件被删除之后重新创建了同名文件
+    if (fileInfo->id() != fileId) {
+        LOG(WARNING) << "LookUpFileById file id not match, fileName = "
+                     << fileName << ", fileId = " << fileId
+                     << ", current fileId = " << fileInfo->id();
+        return StatusCode::kFileNotExists;
+    }
+    return StatusCode::kOK;
+}
+
+namespace {
+
+std::string FileTokenString2Signature(InodeID fileId, InodeID parentId,
+                                      const std::string &fileName,
+                                      const std::string &owner,
+                                      uint64_t expiredTimeSec) {
+    return "file_token:" + std::to_string(fileId) + ":"
+           + std::to_string(parentId) + ":" + std::to_string(expiredTimeSec)
+           + ":" + owner + ":" + fileName;
+}
+
+}  // namespace
+
+std::string CurveFS::GetFileToken(InodeID fileId,
+                                  InodeID parentId,
+                                  const std::string &fileName,
+                                  const std::string &owner) const {
+    uint64_t expiredTimeSec = TimeUtility::GetTimeofDaySec()
+                              + fileTokenExpiredTimeSec_;
+    std::string str2sig = FileTokenString2Signature(fileId, parentId,
+                                    fileName, owner, expiredTimeSec);
+    return std::to_string(expiredTimeSec) + ":"
+           + Authenticator::CalcString2Signature(str2sig, fileTokenKey_);
+}
+
+StatusCode CurveFS::CheckFileToken(InodeID fileId,
+                                   InodeID parentId,
+                                   const std::string &fileName,
+                                   const std::string &owner,
+                                   const std::string &token) const {
+    size_t pos = token.find(':');
+    uint64_t expiredTimeSec = 0;
+    if (pos == std::string::npos
+        || !curve::common::StringToUll(token.substr(0, pos),
+                                       &expiredTimeSec)) {
+        LOG(WARNING) << "check file token fail, invalid token, fileId = "
+                     << fileId << ", owner = " << owner;
+        return StatusCode::kOwnerAuthFail;
+    }
+
+    if (expiredTimeSec < TimeUtility::GetTimeofDaySec()) {
+        LOG(INFO) << "check file token fail, token expired, fileId = "
+                  << fileId << ", owner = " << owner;
+        return StatusCode::kOwnerAuthFail;
+    }
+
+    std::string str2sig = FileTokenString2Signature(fileId, parentId,
+                                    fileName, owner, expiredTimeSec);
+    std::string sig = Authenticator::CalcString2Signature(str2sig,
+                                                          fileTokenKey_);
+    if (!Authenticator::SignatureEqual(token.substr(pos + 1), sig)) {
+        LOG(WARNING) << "check file token fail, fileId = " << fileId
+                     << ", fileName = " << fileName
+                     << ", owner = " << owner;
+        return StatusCode::kOwnerAuthFail;
+    }
+    return StatusCode::kOK;
+}
+
 StatusCode CurveFS::CreateCloneFile(const std::string &fileName,
                             const std::string& owner,
                             FileType filetype,
@@ -1409,6 +1674,9 @@ StatusCode CurveFS::CreateCloneFile(const std::string &fileName,
         fileInfo.set_filestatus(FileStatus::kFileCloning);
 
         ret = PutFile(fileInfo);
+        if (ret == StatusCode::kOK) {
+            allocStatistic_->SetFileAlloc(inodeID, {});
+        }
         if (ret == StatusCode::kOK && retFileInfo != nullptr) {
             *retFileInfo = fileInfo;
         }
@@ -1516,27 +1784,21 @@ StatusCode CurveFS::CheckPathOwnerInternal(const std::string &filename,
     *lastEntry = paths.back();
     uint64_t tempParentID = rootFileInfo_.id();
 
+    uint64_t generation = dentryCache_.GetGeneration();
     for (uint32_t i = 0; i < paths.size() - 1; i++) {
         FileInfo  fileInfo;
-        auto ret = storage_->GetFile(tempParentID, paths[i], &fileInfo);
-
-        if (ret ==  StoreStatus::OK) {
-            if (fileInfo.filetype() !=  FileType::INODE_DIRECTORY) {
-                LOG(INFO) << fileInfo.filename() << " is not an directory";
-                return StatusCode::kNotDirectory;
-            }
-
-            if (fileInfo.owner() != owner) {
-                LOG(ERROR) << fileInfo.filename() << " auth fail, owner = "
-                           << owner;
-                return StatusCode::kOwnerAuthFail;
-            }
-        } else if (ret == StoreStatus::KeyNotExist) {
+        auto ret = LookUpDir(tempParentID, paths[i], generation, &fileInfo);
+        if (ret == StatusCode::kFileNotExists) {
             LOG(WARNING) << paths[i] << " not exist";
-            return StatusCode::kFileNotExists;
-        } else {
-            LOG(ERROR) << "GetFile " << paths[i] << " error, errcode = " << ret;
-            return StatusCode::kStorageError;
+            return ret;
+        } else if (ret != StatusCode::kOK) {
+            return ret;
+        }
+
+        if (fileInfo.owner() != owner) {
+            LOG(ERROR) << fileInfo.filename() << " auth fail, owner = "
+                       << owner;
+            return StatusCode::kOwnerAuthFail;
         }
         tempParentID =  fileInfo.id();
     }
@@ -24,6 +24,7 @@
 #define SRC_MDS_NAMESERVER2_CURVEFS_H_
 
 #include <bvar/bvar.h>
+#include <map>
 #include <vector>
 #include <string>
 #include <memory>
@@ -35,6 +36,7 @@
 #include "src/mds/nameserver2/chunk_allocator.h"
 #include "src/mds/nameserver2/clean_manager.h"
 #include "src/mds/nameserver2/async_delete_snapshot_entity.h"
+#include "src/mds/nameserver2/dentry_cache.h"
 #include "src/mds/nameserver2/file_record.h"
 #include "src/mds/nameserver2/idgenerator/inode_id_generator.h"
 #include "src/common/authenticator.h"
@@ -53,6 +55,13 @@ struct CurveFSOption {
     uint64_t defaultChunkSize;
     RootAuthOption authOptions;
     FileRecordOptions fileRecordOptions;
+    // 路径解析缓存的目录项个数上限，0表示不使用缓存
+    uint64_t dentryCacheSize;
+    // 文件访问token的有效期，client每次续约时获取新的token
+    uint32_t fileTokenExpiredTimeSec;
+
+    CurveFSOption() : defaultChunkSize(0), dentryCacheSize(0),
+                      fileTokenExpiredTimeSec(600) {}
 };
 
 struct AllocatedSize {
@@ -197,6 +206,17 @@ class CurveFS {
     StatusCode ChangeOwner(const std::string &filename,
                            const std::string &newOwner);
 
+    /**
+     *  @brief 修改文件的QoS限制，文件打开时也可以修改，
+     *         client在下一次续约时获取新的限制
+     *  @param fileName: 文件名
+     *  @param params: 新的QoS限制，为nullptr时清除文件的限制
+     *  @return 是否成功，成功返回StatusCode::kOK，
+     *          文件不是INODE_PAGEFILE时返回StatusCode::kNotSupported
+     */
+    StatusCode UpdateFileThrottleParams(const std::string &filename,
+                                        const FileThrottleParams *params);
+
     // segment(chunk) ops
     /**
      *  @brief 查询segment信息，如果segment不存在，根据allocateIfNoExist决定是否
@@ -212,6 +232,26 @@ class CurveFS {
         offset_t offset,
         bool allocateIfNoExist, PageFileSegment *segment);
 
+    /**
+     *  @brief 通过inode id查询或分配segment，根据parentId和文件名直接从storage
+     *         获取文件，不遍历路径，调用前需要通过CheckFileToken验证身份
+     *  @param fileId：文件的inode id，与storage中的不一致时认为文件不存在
+     *         parentId：文件所在目录的inode id
+     *         filename：文件的全路径
+     *         owner：请求的owner，非root用户需要与文件的owner一致
+     *         offset: segment的偏移
+     *         allocateIfNoExist：如果segment不存在，是否需要创建新的segment
+     *         segment：返回查询到的segment信息
+     *  @return 是否成功，成功返回StatusCode::kOK
+     */
+    StatusCode GetOrAllocateSegmentById(
+        InodeID fileId,
+        InodeID parentId,
+        const std::string & filename,
+        const std::string & owner,
+        offset_t offset,
+        bool allocateIfNoExist, PageFileSegment *segment);
+
     /**
      *  @brief 获取root文件信息
      *  @param
@@ -328,6 +368,74 @@ class CurveFS {
                               const std::string &clientVersion,
                               FileInfo  *fileInfo);
 
+    /**
+     *  @brief 批量续约的身份验证，一个请求中的所有文件只验证一次，
+     *         root用户校验签名，其他用户在续约每个文件时校验文件的owner
+     *  @param: owner: 请求的owner
+     *  @param: signature: 用来进行请求的身份验证
+     *  @param: date: 请求的时间，用来防止重放攻击
+     *  @return 验证通过返回StatusCode::kOK，否则返回StatusCode::kOwnerAuthFail
+     */
+    StatusCode CheckRefreshSessionOwner(const std::string &owner,
+                                        const std::string &signature,
+                                        uint64_t date);
+
+    /**
+     *  @brief 通过inode id续约，根据parentID和文件名直接从storage获取文件，
+     *         不遍历路径，调用前需要通过CheckRefreshSessionOwner验证身份，
+     *         并通过CheckFileToken确认parentId和文件名是打开文件时解析得到的
+     *  @param: fileId: 文件的inode id，与storage中的不一致时认为文件不存在
+     *  @param: parentId: 文件所在目录的inode id
+     *  @param: fileName: 文件的全路径
+     *  @param: owner: 请求的owner，非root用户需要与文件的owner一致
+     *  @param: clientIP/clientPort/clientVersion: 用于更新文件记录
+     *  @param[out]: fileInfo: 返回文件信息
+     *  @return 是否成功，成功返回StatusCode::kOK
+     */
+    StatusCode RefreshSessionById(InodeID fileId,
+                                  InodeID parentId,
+                                  const std::string &fileName,
+                                  const std::string &owner,
+                                  const std::string &clientIP,
+                                  uint32_t clientPort,
+                                  const std::string &clientVersion,
+                                  FileInfo *fileInfo);
+
+    /**
+     *  @brief 生成文件的访问token，打开文件和续约时返回给client，
+     *         之后client可以通过inode id和token访问文件，
+     *         不需要遍历路径校验owner，也不需要每次计算签名。
+     *         token格式为"<过期时间>:<签名>"，签名覆盖文件的inode id、
+     *         父目录id、打开时解析的完整路径、owner和过期时间，
+     *         使用由root密码派生的秘钥计算，与root签名的秘钥不同
+     *  @param: fileId: 文件的inode id
+     *  @param: parentId: 文件父目录的inode id
+     *  @param: fileName: 通过路径解析得到该文件的完整路径
+     *  @param: owner: 打开文件的owner
+     *  @return 文件的访问token
+     */
+    std::string GetFileToken(InodeID fileId,
+                             InodeID parentId,
+                             const std::string &fileName,
+                             const std::string &owner) const;
+
+    /**
+     *  @brief 校验文件的访问token，校验通过时请求中的文件名即为
+     *         打开文件时解析得到的完整路径
+     *  @param: fileId: 文件的inode id
+     *  @param: parentId: 文件父目录的inode id
+     *  @param: fileName: 请求中的文件名
+     *  @param: owner: 请求的owner
+     *  @param: token: 请求中携带的token
+     *  @return 校验通过返回StatusCode::kOK，token过期或不匹配时
+     *          返回StatusCode::kOwnerAuthFail
+     */
+    StatusCode CheckFileToken(InodeID fileId,
+                              InodeID parentId,
+                              const std::string &fileName,
+                              const std::string &owner,
+                              const std::string &token) const;
+
     /**
      * @breif 创建克隆文件，当前克隆文件的创建只有root用户能够创建
      * @param filename 文件名
@@ -470,6 +578,38 @@ class CurveFS {
                           const std::string & fileName,
                           FileInfo *fileInfo) const;
 
+    /**
+     *  @brief 查找路径中间的一级目录，优先从dentry缓存中获取
+     *  @param: parentId 父目录的inode id
+     *  @param: dirName 目录名
+     *  @param: generation 开始解析路径时dentry缓存的generation
+     *  @param[out]: fileInfo 目录的FileInfo
+     *  @return 成功返回StatusCode::kOK，不是目录返回kNotDirectory
+     */
+    StatusCode LookUpDir(uint64_t parentId, const std::string &dirName,
+                         uint64_t generation, FileInfo *fileInfo) const;
+
+    /**
+     *  @brief 根据parentId和文件名直接从storage获取文件，并校验inode id
+     *  @param: fileId: 文件的inode id，与storage中的不一致时认为文件不存在
+     *  @param: parentId: 文件所在目录的inode id
+     *  @param: fileName: 文件的全路径
+     *  @param[out]: fileInfo: 返回文件信息
+     *  @return 是否成功，成功返回StatusCode::kOK
+     */
+    StatusCode LookUpFileById(InodeID fileId, InodeID parentId,
+                              const std::string &fileName,
+                              FileInfo *fileInfo) const;
+
+    /**
+     *  @brief 查询或分配已获取到fileInfo的文件的segment
+     */
+    StatusCode GetOrAllocateSegmentInternal(const std::string &filename,
+                                            const FileInfo &fileInfo,
+                                            offset_t offset,
+                                            bool allocateIfNoExist,
+                                            PageFileSegment *segment);
+
     StatusCode PutFile(const FileInfo & fileInfo);
 
     /**
@@ -573,6 +713,16 @@ class CurveFS {
                                 const FileInfo& fileInfo,
                                 AllocatedSize* allocSize);
 
+    /**
+     *  @brief 从storage加载文件在各逻辑池上的分配量并加入统计，
+     *         之后文件的分配量随segment的分配和释放更新
+     *  @param: fileInfo 文件信息
+     *  @param[out]: alloc：逻辑池id到分配大小的映射
+     *  @return 是否成功，成功返回StatusCode::kOK
+     */
+    StatusCode LoadFileAlloc(const FileInfo& fileInfo,
+                             std::map<PoolIdType, int64_t>* alloc);
+
  private:
     FileInfo rootFileInfo_;
     std::shared_ptr<NameServerStorage> storage_;
@@ -583,6 +733,12 @@ class CurveFS {
     std::shared_ptr<AllocStatistic> allocStatistic_;
     std::shared_ptr<Topology> topology_;
     struct RootAuthOption       rootAuthOptions_;
+    // 计算文件访问token的秘钥，由root密码派生
+    std::string fileTokenKey_;
+    uint32_t fileTokenExpiredTimeSec_;
+
+    // 路径解析过程中经过的目录的缓存
+    mutable DentryCache dentryCache_;
 
     uint64_t defaultChunkSize_;
     std::chrono::steady_clock::time_point startTime_;
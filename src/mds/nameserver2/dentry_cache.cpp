@@ -0,0 +1,116 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include "src/mds/nameserver2/dentry_cache.h"
+
+namespace curve {
+namespace mds {
+
+using ::curve::common::ReadLockGuard;
+using ::curve::common::WriteLockGuard;
+
+DentryCache::DentryCache(uint64_t maxCount)
+    : maxCount_(maxCount), generation_(0) {}
+
+void DentryCache::SetMaxCount(uint64_t maxCount) {
+    WriteLockGuard guard(lock_);
+    maxCount_ = maxCount;
+    generation_++;
+    ClearLocked();
+}
+
+uint64_t DentryCache::GetGeneration() {
+    ReadLockGuard guard(lock_);
+    return generation_;
+}
+
+bool DentryCache::GetDentry(uint64_t parentId, const std::string &name,
+                            FileInfo *fileInfo) {
+    if (!Enabled()) {
+        return false;
+    }
+    ReadLockGuard guard(lock_);
+    auto iter = dentries_.find(std::make_pair(parentId, name));
+    if (iter == dentries_.end()) {
+        return false;
+    }
+    fileInfo->CopyFrom(iter->second);
+    return true;
+}
+
+void DentryCache::PutDentry(uint64_t parentId, const std::string &name,
+                            const FileInfo &fileInfo, uint64_t generation) {
+    if (!Enabled() || fileInfo.filetype() != FileType::INODE_DIRECTORY) {
+        return;
+    }
+    WriteLockGuard guard(lock_);
+    if (generation != generation_) {
+        return;
+    }
+    if (dentries_.size() + paths_.size() >= maxCount_) {
+        ClearLocked();
+    }
+    dentries_[std::make_pair(parentId, name)] = fileInfo;
+}
+
+bool DentryCache::GetPath(const std::string &path, FileInfo *fileInfo) {
+    if (!Enabled()) {
+        return false;
+    }
+    ReadLockGuard guard(lock_);
+    auto iter = paths_.find(path);
+    if (iter == paths_.end()) {
+        return false;
+    }
+    fileInfo->CopyFrom(iter->second);
+    return true;
+}
+
+void DentryCache::PutPath(const std::string &path, const FileInfo &fileInfo,
+                          uint64_t generation) {
+    if (!Enabled() || fileInfo.filetype() != FileType::INODE_DIRECTORY) {
+        return;
+    }
+    WriteLockGuard guard(lock_);
+    if (generation != generation_) {
+        return;
+    }
+    if (dentries_.size() + paths_.size() >= maxCount_) {
+        ClearLocked();
+    }
+    paths_[path] = fileInfo;
+}
+
+void DentryCache::Invalidate() {
+    WriteLockGuard guard(lock_);
+    generation_++;
+    ClearLocked();
+}
+
+void DentryCache::ClearLocked() {
+    dentries_.clear();
+    paths_.clear();
+}
+
+}  // namespace mds
+}  // namespace curve
@@ -0,0 +1,123 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#ifndef SRC_MDS_NAMESERVER2_DENTRY_CACHE_H_
+#define SRC_MDS_NAMESERVER2_DENTRY_CACHE_H_
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "proto/nameserver2.pb.h"
+#include "src/common/concurrent/rw_lock.h"
+
+namespace curve {
+namespace mds {
+
+/**
+ * 缓存路径解析过程中经过的目录，减少WalkPath时对storage的GetFile调用:
+ * 1. dentry缓存，(parent inode id, name) -> 目录的FileInfo
+ * 2. 路径缓存，目录的完整路径 -> 目录的FileInfo
+ * 只缓存目录，不缓存普通文件和不存在的项。每个缓存项记录写入时的generation，
+ * 目录被删除或修改时调用Invalidate增加generation并清空缓存，
+ * 在Invalidate之前开始的解析结果不会再写入缓存。
+ * 缓存项个数超过上限时直接清空，maxCount为0表示不使用缓存
+ */
+class DentryCache {
+ public:
+    explicit DentryCache(uint64_t maxCount = 0);
+
+    /**
+     * @brief 设置缓存项个数的上限，同时清空缓存
+     * @param maxCount 缓存项个数的上限，0表示不使用缓存
+     */
+    void SetMaxCount(uint64_t maxCount);
+
+    bool Enabled() const {
+        return maxCount_ > 0;
+    }
+
+    /**
+     * @brief 获取当前的generation，在解析路径之前获取，写入缓存时使用
+     */
+    uint64_t GetGeneration();
+
+    /**
+     * @brief 查询parentId下名为name的目录
+     * @param parentId 父目录的inode id
+     * @param name 目录名
+     * @param[out] fileInfo 目录的FileInfo
+     * @return 命中返回true，否则返回false
+     */
+    bool GetDentry(uint64_t parentId, const std::string &name,
+                   FileInfo *fileInfo);
+
+    /**
+     * @brief 缓存parentId下名为name的目录
+     * @param generation 开始解析时获取的generation，
+     *        和当前generation不一致时不写入
+     */
+    void PutDentry(uint64_t parentId, const std::string &name,
+                   const FileInfo &fileInfo, uint64_t generation);
+
+    /**
+     * @brief 查询完整路径对应的目录
+     * @param path 目录的完整路径
+     * @param[out] fileInfo 目录的FileInfo
+     * @return 命中返回true，否则返回false
+     */
+    bool GetPath(const std::string &path, FileInfo *fileInfo);
+
+    /**
+     * @brief 缓存完整路径对应的目录
+     * @param generation 开始解析时获取的generation，
+     *        和当前generation不一致时不写入
+     */
+    void PutPath(const std::string &path, const FileInfo &fileInfo,
+                 uint64_t generation);
+
+    /**
+     * @brief 目录被删除或修改后调用，使所有缓存项失效
+     */
+    void Invalidate();
+
+ private:
+    void ClearLocked();
+
+ private:
+    ::curve::common::RWLock lock_;
+
+    uint64_t maxCount_;
+
+    uint64_t generation_;
+
+    std::map<std::pair<uint64_t, std::string>, FileInfo> dentries_;
+
+    std::unordered_map<std::string, FileInfo> paths_;
+};
+
+}  // namespace mds
+}  // namespace curve
+
+#endif  // SRC_MDS_NAMESERVER2_DENTRY_CACHE_H_
@@ -275,36 +275,65 @@ void NameSpaceService::GetOrAllocateSegment(
         << ", offset = " << request->offset() << ", allocateTag = "
         << request->allocateifnotexist();
 
-    FileWriteLockGuard guard(fileLockManager_, request->filename());
-
     std::string signature;
     if (request->has_signature()) {
         signature = request->signature();
     }
 
-    StatusCode retCode;
-    retCode = kCurveFS.CheckFileOwner(request->filename(), request->owner(),
-                                      signature, request->date());
+    // 携带fileToken的请求通过inode id访问文件，不需要遍历路径。
+    // token签名覆盖了打开文件时解析得到的完整路径，需要在加锁之前校验，
+    // 校验通过后请求中的文件名即为解析得到的路径，再对其加锁
+    bool byId = request->has_filetoken() && request->has_fileid()
+                && request->has_parentid();
+
+    StatusCode retCode = StatusCode::kOK;
+    if (byId) {
+        retCode = kCurveFS.CheckFileToken(request->fileid(),
+                                          request->parentid(),
+                                          request->filename(),
+                                          request->owner(),
+                                          request->filetoken());
+    }
+
+    FileWriteLockGuard guard(fileLockManager_, request->filename());
+
+    if (!byId) {
+        retCode = kCurveFS.CheckFileOwner(request->filename(),
+                                          request->owner(),
+                                          signature, request->date());
+    }
     if (retCode != StatusCode::kOK) {
         response->set_statuscode(retCode);
         if (google::ERROR != GetMdsLogLevel(retCode)) {
             LOG(WARNING) << "logid = " << cntl->log_id()
                 << ", CheckFileOwner fail, filename = " <<  request->filename()
                 << ", owner = " << request->owner()
+                << ", byId = " << byId
                 << ", statusCode = " << retCode;
         } else {
             LOG(ERROR) << "logid = " << cntl->log_id()
                 << ", CheckFileOwner fail, filename = " <<  request->filename()
                 << ", owner = " << request->owner()
+                << ", byId = " << byId
                 << ", statusCode = " << retCode;
         }
         return;
     }
 
-    retCode = kCurveFS.GetOrAllocateSegment(request->filename(),
-                request->offset(),
-                request->allocateifnotexist(),
-                response->mutable_pagefilesegment());
+    if (byId) {
+        retCode = kCurveFS.GetOrAllocateSegmentById(request->fileid(),
+                    request->parentid(),
+                    request->filename(),
+                    request->owner(),
+                    request->offset(),
+                    request->allocateifnotexist(),
+                    response->mutable_pagefilesegment());
+    } else {
+        retCode = kCurveFS.GetOrAllocateSegment(request->filename(),
+                    request->offset(),
+                    request->allocateifnotexist(),
+                    response->mutable_pagefilesegment());
+    }
 
     if (retCode != StatusCode::kOK)  {
         response->set_statuscode(retCode);
@@ -589,6 +618,76 @@ void NameSpaceService::ChangeOwner(
     return;
 }
 
+void NameSpaceService::UpdateFileThrottleParams(
+            ::google::protobuf::RpcController* controller,
+            const ::curve::mds::UpdateFileThrottleParamsRequest* request,
+            ::curve::mds::UpdateFileThrottleParamsResponse* response,
+            ::google::protobuf::Closure* done) {
+    brpc::ClosureGuard doneGuard(done);
+    brpc::Controller* cntl = static_cast<brpc::Controller*>(controller);
+
+    if (!isPathValid(request->filename())) {
+        response->set_statuscode(StatusCode::kParaError);
+        LOG(ERROR) << "logid = " << cntl->log_id()
+                << ", UpdateFileThrottleParams request path is invalid"
+                << ", filename = " << request->filename();
+        return;
+    }
+
+    LOG(INFO) << "logid = " << cntl->log_id()
+              << ", UpdateFileThrottleParams request, filename = "
+              << request->filename()
+              << ", throttleParams = "
+              << request->throttleparams().ShortDebugString();
+
+    FileWriteLockGuard guard(fileLockManager_, request->filename());
+
+    StatusCode retCode;
+    // UpdateFileThrottleParams()接口，只允许root用户调用
+    retCode = kCurveFS.CheckRootOwner(request->filename(), request->rootowner(),
+                                      request->signature(), request->date());
+    if (retCode != StatusCode::kOK) {
+        response->set_statuscode(retCode);
+        if (google::ERROR != GetMdsLogLevel(retCode)) {
+            LOG(WARNING) << "logid = " << cntl->log_id()
+                << ", CheckRootOwner fail, filename = " <<  request->filename()
+                << ", owner = " << request->rootowner()
+                << ", statusCode = " << retCode;
+        } else {
+            LOG(ERROR) << "logid = " << cntl->log_id()
+                << ", CheckRootOwner fail, filename = " <<  request->filename()
+                << ", owner = " << request->rootowner()
+                << ", statusCode = " << retCode;
+        }
+        return;
+    }
+
+    retCode = kCurveFS.UpdateFileThrottleParams(request->filename(),
+                request->has_throttleparams() ? &request->throttleparams()
+                                              : nullptr);
+    if (retCode != StatusCode::kOK)  {
+        response->set_statuscode(retCode);
+        if (google::ERROR != GetMdsLogLevel(retCode)) {
+            LOG(WARNING) << "logid = " << cntl->log_id()
+                    << ", UpdateFileThrottleParams fail, filename = "
+                    << request->filename()
+                    << ", statusCode = " << retCode
+                    << ", StatusCode_Name = " << StatusCode_Name(retCode);
+        } else {
+            LOG(ERROR) << "logid = " << cntl->log_id()
+                    << ", UpdateFileThrottleParams fail, filename = "
+                    << request->filename()
+                    << ", statusCode = " << retCode
+                    << ", StatusCode_Name = " << StatusCode_Name(retCode);
+        }
+    } else {
+        response->set_statuscode(StatusCode::kOK);
+        LOG(INFO) << "logid = " << cntl->log_id()
+           << ", UpdateFileThrottleParams ok, filename = "
+           << request->filename();
+    }
+}
+
 void NameSpaceService::ListDir(::google::protobuf::RpcController* controller,
                        const ::curve::mds::ListDirRequest* request,
                        ::curve::mds::ListDirResponse* response,
@@ -1153,6 +1252,9 @@ void NameSpaceService::OpenFile(::google::protobuf::RpcController* controller,
         delete fileInfo;
         return;
     } else {
+        response->set_filetoken(
+            kCurveFS.GetFileToken(fileInfo->id(), fileInfo->parentid(),
+                                  request->filename(), request->owner()));
         response->set_allocated_protosession(protoSession);
         response->set_allocated_fileinfo(fileInfo);
         response->set_statuscode(StatusCode::kOK);
@@ -1352,6 +1454,9 @@ void NameSpaceService::RefreshSession(
         return;
     } else {
         response->set_sessionid(request->sessionid());
+        response->set_filetoken(
+            kCurveFS.GetFileToken(fileInfo->id(), fileInfo->parentid(),
+                                  request->filename(), request->owner()));
         response->set_allocated_fileinfo(fileInfo);
         response->set_statuscode(StatusCode::kOK);
         DVLOG(6) << "logid = " << cntl->log_id()
@@ -1366,6 +1471,127 @@ void NameSpaceService::RefreshSession(
     return;
 }
 
+void NameSpaceService::BatchRefreshSession(
+                    ::google::protobuf::RpcController* controller,
+                    const ::curve::mds::BatchRefreshSessionRequest* request,
+                    ::curve::mds::BatchRefreshSessionResponse* response,
+                    ::google::protobuf::Closure* done) {
+    brpc::ClosureGuard doneGuard(done);
+    brpc::Controller* cntl = static_cast<brpc::Controller*>(controller);
+
+    std::string clientIP = butil::ip2str(cntl->remote_side().ip).c_str();
+    std::string clientVersion;
+    if (request->has_clientversion()) {
+        clientVersion = request->clientversion();
+    }
+    uint32_t clientPort = cntl->remote_side().port;
+
+    DVLOG(6) << "logid = " << cntl->log_id()
+        << ", BatchRefreshSession request, owner = " << request->owner()
+        << ", file num = " << request->items_size()
+        << ", date = " << request->date()
+        << ", clientip = " << clientIP
+        << ", clientport = " << clientPort;
+
+    std::string signature;
+    if (request->has_signature()) {
+        signature = request->signature();
+    }
+
+    // 所有文件的owner相同，只验证一次身份
+    StatusCode retCode = kCurveFS.CheckRefreshSessionOwner(
+        request->owner(), signature, request->date());
+    if (retCode != StatusCode::kOK) {
+        response->set_statuscode(retCode);
+        LOG(WARNING) << "logid = " << cntl->log_id()
+            << ", BatchRefreshSession check owner fail, owner = "
+            << request->owner()
+            << ", date = " << request->date()
+            << ", clientip = " << clientIP
+            << ", clientport = " << clientPort
+            << ", statusCode = " << retCode;
+        return;
+    }
+
+    for (const auto& item : request->items()) {
+        RefreshSessionResult* result = response->add_results();
+        result->set_sessionid(item.sessionid());
+
+        if (!isPathValid(item.filename())) {
+            result->set_statuscode(StatusCode::kParaError);
+            LOG(ERROR) << "logid = " << cntl->log_id()
+                << ", BatchRefreshSession request path is invalid, filename = "
+                << item.filename()
+                << ", sessionid = " << item.sessionid();
+            continue;
+        }
+
+        FileReadLockGuard guard(fileLockManager_, item.filename());
+
+        // parentId和文件名由client提供，只有token校验通过(即二者是打开文件时
+        // 解析得到的)时才直接通过parentId获取文件，否则和RefreshSession一样
+        // 遍历路径，检查各级目录的owner
+        FileInfo fileInfo;
+        if (item.has_filetoken() && StatusCode::kOK ==
+            kCurveFS.CheckFileToken(item.fileid(), item.parentid(),
+                                    item.filename(), request->owner(),
+                                    item.filetoken())) {
+            retCode = kCurveFS.RefreshSessionById(
+                item.fileid(),
+                item.parentid(),
+                item.filename(),
+                request->owner(),
+                request->has_clientip() ? request->clientip() : clientIP,
+                request->has_clientport() ? request->clientport()
+                                          : kInvalidPort,
+                clientVersion,
+                &fileInfo);
+        } else {
+            retCode = kCurveFS.CheckFileOwner(item.filename(),
+                                              request->owner(),
+                                              signature, request->date());
+            if (retCode == StatusCode::kOK) {
+                retCode = kCurveFS.RefreshSession(
+                    item.filename(),
+                    item.sessionid(),
+                    request->date(),
+                    signature,
+                    request->has_clientip() ? request->clientip() : clientIP,
+                    request->has_clientport() ? request->clientport()
+                                              : kInvalidPort,
+                    clientVersion,
+                    &fileInfo);
+            }
+            // 与通过id续约一致，文件被删除之后重新创建的同名文件认为不存在
+            if (retCode == StatusCode::kOK && fileInfo.id() != item.fileid()) {
+                retCode = StatusCode::kFileNotExists;
+            }
+        }
+        result->set_statuscode(retCode);
+        if (retCode == StatusCode::kOK) {
+            result->set_filetoken(kCurveFS.GetFileToken(fileInfo.id(),
+                fileInfo.parentid(), item.filename(), request->owner()));
+            result->mutable_fileinfo()->Swap(&fileInfo);
+        } else {
+            LOG(WARNING) << "logid = " << cntl->log_id()
+                << ", BatchRefreshSession fail, filename = " << item.filename()
+                << ", fileid = " << item.fileid()
+                << ", sessionid = " << item.sessionid()
+                << ", clientip = " << clientIP
+                << ", clientport = " << clientPort
+                << ", statusCode = " << retCode
+                << ", StatusCode_Name = " << StatusCode_Name(retCode);
+        }
+    }
+
+    response->set_statuscode(StatusCode::kOK);
+    DVLOG(6) << "logid = " << cntl->log_id()
+        << ", BatchRefreshSession ok, owner = " << request->owner()
+        << ", file num = " << request->items_size()
+        << ", clientip = " << clientIP
+        << ", clientport = " << clientPort;
+}
+
 bool isPathValid(const std::string path) {
     if (path.empty() || path[0] != '/') {
         return false;
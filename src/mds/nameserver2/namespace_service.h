@@ -104,6 +104,12 @@ class NameSpaceService: public CurveFSService {
                        ::curve::mds::ChangeOwnerResponse* response,
                        ::google::protobuf::Closure* done) override;
 
+    void UpdateFileThrottleParams(
+                ::google::protobuf::RpcController* controller,
+                const ::curve::mds::UpdateFileThrottleParamsRequest* request,
+                ::curve::mds::UpdateFileThrottleParamsResponse* response,
+                ::google::protobuf::Closure* done) override;
+
     void ListDir(::google::protobuf::RpcController* controller,
                        const ::curve::mds::ListDirRequest* request,
                        ::curve::mds::ListDirResponse* response,
@@ -142,6 +148,10 @@ class NameSpaceService: public CurveFSService {
                         const ::curve::mds::ReFreshSessionRequest* request,
                         ::curve::mds::ReFreshSessionResponse* response,
                         ::google::protobuf::Closure* done) override;
+    void BatchRefreshSession(::google::protobuf::RpcController* controller,
+                    const ::curve::mds::BatchRefreshSessionRequest* request,
+                    ::curve::mds::BatchRefreshSessionResponse* response,
+                    ::google::protobuf::Closure* done) override;
     void CreateCloneFile(::google::protobuf::RpcController* controller,
                        const ::curve::mds::CreateCloneFileRequest* request,
                        ::curve::mds::CreateCloneFileResponse* response,
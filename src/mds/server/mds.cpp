@@ -458,6 +458,10 @@ void MDS::InitAuthOptions(RootAuthOption *authOptions) {
 void MDS::InitCurveFSOptions(CurveFSOption *curveFSOptions) {
     conf_->GetValueFatalIfFail(
         "mds.curvefs.defaultChunkSize", &curveFSOptions->defaultChunkSize);
+    conf_->GetValueFatalIfFail(
+        "mds.curvefs.dentryCacheSize", &curveFSOptions->dentryCacheSize);
+    conf_->GetValueFatalIfFail("mds.curvefs.fileTokenExpiredTimeSec",
+                               &curveFSOptions->fileTokenExpiredTimeSec);
     FileRecordOptions fileRecordOptions;
     InitFileRecordOptions(&curveFSOptions->fileRecordOptions);
 
@@ -570,6 +574,20 @@ void MDS::InitHeartbeatOption(HeartbeatOption* heartbeatOption) {
                         &heartbeatOption->offLineTimeOutMs);
     conf_->GetValueFatalIfFail("mds.heartbeat.clean_follower_afterMs",
                         &heartbeatOption->cleanFollowerAfterMs);
+    conf_->GetValueFatalIfFail("mds.heartbeat.qos.enable",
+                        &heartbeatOption->enableChunkServerQos);
+    conf_->GetValueFatalIfFail("mds.heartbeat.qos.chunkserverIops",
+                        &heartbeatOption->chunkserverQosIops);
+    conf_->GetValueFatalIfFail("mds.heartbeat.qos.chunkserverBps",
+                        &heartbeatOption->chunkserverQosBps);
+    conf_->GetValueFatalIfFail("mds.heartbeat.qos.copysetIops",
+                        &heartbeatOption->copysetQosIops);
+    conf_->GetValueFatalIfFail("mds.heartbeat.qos.copysetBps",
+                        &heartbeatOption->copysetQosBps);
+    conf_->GetValueFatalIfFail("mds.heartbeat.qos.clientIops",
+                        &heartbeatOption->clientQosIops);
+    conf_->GetValueFatalIfFail("mds.heartbeat.qos.clientBps",
+                        &heartbeatOption->clientQosBps);
 }
 }  // namespace mds
 }  // namespace curve
@@ -37,25 +37,41 @@ namespace topology {
 
 void TopologyStatImpl::UpdateChunkServerStat(ChunkServerIdType csId,
     const ChunkServerStat &stat) {
+    // 在锁外拷贝统计数据
+    std::shared_ptr<const ChunkServerStat> newStat =
+        std::make_shared<const ChunkServerStat>(stat);
+    {
+        ReadLockGuard rLock(statsLock_);
+        auto it = chunkServerStats_.find(csId);
+        if (it != chunkServerStats_.end()) {
+            std::atomic_store(&it->second->stat, newStat);
+            return;
+        }
+    }
+
     WriteLockGuard wLock(statsLock_);
     auto it = chunkServerStats_.find(csId);
-    if (it != chunkServerStats_.end()) {
-        it->second = stat;
-    } else {
-        chunkServerStats_.emplace(csId, stat);
+    if (it == chunkServerStats_.end()) {
+        it = chunkServerStats_.emplace(
+            csId, std::make_shared<ChunkServerStatSlot>()).first;
     }
+    std::atomic_store(&it->second->stat, newStat);
     return;
 }
 
 bool TopologyStatImpl::GetChunkServerStat(ChunkServerIdType csId,
     ChunkServerStat *stat) {
-    ReadLockGuard rLock(statsLock_);
-    auto it = chunkServerStats_.find(csId);
-    if (it != chunkServerStats_.end()) {
-        *stat = it->second;
-        return true;
+    std::shared_ptr<const ChunkServerStat> current;
+    {
+        ReadLockGuard rLock(statsLock_);
+        auto it = chunkServerStats_.find(csId);
+        if (it == chunkServerStats_.end()) {
+            return false;
+        }
+        current = std::atomic_load(&it->second->stat);
     }
-    return false;
+    *stat = *current;
+    return true;
 }
 
 int TopologyStatImpl::Init() {
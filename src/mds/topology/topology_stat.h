@@ -54,6 +54,8 @@ struct CopysetStat {
     uint32_t readIOPS;
     // 写iops
     uint32_t writeIOPS;
+    // 后台巡检发现的副本间不一致的chunk个数
+    uint32_t inconsistentChunkNum;
     CopysetStat() :
         logicalPoolId(UNINTIALIZE_ID),
         copysetId(UNINTIALIZE_ID),
@@ -61,7 +63,8 @@ struct CopysetStat {
         readRate(0),
         writeRate(0),
         readIOPS(0),
-        writeIOPS(0) {}
+        writeIOPS(0),
+        inconsistentChunkNum(0) {}
 };
 
 struct ChunkServerStat {
@@ -140,12 +143,22 @@ class TopologyStatImpl : public TopologyStat {
         ChunkServerStat *stat) override;
 
  private:
+    /**
+     * @brief 每个chunkserver的统计数据，心跳更新时构造新的数据后原子的替换，
+     *        读取时原子的获取当前数据，读写之间不需要加锁
+     */
+    struct ChunkServerStatSlot {
+        std::shared_ptr<const ChunkServerStat> stat;
+    };
+
     /**
      * @brief 心跳来源的chunkserver统计数据
      */
-    std::map<ChunkServerIdType, ChunkServerStat>  chunkServerStats_;
+    std::map<ChunkServerIdType, std::shared_ptr<ChunkServerStatSlot>>
+        chunkServerStats_;
     /**
-     * @brief 保护chunkServerStats_并发访问的锁
+     * @brief 保护chunkServerStats_并发访问的锁，
+     *        只有增加chunkserver时加写锁，更新和读取统计数据时加读锁
      */
     mutable curve::common::RWLock statsLock_;
 
@@ -1314,6 +1314,20 @@ int CloneCoreImpl::GetCloneInfoByFileName(
     return metaStore_->GetCloneInfoByFileName(fileName, list);
 }
 
+int CloneCoreImpl::GetCloneInfoPage(const CloneInfoFilter &filter,
+    const TaskIdType &cursor,
+    uint64_t limit,
+    std::vector<CloneInfo> *list,
+    TaskIdType *nextCursor,
+    uint64_t *total) {
+    int ret = metaStore_->GetCloneInfoPage(filter, cursor, limit,
+        list, nextCursor, total);
+    if (ret < 0) {
+        return kErrCodeInternalError;
+    }
+    return kErrCodeSuccess;
+}
+
 inline bool CloneCoreImpl::IsLazy(std::shared_ptr<CloneTaskInfo> task) {
     return task->GetCloneInfo().GetIsLazy();
 }
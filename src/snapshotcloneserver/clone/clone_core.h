@@ -148,6 +148,25 @@ class CloneCore {
     virtual int GetCloneInfoByFileName(
     const std::string &fileName, std::vector<CloneInfo> *list) = 0;
 
+    /**
+     * @brief 分页获取满足条件的克隆/恢复任务
+     *
+     * @param filter 过滤条件
+     * @param cursor 上一页最后一个任务的id，为空时从第一个开始
+     * @param limit 本页最多返回的任务数
+     * @param[out] list 本页的克隆/恢复任务
+     * @param[out] nextCursor 下一页的cursor，没有更多任务时为空
+     * @param[out] total 满足条件的任务总数
+     *
+     * @return 错误码
+     */
+    virtual int GetCloneInfoPage(const CloneInfoFilter &filter,
+        const TaskIdType &cursor,
+        uint64_t limit,
+        std::vector<CloneInfo> *list,
+        TaskIdType *nextCursor,
+        uint64_t *total) = 0;
+
     /**
      * @brief 获取快照引用管理模块
      *
@@ -252,6 +271,13 @@ class CloneCoreImpl : public CloneCore {
     int GetCloneInfoByFileName(
         const std::string &fileName, std::vector<CloneInfo> *list) override;
 
+    int GetCloneInfoPage(const CloneInfoFilter &filter,
+        const TaskIdType &cursor,
+        uint64_t limit,
+        std::vector<CloneInfo> *list,
+        TaskIdType *nextCursor,
+        uint64_t *total) override;
+
     std::shared_ptr<SnapshotReference> GetSnapshotRef() {
         return snapshotRef_;
     }
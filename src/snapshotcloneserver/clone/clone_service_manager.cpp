@@ -286,12 +286,37 @@ int CloneServiceManager::GetCloneTaskInfoByName(
     return GetCloneTaskInfoInner(cloneInfos, user, info);
 }
 
+int CloneServiceManager::GetCloneTaskInfoPage(
+    const std::string &user,
+    const std::string &fileName,
+    const TaskIdType &cursor,
+    uint64_t limit,
+    std::vector<TaskCloneInfo> *info,
+    TaskIdType *nextCursor,
+    uint64_t *total) {
+    CloneInfoFilter filter;
+    filter.user = user;
+    filter.fileName = fileName;
+    std::vector<CloneInfo> cloneInfos;
+    int ret = cloneCore_->GetCloneInfoPage(filter, cursor, limit,
+        &cloneInfos, nextCursor, total);
+    if (ret < 0) {
+        LOG(ERROR) << "GetCloneInfoPage fail"
+                   << ", ret = " << ret
+                   << ", user = " << user
+                   << ", fileName = " << fileName
+                   << ", cursor = " << cursor;
+        return ret;
+    }
+    return GetCloneTaskInfoInner(cloneInfos, user, info);
+}
+
 int CloneServiceManager::GetCloneTaskInfoInner(
-    std::vector<CloneInfo> cloneInfos,
+    const std::vector<CloneInfo> &cloneInfos,
     const std::string &user,
     std::vector<TaskCloneInfo> *info) {
     int ret = kErrCodeSuccess;
-    for (auto &cloneInfo : cloneInfos) {
+    for (const auto &cloneInfo : cloneInfos) {
         if (cloneInfo.GetUser() == user) {
             switch (cloneInfo.GetStatus()) {
                 case CloneStatus::done : {
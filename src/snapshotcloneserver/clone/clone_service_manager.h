@@ -215,6 +215,28 @@ class CloneServiceManager {
         const std::string &fileName,
         std::vector<TaskCloneInfo> *info);
 
+    /**
+     * @brief 分页查询某个用户的克隆/恢复任务信息，只查询本页任务的进度
+     *
+     * @param user 用户名
+     * @param fileName 目标文件名，为空时查询用户的所有任务
+     * @param cursor 上一页最后一个任务的id，为空时从第一个开始
+     * @param limit 本页最多返回的任务数
+     * @param[out] info 本页的克隆/恢复任务信息
+     * @param[out] nextCursor 下一页的cursor，没有更多任务时为空
+     * @param[out] total 满足条件的任务总数
+     *
+     * @return 错误码
+     */
+    virtual int GetCloneTaskInfoPage(
+        const std::string &user,
+        const std::string &fileName,
+        const TaskIdType &cursor,
+        uint64_t limit,
+        std::vector<TaskCloneInfo> *info,
+        TaskIdType *nextCursor,
+        uint64_t *total);
+
     /**
      * @brief 清除失败的clone/Recover任务、状态、文件
      *
@@ -243,7 +265,7 @@ class CloneServiceManager {
      *
      * @return 错误码
      */
-    int GetCloneTaskInfoInner(std::vector<CloneInfo> cloneInfos,
+    int GetCloneTaskInfoInner(const std::vector<CloneInfo> &cloneInfos,
         const std::string &user,
         std::vector<TaskCloneInfo> *info);
 
@@ -47,6 +47,7 @@ const char* kNameStr = "Name";
 const char* kUUIDStr = "UUID";
 const char* kLimitStr = "Limit";
 const char* kOffsetStr = "Offset";
+const char* kCursorStr = "Cursor";
 const char* kSourceStr = "Source";
 const char* kDestinationStr = "Destination";
 const char* kLazyStr = "Lazy";
@@ -55,6 +56,7 @@ const char* kCodeStr = "Code";
 const char* kMessageStr = "Message";
 const char* kRequestIdStr = "RequestId";
 const char* kTotalCountStr = "TotalCount";
+const char* kNextCursorStr = "NextCursor";
 const char* kSnapshotsStr = "Snapshots";
 const char* kTaskInfosStr = "TaskInfos";
 
@@ -51,6 +51,7 @@ extern const char* kNameStr;
 extern const char* kUUIDStr;
 extern const char* kLimitStr;
 extern const char* kOffsetStr;
+extern const char* kCursorStr;
 extern const char* kSourceStr;
 extern const char* kDestinationStr;
 extern const char* kLazyStr;
@@ -60,6 +61,7 @@ extern const char* kCodeStr;
 extern const char* kMessageStr;
 extern const char* kRequestIdStr;
 extern const char* kTotalCountStr;
+extern const char* kNextCursorStr;
 extern const char* kSnapshotsStr;
 extern const char* kTaskInfosStr;
 
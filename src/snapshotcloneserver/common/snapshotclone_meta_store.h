@@ -37,6 +37,36 @@
 namespace curve {
 namespace snapshotcloneserver {
 
+/**
+ * 分页获取快照信息的过滤条件，为空的条件不过滤
+ */
+struct SnapshotFilter {
+    // 快照所属用户
+    std::string user;
+    // 快照的源文件
+    std::string fileName;
+    // 是否按照快照状态过滤
+    bool filterStatus;
+    Status status;
+
+    SnapshotFilter() : filterStatus(false), status(Status::done) {}
+};
+
+/**
+ * 分页获取克隆/恢复任务的过滤条件，为空的条件不过滤
+ */
+struct CloneInfoFilter {
+    // 任务所属用户
+    std::string user;
+    // 克隆/恢复的目标文件
+    std::string fileName;
+    // 是否按照任务状态过滤
+    bool filterStatus;
+    CloneStatus status;
+
+    CloneInfoFilter() : filterStatus(false), status(CloneStatus::done) {}
+};
+
 class SnapshotCloneMetaStore {
  public:
     SnapshotCloneMetaStore() {}
@@ -89,6 +119,25 @@ class SnapshotCloneMetaStore {
      */
     virtual uint32_t GetSnapshotCount() = 0;
 
+    /**
+     * @brief 按照uuid的顺序分页获取满足条件的快照信息，只拷贝本页的记录
+     *
+     * @param filter 过滤条件
+     * @param cursor 上一页最后一条记录的uuid，为空时从第一条开始
+     * @param limit 本页最多返回的记录数
+     * @param[out] list 本页的快照信息
+     * @param[out] nextCursor 下一页的cursor，没有更多记录时为空
+     * @param[out] total 满足条件的记录总数
+     *
+     * @return 0 获取成功/ -1 获取失败
+     */
+    virtual int GetSnapshotPage(const SnapshotFilter &filter,
+                                const UUID &cursor,
+                                uint64_t limit,
+                                std::vector<SnapshotInfo> *list,
+                                UUID *nextCursor,
+                                uint64_t *total) = 0;
+
     /**
      * @brief 插入一条clone任务记录到metastore
      * @param clone记录信息
@@ -131,6 +180,26 @@ class SnapshotCloneMetaStore {
      * @return: 0 获取成功/ -1 获取失败
      */
     virtual int GetCloneInfoList(std::vector<CloneInfo> *list) = 0;
+
+    /**
+     * @brief 按照task id的顺序分页获取满足条件的克隆/恢复任务信息，
+     *        只拷贝本页的记录
+     *
+     * @param filter 过滤条件
+     * @param cursor 上一页最后一条记录的task id，为空时从第一条开始
+     * @param limit 本页最多返回的记录数
+     * @param[out] list 本页的任务信息
+     * @param[out] nextCursor 下一页的cursor，没有更多记录时为空
+     * @param[out] total 满足条件的记录总数
+     *
+     * @return 0 获取成功/ -1 获取失败
+     */
+    virtual int GetCloneInfoPage(const CloneInfoFilter &filter,
+                                 const TaskIdType &cursor,
+                                 uint64_t limit,
+                                 std::vector<CloneInfo> *list,
+                                 TaskIdType *nextCursor,
+                                 uint64_t *total) = 0;
 };
 
 }  // namespace snapshotcloneserver
@@ -22,12 +22,147 @@
 
 #include "src/snapshotcloneserver/common/snapshotclone_meta_store_etcd.h"
 
+#include <map>
+#include <set>
 #include <vector>
 #include <string>
 
 namespace curve {
 namespace snapshotcloneserver {
 
+namespace {
+
+const std::set<std::string> kEmptyIds;
+
+template <typename Key>
+void AddToIndex(std::map<Key, std::set<std::string>> *index,
+                const Key &key, const std::string &id) {
+    (*index)[key].insert(id);
+}
+
+template <typename Key>
+void RemoveFromIndex(std::map<Key, std::set<std::string>> *index,
+                     const Key &key, const std::string &id) {
+    auto it = index->find(key);
+    if (it == index->end()) {
+        return;
+    }
+    it->second.erase(id);
+    if (it->second.empty()) {
+        index->erase(it);
+    }
+}
+
+/**
+ * 选择满足条件的记录最少的索引作为分页查找的范围
+ * @param index: 二级索引
+ * @param key: 过滤条件
+ * @param[in,out] ids: 当前选中的索引
+ * @param[in,out] conditions: 过滤条件的个数
+ */
+template <typename Key>
+void ChooseIndex(const std::map<Key, std::set<std::string>> &index,
+                 const Key &key,
+                 const std::set<std::string> **ids,
+                 int *conditions) {
+    ++(*conditions);
+    auto it = index.find(key);
+    const std::set<std::string> *candidate =
+        (it == index.end()) ? &kEmptyIds : &it->second;
+    if (*ids == nullptr || candidate->size() < (*ids)->size()) {
+        *ids = candidate;
+    }
+}
+
+bool MatchFilter(const SnapshotInfo &info, const SnapshotFilter &filter) {
+    return (filter.user.empty() || info.GetUser() == filter.user) &&
+           (filter.fileName.empty() || info.GetFileName() == filter.fileName) &&
+           (!filter.filterStatus || info.GetStatus() == filter.status);
+}
+
+bool MatchFilter(const CloneInfo &info, const CloneInfoFilter &filter) {
+    return (filter.user.empty() || info.GetUser() == filter.user) &&
+           (filter.fileName.empty() || info.GetDest() == filter.fileName) &&
+           (!filter.filterStatus || info.GetStatus() == filter.status);
+}
+
+template <typename Info>
+const std::string &GetId(const std::pair<const std::string, Info> &item) {
+    return item.first;
+}
+
+const std::string &GetId(const std::string &id) {
+    return id;
+}
+
+template <typename Info>
+const Info *GetInfo(const std::map<std::string, Info> &infos,
+                    const std::pair<const std::string, Info> &item) {
+    return &item.second;
+}
+
+template <typename Info>
+const Info *GetInfo(const std::map<std::string, Info> &infos,
+                    const std::string &id) {
+    auto it = infos.find(id);
+    return (it == infos.end()) ? nullptr : &it->second;
+}
+
+/**
+ * 从按照id排列的ids中获取cursor之后的一页满足条件的记录，
+ * ids为记录本身或者某个二级索引，
+ * exact为true表示ids中的记录都满足条件，只需要定位到cursor之后拷贝本页，
+ * 否则需要逐条检查并统计总数
+ */
+template <typename Info, typename Filter, typename Container>
+void GetPage(const std::map<std::string, Info> &infos,
+             const Container &ids,
+             bool exact,
+             const Filter &filter,
+             const std::string &cursor,
+             uint64_t limit,
+             std::vector<Info> *list,
+             std::string *nextCursor,
+             uint64_t *total) {
+    std::string lastId;
+    bool hasMore = false;
+    if (exact) {
+        *total = ids.size();
+        auto it = cursor.empty() ? ids.begin() : ids.upper_bound(cursor);
+        for (; it != ids.end() && list->size() < limit; ++it) {
+            const Info *info = GetInfo(infos, *it);
+            if (info != nullptr) {
+                list->push_back(*info);
+                lastId = GetId(*it);
+            }
+        }
+        hasMore = (it != ids.end());
+    } else {
+        *total = 0;
+        for (auto it = ids.begin(); it != ids.end(); ++it) {
+            const Info *info = GetInfo(infos, *it);
+            if (info == nullptr || !MatchFilter(*info, filter)) {
+                continue;
+            }
+            ++(*total);
+            if (!cursor.empty() && GetId(*it) <= cursor) {
+                continue;
+            }
+            if (list->size() < limit) {
+                list->push_back(*info);
+                lastId = GetId(*it);
+            } else {
+                hasMore = true;
+            }
+        }
+    }
+    if (hasMore) {
+        *nextCursor = lastId;
+    }
+}
+
+}  // namespace
+
 int SnapshotCloneMetaStoreEtcd::Init() {
     int ret = LoadSnapshotInfos();
     if (ret < 0) {
@@ -59,7 +194,9 @@ int SnapshotCloneMetaStoreEtcd::AddSnapshot(const SnapshotInfo &info) {
         return -1;
     }
 
-    snapInfos_.emplace(info.GetUuid(), info);
+    if (snapInfos_.emplace(info.GetUuid(), info).second) {
+        AddSnapshotIndex(info);
+    }
     return 0;
 }
 
@@ -75,6 +212,7 @@ int SnapshotCloneMetaStoreEtcd::DeleteSnapshot(const UUID &uuid) {
     }
     auto search = snapInfos_.find(uuid);
     if (search != snapInfos_.end()) {
+        RemoveSnapshotIndex(search->second);
         snapInfos_.erase(search);
     }
     return 0;
@@ -99,10 +237,12 @@ int SnapshotCloneMetaStoreEtcd::UpdateSnapshot(const SnapshotInfo &info) {
     }
     auto search = snapInfos_.find(info.GetUuid());
     if (search != snapInfos_.end()) {
+        RemoveSnapshotIndex(search->second);
         search->second = info;
     } else {
         snapInfos_.emplace(info.GetUuid(), info);
     }
+    AddSnapshotIndex(info);
     return 0;
 }
 
@@ -120,11 +260,13 @@ int SnapshotCloneMetaStoreEtcd::GetSnapshotInfo(
 int SnapshotCloneMetaStoreEtcd::GetSnapshotList(const std::string &filename,
     std::vector<SnapshotInfo> *v) {
     ReadLockGuard guard(snapInfos_mutex);
-    for (auto it = snapInfos_.begin();
-         it != snapInfos_.end();
-         it++) {
-        if (filename == it->second.GetFileName()) {
-            v->push_back(it->second);
+    auto index = snapFileIndex_.find(filename);
+    if (index != snapFileIndex_.end()) {
+        for (const auto &uuid : index->second) {
+            auto it = snapInfos_.find(uuid);
+            if (it != snapInfos_.end()) {
+                v->push_back(it->second);
+            }
         }
     }
     if (v->size() != 0) {
@@ -152,6 +294,36 @@ uint32_t SnapshotCloneMetaStoreEtcd::GetSnapshotCount() {
     return snapInfos_.size();
 }
 
+int SnapshotCloneMetaStoreEtcd::GetSnapshotPage(const SnapshotFilter &filter,
+    const UUID &cursor,
+    uint64_t limit,
+    std::vector<SnapshotInfo> *list,
+    UUID *nextCursor,
+    uint64_t *total) {
+    list->clear();
+    nextCursor->clear();
+    ReadLockGuard guard(snapInfos_mutex);
+    const std::set<UUID> *ids = nullptr;
+    int conditions = 0;
+    if (!filter.user.empty()) {
+        ChooseIndex(snapUserIndex_, filter.user, &ids, &conditions);
+    }
+    if (!filter.fileName.empty()) {
+        ChooseIndex(snapFileIndex_, filter.fileName, &ids, &conditions);
+    }
+    if (filter.filterStatus) {
+        ChooseIndex(snapStatusIndex_, filter.status, &ids, &conditions);
+    }
+    if (ids == nullptr) {
+        GetPage(snapInfos_, snapInfos_, true, filter, cursor, limit,
+                list, nextCursor, total);
+    } else {
+        GetPage(snapInfos_, *ids, conditions == 1, filter, cursor, limit,
+                list, nextCursor, total);
+    }
+    return 0;
+}
+
 int SnapshotCloneMetaStoreEtcd::AddCloneInfo(const CloneInfo &info) {
     std::string key = codec_->EncodeCloneInfoKey(info.GetTaskId());
     std::string value;
@@ -169,7 +341,9 @@ int SnapshotCloneMetaStoreEtcd::AddCloneInfo(const CloneInfo &info) {
                    << ", cloneInfo : " << info;
         return -1;
     }
-    cloneInfos_.emplace(info.GetTaskId(), info);
+    if (cloneInfos_.emplace(info.GetTaskId(), info).second) {
+        AddCloneInfoIndex(info);
+    }
     return 0;
 }
 
@@ -185,6 +359,7 @@ int SnapshotCloneMetaStoreEtcd::DeleteCloneInfo(const std::string &uuid) {
     }
     auto search = cloneInfos_.find(uuid);
     if (search != cloneInfos_.end()) {
+        RemoveCloneInfoIndex(search->second);
         cloneInfos_.erase(search);
     }
     return 0;
@@ -209,10 +384,12 @@ int SnapshotCloneMetaStoreEtcd::UpdateCloneInfo(const CloneInfo &info) {
     }
     auto search = cloneInfos_.find(info.GetTaskId());
     if (search != cloneInfos_.end()) {
+        RemoveCloneInfoIndex(search->second);
         search->second = info;
     } else {
         cloneInfos_.emplace(info.GetTaskId(), info);
     }
+    AddCloneInfoIndex(info);
     return 0;
 }
 
@@ -230,9 +407,13 @@ int SnapshotCloneMetaStoreEtcd::GetCloneInfo(
 int SnapshotCloneMetaStoreEtcd::GetCloneInfoByFileName(
     const std::string &fileName, std::vector<CloneInfo> *list) {
     ReadLockGuard guard(cloneInfos_lock_);
-    for (auto it = cloneInfos_.begin(); it != cloneInfos_.end(); it++) {
-        if (it->second.GetDest() == fileName) {
-            list->push_back(it->second);
+    auto index = cloneFileIndex_.find(fileName);
+    if (index != cloneFileIndex_.end()) {
+        for (const auto &taskId : index->second) {
+            auto it = cloneInfos_.find(taskId);
+            if (it != cloneInfos_.end()) {
+                list->push_back(it->second);
+            }
         }
     }
     if (list->size() != 0) {
@@ -254,6 +435,62 @@ int SnapshotCloneMetaStoreEtcd::GetCloneInfoList(std::vector<CloneInfo> *list) {
     return -1;
 }
 
+int SnapshotCloneMetaStoreEtcd::GetCloneInfoPage(
+    const CloneInfoFilter &filter,
+    const TaskIdType &cursor,
+    uint64_t limit,
+    std::vector<CloneInfo> *list,
+    TaskIdType *nextCursor,
+    uint64_t *total) {
+    list->clear();
+    nextCursor->clear();
+    ReadLockGuard guard(cloneInfos_lock_);
+    const std::set<TaskIdType> *ids = nullptr;
+    int conditions = 0;
+    if (!filter.user.empty()) {
+        ChooseIndex(cloneUserIndex_, filter.user, &ids, &conditions);
+    }
+    if (!filter.fileName.empty()) {
+        ChooseIndex(cloneFileIndex_, filter.fileName, &ids, &conditions);
+    }
+    if (filter.filterStatus) {
+        ChooseIndex(cloneStatusIndex_, filter.status, &ids, &conditions);
+    }
+    if (ids == nullptr) {
+        GetPage(cloneInfos_, cloneInfos_, true, filter, cursor, limit,
+                list, nextCursor, total);
+    } else {
+        GetPage(cloneInfos_, *ids, conditions == 1, filter, cursor, limit,
+                list, nextCursor, total);
+    }
+    return 0;
+}
+
+void SnapshotCloneMetaStoreEtcd::AddSnapshotIndex(const SnapshotInfo &info) {
+    AddToIndex(&snapFileIndex_, info.GetFileName(), info.GetUuid());
+    AddToIndex(&snapUserIndex_, info.GetUser(), info.GetUuid());
+    AddToIndex(&snapStatusIndex_, info.GetStatus(), info.GetUuid());
+}
+
+void SnapshotCloneMetaStoreEtcd::RemoveSnapshotIndex(
+    const SnapshotInfo &info) {
+    RemoveFromIndex(&snapFileIndex_, info.GetFileName(), info.GetUuid());
+    RemoveFromIndex(&snapUserIndex_, info.GetUser(), info.GetUuid());
+    RemoveFromIndex(&snapStatusIndex_, info.GetStatus(), info.GetUuid());
+}
+
+void SnapshotCloneMetaStoreEtcd::AddCloneInfoIndex(const CloneInfo &info) {
+    AddToIndex(&cloneFileIndex_, info.GetDest(), info.GetTaskId());
+    AddToIndex(&cloneUserIndex_, info.GetUser(), info.GetTaskId());
+    AddToIndex(&cloneStatusIndex_, info.GetStatus(), info.GetTaskId());
+}
+
+void SnapshotCloneMetaStoreEtcd::RemoveCloneInfoIndex(const CloneInfo &info) {
+    RemoveFromIndex(&cloneFileIndex_, info.GetDest(), info.GetTaskId());
+    RemoveFromIndex(&cloneUserIndex_, info.GetUser(), info.GetTaskId());
+    RemoveFromIndex(&cloneStatusIndex_, info.GetStatus(), info.GetTaskId());
+}
+
 int SnapshotCloneMetaStoreEtcd::LoadSnapshotInfos() {
     std::string startKey = SnapshotCloneCodec::GetSnapshotInfoKeyPrefix();
     std::string endKey = SnapshotCloneCodec::GetSnapshotInfoKeyEnd();
@@ -271,7 +508,9 @@ int SnapshotCloneMetaStoreEtcd::LoadSnapshotInfos() {
             LOG(ERROR) << "DecodeSnapshotData err";
             return -1;
         }
-        snapInfos_.emplace(data.GetUuid(), data);
+        if (snapInfos_.emplace(data.GetUuid(), data).second) {
+            AddSnapshotIndex(data);
+        }
     }
     LOG(INFO) << "LoadSnapshotInfos size = " << snapInfos_.size();
     return 0;
@@ -294,7 +533,9 @@ int SnapshotCloneMetaStoreEtcd::LoadCloneInfos() {
             LOG(ERROR) << "DecodeCloneInfoData err";
             return -1;
         }
-        cloneInfos_.emplace(data.GetTaskId(), data);
+        if (cloneInfos_.emplace(data.GetTaskId(), data).second) {
+            AddCloneInfoIndex(data);
+        }
     }
     LOG(INFO) << "LoadCloneInfos size = " << cloneInfos_.size();
     return 0;
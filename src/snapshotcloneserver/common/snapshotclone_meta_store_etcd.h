@@ -26,6 +26,7 @@
 #include <vector>
 #include <memory>
 #include <map>
+#include <set>
 #include <string>
 
 #include "src/snapshotcloneserver/common/snapshotclone_meta_store.h"
@@ -66,6 +67,13 @@ class SnapshotCloneMetaStoreEtcd : public SnapshotCloneMetaStore {
 
     uint32_t GetSnapshotCount() override;
 
+    int GetSnapshotPage(const SnapshotFilter &filter,
+                        const UUID &cursor,
+                        uint64_t limit,
+                        std::vector<SnapshotInfo> *list,
+                        UUID *nextCursor,
+                        uint64_t *total) override;
+
     int AddCloneInfo(const CloneInfo &info) override;
 
     int DeleteCloneInfo(const std::string &uuid) override;
@@ -79,6 +87,13 @@ class SnapshotCloneMetaStoreEtcd : public SnapshotCloneMetaStore {
 
     int GetCloneInfoList(std::vector<CloneInfo> *list) override;
 
+    int GetCloneInfoPage(const CloneInfoFilter &filter,
+                         const TaskIdType &cursor,
+                         uint64_t limit,
+                         std::vector<CloneInfo> *list,
+                         TaskIdType *nextCursor,
+                         uint64_t *total) override;
+
  private:
     /**
      * @brief 加载快照信息
@@ -94,6 +109,18 @@ class SnapshotCloneMetaStoreEtcd : public SnapshotCloneMetaStore {
      */
     int LoadCloneInfos();
 
+    /**
+     * @brief 将快照加入/移出二级索引，调用者需要持有snapInfos_mutex的写锁
+     */
+    void AddSnapshotIndex(const SnapshotInfo &info);
+    void RemoveSnapshotIndex(const SnapshotInfo &info);
+
+    /**
+     * @brief 将克隆任务加入/移出二级索引，调用者需要持有cloneInfos_lock_的写锁
+     */
+    void AddCloneInfoIndex(const CloneInfo &info);
+    void RemoveCloneInfoIndex(const CloneInfo &info);
+
  private:
     std::shared_ptr<KVStorageClient> client_;
     std::shared_ptr<SnapshotCloneCodec> codec_;
@@ -102,10 +129,19 @@ class SnapshotCloneMetaStoreEtcd : public SnapshotCloneMetaStore {
     std::map<UUID, SnapshotInfo> snapInfos_;
     // snap info lock
     RWLock snapInfos_mutex;
+    // 快照的二级索引，value为按顺序排列的uuid，与snapInfos_一起受锁保护
+    std::map<std::string, std::set<UUID>> snapFileIndex_;
+    std::map<std::string, std::set<UUID>> snapUserIndex_;
+    std::map<Status, std::set<UUID>> snapStatusIndex_;
     // key is TaskIdType, map 需要考虑并发保护
     std::map<std::string, CloneInfo> cloneInfos_;
     // clone info map lock
     RWLock cloneInfos_lock_;
+    // 克隆任务的二级索引，value为按顺序排列的task id，
+    // 与cloneInfos_一起受锁保护
+    std::map<std::string, std::set<TaskIdType>> cloneFileIndex_;
+    std::map<std::string, std::set<TaskIdType>> cloneUserIndex_;
+    std::map<CloneStatus, std::set<TaskIdType>> cloneStatusIndex_;
 };
 
 }  // namespace snapshotcloneserver
@@ -1144,6 +1144,20 @@ int SnapshotCoreImpl::GetSnapshotList(std::vector<SnapshotInfo> *list) {
     return kErrCodeSuccess;
 }
 
+int SnapshotCoreImpl::GetSnapshotPage(const SnapshotFilter &filter,
+    const UUID &cursor,
+    uint64_t limit,
+    std::vector<SnapshotInfo> *list,
+    UUID *nextCursor,
+    uint64_t *total) {
+    int ret = metaStore_->GetSnapshotPage(filter, cursor, limit,
+        list, nextCursor, total);
+    if (ret < 0) {
+        return kErrCodeInternalError;
+    }
+    return kErrCodeSuccess;
+}
+
 int SnapshotCoreImpl::HandleCancelUnSchduledSnapshotTask(
     std::shared_ptr<SnapshotTaskInfo> task) {
     auto &snapInfo = task->GetSnapshotInfo();
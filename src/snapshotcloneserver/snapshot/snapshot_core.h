@@ -150,6 +150,25 @@ class SnapshotCore {
      */
     virtual int GetSnapshotList(std::vector<SnapshotInfo> *list) = 0;
 
+    /**
+     * @brief 分页获取满足条件的快照信息
+     *
+     * @param filter 过滤条件
+     * @param cursor 上一页最后一个快照的uuid，为空时从第一个开始
+     * @param limit 本页最多返回的快照数
+     * @param[out] list 本页的快照信息
+     * @param[out] nextCursor 下一页的cursor，没有更多快照时为空
+     * @param[out] total 满足条件的快照总数
+     *
+     * @return 错误码
+     */
+    virtual int GetSnapshotPage(const SnapshotFilter &filter,
+        const UUID &cursor,
+        uint64_t limit,
+        std::vector<SnapshotInfo> *list,
+        UUID *nextCursor,
+        uint64_t *total) = 0;
+
 
     virtual int GetSnapshotInfo(const UUID uuid,
         SnapshotInfo *info) = 0;
@@ -221,6 +240,13 @@ class SnapshotCoreImpl : public SnapshotCore {
 
     int GetSnapshotList(std::vector<SnapshotInfo> *list) override;
 
+    int GetSnapshotPage(const SnapshotFilter &filter,
+        const UUID &cursor,
+        uint64_t limit,
+        std::vector<SnapshotInfo> *list,
+        UUID *nextCursor,
+        uint64_t *total) override;
+
     int HandleCancelUnSchduledSnapshotTask(
         std::shared_ptr<SnapshotTaskInfo> task) override;
 
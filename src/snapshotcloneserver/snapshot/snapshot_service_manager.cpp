@@ -199,12 +199,36 @@ int SnapshotServiceManager::GetFileSnapshotInfoById(const std::string &file,
     return GetFileSnapshotInfoInner(snapInfos, user, info);
 }
 
+int SnapshotServiceManager::GetFileSnapshotInfoPage(const std::string &file,
+    const std::string &user,
+    const UUID &cursor,
+    uint64_t limit,
+    std::vector<FileSnapshotInfo> *info,
+    UUID *nextCursor,
+    uint64_t *total) {
+    SnapshotFilter filter;
+    filter.user = user;
+    filter.fileName = file;
+    std::vector<SnapshotInfo> snapInfos;
+    int ret = core_->GetSnapshotPage(filter, cursor, limit,
+        &snapInfos, nextCursor, total);
+    if (ret < 0) {
+        LOG(ERROR) << "GetSnapshotPage error, "
+                   << " ret = " << ret
+                   << ", file = " << file
+                   << ", user = " << user
+                   << ", cursor = " << cursor;
+        return ret;
+    }
+    return GetFileSnapshotInfoInner(snapInfos, user, info);
+}
+
 int SnapshotServiceManager::GetFileSnapshotInfoInner(
-    std::vector<SnapshotInfo> snapInfos,
+    const std::vector<SnapshotInfo> &snapInfos,
     const std::string &user,
     std::vector<FileSnapshotInfo> *info) {
     int ret = kErrCodeSuccess;
-    for (auto &snap : snapInfos) {
+    for (const auto &snap : snapInfos) {
         if (snap.GetUser() == user) {
             Status st = snap.GetStatus();
             switch (st) {
@@ -212,6 +212,27 @@ class SnapshotServiceManager {
         const UUID &uuid,
         std::vector<FileSnapshotInfo> *info);
 
+    /**
+     * @brief 分页获取用户的快照信息，只查询本页快照的进度
+     *
+     * @param file 文件名，为空时获取用户所有文件的快照
+     * @param user 用户名
+     * @param cursor 上一页最后一个快照的uuid，为空时从第一个开始
+     * @param limit 本页最多返回的快照数
+     * @param[out] info 本页的快照信息
+     * @param[out] nextCursor 下一页的cursor，没有更多快照时为空
+     * @param[out] total 满足条件的快照总数
+     *
+     * @return 错误码
+     */
+    virtual int GetFileSnapshotInfoPage(const std::string &file,
+        const std::string &user,
+        const UUID &cursor,
+        uint64_t limit,
+        std::vector<FileSnapshotInfo> *info,
+        UUID *nextCursor,
+        uint64_t *total);
+
     /**
      * @brief 恢复快照任务接口
      *
@@ -230,7 +251,7 @@ class SnapshotServiceManager {
      * @return 错误码
      */
     int GetFileSnapshotInfoInner(
-        std::vector<SnapshotInfo> snapInfos,
+        const std::vector<SnapshotInfo> &snapInfos,
         const std::string &user,
         std::vector<FileSnapshotInfo> *info);
 
@@ -288,6 +288,8 @@ void SnapshotCloneServiceImpl::HandleGetFileSnapshotInfoAction(
         bcntl->http_request().uri().GetQuery(kOffsetStr);
     const std::string *uuid =
         bcntl->http_request().uri().GetQuery(kUUIDStr);
+    const std::string *cursor =
+        bcntl->http_request().uri().GetQuery(kCursorStr);
     if ((version == nullptr) ||
         (user == nullptr) ||
         (version->empty()) ||
@@ -340,6 +342,10 @@ void SnapshotCloneServiceImpl::HandleGetFileSnapshotInfoAction(
         fileStr = *file;
         fileName = *file;
     }
+    std::string cursorStr = "null";
+    if (cursor != nullptr) {
+        cursorStr = *cursor;
+    }
     LOG(INFO) << "GetFileSnapshotInfo:"
               << " Version = " << *version
               << ", User = " << *user
@@ -347,13 +353,22 @@ void SnapshotCloneServiceImpl::HandleGetFileSnapshotInfoAction(
               << ", Limit = " << limitNum
               << ", Offset = " << offsetNum
               << ", UUID = " << uuidStr
+              << ", Cursor = " << cursorStr
               << ", requestId = " << requestId;
 
+    // 带有Cursor参数时从metastore中只获取本页的快照，忽略Offset
+    bool useCursor = (uuid == nullptr) && (cursor != nullptr);
     std::vector<FileSnapshotInfo> info;
+    UUID nextCursor;
+    uint64_t totalCount = 0;
     int ret = kErrCodeSuccess;
     if (uuid != nullptr) {
         ret = snapshotManager_->GetFileSnapshotInfoById(
         fileName, *user, *uuid, &info);
+    } else if (useCursor) {
+        ret = snapshotManager_->GetFileSnapshotInfoPage(
+            fileName, *user, *cursor, limitNum,
+            &info, &nextCursor, &totalCount);
     } else {
         ret = snapshotManager_->GetFileSnapshotInfo(
             fileName, *user, &info);
@@ -374,13 +389,21 @@ void SnapshotCloneServiceImpl::HandleGetFileSnapshotInfoAction(
     mainObj[kCodeStr] = std::to_string(kErrCodeSuccess);
     mainObj[kMessageStr] = code2Msg[kErrCodeSuccess];
     mainObj[kRequestIdStr] = requestId;
-    mainObj[kTotalCountStr] = info.size();
     Json::Value listSnapObj;
-    for (std::vector<FileSnapshotInfo>::size_type i = offsetNum;
-        i < info.size() && i < limitNum;
-        i++) {
-        Json::Value fileSnapObj = info[i].ToJsonObj();
-        listSnapObj.append(fileSnapObj);
+    if (useCursor) {
+        mainObj[kTotalCountStr] = totalCount;
+        for (const auto &fileSnapInfo : info) {
+            listSnapObj.append(fileSnapInfo.ToJsonObj());
+        }
+        mainObj[kNextCursorStr] = nextCursor;
+    } else {
+        mainObj[kTotalCountStr] = info.size();
+        for (std::vector<FileSnapshotInfo>::size_type i = offsetNum;
+            i < info.size() && i < offsetNum + limitNum;
+            i++) {
+            Json::Value fileSnapObj = info[i].ToJsonObj();
+            listSnapObj.append(fileSnapObj);
+        }
     }
     mainObj[kSnapshotsStr] = listSnapObj;
     os << mainObj.toStyledString();
@@ -601,6 +624,8 @@ void SnapshotCloneServiceImpl::HandleGetCloneTasksAction(
         bcntl->http_request().uri().GetQuery(kUUIDStr);
     const std::string *file =
         bcntl->http_request().uri().GetQuery(kFileStr);
+    const std::string *cursor =
+        bcntl->http_request().uri().GetQuery(kCursorStr);
     if ((version == nullptr) ||
         (user == nullptr) ||
         (version->empty()) ||
@@ -653,6 +678,11 @@ void SnapshotCloneServiceImpl::HandleGetCloneTasksAction(
         fileStr = *file;
     }
 
+    std::string cursorStr = "null";
+    if (cursor != nullptr) {
+        cursorStr = *cursor;
+    }
+
     LOG(INFO) << "GetTasks:"
               << " Version = " << *version
               << ", User = " << *user
@@ -660,13 +690,23 @@ void SnapshotCloneServiceImpl::HandleGetCloneTasksAction(
               << ", Offset = " << offsetNum
               << ", UUID = " << uuidStr
               << ", File = " << fileStr
+              << ", Cursor = " << cursorStr
               << ", requestId = " << requestId;
 
+    // 带有Cursor参数时从metastore中只获取本页的任务，忽略Offset
+    bool useCursor = (uuid == nullptr) && (cursor != nullptr);
     std::vector<TaskCloneInfo> cloneTaskInfos;
+    TaskIdType nextCursor;
+    uint64_t totalCount = 0;
     int ret = kErrCodeSuccess;
     if (uuid != nullptr) {
         ret = cloneManager_->GetCloneTaskInfoById(
             *user, *uuid, &cloneTaskInfos);
+    } else if (useCursor) {
+        std::string fileName = (file != nullptr) ? *file : "";
+        ret = cloneManager_->GetCloneTaskInfoPage(
+            *user, fileName, *cursor, limitNum,
+            &cloneTaskInfos, &nextCursor, &totalCount);
     } else if (file != nullptr) {
         ret = cloneManager_->GetCloneTaskInfoByName(
             *user, *file, &cloneTaskInfos);
@@ -690,13 +730,21 @@ void SnapshotCloneServiceImpl::HandleGetCloneTasksAction(
     mainObj[kCodeStr] = std::to_string(kErrCodeSuccess);
     mainObj[kMessageStr] = code2Msg[kErrCodeSuccess];
     mainObj[kRequestIdStr] = requestId;
-    mainObj[kTotalCountStr] = cloneTaskInfos.size();
     Json::Value listObj;
-    for (std::vector<TaskCloneInfo>::size_type i = offsetNum;
-        i < cloneTaskInfos.size() && i < limitNum;
-        i++) {
-        Json::Value cloneTaskObj = cloneTaskInfos[i].ToJsonObj();
-        listObj.append(cloneTaskObj);
+    if (useCursor) {
+        mainObj[kTotalCountStr] = totalCount;
+        for (const auto &cloneTaskInfo : cloneTaskInfos) {
+            listObj.append(cloneTaskInfo.ToJsonObj());
+        }
+        mainObj[kNextCursorStr] = nextCursor;
+    } else {
+        mainObj[kTotalCountStr] = cloneTaskInfos.size();
+        for (std::vector<TaskCloneInfo>::size_type i = offsetNum;
+            i < cloneTaskInfos.size() && i < offsetNum + limitNum;
+            i++) {
+            Json::Value cloneTaskObj = cloneTaskInfos[i].ToJsonObj();
+            listObj.append(cloneTaskObj);
+        }
     }
     mainObj[kTaskInfosStr] = listObj;
 
@@ -21,8 +21,11 @@
  */
 #include "src/tools/chunkserver_client.h"
 
+#include <brpc/controller.h>
+
 DECLARE_uint64(rpcTimeout);
 DECLARE_uint64(rpcRetryTimes);
+DECLARE_uint64(copysetHashTimeout);
 
 namespace curve {
 namespace tool {
@@ -165,5 +168,112 @@ int ChunkServerClient::GetChunkHash(const Chunk& chunk,
     return -1;
 }
 
+/**
+ * 把续传得到的一段结果合并到整个范围的结果中，
+ * 续传时chunkserver在上一段的hash基础上继续计算，所以hash直接取最后一段的
+ */
+static void MergeCopysetHashResponse(const GetCopysetHashResponse& page,
+                                     bool started,
+                                     GetCopysetHashResponse* response) {
+    if (!started) {
+        *response = page;
+        response->clear_nextchunkid();
+        return;
+    }
+    response->set_hash(page.hash());
+    if (page.chunkcount() > 0) {
+        if (response->chunkcount() == 0) {
+            response->set_minchunkid(page.minchunkid());
+        }
+        response->set_maxchunkid(page.maxchunkid());
+    }
+    response->set_chunkcount(response->chunkcount() + page.chunkcount());
+    response->mutable_chunkhashes()->MergeFrom(page.chunkhashes());
+}
+
+int ChunkServerClient::GetCopysetHash(
+                        const std::vector<std::string>& csAddrs,
+                        const GetCopysetHashRequest& request,
+                        std::vector<GetCopysetHashResponse>* responses) {
+    size_t num = csAddrs.size();
+    std::vector<std::unique_ptr<brpc::Channel>> channels(num);
+    for (size_t i = 0; i < num; ++i) {
+        channels[i].reset(new brpc::Channel());
+        if (channels[i]->Init(csAddrs[i].c_str(), nullptr) != 0) {
+            std::cout << "Init channel to chunkserver: " << csAddrs[i]
+                      << " failed!" << std::endl;
+            return -1;
+        }
+    }
+
+    responses->clear();
+    responses->resize(num);
+    // chunkserver单次最多计算一定数量的chunk，返回nextChunkId时需要续传，
+    // 每个chunkserver的续传进度不同，所以各自维护请求
+    std::vector<GetCopysetHashRequest> requests(num, request);
+    std::vector<GetCopysetHashResponse> pages(num);
+    std::vector<brpc::Controller> cntls(num);
+    std::vector<bool> done(num, false);
+    std::vector<bool> started(num, false);
+    uint64_t retryTimes = 0;
+    size_t finished = 0;
+    while (finished < num && retryTimes < FLAGS_rpcRetryTimes) {
+        // 向所有还没有完成的chunkserver并发发送请求
+        for (size_t i = 0; i < num; ++i) {
+            if (done[i]) {
+                continue;
+            }
+            cntls[i].Reset();
+            cntls[i].set_timeout_ms(FLAGS_copysetHashTimeout);
+            pages[i].Clear();
+            curve::chunkserver::ChunkService_Stub stub(channels[i].get());
+            stub.GetCopysetHash(&cntls[i], &requests[i], &pages[i],
+                                brpc::DoNothing());
+        }
+        bool failed = false;
+        for (size_t i = 0; i < num; ++i) {
+            if (done[i]) {
+                continue;
+            }
+            brpc::Join(cntls[i].call_id());
+            if (cntls[i].Failed()) {
+                failed = true;
+                continue;
+            }
+            if (pages[i].status() != CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS) {
+                std::cout << "GetCopysetHash from " << csAddrs[i]
+                          << " fail, request: " << requests[i].DebugString()
+                          << ", errCode: " << pages[i].status() << std::endl;
+                return -1;
+            }
+            MergeCopysetHashResponse(pages[i], started[i], &(*responses)[i]);
+            started[i] = true;
+            if (pages[i].has_nextchunkid()) {
+                requests[i].set_beginchunkid(pages[i].nextchunkid());
+                requests[i].set_inithash(pages[i].hash());
+                continue;
+            }
+            done[i] = true;
+            ++finished;
+        }
+        // 只有rpc失败才计入重试次数，续传不算
+        if (failed) {
+            retryTimes++;
+        }
+    }
+    if (finished == num) {
+        return 0;
+    }
+    // 只打最后一次失败的原因
+    for (size_t i = 0; i < num; ++i) {
+        if (!done[i]) {
+            std::cout << "Send RPC to chunkserver " << csAddrs[i]
+                      << " fail, error content: "
+                      << cntls[i].ErrorText() << std::endl;
+        }
+    }
+    return -1;
+}
+
 }  // namespace tool
 }  // namespace curve
@@ -29,6 +29,8 @@
 
 #include <string>
 #include <iostream>
+#include <memory>
+#include <vector>
 
 #include "proto/chunk.pb.h"
 #include "proto/copyset.pb.h"
@@ -39,6 +41,8 @@ using curve::chunkserver::CopysetStatusResponse;
 using curve::chunkserver::COPYSET_OP_STATUS;
 using curve::chunkserver::GetChunkHashRequest;
 using curve::chunkserver::GetChunkHashResponse;
+using curve::chunkserver::GetCopysetHashRequest;
+using curve::chunkserver::GetCopysetHashResponse;
 using curve::chunkserver::CHUNK_OP_STATUS;
 
 namespace curve {
@@ -94,6 +98,19 @@ class ChunkServerClient {
     */
     virtual int GetChunkHash(const Chunk& chunk, std::string* chunkHash);
 
+    /**
+    *  @brief 并发地向多个chunkserver获取copyset指定范围内chunk的hash，
+    *         chunkserver返回nextChunkId时继续请求剩余的部分并合并结果，
+    *         不使用Init初始化的channel
+    *  @param csAddrs chunkserver地址列表
+    *  @param request 查询的request
+    *  @param[out] responses 与csAddrs一一对应的response，返回值为0时有效
+    *  @return 成功返回0，失败返回-1
+    */
+    virtual int GetCopysetHash(const std::vector<std::string>& csAddrs,
+                               const GetCopysetHashRequest& request,
+                               std::vector<GetCopysetHashResponse>* responses);
+
  private:
     brpc::Channel channel_;
     std::string csAddr_;
@@ -22,6 +22,9 @@
 
 #include <gflags/gflags.h>
 
+#include <algorithm>
+#include <limits>
+
 #include "src/tools/consistency_check.h"
 
 DEFINE_string(filename, "", "filename to check consistency");
@@ -30,6 +33,11 @@ DEFINE_bool(check_hash, true, R"(用户需要先确认copyset的applyindex一致
                         check_hash = false先检查copyset的applyindex是否一致
                         如果一致了再设置check_hash = true，
                         检查copyset内容是不是一致)");
+DEFINE_bool(check_copyset_hash, true, "检查hash时按chunk id范围计算整个"
+                        "copyset的hash，只对不一致的范围继续细分；为false时"
+                        "逐个检查文件的chunk，用于不支持该接口的chunkserver");
+DEFINE_uint32(hash_leaf_chunk_num, 16, "范围内chunk个数不超过该值时"
+                                       "直接比较每个chunk的hash");
 DEFINE_uint32(chunkServerBasePort, 8200, "base port of chunkserver");
 DECLARE_string(mdsAddr);
 
@@ -222,6 +230,10 @@ int ConsistencyCheck::GetCopysetStatusResponse(
 
 int ConsistencyCheck::CheckCopysetHash(const CopySet& copyset,
                                        const CsAddrsType& csAddrs) {
+    if (FLAGS_check_copyset_hash) {
+        return CheckRangeHash(copyset, csAddrs, 0,
+                              std::numeric_limits<uint64_t>::max());
+    }
     for (const auto& chunkId : chunksInCopyset_[copyset]) {
         Chunk chunk(copyset.first, copyset.second, chunkId);
         int res = CheckChunkHash(chunk, csAddrs);
@@ -266,6 +278,120 @@ int ConsistencyCheck::CheckChunkHash(const Chunk& chunk,
     return 0;
 }
 
+int ConsistencyCheck::CheckRangeHash(const CopySet& copyset,
+                                     const CsAddrsType& csAddrs,
+                                     uint64_t begin, uint64_t end) {
+    GetCopysetHashRequest request;
+    request.set_logicpoolid(copyset.first);
+    request.set_copysetid(copyset.second);
+    request.set_beginchunkid(begin);
+    request.set_endchunkid(end);
+    request.set_withchunkhash(false);
+    std::vector<GetCopysetHashResponse> responses;
+    int res = csClient_->GetCopysetHash(csAddrs, request, &responses);
+    if (res != 0) {
+        std::cout << "GetCopysetHash fail, " << copyset << ","
+                  << csAddrs << std::endl;
+        return -1;
+    }
+
+    bool equal = true;
+    uint32_t maxCount = 0;
+    uint64_t minId = std::numeric_limits<uint64_t>::max();
+    uint64_t maxId = 0;
+    for (const auto& response : responses) {
+        if (response.hash() != responses[0].hash() ||
+            response.chunkcount() != responses[0].chunkcount()) {
+            equal = false;
+        }
+        if (response.chunkcount() > 0) {
+            minId = std::min(minId, response.minchunkid());
+            maxId = std::max(maxId, response.maxchunkid());
+        }
+        maxCount = std::max(maxCount, response.chunkcount());
+    }
+    if (equal) {
+        return 0;
+    }
+
+    // chunk个数足够少时直接比较每个chunk，否则二分之后只检查不一致的一半
+    if (maxCount <= FLAGS_hash_leaf_chunk_num || minId == maxId) {
+        return CheckChunkHashInRange(copyset, csAddrs, minId, maxId + 1);
+    }
+    uint64_t mid = minId + (maxId - minId) / 2;
+    int ret = 0;
+    if (CheckRangeHash(copyset, csAddrs, minId, mid + 1) != 0) {
+        ret = -1;
+    }
+    if (CheckRangeHash(copyset, csAddrs, mid + 1, maxId + 1) != 0) {
+        ret = -1;
+    }
+    return ret;
+}
+
+int ConsistencyCheck::CheckChunkHashInRange(const CopySet& copyset,
+                                            const CsAddrsType& csAddrs,
+                                            uint64_t begin, uint64_t end) {
+    GetCopysetHashRequest request;
+    request.set_logicpoolid(copyset.first);
+    request.set_copysetid(copyset.second);
+    request.set_beginchunkid(begin);
+    request.set_endchunkid(end);
+    request.set_withchunkhash(true);
+    std::vector<GetCopysetHashResponse> responses;
+    int res = csClient_->GetCopysetHash(csAddrs, request, &responses);
+    if (res != 0) {
+        std::cout << "GetCopysetHash fail, " << copyset << ","
+                  << csAddrs << std::endl;
+        return -1;
+    }
+
+    // chunk id -> 各个副本上的hash，副本上不存在的chunk的hash为空
+    std::map<uint64_t, std::vector<std::string>> chunkHashes;
+    for (size_t i = 0; i < responses.size(); ++i) {
+        for (const auto& chunkHash : responses[i].chunkhashes()) {
+            auto& hashes = chunkHashes[chunkHash.chunkid()];
+            hashes.resize(responses.size());
+            hashes[i] = chunkHash.hash();
+        }
+    }
+
+    int ret = 0;
+    for (auto& item : chunkHashes) {
+        item.second.resize(responses.size());
+        bool equal = true;
+        for (const auto& hash : item.second) {
+            if (hash != item.second[0]) {
+                equal = false;
+                break;
+            }
+        }
+        if (equal) {
+            continue;
+        }
+        ret = -1;
+        Chunk chunk(copyset.first, copyset.second, item.first);
+        std::cout << "Chunk hash not equal!" << std::endl;
+        std::cout << "chunk hashes = [";
+        for (size_t i = 0; i < item.second.size(); ++i) {
+            if (i != 0) {
+                std::cout << ",";
+            }
+            std::cout << item.second[i];
+        }
+        std::cout << "]" << std::endl;
+        std::cout << "{" << chunk << "," << csAddrs << "}" << std::endl;
+    }
+    if (ret == 0) {
+        // 两次查询之间chunk被修改过，需要在没有IO的时候重新检查
+        std::cout << "Copyset hash not equal but chunk hash equal, "
+                  << "chunk may be modified during check, " << copyset
+                  << "," << csAddrs << std::endl;
+        ret = -1;
+    }
+    return ret;
+}
+
 int ConsistencyCheck::CheckApplyIndex(const CopySet copyset,
                                       const CsAddrsType& csAddrs) {
     uint64_t preIndex;
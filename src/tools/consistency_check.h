@@ -45,6 +45,7 @@
 
 DECLARE_string(filename);
 DECLARE_bool(check_hash);
+DECLARE_bool(check_copyset_hash);
 
 namespace curve {
 namespace tool {
@@ -147,6 +148,32 @@ class ConsistencyCheck : public CurveTool {
     int CheckChunkHash(const Chunk& chunk,
                        const CsAddrsType& csAddrs);
 
+    /**
+     *  @brief 并发获取各副本上chunk id在[begin, end)范围内的copyset hash，
+     *         不一致时将范围二分，只对不一致的范围继续检查
+     *  @param copyset 要检查的copyset
+     *  @param csAddrs copyset对应的chunkserver的地址
+     *  @param begin 范围内最小的chunk id
+     *  @param end 范围内最大的chunk id加一
+     *  @return 一致返回0，否则返回-1
+     */
+    int CheckRangeHash(const CopySet& copyset,
+                       const CsAddrsType& csAddrs,
+                       uint64_t begin, uint64_t end);
+
+    /**
+     *  @brief 获取各副本上[begin, end)范围内每个chunk的hash并逐个比较，
+     *         打印不一致的chunk
+     *  @param copyset 要检查的copyset
+     *  @param csAddrs copyset对应的chunkserver的地址
+     *  @param begin 范围内最小的chunk id
+     *  @param end 范围内最大的chunk id加一
+     *  @return 一致返回0，否则返回-1
+     */
+    int CheckChunkHashInRange(const CopySet& copyset,
+                              const CsAddrsType& csAddrs,
+                              uint64_t begin, uint64_t end);
+
     /**
      *  @brief 检查副本间applyindex的一致性
      *  @param copysetId 要检查的copysetId
@@ -25,17 +25,20 @@
 #include <json/json.h>
 
 #include <fcntl.h>
+#include <unistd.h>
 
+#include <algorithm>
 #include <set>
-#include <mutex>    // NOLINT
 #include <thread>   // NOLINT
 #include <atomic>
+#include <chrono>   // NOLINT
 #include <vector>
 
 #include "src/fs/fs_common.h"
 #include "src/fs/local_filesystem.h"
 #include "src/common/crc32.h"
 #include "src/common/curve_define.h"
+#include "src/common/interruptible_sleeper.h"
 #include "src/chunkserver/datastore/chunkfile_pool.h"
 
 /**
@@ -86,11 +89,39 @@ DEFINE_bool(needWriteZero,
         true,
         "not write zero for test.");
 
+// 同时分配chunk的线程数，NVMe盘单线程远远达不到磁盘带宽，可以适当调大
+DEFINE_uint32(allocateThreadNum,
+              4,
+              "number of threads allocating chunks concurrently");
+
+// 使用O_DIRECT写零可以避免大量脏页和page cache的拷贝，
+// 文件系统不支持O_DIRECT时自动退回到buffer io
+DEFINE_bool(useDirectIO,
+            true,
+            "write zero with O_DIRECT");
+
+// 每个线程分配这么多个chunk之后才执行一次syncfs，而不是每个chunk一次fsync
+DEFINE_uint32(syncBatchNum,
+              64,
+              "sync the filesystem once per batch of allocated chunks");
+
+DEFINE_uint32(progressIntervalSec,
+              10,
+              "interval of reporting allocate progress, 0 means not report");
+
 using curve::fs::FileSystemType;
 using curve::fs::LocalFsFactory;
 using curve::fs::FileSystemInfo;
 using curve::fs::LocalFileSystem;
 using curve::common::kChunkFilePoolMaigic;
+using curve::common::kChunkFilePoolTmpSuffix;
+
+using curve::common::InterruptibleSleeper;
+
+// 写零时每次写入的数据量
+static const uint32_t kWriteZeroBlockSize = 1024 * 1024;
+// O_DIRECT要求的内存对齐
+static const uint32_t kDirectIOAlignment = 4096;
 
 class CompareInternal {
  public:
@@ -101,77 +132,222 @@ class CompareInternal {
     }
 };
 
+// 分配过程中先写临时文件，数据落盘之后才rename成正式的chunk文件，
+// 分配失败退出或者中断后重新执行时会删除残留的临时文件，
+// 已经分配好的chunk不会重复分配
 struct AllocateStruct {
     std::shared_ptr<LocalFileSystem> fsptr;
+    // 下一个chunk文件的编号
     std::atomic<uint64_t>* allocateChunknum;
-    bool* checkwrong;
-    std::mutex* mtx;
+    // 已经开始分配的chunk数量，用于在线程间分配任务
+    std::atomic<uint64_t>* claimedChunknum;
+    // 已经落盘的chunk数量
+    std::atomic<uint64_t>* finishedChunknum;
+    std::atomic<bool>* checkwrong;
+    // 文件系统不支持O_DIRECT时置为false
+    std::atomic<bool>* directIO;
+    // 本次需要分配的chunk数量
     uint64_t chunknum;
 };
 
-int AllocateChunks(AllocateStruct* allocatestruct) {
-    char* data = new(std::nothrow)char[FLAGS_chunksize + FLAGS_metapagsize];
-    memset(data, 0, FLAGS_chunksize + FLAGS_metapagsize);
-
-    uint64_t count = 0;
-    while (count < allocatestruct->chunknum) {
-        std::string filename;
-        {
-            std::unique_lock<std::mutex> lk(*allocatestruct->mtx);
-            allocatestruct->allocateChunknum->fetch_add(1);
-            filename = std::to_string(
-                            allocatestruct->allocateChunknum->load());
+/**
+ * 将一批临时chunk文件落盘并rename为正式的chunk文件
+ * @param fsptr: 本地文件系统
+ * @param tmpfiles: 待提交的临时文件名（不带后缀）
+ * @return 成功返回0，失败返回-1
+ */
+int CommitChunks(std::shared_ptr<LocalFileSystem> fsptr,
+                 std::vector<std::string>* tmpfiles) {
+    if (tmpfiles->empty()) {
+        return 0;
+    }
+
+    // 一次syncfs代替每个文件一次fsync
+    int dirfd = fsptr->Open(FLAGS_chunkfilepool_dir.c_str(),
+                            O_RDONLY | O_DIRECTORY);
+    if (dirfd < 0) {
+        LOG(ERROR) << "open dir failed, " << FLAGS_chunkfilepool_dir;
+        return -1;
+    }
+    int ret = ::syncfs(dirfd);
+    if (ret < 0) {
+        LOG(ERROR) << "syncfs failed, " << FLAGS_chunkfilepool_dir
+                   << ", errno = " << errno;
+        fsptr->Close(dirfd);
+        return -1;
+    }
+
+    for (auto& filename : *tmpfiles) {
+        std::string path = FLAGS_chunkfilepool_dir + "/" + filename;
+        ret = fsptr->Rename(path + kChunkFilePoolTmpSuffix, path);
+        if (ret < 0) {
+            LOG(ERROR) << "rename failed, " << path;
+            fsptr->Close(dirfd);
+            return -1;
+        }
+    }
+
+    // rename修改的是目录项，需要fsync目录才能保证掉电之后chunk文件名已经持久化
+    ret = fsptr->Fsync(dirfd);
+    fsptr->Close(dirfd);
+    if (ret < 0) {
+        LOG(ERROR) << "fsync dir failed, " << FLAGS_chunkfilepool_dir;
+        return -1;
+    }
+    tmpfiles->clear();
+    return 0;
+}
+
+/**
+ * 删除目录中残留的临时chunk文件
+ * @param fsptr: 本地文件系统
+ * @param filenames: 目录中的文件名，删除的临时文件会从中移除
+ * @return 成功返回0，失败返回-1
+ */
+int RemoveTmpChunks(std::shared_ptr<LocalFileSystem> fsptr,
+                    std::vector<std::string>* filenames) {
+    for (auto iter = filenames->begin(); iter != filenames->end();) {
+        if (iter->find(kChunkFilePoolTmpSuffix) != std::string::npos) {
+            std::string path = FLAGS_chunkfilepool_dir + "/" + *iter;
+            if (fsptr->Delete(path.c_str()) < 0) {
+                LOG(ERROR) << "delete tmp chunk failed, " << path;
+                return -1;
+            }
+            iter = filenames->erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+    return 0;
+}
+
+/**
+ * 打开用于分配的临时文件，优先使用O_DIRECT
+ */
+int OpenChunkFile(AllocateStruct* allocatestruct, const std::string& path) {
+    int flags = O_RDWR | O_CREAT | O_TRUNC;
+    if (FLAGS_needWriteZero && allocatestruct->directIO->load()) {
+        int fd = allocatestruct->fsptr->Open(path.c_str(), flags | O_DIRECT);
+        if (fd != -EINVAL) {
+            return fd;
+        }
+        if (allocatestruct->directIO->exchange(false)) {
+            LOG(WARNING) << "filesystem does not support O_DIRECT, "
+                         << "fall back to buffered io.";
         }
-        std::string tmpchunkfilepath
-                    = FLAGS_chunkfilepool_dir + "/" + filename;
+    }
+    return allocatestruct->fsptr->Open(path.c_str(), flags);
+}
 
-        int ret = allocatestruct->fsptr->Open(tmpchunkfilepath.c_str(),
-                                             O_RDWR | O_CREAT);
+int AllocateChunks(AllocateStruct* allocatestruct) {
+    uint64_t filelen = FLAGS_chunksize + FLAGS_metapagsize;
+    char* data = nullptr;
+    if (posix_memalign(reinterpret_cast<void**>(&data),
+                       kDirectIOAlignment, kWriteZeroBlockSize) != 0) {
+        LOG(ERROR) << "allocate aligned buffer failed.";
+        allocatestruct->checkwrong->store(true);
+        return -1;
+    }
+    memset(data, 0, kWriteZeroBlockSize);
+
+    std::vector<std::string> tmpfiles;
+    while (!allocatestruct->checkwrong->load() &&
+           allocatestruct->claimedChunknum->fetch_add(1) <
+           allocatestruct->chunknum) {
+        std::string filename = std::to_string(
+                            allocatestruct->allocateChunknum->fetch_add(1));
+        std::string tmpchunkfilepath = FLAGS_chunkfilepool_dir + "/"
+                + filename + kChunkFilePoolTmpSuffix;
+
+        int ret = OpenChunkFile(allocatestruct, tmpchunkfilepath);
         if (ret < 0) {
-            *allocatestruct->checkwrong = true;
+            allocatestruct->checkwrong->store(true);
             LOG(ERROR) << "file open failed, " << tmpchunkfilepath.c_str();
             break;
         }
         int fd = ret;
 
-        ret = allocatestruct->fsptr->Fallocate(fd, 0, 0,
-                                             FLAGS_chunksize+FLAGS_metapagsize);
+        ret = allocatestruct->fsptr->Fallocate(fd, 0, 0, filelen);
         if (ret < 0) {
             allocatestruct->fsptr->Close(fd);
-            *allocatestruct->checkwrong = true;
+            allocatestruct->checkwrong->store(true);
             LOG(ERROR) << "Fallocate failed, " << tmpchunkfilepath.c_str();
             break;
         }
 
         if (FLAGS_needWriteZero) {
-            ret = allocatestruct->fsptr->Write(fd, data, 0,
-                FLAGS_chunksize+FLAGS_metapagsize);
+            // 以大块对齐的写入写零，保证后续写入不需要再转换unwritten extent
+            for (uint64_t offset = 0; offset < filelen && ret >= 0;
+                 offset += kWriteZeroBlockSize) {
+                uint64_t len = std::min<uint64_t>(kWriteZeroBlockSize,
+                                                  filelen - offset);
+                ret = allocatestruct->fsptr->Write(fd, data, offset, len);
+            }
             if (ret < 0) {
                 allocatestruct->fsptr->Close(fd);
-                *allocatestruct->checkwrong = true;
+                allocatestruct->checkwrong->store(true);
                 LOG(ERROR) << "write failed, " << tmpchunkfilepath.c_str();
                 break;
             }
         }
 
-        ret = allocatestruct->fsptr->Fsync(fd);
+        ret = allocatestruct->fsptr->Close(fd);
         if (ret < 0) {
-            allocatestruct->fsptr->Close(fd);
-            *allocatestruct->checkwrong = true;
-            LOG(ERROR) << "fsync failed, " << tmpchunkfilepath.c_str();
+            allocatestruct->checkwrong->store(true);
+            LOG(ERROR) << "close failed, " << tmpchunkfilepath.c_str();
             break;
         }
 
-        allocatestruct->fsptr->Close(fd);
-        if (ret < 0) {
-            *allocatestruct->checkwrong = true;
-            LOG(ERROR) << "close failed, " << tmpchunkfilepath.c_str();
-            break;
+        tmpfiles.push_back(filename);
+        if (tmpfiles.size() >= FLAGS_syncBatchNum) {
+            uint64_t num = tmpfiles.size();
+            if (CommitChunks(allocatestruct->fsptr, &tmpfiles) != 0) {
+                allocatestruct->checkwrong->store(true);
+                break;
+            }
+            allocatestruct->finishedChunknum->fetch_add(num);
         }
-        count++;
     }
-    delete[] data;
-    return *allocatestruct->checkwrong == true ? 0 : -1;
+
+    if (!allocatestruct->checkwrong->load()) {
+        uint64_t num = tmpfiles.size();
+        if (CommitChunks(allocatestruct->fsptr, &tmpfiles) != 0) {
+            allocatestruct->checkwrong->store(true);
+        } else {
+            allocatestruct->finishedChunknum->fetch_add(num);
+        }
+    }
+    free(data);
+    return allocatestruct->checkwrong->load() ? -1 : 0;
+}
+
+/**
+ * 定期打印分配进度和吞吐
+ */
+void ReportProgress(std::atomic<uint64_t>* finishedChunknum,
+                    uint64_t totalChunknum,
+                    InterruptibleSleeper* sleeper) {
+    uint64_t filelen = FLAGS_chunksize + FLAGS_metapagsize;
+    auto start = std::chrono::steady_clock::now();
+    uint64_t lastFinished = 0;
+    while (sleeper->wait_for(
+        std::chrono::seconds(FLAGS_progressIntervalSec))) {
+        uint64_t finished = finishedChunknum->load();
+        double elapsed = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+        double intervalMBps = (finished - lastFinished) * filelen
+            / 1024.0 / 1024.0 / FLAGS_progressIntervalSec;
+        double avgMBps = finished * filelen / 1024.0 / 1024.0 / elapsed;
+        uint64_t etaSec = avgMBps > 0 ?
+            (totalChunknum - finished) * filelen / 1024.0 / 1024.0 / avgMBps
+            : 0;
+        LOG(INFO) << "allocated " << finished << "/" << totalChunknum
+                  << " chunks (" << finished * 100 / totalChunknum << "%)"
+                  << ", throughput = " << intervalMBps << " MB/s"
+                  << ", average = " << avgMBps << " MB/s"
+                  << ", eta = " << etaSec << " s";
+        lastFinished = finished;
+    }
 }
 
 // TODO(tongguangxun) :添加单元测试
@@ -180,7 +356,6 @@ int main(int argc, char** argv) {
     google::InitGoogleLogging(argv[0]);
 
     // load current chunkfile pool
-    std::mutex mtx;
     std::shared_ptr<LocalFileSystem> fsptr = LocalFsFactory::CreateFs(FileSystemType::EXT4, "");   // NOLINT
     std::set<std::string, CompareInternal> tmpChunkSet_;
     std::atomic<uint64_t> allocateChunknum_(0);
@@ -195,7 +370,13 @@ int main(int argc, char** argv) {
         return -1;
     }
 
+    // 删除上次中断时没有完成的临时文件
+    if (RemoveTmpChunks(fsptr, &tmpvec) != 0) {
+        return -1;
+    }
+
     tmpChunkSet_.insert(tmpvec.begin(), tmpvec.end());
+    uint64_t existChunkNum = tmpChunkSet_.size();
     uint64_t size = tmpChunkSet_.size() ? atoi((*(--tmpChunkSet_.end())).c_str()) : 0;          // NOLINT
     allocateChunknum_.store(size + 1);
 
@@ -206,8 +387,12 @@ int main(int argc, char** argv) {
         return -1;
     }
 
-    uint64_t freepercent = finfo.available * 100 / finfo.total;
+    // 已经分配好的chunk也算作可用空间，以便中断之后可以继续分配
+    uint64_t existSize =
+        existChunkNum * (FLAGS_chunksize + FLAGS_metapagsize);
+    uint64_t freepercent = (finfo.available + existSize) * 100 / finfo.total;
     LOG(INFO) << "free space = " << finfo.available
+              << ", allocated chunks = " << existChunkNum
               << ", total space = " << finfo.total
               << ", freepercent = " << freepercent;
 
@@ -226,26 +411,64 @@ int main(int argc, char** argv) {
         preAllocateChunkNum = FLAGS_preallocateNum;
     }
 
-    bool checkwrong = false;
-    // two threads concurrent, can reach the bandwidth of disk.
-    uint64_t threadAllocateNum = preAllocateChunkNum/2;
-    std::vector<std::thread> thvec;
+    uint64_t needAllocateNum = preAllocateChunkNum > existChunkNum ?
+                               preAllocateChunkNum - existChunkNum : 0;
+    LOG(INFO) << "preallocate chunk num = " << preAllocateChunkNum
+              << ", already allocated = " << existChunkNum
+              << ", need allocate = " << needAllocateNum;
+
+    std::atomic<uint64_t> claimedChunknum(0);
+    std::atomic<uint64_t> finishedChunknum(0);
+    std::atomic<bool> checkwrong(false);
+    std::atomic<bool> directIO(FLAGS_useDirectIO);
     AllocateStruct allocateStruct;
     allocateStruct.fsptr = fsptr;
     allocateStruct.allocateChunknum = &allocateChunknum_;
+    allocateStruct.claimedChunknum = &claimedChunknum;
+    allocateStruct.finishedChunknum = &finishedChunknum;
     allocateStruct.checkwrong = &checkwrong;
-    allocateStruct.mtx = &mtx;
-    allocateStruct.chunknum = threadAllocateNum;
+    allocateStruct.directIO = &directIO;
+    allocateStruct.chunknum = needAllocateNum;
+
+    InterruptibleSleeper sleeper;
+    std::thread reporter;
+    if (FLAGS_progressIntervalSec > 0 && needAllocateNum > 0) {
+        reporter = std::thread(ReportProgress, &finishedChunknum,
+                               needAllocateNum, &sleeper);
+    }
 
-    thvec.push_back(std::move(std::thread(AllocateChunks, &allocateStruct)));
-    thvec.push_back(std::move(std::thread(AllocateChunks, &allocateStruct)));
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> thvec;
+    uint32_t threadNum = std::max<uint32_t>(1, FLAGS_allocateThreadNum);
+    for (uint32_t i = 0; i < threadNum; ++i) {
+        thvec.emplace_back(AllocateChunks, &allocateStruct);
+    }
 
     for (auto& iter : thvec) {
         iter.join();
     }
+    sleeper.interrupt();
+    if (reporter.joinable()) {
+        reporter.join();
+    }
 
-    if (checkwrong) {
+    double elapsed = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+    LOG(INFO) << "allocate " << finishedChunknum.load() << " chunks in "
+              << elapsed << " s, average throughput = "
+              << (elapsed > 0 ? finishedChunknum.load() *
+                  (FLAGS_chunksize + FLAGS_metapagsize) / 1024.0 / 1024.0
+                  / elapsed : 0) << " MB/s";
+
+    if (checkwrong.load()) {
         LOG(ERROR) << "allocate got something wrong, please check.";
+        // 失败的线程中还没有提交的临时文件不能留在chunkfilepool目录中
+        std::vector<std::string> leftvec;
+        if (fsptr->List(FLAGS_chunkfilepool_dir.c_str(), &leftvec) < 0 ||
+            RemoveTmpChunks(fsptr, &leftvec) != 0) {
+            LOG(ERROR) << "remove tmp chunks failed, "
+                       << FLAGS_chunkfilepool_dir;
+        }
         return -1;
     }
 
@@ -31,6 +31,8 @@ DEFINE_string(mdsDummyPort, "6667", "dummy port of mds, "
 DEFINE_string(etcdAddr, "127.0.0.1:2379", "etcd addr");
 DEFINE_uint64(rpcTimeout, 3000, "millisecond for rpc timeout");
 DEFINE_uint64(rpcRetryTimes, 5, "rpc retry times");
+DEFINE_uint64(copysetHashTimeout, 600000, "millisecond for rpc timeout of "
+                                          "calculating copyset hash");
 DEFINE_string(snapshotCloneAddr, "127.0.0.1:5555", "snapshot clone addr");
 DEFINE_string(snapshotCloneDummyPort, "8081", "dummy port of snapshot clone, "
                                     "can specify one or several. "
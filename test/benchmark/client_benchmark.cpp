@@ -0,0 +1,154 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include <benchmark/benchmark.h>
+#include <butil/endpoint.h>
+#include <glog/logging.h>
+
+#include <list>
+#include <memory>
+#include <string>
+
+#include "src/client/io_tracker.h"
+#include "src/client/mds_client.h"
+#include "src/client/metacache.h"
+#include "src/client/request_context.h"
+#include "src/client/splitor.h"
+
+namespace curve {
+namespace client {
+
+const uint64_t kChunkSize = 16 * 1024 * 1024;
+const uint32_t kChunkNum = 1024;
+const uint32_t kCopysetNum = 100;
+
+/**
+ * metacache中预先填充所有chunk和copyset的信息，
+ * 测试过程中不会访问mds或者chunkserver
+ */
+static void FillMetaCache(MetaCache* metaCache) {
+    MetaCacheOption_t option;
+    metaCache->Init(option, nullptr);
+
+    for (CopysetID cpid = 0; cpid < kCopysetNum; ++cpid) {
+        CopysetInfo_t csinfo;
+        for (ChunkServerID csid = 1; csid <= 3; ++csid) {
+            butil::EndPoint ep;
+            butil::str2endpoint("127.0.0.1", 8200 + csid, &ep);
+            csinfo.csinfos_.push_back(
+                CopysetPeerInfo(csid, ChunkServerAddr(ep)));
+        }
+        csinfo.UpdateLeaderInfo(1, csinfo.csinfos_[0].csaddr_);
+        metaCache->UpdateCopysetInfo(1, cpid, csinfo);
+    }
+    for (ChunkIndex idx = 0; idx < kChunkNum; ++idx) {
+        metaCache->UpdateChunkInfoByIndex(
+            idx, ChunkIDInfo(idx + 1, 1, idx % kCopysetNum));
+    }
+}
+
+// 用户IO按chunk及最大请求大小拆分成RequestContext
+// range(0)为用户IO的大小
+static void BM_SplitIO(benchmark::State& state) {
+    IOSplitOPtion_t splitOption;
+    splitOption.fileIOSplitMaxSizeKB = 64;
+    Splitor::Init(splitOption);
+
+    MetaCache metaCache;
+    FillMetaCache(&metaCache);
+    MDSClient mdsClient;
+
+    FInfo_t fileInfo;
+    fileInfo.chunksize = kChunkSize;
+    fileInfo.segmentsize = 1024 * 1024 * 1024ul;
+    fileInfo.seqnum = 1;
+
+    size_t length = state.range(0);
+    std::unique_ptr<char[]> buf(new char[length]);
+    uint64_t fileSize = kChunkSize * kChunkNum;
+    off_t offset = 0;
+    for (auto _ : state) {
+        IOTracker tracker(nullptr, &metaCache, nullptr);
+        tracker.SetOpType(OpType::WRITE);
+        std::list<RequestContext*> requests;
+        int ret = Splitor::IO2ChunkRequests(&tracker, &metaCache, &requests,
+                                            buf.get(), offset, length,
+                                            &mdsClient, &fileInfo);
+        if (ret != 0) {
+            state.SkipWithError("split io failed");
+            break;
+        }
+        for (auto req : requests) {
+            req->UnInit();
+            delete req;
+        }
+        offset = (offset + length) % (fileSize - length);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SplitIO)->Arg(4 * 1024)->Arg(64 * 1024)->Arg(1024 * 1024);
+
+// 按chunk index查找chunk信息
+static void BM_MetaCacheGetChunkInfo(benchmark::State& state) {
+    MetaCache metaCache;
+    FillMetaCache(&metaCache);
+
+    ChunkIndex idx = 0;
+    ChunkIDInfo_t chunkInfo;
+    for (auto _ : state) {
+        MetaCacheErrorType ret =
+            metaCache.GetChunkInfoByIndex(idx, &chunkInfo);
+        if (ret != MetaCacheErrorType::OK) {
+            state.SkipWithError("get chunk info failed");
+            break;
+        }
+        idx = (idx + 1) % kChunkNum;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MetaCacheGetChunkInfo)->ThreadRange(1, 8)->UseRealTime();
+
+// 查找copyset的leader，leader已经缓存在metacache中
+static void BM_MetaCacheGetLeader(benchmark::State& state) {
+    MetaCache metaCache;
+    FillMetaCache(&metaCache);
+
+    CopysetID cpid = 0;
+    ChunkServerID leaderId;
+    butil::EndPoint leaderAddr;
+    for (auto _ : state) {
+        int ret = metaCache.GetLeader(1, cpid, &leaderId, &leaderAddr);
+        if (ret != 0) {
+            state.SkipWithError("get leader failed");
+            break;
+        }
+        cpid = (cpid + 1) % kCopysetNum;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MetaCacheGetLeader)->ThreadRange(1, 8)->UseRealTime();
+
+}  // namespace client
+}  // namespace curve
+
+BENCHMARK_MAIN();
@@ -0,0 +1,70 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include <benchmark/benchmark.h>
+#include <glog/logging.h>
+
+#include <atomic>
+
+#include "src/chunkserver/concurrent_apply.h"
+
+namespace curve {
+namespace chunkserver {
+
+/**
+ * ConcurrentApplyModule的吞吐：每次迭代push一个空任务，
+ * 不同的key分散到各个apply线程，最后等待所有任务执行完
+ * range(0)为apply线程数，range(1)为key的个数
+ */
+static void BM_ConcurrentApplyPush(benchmark::State& state) {
+    ConcurrentApplyModule concurrentApply;
+    CHECK(concurrentApply.Init(state.range(0), 1024));
+
+    std::atomic<uint64_t> done(0);
+    auto task = [&done]() {
+        done.fetch_add(1, std::memory_order_relaxed);
+    };
+
+    uint64_t key = 0;
+    for (auto _ : state) {
+        concurrentApply.Push(key, task);
+        key = (key + 1) % state.range(1);
+    }
+    concurrentApply.Flush();
+    concurrentApply.Stop();
+
+    CHECK_EQ(state.iterations(), done.load());
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_ConcurrentApplyPush)
+    ->Args({1, 1})
+    ->Args({10, 1})
+    ->Args({10, 1024})
+    ->Args({32, 1024})
+    ->UseRealTime();
+
+}  // namespace chunkserver
+}  // namespace curve
+
+BENCHMARK_MAIN();
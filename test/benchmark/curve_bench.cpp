@@ -0,0 +1,323 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+/**
+ * 类似fio的libcurve压测工具，通过libcurve的异步接口对卷发起读写，
+ * 结束后以json格式输出各类IO的iops、带宽及延时分布，例如：
+ * curve_bench --confPath=/etc/curve/client.conf --fileName=/bench \
+ *     --rw=randwrite --bs=4096 --iodepth=32 --runtimeSec=60 \
+ *     --output=result.json
+ */
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <butil/fast_rand.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>  // NOLINT
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>   // NOLINT
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "include/client/libcurve.h"
+#include "src/common/timeutility.h"
+
+DEFINE_string(confPath, "/etc/curve/client.conf", "libcurve config path");
+DEFINE_string(fileName, "", "volume to test, must exist");
+DEFINE_string(user, "curve", "owner of the volume");
+DEFINE_string(password, "", "password of the owner, only for root");
+DEFINE_string(rw, "randwrite",
+              "io pattern: read, write, randread, randwrite, randrw");
+DEFINE_uint64(bs, 4096, "block size of each io");
+DEFINE_uint32(iodepth, 32, "number of inflight ios");
+DEFINE_uint32(runtimeSec, 60, "test duration in seconds");
+DEFINE_uint64(size, 0, "io range in bytes from offset 0, 0 means file size");
+DEFINE_uint32(rwmixread, 50, "percentage of reads for randrw");
+DEFINE_string(output, "", "json result file, print to stdout if empty");
+
+using curve::common::TimeUtility;
+
+namespace curve {
+namespace benchmark {
+
+struct IOStat {
+    uint64_t ios = 0;
+    uint64_t errors = 0;
+    std::vector<uint32_t> latencyUs;
+};
+
+class CurveBench;
+
+struct BenchIO {
+    CurveAioContext ctx;
+    CurveBench* bench;
+    uint64_t startUs;
+    std::unique_ptr<char[]> buf;
+};
+
+class CurveBench {
+ public:
+    int Run();
+
+    void OnIOComplete(BenchIO* io);
+
+ private:
+    int Submit(BenchIO* io);
+
+    void NextIO(CurveAioContext* ctx);
+
+    std::string Dump(uint64_t elapsedUs);
+
+    static void DumpStat(std::ostringstream* oss, const char* name,
+                         IOStat* stat, uint64_t elapsedUs);
+
+ private:
+    int fd_ = -1;
+    uint64_t range_ = 0;
+    uint64_t nextOffset_ = 0;
+    bool sequential_ = false;
+    uint32_t readPercent_ = 0;
+
+    std::atomic<bool> stop_{false};
+    uint32_t inflight_ = 0;
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    IOStat readStat_;
+    IOStat writeStat_;
+};
+
+static void BenchCallback(CurveAioContext* ctx) {
+    BenchIO* io = reinterpret_cast<BenchIO*>(ctx);
+    io->bench->OnIOComplete(io);
+}
+
+void CurveBench::NextIO(CurveAioContext* ctx) {
+    ctx->op = butil::fast_rand_less_than(100) < readPercent_
+                  ? LIBCURVE_OP_READ : LIBCURVE_OP_WRITE;
+    uint64_t blocks = range_ / FLAGS_bs;
+    if (sequential_) {
+        ctx->offset = nextOffset_;
+        nextOffset_ = (nextOffset_ + FLAGS_bs) % (blocks * FLAGS_bs);
+    } else {
+        ctx->offset = butil::fast_rand_less_than(blocks) * FLAGS_bs;
+    }
+    ctx->length = FLAGS_bs;
+}
+
+int CurveBench::Submit(BenchIO* io) {
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        NextIO(&io->ctx);
+    }
+    io->startUs = TimeUtility::GetTimeofDayUs();
+    return io->ctx.op == LIBCURVE_OP_READ ? AioRead(fd_, &io->ctx)
+                                          : AioWrite(fd_, &io->ctx);
+}
+
+void CurveBench::OnIOComplete(BenchIO* io) {
+    uint32_t latency = TimeUtility::GetTimeofDayUs() - io->startUs;
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        IOStat* stat =
+            io->ctx.op == LIBCURVE_OP_READ ? &readStat_ : &writeStat_;
+        ++stat->ios;
+        if (io->ctx.ret != static_cast<int>(io->ctx.length)) {
+            ++stat->errors;
+        }
+        stat->latencyUs.push_back(latency);
+    }
+
+    // 没有结束时在回调中继续下发，保持iodepth个inflight的io
+    if (!stop_.load() && Submit(io) == 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lk(mtx_);
+    --inflight_;
+    cv_.notify_all();
+}
+
+int CurveBench::Run() {
+    if (FLAGS_rw == "read" || FLAGS_rw == "randread") {
+        readPercent_ = 100;
+    } else if (FLAGS_rw == "write" || FLAGS_rw == "randwrite") {
+        readPercent_ = 0;
+    } else if (FLAGS_rw == "randrw") {
+        readPercent_ = FLAGS_rwmixread;
+    } else {
+        LOG(ERROR) << "unknown rw pattern " << FLAGS_rw;
+        return -1;
+    }
+    sequential_ = (FLAGS_rw == "read" || FLAGS_rw == "write");
+
+    if (Init(FLAGS_confPath.c_str()) != 0) {
+        LOG(ERROR) << "init libcurve failed, conf = " << FLAGS_confPath;
+        return -1;
+    }
+
+    C_UserInfo_t userInfo;
+    memset(&userInfo, 0, sizeof(userInfo));
+    snprintf(userInfo.owner, sizeof(userInfo.owner), "%s",
+             FLAGS_user.c_str());
+    snprintf(userInfo.password, sizeof(userInfo.password), "%s",
+             FLAGS_password.c_str());
+
+    FileStatInfo fileStat;
+    if (StatFile(FLAGS_fileName.c_str(), &userInfo, &fileStat) != 0) {
+        LOG(ERROR) << "stat file " << FLAGS_fileName << " failed";
+        UnInit();
+        return -1;
+    }
+    range_ = FLAGS_size == 0 ? fileStat.length
+                             : std::min(FLAGS_size, fileStat.length);
+    if (FLAGS_bs == 0 || range_ < FLAGS_bs) {
+        LOG(ERROR) << "invalid bs " << FLAGS_bs << ", io range " << range_;
+        UnInit();
+        return -1;
+    }
+
+    fd_ = Open(FLAGS_fileName.c_str(), &userInfo);
+    if (fd_ < 0) {
+        LOG(ERROR) << "open file " << FLAGS_fileName << " failed";
+        UnInit();
+        return -1;
+    }
+
+    std::vector<std::unique_ptr<BenchIO>> ios;
+    for (uint32_t i = 0; i < FLAGS_iodepth; ++i) {
+        std::unique_ptr<BenchIO> io(new BenchIO());
+        io->bench = this;
+        io->buf.reset(new char[FLAGS_bs]);
+        memset(io->buf.get(), 'a' + i % 26, FLAGS_bs);
+        io->ctx.buf = io->buf.get();
+        io->ctx.cb = BenchCallback;
+        ios.push_back(std::move(io));
+    }
+
+    uint64_t startUs = TimeUtility::GetTimeofDayUs();
+    for (auto& io : ios) {
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            ++inflight_;
+        }
+        if (Submit(io.get()) != 0) {
+            LOG(ERROR) << "submit io failed";
+            std::lock_guard<std::mutex> lk(mtx_);
+            --inflight_;
+        }
+    }
+
+    {
+        std::unique_lock<std::mutex> lk(mtx_);
+        cv_.wait_for(lk, std::chrono::seconds(FLAGS_runtimeSec),
+                     [this]() { return inflight_ == 0; });
+        stop_.store(true);
+        cv_.wait(lk, [this]() { return inflight_ == 0; });
+    }
+    uint64_t elapsedUs = TimeUtility::GetTimeofDayUs() - startUs;
+
+    Close(fd_);
+    UnInit();
+
+    std::string result = Dump(elapsedUs);
+    if (FLAGS_output.empty()) {
+        std::cout << result << std::endl;
+    } else {
+        std::ofstream out(FLAGS_output);
+        out << result << std::endl;
+        if (!out.good()) {
+            LOG(ERROR) << "write result to " << FLAGS_output << " failed";
+            return -1;
+        }
+    }
+    return 0;
+}
+
+void CurveBench::DumpStat(std::ostringstream* oss, const char* name,
+                          IOStat* stat, uint64_t elapsedUs) {
+    std::vector<uint32_t>& lat = stat->latencyUs;
+    std::sort(lat.begin(), lat.end());
+    auto percentile = [&lat](double p) -> uint32_t {
+        if (lat.empty()) {
+            return 0;
+        }
+        size_t idx = static_cast<size_t>(p * (lat.size() - 1));
+        return lat[idx];
+    };
+    uint64_t sum = 0;
+    for (auto l : lat) {
+        sum += l;
+    }
+    double seconds = elapsedUs / 1000000.0;
+
+    *oss << "\"" << name << "\": {"
+         << "\"ios\": " << stat->ios
+         << ", \"errors\": " << stat->errors
+         << ", \"iops\": " << (seconds > 0 ? stat->ios / seconds : 0)
+         << ", \"bw_bytes\": "
+         << (seconds > 0 ? stat->ios * FLAGS_bs / seconds : 0)
+         << ", \"lat_us\": {"
+         << "\"avg\": " << (lat.empty() ? 0 : sum / lat.size())
+         << ", \"p50\": " << percentile(0.5)
+         << ", \"p90\": " << percentile(0.9)
+         << ", \"p99\": " << percentile(0.99)
+         << ", \"p999\": " << percentile(0.999)
+         << ", \"max\": " << (lat.empty() ? 0 : lat.back())
+         << "}}";
+}
+
+std::string CurveBench::Dump(uint64_t elapsedUs) {
+    std::ostringstream oss;
+    oss << "{\"file\": \"" << FLAGS_fileName << "\""
+        << ", \"rw\": \"" << FLAGS_rw << "\""
+        << ", \"bs\": " << FLAGS_bs
+        << ", \"iodepth\": " << FLAGS_iodepth
+        << ", \"runtime_us\": " << elapsedUs << ", ";
+    DumpStat(&oss, "read", &readStat_, elapsedUs);
+    oss << ", ";
+    DumpStat(&oss, "write", &writeStat_, elapsedUs);
+    oss << "}";
+    return oss.str();
+}
+
+}  // namespace benchmark
+}  // namespace curve
+
+int main(int argc, char* argv[]) {
+    google::ParseCommandLineFlags(&argc, &argv, true);
+    google::InitGoogleLogging(argv[0]);
+
+    if (FLAGS_fileName.empty()) {
+        LOG(ERROR) << "fileName must be specified";
+        return -1;
+    }
+
+    curve::benchmark::CurveBench bench;
+    return bench.Run() == 0 ? 0 : -1;
+}
@@ -0,0 +1,134 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include <benchmark/benchmark.h>
+#include <glog/logging.h>
+
+#include <memory>
+#include <string>
+
+#include "src/mds/nameserver2/allocstatistic/alloc_statistic.h"
+#include "src/mds/nameserver2/chunk_allocator.h"
+#include "src/mds/nameserver2/curvefs.h"
+#include "src/mds/nameserver2/file_record.h"
+#include "test/mds/nameserver2/fakes.h"
+
+namespace curve {
+namespace mds {
+
+const uint64_t kGB = 1024 * 1024 * 1024ul;
+const char kFileName[] = "/benchmark_file";
+
+/**
+ * CurveFS使用内存中的FakeNameServerStorage代替etcd，
+ * chunk分配使用FackTopologyChunkAllocator，只测量mds本身的开销
+ */
+class CurveFSFixture : public benchmark::Fixture {
+ public:
+    void SetUp(const benchmark::State& state) override {
+        auto storage = std::make_shared<FakeNameServerStorage>();
+        auto inodeIdGenerator = std::make_shared<FakeInodeIDGenerator>(0);
+        auto chunkSegAllocator = std::make_shared<ChunkSegmentAllocatorImpl>(
+            std::make_shared<FackTopologyChunkAllocator>(),
+            std::make_shared<FackChunkIDGenerator>());
+        auto allocStatistic =
+            std::make_shared<AllocStatistic>(1000, 1000, nullptr);
+
+        CurveFSOption options;
+        options.defaultChunkSize = 16 * 1024 * 1024;
+        options.authOptions.rootOwner = "root";
+        options.authOptions.rootPassword = "root_password";
+        options.fileRecordOptions.fileRecordExpiredTimeUs = 5 * 1000 * 1000;
+        options.fileRecordOptions.scanIntervalTimeUs = 1000 * 1000;
+
+        curvefs_ = &kCurveFS;
+        CHECK(curvefs_->Init(storage, inodeIdGenerator, chunkSegAllocator,
+                             nullptr, std::make_shared<FileRecordManager>(),
+                             allocStatistic, options, nullptr));
+        CHECK(StatusCode::kOK == curvefs_->CreateFile(
+            kFileName, "root", FileType::INODE_PAGEFILE, fileLength_));
+    }
+
+    void TearDown(const benchmark::State& state) override {
+        curvefs_->Uninit();
+    }
+
+ protected:
+    CurveFS* curvefs_;
+    uint64_t fileLength_ = 1024 * kGB;
+};
+
+// 每次都分配新的segment，文件的segment分配完之后创建新的文件
+BENCHMARK_DEFINE_F(CurveFSFixture, AllocateSegment)(benchmark::State& state) {
+    std::string fileName = kFileName;
+    uint32_t fileNum = 0;
+    offset_t offset = 0;
+    PageFileSegment segment;
+    for (auto _ : state) {
+        StatusCode ret = curvefs_->GetOrAllocateSegment(
+            fileName, offset, true, &segment);
+        if (ret != StatusCode::kOK) {
+            state.SkipWithError("allocate segment failed");
+            break;
+        }
+        offset += kGB;
+        if (offset >= fileLength_) {
+            state.PauseTiming();
+            fileName = std::string(kFileName) + std::to_string(++fileNum);
+            CHECK(StatusCode::kOK == curvefs_->CreateFile(
+                fileName, "root", FileType::INODE_PAGEFILE, fileLength_));
+            offset = 0;
+            state.ResumeTiming();
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// segment已经分配，只查询
+BENCHMARK_DEFINE_F(CurveFSFixture, GetSegment)(benchmark::State& state) {
+    PageFileSegment segment;
+    for (offset_t offset = 0; offset < fileLength_; offset += kGB) {
+        CHECK(StatusCode::kOK == curvefs_->GetOrAllocateSegment(
+            kFileName, offset, true, &segment));
+    }
+
+    offset_t offset = 0;
+    for (auto _ : state) {
+        StatusCode ret = curvefs_->GetOrAllocateSegment(
+            kFileName, offset, false, &segment);
+        if (ret != StatusCode::kOK) {
+            state.SkipWithError("get segment failed");
+            break;
+        }
+        offset = (offset + kGB) % fileLength_;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_REGISTER_F(CurveFSFixture, AllocateSegment)->UseRealTime();
+BENCHMARK_REGISTER_F(CurveFSFixture, GetSegment)->UseRealTime();
+
+}  // namespace mds
+}  // namespace curve
+
+BENCHMARK_MAIN();
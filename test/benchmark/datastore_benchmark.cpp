@@ -0,0 +1,172 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include <benchmark/benchmark.h>
+#include <glog/logging.h>
+
+#include <memory>
+#include <string>
+
+#include "src/chunkserver/datastore/chunkfile_pool.h"
+#include "src/chunkserver/datastore/chunkserver_datastore.h"
+#include "src/fs/local_filesystem.h"
+
+using curve::fs::FileSystemType;
+using curve::fs::LocalFileSystem;
+using curve::fs::LocalFsFactory;
+
+namespace curve {
+namespace chunkserver {
+
+const char kBaseDir[] = "./datastore_benchmark";
+const ChunkSizeType kChunkSize = 16 * 1024 * 1024;
+const PageSizeType kPageSize = 4096;
+
+/**
+ * 在本地文件系统上创建CSDataStore，chunk不从chunkfilepool中获取，
+ * 由datastore直接创建，测试结束后删除所有文件
+ */
+class DataStoreFixture : public benchmark::Fixture {
+ public:
+    void SetUp(const benchmark::State& state) override {
+        lfs_ = LocalFsFactory::CreateFs(FileSystemType::EXT4, "");
+        lfs_->Delete(kBaseDir);
+
+        ChunkfilePoolOptions poolOptions;
+        poolOptions.getChunkFromPool = false;
+        poolOptions.chunkSize = kChunkSize;
+        poolOptions.metaPageSize = kPageSize;
+        poolOptions.retryTimes = 3;
+        poolOptions.lowWaterMark = 0;
+        poolOptions.cleanRecycledChunk = false;
+        filePool_ = std::make_shared<ChunkfilePool>(lfs_);
+        CHECK(filePool_->Initialize(poolOptions));
+
+        DataStoreOptions options;
+        options.baseDir = kBaseDir;
+        options.chunkSize = kChunkSize;
+        options.pageSize = kPageSize;
+        options.locationLimit = 3000;
+        dataStore_ = std::make_shared<CSDataStore>(lfs_, filePool_, options);
+        CHECK(dataStore_->Initialize());
+
+        buf_ = std::string(state.range(0), 'a');
+    }
+
+    void TearDown(const benchmark::State& state) override {
+        dataStore_ = nullptr;
+        filePool_->UnInitialize();
+        lfs_->Delete(kBaseDir);
+    }
+
+ protected:
+    // 顺序写满一个chunk，作为读和cow的初始数据
+    void FillChunk(ChunkID id, SequenceNum sn) {
+        uint32_t cost;
+        for (off_t off = 0; off < kChunkSize; off += buf_.size()) {
+            CHECK(CSErrorCode::Success == dataStore_->WriteChunk(
+                id, sn, buf_.data(), off, buf_.size(), &cost));
+        }
+    }
+
+ protected:
+    std::shared_ptr<LocalFileSystem> lfs_;
+    std::shared_ptr<ChunkfilePool> filePool_;
+    std::shared_ptr<CSDataStore> dataStore_;
+    std::string buf_;
+};
+
+// 在一个chunk内顺序覆盖写
+BENCHMARK_DEFINE_F(DataStoreFixture, Write)(benchmark::State& state) {
+    size_t length = buf_.size();
+    off_t offset = 0;
+    uint32_t cost;
+    for (auto _ : state) {
+        CSErrorCode ret = dataStore_->WriteChunk(
+            1, 1, buf_.data(), offset, length, &cost);
+        if (ret != CSErrorCode::Success) {
+            state.SkipWithError("write chunk failed");
+            break;
+        }
+        offset = (offset + length) % kChunkSize;
+    }
+    state.SetBytesProcessed(state.iterations() * length);
+}
+
+// 在一个写满的chunk内顺序读
+BENCHMARK_DEFINE_F(DataStoreFixture, Read)(benchmark::State& state) {
+    FillChunk(1, 1);
+    size_t length = buf_.size();
+    std::unique_ptr<char[]> readBuf(new char[length]);
+    off_t offset = 0;
+    for (auto _ : state) {
+        CSErrorCode ret = dataStore_->ReadChunk(
+            1, 1, readBuf.get(), offset, length);
+        if (ret != CSErrorCode::Success) {
+            state.SkipWithError("read chunk failed");
+            break;
+        }
+        offset = (offset + length) % kChunkSize;
+    }
+    state.SetBytesProcessed(state.iterations() * length);
+}
+
+// 打快照之后的首次写，每次写都需要将原数据拷贝到快照文件中，
+// chunk的所有page都拷贝过之后删除快照并递增版本号
+BENCHMARK_DEFINE_F(DataStoreFixture, CopyOnWrite)(benchmark::State& state) {
+    FillChunk(1, 1);
+    size_t length = buf_.size();
+    SequenceNum sn = 2;
+    off_t offset = 0;
+    uint32_t cost;
+    for (auto _ : state) {
+        CSErrorCode ret = dataStore_->WriteChunk(
+            1, sn, buf_.data(), offset, length, &cost);
+        if (ret != CSErrorCode::Success) {
+            state.SkipWithError("write chunk failed");
+            break;
+        }
+        offset += length;
+        if (offset >= kChunkSize) {
+            state.PauseTiming();
+            CHECK(CSErrorCode::Success ==
+                dataStore_->DeleteSnapshotChunkOrCorrectSn(1, sn));
+            ++sn;
+            offset = 0;
+            state.ResumeTiming();
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * length);
+}
+
+BENCHMARK_REGISTER_F(DataStoreFixture, Write)
+    ->Arg(4 * 1024)->Arg(64 * 1024)->UseRealTime();
+BENCHMARK_REGISTER_F(DataStoreFixture, Read)
+    ->Arg(4 * 1024)->Arg(64 * 1024)->UseRealTime();
+BENCHMARK_REGISTER_F(DataStoreFixture, CopyOnWrite)
+    ->Arg(4 * 1024)->Arg(64 * 1024)->UseRealTime();
+
+}  // namespace chunkserver
+}  // namespace curve
+
+BENCHMARK_MAIN();
@@ -0,0 +1,62 @@
+#!/bin/bash
+#
+#  Copyright (c) 2020 NetEase Inc.
+#
+#  Licensed under the Apache License, Version 2.0 (the "License");
+#  you may not use this file except in compliance with the License.
+#  You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+#  Unless required by applicable law or agreed to in writing, software
+#  distributed under the License is distributed on an "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#  See the License for the specific language governing permissions and
+#  limitations under the License.
+#
+
+# 编译并运行test/benchmark下的性能测试，结果以json格式保存在输出目录中，
+# 可以用google benchmark自带的tools/compare.py比较两次运行的结果
+#
+# 用法: run_benchmarks.sh [输出目录]
+# 设置了CURVE_BENCH_CONF和CURVE_BENCH_FILE时，还会使用curve_bench对
+# 已部署好的集群(例如deploy/local下的单机集群)中的卷做端到端的读写测试
+
+set -e
+
+cd "$(dirname "$0")/../.."
+OUTPUT=${1:-benchmark_result/$(date +%Y%m%d%H%M%S)}
+mkdir -p ${OUTPUT}
+
+BENCHMARKS="datastore_benchmark concurrent_apply_benchmark client_benchmark curvefs_benchmark"
+
+bazel build -c opt --copt -DHAVE_ZLIB=1 --define=with_glog=true \
+    --define=libunwind=true --copt -DGFLAGS_NS=google \
+    --copt -Wno-error=format-security --copt -DUSE_BTHREAD_MUTEX \
+    //test/benchmark/...
+
+for bench in ${BENCHMARKS}; do
+    echo "running ${bench}"
+    bazel-bin/test/benchmark/${bench} \
+        --benchmark_repetitions=${REPETITIONS:-3} \
+        --benchmark_report_aggregates_only=true \
+        --benchmark_format=json \
+        --benchmark_out=${OUTPUT}/${bench}.json
+done
+
+if [ -n "${CURVE_BENCH_CONF}" ] && [ -n "${CURVE_BENCH_FILE}" ]; then
+    for rw in randwrite randread write read; do
+        for bs in 4096 131072; do
+            echo "running curve_bench rw=${rw} bs=${bs}"
+            bazel-bin/test/benchmark/curve_bench \
+                --confPath=${CURVE_BENCH_CONF} \
+                --fileName=${CURVE_BENCH_FILE} \
+                --user=${CURVE_BENCH_USER:-curve} \
+                --rw=${rw} --bs=${bs} --iodepth=${IODEPTH:-32} \
+                --runtimeSec=${RUNTIME:-60} \
+                --output=${OUTPUT}/curve_bench_${rw}_${bs}.json
+        done
+    done
+fi
+
+echo "results are saved in ${OUTPUT}"
@@ -665,6 +665,89 @@ TEST_F(OpRequestTest, ReadChunkTest) {
         closure->Run();
         ASSERT_TRUE(closure->isDone_);
     }
+    /**
+     * 测试Process
+     * 用例： node_->IsLeaderTerm() == true, 请求没有携带apply index,
+     *       leader的租约有效
+     * 预期： 不会走一致性协议，请求提交给concurrentApplyModule_处理
+     */
+    {
+        // 重置closure
+        closure->Reset();
+
+        request->clear_appliedindex();
+
+        // 设置预期
+        EXPECT_CALL(*node_, IsLeaderTerm())
+            .WillRepeatedly(Return(true));
+        EXPECT_CALL(*node_, IsLeaseValid())
+            .WillOnce(Return(true));
+        EXPECT_CALL(*node_, Propose(_))
+            .Times(0);
+
+        opReq->Process();
+
+        // 验证结果
+        ASSERT_FALSE(closure->isDone_);
+        ASSERT_FALSE(closure->response_->has_status());
+
+        closure->Run();
+        ASSERT_TRUE(closure->isDone_);
+    }
+    /**
+     * 测试Process
+     * 用例： node_->IsLeaderTerm() == false, 开启了follower read,
+     *       请求的 apply index 小于等于 node的 apply index
+     * 预期： follower处理读请求，请求提交给concurrentApplyModule_处理
+     */
+    {
+        // 重置closure
+        closure->Reset();
+
+        request->set_appliedindex(3);
+
+        // 设置预期
+        EXPECT_CALL(*node_, IsLeaderTerm())
+            .WillRepeatedly(Return(false));
+        EXPECT_CALL(*node_, IsFollowerReadEnabled())
+            .WillRepeatedly(Return(true));
+        EXPECT_CALL(*node_, Propose(_))
+            .Times(0);
+
+        opReq->Process();
+
+        // 验证结果
+        ASSERT_FALSE(closure->isDone_);
+        ASSERT_FALSE(closure->response_->has_status());
+
+        closure->Run();
+        ASSERT_TRUE(closure->isDone_);
+    }
+    /**
+     * 测试Process
+     * 用例： node_->IsLeaderTerm() == false, 开启了follower read,
+     *       请求的 apply index 大于 node的 apply index
+     * 预期： 返回CHUNK_OP_STATUS_REDIRECTED，由client重试到leader
+     */
+    {
+        // 重置closure
+        closure->Reset();
+
+        request->set_appliedindex(LAST_INDEX + 1);
+
+        opReq->Process();
+
+        // 验证结果
+        ASSERT_TRUE(closure->isDone_);
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_REDIRECTED,
+                  closure->response_->status());
+
+        request->set_appliedindex(3);
+        EXPECT_CALL(*node_, IsLeaderTerm())
+            .WillRepeatedly(Return(true));
+        EXPECT_CALL(*node_, IsFollowerReadEnabled())
+            .WillRepeatedly(Return(false));
+    }
     CSChunkInfo info;
     info.isClone = true;
     info.pageSize = PAGE_SIZE;
@@ -320,6 +320,23 @@ TEST_F(CopysetNodeManagerTest, ReloadTest) {
     copysetNodeManager->GetAllCopysetNodes(&copysetNodes);
     ASSERT_EQ(0, copysetNodes.size());
 
+    // reload copysets when loadDiskConcurrency < loadConcurrency
+    std::cout << "Test ReloadCopysets when loadDiskConcurrency=1"
+              << std::endl;
+    defaultOptions_.loadConcurrency = 5;
+    defaultOptions_.loadDiskConcurrency = 1;
+    ASSERT_EQ(0, copysetNodeManager->Init(defaultOptions_));
+    ASSERT_EQ(0, copysetNodeManager->Run());
+    ASSERT_TRUE(copysetNodeManager->LoadFinished());
+    copysetNodes.clear();
+    copysetNodeManager->GetAllCopysetNodes(&copysetNodes);
+    ASSERT_EQ(5, copysetNodes.size());
+    ASSERT_EQ(0, copysetNodeManager->Fini());
+    copysetNodes.clear();
+    copysetNodeManager->GetAllCopysetNodes(&copysetNodes);
+    ASSERT_EQ(0, copysetNodes.size());
+    defaultOptions_.loadDiskConcurrency = 0;
+
     // reload copysets when loadConcurrency == 0
     std::cout << "Test ReloadCopysets when loadConcurrency=0" << std::endl;
     defaultOptions_.loadConcurrency = 0;
@@ -27,6 +27,8 @@
 #include <gmock/gmock-generated-function-mockers.h>
 
 #include <memory>
+#include <mutex>
+#include <thread>   //NOLINT
 #include <cstdio>
 #include <vector>
 #include <string>
@@ -1008,5 +1010,155 @@ TEST_F(CopysetNodeTest, get_leader_status) {
     }
 }
 
+TEST_F(CopysetNodeTest, raft_batch_hold_back) {
+    LogicPoolID logicPoolID = 1;
+    CopysetID copysetID = 1;
+    Configuration conf;
+    conf.add_peer(PeerId("127.0.0.1:3200:0"));
+
+    defaultOptions_.enableRaftBatch = true;
+    defaultOptions_.raftBatchMaxInflight = 1;
+    CopysetNode copysetNode(logicPoolID, copysetID, conf);
+    ASSERT_EQ(0, copysetNode.Init(defaultOptions_));
+    std::shared_ptr<MockNode> mockNode
+        = std::make_shared<MockNode>(logicPoolID, copysetID);
+    copysetNode.SetCopysetNode(mockNode);
+    copysetNode.on_leader_start(8);
+
+    std::mutex mtx;
+    std::vector<braft::Closure *> dones;
+    std::vector<butil::IOBuf> logs;
+    EXPECT_CALL(*mockNode, apply(_))
+        .WillRepeatedly(Invoke([&](const braft::Task &task) {
+            std::lock_guard<std::mutex> lk(mtx);
+            dones.push_back(task.done);
+            logs.push_back(*task.data);
+        }));
+    auto applyCount = [&]() {
+        std::lock_guard<std::mutex> lk(mtx);
+        return dones.size();
+    };
+
+    const int opNum = 3;
+    std::vector<ChunkRequest> requests(opNum);
+    butil::IOBuf data;
+    data.append(std::string(4096, 'a'));
+    for (int i = 0; i < opNum; ++i) {
+        requests[i].set_optype(CHUNK_OP_TYPE::CHUNK_OP_WRITE);
+        requests[i].set_logicpoolid(logicPoolID);
+        requests[i].set_copysetid(copysetID);
+        requests[i].set_chunkid(i + 1);
+        requests[i].set_offset(0);
+        requests[i].set_size(4096);
+    }
+
+    // 1. 没有inflight的log entry时直接propose
+    ASSERT_EQ(0, copysetNode.ProposeBatch(
+        std::make_shared<WriteChunkRequest>(), &requests[0], data));
+    for (int i = 0; i < 100 && applyCount() < 1; ++i) {
+        ::usleep(10 * 1000);
+    }
+    ASSERT_EQ(1, applyCount());
+
+    // 2. inflight达到上限，之后的请求暂缓propose
+    ASSERT_EQ(0, copysetNode.ProposeBatch(
+        std::make_shared<WriteChunkRequest>(), &requests[1], data));
+    ASSERT_EQ(0, copysetNode.ProposeBatch(
+        std::make_shared<WriteChunkRequest>(), &requests[2], data));
+    ::usleep(200 * 1000);
+    ASSERT_EQ(1, applyCount());
+
+    // 3. 之前的log entry commit之后，暂缓的请求合并成一条log entry propose
+    dones[0]->Run();
+    for (int i = 0; i < 100 && applyCount() < 2; ++i) {
+        ::usleep(10 * 1000);
+    }
+    ASSERT_EQ(2, applyCount());
+    ASSERT_FALSE(ChunkOpRequest::IsBatchLog(logs[0]));
+    ASSERT_TRUE(ChunkOpRequest::IsBatchLog(logs[1]));
+    std::vector<butil::IOBuf> opLogs;
+    ASSERT_EQ(0, ChunkOpRequest::DecodeBatch(logs[1], &opLogs));
+    ASSERT_EQ(2, opLogs.size());
+    dones[1]->Run();
+}
+
+TEST_F(CopysetNodeTest, lease_read) {
+    LogicPoolID logicPoolID = 1;
+    CopysetID copysetID = 1;
+    Configuration conf;
+    conf.add_peer(PeerId("127.0.0.1:3200:0"));
+
+    // 租约长度为electionTimeoutMs的4/5，即800ms
+    const int64_t leaseUs = defaultOptions_.electionTimeoutMs * 800;
+
+    // 未开启租约读时租约始终无效
+    {
+        CopysetNode copysetNode(logicPoolID, copysetID, conf);
+        ASSERT_EQ(0, copysetNode.Init(defaultOptions_));
+        copysetNode.on_leader_start(8);
+        copysetNode.RenewLease(butil::monotonic_time_us());
+        ASSERT_FALSE(copysetNode.IsLeaseValid());
+    }
+
+    defaultOptions_.enableLeaseRead = true;
+    CopysetNode copysetNode(logicPoolID, copysetID, conf);
+    ASSERT_EQ(0, copysetNode.Init(defaultOptions_));
+
+    // 不是leader时不续约
+    copysetNode.RenewLease(butil::monotonic_time_us());
+    ASSERT_FALSE(copysetNode.IsLeaseValid());
+
+    // 成为leader之后，apply本任期的日志之前没有租约
+    copysetNode.on_leader_start(8);
+    ASSERT_FALSE(copysetNode.IsLeaseValid());
+    copysetNode.RenewLease(0);
+    ASSERT_FALSE(copysetNode.IsLeaseValid());
+
+    // 租约从日志的propose时间开始计算，0.8个选举超时之后过期
+    int64_t nowUs = butil::monotonic_time_us();
+    copysetNode.RenewLease(nowUs - leaseUs - 10 * 1000);
+    ASSERT_FALSE(copysetNode.IsLeaseValid());
+    copysetNode.RenewLease(nowUs - leaseUs + 200 * 1000);
+    ASSERT_TRUE(copysetNode.IsLeaseValid());
+    ::usleep(300 * 1000);
+    ASSERT_FALSE(copysetNode.IsLeaseValid());
+
+    // 较早propose的日志后apply时租约不会回退
+    nowUs = butil::monotonic_time_us();
+    copysetNode.RenewLease(nowUs);
+    copysetNode.RenewLease(nowUs - leaseUs - 10 * 1000);
+    ASSERT_TRUE(copysetNode.IsLeaseValid());
+
+    // 卸任leader时租约失效，再次成为leader时需要重新续约
+    copysetNode.on_leader_stop(butil::Status::OK());
+    ASSERT_FALSE(copysetNode.IsLeaseValid());
+    copysetNode.RenewLease(butil::monotonic_time_us());
+    ASSERT_FALSE(copysetNode.IsLeaseValid());
+    copysetNode.on_leader_start(9);
+    ASSERT_FALSE(copysetNode.IsLeaseValid());
+
+    // 多个线程并发续约，租约取其中最晚的propose时间
+    nowUs = butil::monotonic_time_us();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&copysetNode, nowUs, leaseUs, i]() {
+            for (int j = 0; j < 1000; ++j) {
+                int64_t proposeTimeUs = nowUs - leaseUs - 10 * 1000 - j;
+                if (i == 0 && j == 500) {
+                    proposeTimeUs = nowUs;
+                }
+                copysetNode.RenewLease(proposeTimeUs);
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    ASSERT_TRUE(copysetNode.IsLeaseValid());
+
+    copysetNode.on_leader_stop(butil::Status::OK());
+    ASSERT_FALSE(copysetNode.IsLeaseValid());
+}
+
 }  // namespace chunkserver
 }  // namespace curve
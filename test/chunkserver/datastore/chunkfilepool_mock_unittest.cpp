@@ -561,6 +561,51 @@ TEST_F(CSChunkfilePoolMockTest, InitializeTest) {
         ASSERT_EQ(true, pool.Initialize(options));
         ASSERT_EQ(1, pool.Size());
     }
+    // 格式化工具残留的临时文件被删除，不计入chunk
+    {
+        ChunkfilePool pool(lfs_);
+        FakeMetaFile();
+        EXPECT_CALL(*lfs_, DirExists(_))
+            .WillOnce(Return(true));
+        std::vector<std::string> fileNames;
+        fileNames.push_back("1");
+        fileNames.push_back("2.tmp");
+        EXPECT_CALL(*lfs_, List(_, _))
+            .WillOnce(DoAll(SetArgPointee<1>(fileNames),
+                            Return(0)));
+        EXPECT_CALL(*lfs_, Delete(poolDir + "/2.tmp"))
+            .WillOnce(Return(0));
+        EXPECT_CALL(*lfs_, FileExists(filePath1))
+            .WillOnce(Return(true));
+        EXPECT_CALL(*lfs_, Open(filePath1, _))
+            .WillOnce(Return(2));
+
+        struct stat fileInfo;
+        fileInfo.st_size = CHUNK_SIZE + PAGE_SIZE;
+        EXPECT_CALL(*lfs_, Fstat(2, NotNull()))
+            .WillOnce(DoAll(SetArgPointee<1>(fileInfo),
+                            Return(0)));
+        EXPECT_CALL(*lfs_, Close(2))
+            .Times(1);
+        ASSERT_EQ(true, pool.Initialize(options));
+        ASSERT_EQ(1, pool.Size());
+        ASSERT_EQ(1, pool.GetState().preallocatedChunksLeft);
+    }
+    // 删除临时文件失败
+    {
+        ChunkfilePool pool(lfs_);
+        FakeMetaFile();
+        EXPECT_CALL(*lfs_, DirExists(_))
+            .WillOnce(Return(true));
+        std::vector<std::string> fileNames;
+        fileNames.push_back("2.tmp");
+        EXPECT_CALL(*lfs_, List(_, _))
+            .WillOnce(DoAll(SetArgPointee<1>(fileNames),
+                            Return(0)));
+        EXPECT_CALL(*lfs_, Delete(poolDir + "/2.tmp"))
+            .WillOnce(Return(-1));
+        ASSERT_EQ(false, pool.Initialize(options));
+    }
 
     /****************getChunkFromPool为false**************/
     options.getChunkFromPool = false;
@@ -606,11 +651,52 @@ TEST_F(CSChunkfilePoolMockTest, GetChunkTest) {
     char metapage[PAGE_SIZE] = {0};
 
     /****************getChunkFromPool为true**************/
-    // 没有剩余chunk的情况
+    // 没有剩余chunk的情况，未开启后台补充时直接失败，不计入allocateDebt
     {
         ChunkfilePool pool(lfs_);
         FakePool(&pool, options, 0);
         ASSERT_EQ(-1, pool.GetChunk(targetPath, metapage));
+        ASSERT_EQ(0, pool.GetState().allocateDebt);
+    }
+    // 开启了后台补充，没有剩余chunk时直接分配，分配失败不计入allocateDebt
+    {
+        ChunkfilePoolOptions refillOptions = options;
+        refillOptions.lowWaterMark = 1;
+        ChunkfilePool pool(lfs_);
+        FakePool(&pool, refillOptions, 0);
+        EXPECT_CALL(*lfs_, Open(_, _))
+            .Times(retryTimes)
+            .WillRepeatedly(Return(-1));
+        ASSERT_EQ(-1, pool.GetChunk(targetPath, metapage));
+        ASSERT_EQ(0, pool.GetState().allocateDebt);
+        pool.UnInitialize();
+    }
+    // 开启了后台补充，直接分配成功时计入allocateDebt
+    {
+        ChunkfilePoolOptions refillOptions = options;
+        refillOptions.lowWaterMark = 1;
+        ChunkfilePool pool(lfs_);
+        FakePool(&pool, refillOptions, 0);
+        EXPECT_CALL(*lfs_, Open(_, _))
+            .Times(2)
+            .WillRepeatedly(Return(1));
+        EXPECT_CALL(*lfs_, Fallocate(1, 0, 0, fileSize))
+            .WillOnce(Return(0));
+        EXPECT_CALL(*lfs_, Write(1, NotNull(), 0, fileSize))
+            .WillOnce(Return(fileSize));
+        EXPECT_CALL(*lfs_, Write(1, metapage, 0, PAGE_SIZE))
+            .WillOnce(Return(PAGE_SIZE));
+        EXPECT_CALL(*lfs_, Fsync(1))
+            .Times(2)
+            .WillRepeatedly(Return(0));
+        EXPECT_CALL(*lfs_, Close(1))
+            .Times(2)
+            .WillRepeatedly(Return(0));
+        EXPECT_CALL(*lfs_, Rename(_, targetPath, _))
+            .WillOnce(Return(0));
+        ASSERT_EQ(0, pool.GetChunk(targetPath, metapage));
+        ASSERT_EQ(1, pool.GetState().allocateDebt);
+        pool.UnInitialize();
     }
     // 存在chunk，open时失败
     {
@@ -25,8 +25,11 @@
 #include <gmock/gmock.h>
 #include <json/json.h>
 #include <fcntl.h>
+#include <chrono>  // NOLINT
 #include <climits>
 #include <memory>
+#include <thread>  // NOLINT
+#include <vector>
 
 #include "src/common/crc32.h"
 #include "src/common/curve_define.h"
@@ -261,6 +264,66 @@ TEST_F(CSChunkfilePool_test, RecycleChunkTest) {
     ASSERT_EQ(0, fsptr->Delete("./cspooltest/chunkfilepool/4"));
 }
 
+TEST_F(CSChunkfilePool_test, RefillAndCleanTest) {
+    std::string chunkfilepool = "./cspooltest/chunkfilepool.meta";
+    ChunkfilePoolOptions cfop;
+    cfop.chunkSize = 4096;
+    cfop.metaPageSize = 4096;
+    cfop.lowWaterMark = 52;
+    cfop.refillRatePerSec = 10;
+    cfop.cleanRecycledChunk = true;
+    memcpy(cfop.metaPath, chunkfilepool.c_str(), chunkfilepool.size());
+
+    ASSERT_TRUE(ChunkfilepoolPtr_->Initialize(cfop));
+    ASSERT_EQ(50, ChunkfilepoolPtr_->Size());
+    char metapage[4096];
+    memset(metapage, '1', 4096);
+    ASSERT_EQ(0, ChunkfilepoolPtr_->GetChunk("./new1", metapage));
+    ASSERT_EQ(49, ChunkfilepoolPtr_->Size());
+
+    // 回收的chunk先进入待清零队列
+    ASSERT_EQ(0, ChunkfilepoolPtr_->RecycleChunk("./new1"));
+    ASSERT_EQ(49, ChunkfilepoolPtr_->Size());
+    ChunkFilePoolState_t currentStat = ChunkfilepoolPtr_->GetState();
+    ASSERT_EQ(50, currentStat.preallocatedChunksLeft);
+
+    // 后台线程补充到低水位，并清零回收的chunk
+    for (int i = 0; i < 50; ++i) {
+        currentStat = ChunkfilepoolPtr_->GetState();
+        if (currentStat.refilledChunks == 2 &&
+            currentStat.cleanedChunks == 1) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    ASSERT_EQ(2, currentStat.refilledChunks);
+    ASSERT_EQ(1, currentStat.cleanedChunks);
+    ASSERT_EQ(0, currentStat.allocateDebt);
+    ASSERT_EQ(52, currentStat.preallocatedChunksLeft);
+    ASSERT_EQ(52, ChunkfilepoolPtr_->Size());
+    ChunkfilepoolPtr_->UnInitialize();
+
+    // 回收的chunk被重新写零，加上补充的两个chunk，共有三个全零的chunk
+    std::vector<std::string> files;
+    ASSERT_EQ(0, fsptr->List("./cspooltest/chunkfilepool", &files));
+    ASSERT_EQ(52, files.size());
+    char zero[8192];
+    char data[8192];
+    memset(zero, 0, sizeof(zero));
+    int zeroCount = 0;
+    for (auto& file : files) {
+        std::string path = "./cspooltest/chunkfilepool/" + file;
+        int fd = fsptr->Open(path.c_str(), O_RDONLY);
+        ASSERT_GE(fd, 0);
+        ASSERT_EQ(8192, fsptr->Read(fd, data, 0, 8192));
+        fsptr->Close(fd);
+        if (memcmp(zero, data, 8192) == 0) {
+            ++zeroCount;
+        }
+    }
+    ASSERT_EQ(3, zeroCount);
+}
+
 TEST(CSChunkfilePool, GetChunkDirectlyTest) {
     std::shared_ptr<ChunkfilePool>  ChunkfilepoolPtr_;
     std::shared_ptr<LocalFileSystem>  fsptr;
@@ -375,6 +375,68 @@ TEST_F(CSDataStore_test, InitializeTest5) {
         .Times(1);
 }
 
+/**
+ * InitializeTest
+ * case:限制了同时打开的chunk文件数
+ * 预期结果:初始化时不打开chunk文件，第一次访问时才打开chunk及其快照文件，
+ *         超过上限时关闭最久未访问的chunk文件
+ */
+TEST_F(CSDataStore_test, InitializeTest6_LazyOpen) {
+    DataStoreOptions options;
+    options.baseDir = baseDir;
+    options.chunkSize = CHUNK_SIZE;
+    options.pageSize = PAGE_SIZE;
+    options.locationLimit = kLocationLimit;
+    options.maxOpenChunkFiles = 1;
+    dataStore = std::make_shared<CSDataStore>(lfs_, fpool_, options);
+    FakeEnv();
+    // 初始化时不打开任何文件
+    EXPECT_CALL(*lfs_, Open(chunk1Path, _))
+        .Times(0);
+    EXPECT_CALL(*lfs_, Open(chunk1snap1Path, _))
+        .Times(0);
+    EXPECT_CALL(*lfs_, Open(chunk2Path, _))
+        .Times(0);
+    EXPECT_TRUE(dataStore->Initialize());
+
+    DataStoreStatus status = dataStore->GetStatus();
+    ASSERT_EQ(2, status.chunkFileCount);
+    ASSERT_EQ(1, status.snapshotCount);
+    // 没有打开过的chunk不统计为clone chunk
+    ASSERT_EQ(0, status.cloneChunkCount);
+
+    // 第一次访问chunk1时打开chunk1及其快照文件
+    EXPECT_CALL(*lfs_, Open(chunk1Path, _))
+        .WillOnce(Return(1));
+    EXPECT_CALL(*lfs_, Open(chunk1snap1Path, _))
+        .WillOnce(Return(2));
+    char buf[PAGE_SIZE] = {0};
+    ASSERT_EQ(CSErrorCode::Success,
+              dataStore->ReadChunk(1, 2, buf, 0, PAGE_SIZE));
+    CSChunkInfo info;
+    ASSERT_EQ(CSErrorCode::Success, dataStore->GetChunkInfo(1, &info));
+    ASSERT_EQ(2, info.curSn);
+    ASSERT_EQ(1, info.snapSn);
+
+    // 访问chunk2时超过上限，关闭chunk1及其快照文件
+    EXPECT_CALL(*lfs_, Open(chunk2Path, _))
+        .WillOnce(Return(3));
+    EXPECT_CALL(*lfs_, Close(1))
+        .Times(1);
+    EXPECT_CALL(*lfs_, Close(2))
+        .Times(1);
+    ASSERT_EQ(CSErrorCode::Success,
+              dataStore->ReadChunk(2, 2, buf, 0, PAGE_SIZE));
+
+    // chunk1被关闭之后重新打开失败，获取chunk信息返回错误
+    EXPECT_CALL(*lfs_, Close(3))
+        .Times(1);
+    EXPECT_CALL(*lfs_, Open(chunk1Path, _))
+        .WillOnce(Return(-UT_ERRNO));
+    ASSERT_EQ(CSErrorCode::InternalError,
+              dataStore->GetChunkInfo(1, &info));
+}
+
 /**
  * InitializeErrorTest
  * case:data目录不存在，创建目录时失败
@@ -1356,6 +1418,144 @@ TEST_F(CSDataStore_test, WriteChunkTest13) {
         .Times(1);
 }
 
+/**
+ * WriteChunkTest
+ * 写clone chunk，开启bitmap延迟持久化
+ * case1:写入区域之前未写过，未持久化的page数量未达到上限
+ * 预期结果1:写入数据，内存中的bitmap立即更新，但不会写metapage
+ * case2:写入之后未持久化的page数量达到上限
+ * 预期结果2:写入数据并持久化metapage
+ * case3:未达到上限时调用SyncChunkMetaPages
+ * 预期结果3:持久化metapage，再次调用不会重复持久化
+ */
+TEST_F(CSDataStore_test, WriteChunkTest13_DeferMetaFlush) {
+    DataStoreOptions options;
+    options.baseDir = baseDir;
+    options.chunkSize = CHUNK_SIZE;
+    options.pageSize = PAGE_SIZE;
+    options.locationLimit = kLocationLimit;
+    options.metaFlushDirtyPages = 3;
+    dataStore = std::make_shared<CSDataStore>(lfs_, fpool_, options);
+    // initialize
+    FakeEnv();
+    EXPECT_TRUE(dataStore->Initialize());
+
+    ChunkID id = 3;
+    SequenceNum sn = 1;
+    SequenceNum correctedSn = 0;
+    off_t offset = 0;
+    size_t length = PAGE_SIZE;
+    char buf[2 * PAGE_SIZE] = {0};
+    CSChunkInfo info;
+    // 创建 clone chunk
+    {
+        char chunk3MetaPage[PAGE_SIZE] = {0};
+        shared_ptr<Bitmap> bitmap =
+            make_shared<Bitmap>(CHUNK_SIZE / PAGE_SIZE);
+        FakeEncodeChunk(chunk3MetaPage, correctedSn, sn, bitmap, location);
+        string chunk3Path = string(baseDir) + "/" +
+                            FileNameOperator::GenerateChunkFileName(id);
+        EXPECT_CALL(*lfs_, FileExists(chunk3Path))
+            .WillOnce(Return(false));
+        EXPECT_CALL(*fpool_, GetChunk(chunk3Path, NotNull()))
+            .WillOnce(Return(0));
+        EXPECT_CALL(*lfs_, Open(chunk3Path, _))
+            .Times(1)
+            .WillOnce(Return(4));
+        EXPECT_CALL(*lfs_, Read(4, NotNull(), 0, PAGE_SIZE))
+            .WillOnce(DoAll(SetArrayArgument<1>(chunk3MetaPage,
+                            chunk3MetaPage + PAGE_SIZE),
+                            Return(PAGE_SIZE)));
+        EXPECT_EQ(CSErrorCode::Success,
+                  dataStore->CreateCloneChunk(id,
+                                              sn,
+                                              correctedSn,
+                                              CHUNK_SIZE,
+                                              location));
+    }
+
+    // case1:未达到上限，不写metapage
+    {
+        offset = PAGE_SIZE;
+        length = PAGE_SIZE;
+        EXPECT_CALL(*lfs_, Write(4, NotNull(), PAGE_SIZE + offset, length))
+            .Times(1);
+        EXPECT_CALL(*lfs_, Write(4, NotNull(), 0, PAGE_SIZE))
+            .Times(0);
+        ASSERT_EQ(CSErrorCode::Success,
+                  dataStore->WriteChunk(id,
+                                        sn,
+                                        buf,
+                                        offset,
+                                        length,
+                                        nullptr));
+        ASSERT_EQ(CSErrorCode::Success, dataStore->GetChunkInfo(id, &info));
+        ASSERT_EQ(true, info.isClone);
+        ASSERT_EQ(1, info.bitmap->NextSetBit(0));
+        ASSERT_EQ(2, info.bitmap->NextClearBit(1));
+    }
+
+    // case2:达到上限，持久化metapage
+    {
+        offset = 2 * PAGE_SIZE;
+        length = 2 * PAGE_SIZE;
+        EXPECT_CALL(*lfs_, Write(4, NotNull(), PAGE_SIZE + offset, length))
+            .Times(1);
+        EXPECT_CALL(*lfs_, Write(4, NotNull(), 0, PAGE_SIZE))
+            .Times(1);
+        ASSERT_EQ(CSErrorCode::Success,
+                  dataStore->WriteChunk(id,
+                                        sn,
+                                        buf,
+                                        offset,
+                                        length,
+                                        nullptr));
+        ASSERT_EQ(CSErrorCode::Success, dataStore->GetChunkInfo(id, &info));
+        ASSERT_EQ(true, info.isClone);
+        ASSERT_EQ(1, info.bitmap->NextSetBit(0));
+        ASSERT_EQ(4, info.bitmap->NextClearBit(1));
+    }
+
+    // case3:调用SyncChunkMetaPages持久化
+    {
+        offset = 5 * PAGE_SIZE;
+        length = PAGE_SIZE;
+        EXPECT_CALL(*lfs_, Write(4, NotNull(), PAGE_SIZE + offset, length))
+            .Times(1);
+        EXPECT_CALL(*lfs_, Write(4, NotNull(), 0, PAGE_SIZE))
+            .Times(0);
+        ASSERT_EQ(CSErrorCode::Success,
+                  dataStore->WriteChunk(id,
+                                        sn,
+                                        buf,
+                                        offset,
+                                        length,
+                                        nullptr));
+        Mock::VerifyAndClearExpectations(lfs_.get());
+
+        EXPECT_CALL(*lfs_, Write(4, NotNull(), 0, PAGE_SIZE))
+            .WillOnce(Return(PAGE_SIZE));
+        ASSERT_EQ(CSErrorCode::Success, dataStore->SyncChunkMetaPages());
+        Mock::VerifyAndClearExpectations(lfs_.get());
+
+        EXPECT_CALL(*lfs_, Write(4, NotNull(), 0, PAGE_SIZE))
+            .Times(0);
+        ASSERT_EQ(CSErrorCode::Success, dataStore->SyncChunkMetaPages());
+        ASSERT_EQ(CSErrorCode::Success, dataStore->GetChunkInfo(id, &info));
+        ASSERT_EQ(true, info.isClone);
+        ASSERT_EQ(5, info.bitmap->NextSetBit(4));
+    }
+
+    EXPECT_CALL(*lfs_, Close(1))
+        .Times(1);
+    EXPECT_CALL(*lfs_, Close(2))
+        .Times(1);
+    EXPECT_CALL(*lfs_, Close(3))
+        .Times(1);
+    EXPECT_CALL(*lfs_, Close(4))
+        .Times(1);
+}
+
 /**
  * WriteChunkTest
  * 写clone chunk，模拟恢复
@@ -1649,6 +1849,114 @@ TEST_F(CSDataStore_test, WriteChunkTest16) {
         .Times(1);
 }
 
+/**
+ * WriteChunkTest
+ * case:开启稀疏快照，chunk存在,请求sn大于chunk的sn，chunk不存在快照
+ * 预期结果:不从chunkfilepool获取快照文件，而是新建文件并写入metapage，
+ *         cow拷贝的数据与metapage分别fsync后再写chunk，
+ *         删除快照时直接删除文件，不回收到chunkfilepool
+ */
+TEST_F(CSDataStore_test, WriteChunkTest17_SparseSnapshot) {
+    DataStoreOptions options;
+    options.baseDir = baseDir;
+    options.chunkSize = CHUNK_SIZE;
+    options.pageSize = PAGE_SIZE;
+    options.locationLimit = kLocationLimit;
+    options.sparseSnapshot = true;
+    dataStore = std::make_shared<CSDataStore>(lfs_, fpool_, options);
+    // initialize
+    FakeEnv();
+    EXPECT_TRUE(dataStore->Initialize());
+
+    ChunkID id = 2;
+    SequenceNum sn = 3;
+    off_t offset = 0;
+    size_t length = PAGE_SIZE;
+    char buf[length] = {0};
+    string snapPath = string(baseDir) + "/" +
+                      FileNameOperator::GenerateSnapshotName(id, 2);
+    string tmpPath = snapPath + "_tmp";
+
+    // 快照文件不从chunkfilepool中获取
+    EXPECT_CALL(*fpool_, GetChunk(_, _))
+        .Times(0);
+    EXPECT_CALL(*lfs_, FileExists(snapPath))
+        .WillOnce(Return(false));
+    EXPECT_CALL(*lfs_, Open(tmpPath, Truly(hasCreatFlag)))
+        .WillOnce(Return(4));
+    EXPECT_CALL(*lfs_, Write(4, NotNull(), 0, PAGE_SIZE))
+        .Times(1);
+    EXPECT_CALL(*lfs_, Fsync(4))
+        .Times(1);
+    EXPECT_CALL(*lfs_, Close(4))
+        .Times(1);
+    EXPECT_CALL(*lfs_, Rename(tmpPath, snapPath, _))
+        .WillOnce(Return(0));
+    EXPECT_CALL(*lfs_, Open(snapPath, _))
+        .WillOnce(Return(5));
+    // 新建的稀疏快照文件只包含metapage
+    struct stat fileInfo;
+    fileInfo.st_size = PAGE_SIZE;
+    EXPECT_CALL(*lfs_, Fstat(5, NotNull()))
+        .WillOnce(DoAll(SetArgPointee<1>(fileInfo),
+                        Return(0)));
+    char snapMetaPage[PAGE_SIZE] = {0};
+    SnapshotMetaPage metaPage;
+    metaPage.version = SPARSE_SNAPSHOT_FORMAT_VERSION;
+    metaPage.sn = 2;
+    metaPage.bitmap = std::make_shared<Bitmap>(CHUNK_SIZE / PAGE_SIZE);
+    metaPage.encode(snapMetaPage);
+    EXPECT_CALL(*lfs_, Read(5, NotNull(), 0, PAGE_SIZE))
+        .WillRepeatedly(DoAll(SetArrayArgument<1>(snapMetaPage,
+                              snapMetaPage + PAGE_SIZE),
+                              Return(PAGE_SIZE)));
+    // will update sn
+    EXPECT_CALL(*lfs_, Write(3, NotNull(), 0, PAGE_SIZE))
+        .Times(1);
+    // will copy on write
+    EXPECT_CALL(*lfs_, Read(3, NotNull(), PAGE_SIZE + offset, length))
+        .Times(1);
+    EXPECT_CALL(*lfs_, Write(5, NotNull(), PAGE_SIZE + offset, length))
+        .Times(1);
+    // 先持久化cow数据，再持久化metapage
+    EXPECT_CALL(*lfs_, Write(5, NotNull(), 0, PAGE_SIZE))
+        .Times(1);
+    EXPECT_CALL(*lfs_, Fsync(5))
+        .Times(2);
+    // will write data
+    EXPECT_CALL(*lfs_, Write(3, NotNull(), PAGE_SIZE + offset, length))
+        .Times(1);
+
+    EXPECT_EQ(CSErrorCode::Success,
+              dataStore->WriteChunk(id,
+                                    sn,
+                                    buf,
+                                    offset,
+                                    length,
+                                    nullptr));
+    CSChunkInfo info;
+    dataStore->GetChunkInfo(id, &info);
+    ASSERT_EQ(3, info.curSn);
+    ASSERT_EQ(2, info.snapSn);
+
+    // 删除稀疏快照时直接删除文件
+    EXPECT_CALL(*lfs_, Close(5))
+        .Times(1);
+    EXPECT_CALL(*fpool_, RecycleChunk(snapPath))
+        .Times(0);
+    EXPECT_CALL(*lfs_, Delete(snapPath))
+        .WillOnce(Return(0));
+    EXPECT_EQ(CSErrorCode::Success,
+              dataStore->DeleteSnapshotChunkOrCorrectSn(id, sn));
+
+    EXPECT_CALL(*lfs_, Close(1))
+        .Times(1);
+    EXPECT_CALL(*lfs_, Close(2))
+        .Times(1);
+    EXPECT_CALL(*lfs_, Close(3))
+        .Times(1);
+}
+
 /**
  * WriteChunkTest 异常测试
  * case:创建快照文件时出错
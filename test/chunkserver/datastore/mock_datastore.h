@@ -66,7 +66,13 @@ class MockDataStore : public CSDataStore {
                                          off_t,
                                          size_t));
     MOCK_METHOD2(GetChunkInfo, CSErrorCode(ChunkID, CSChunkInfo*));
+    MOCK_METHOD4(GetChunkHash, CSErrorCode(ChunkID,
+                                           off_t,
+                                           size_t,
+                                           std::string*));
+    MOCK_METHOD1(GetChunkIds, void(std::vector<ChunkID>*));
     MOCK_METHOD0(GetStatus, DataStoreStatus());
+    MOCK_METHOD0(SyncChunkMetaPages, CSErrorCode());
 };
 
 }  // namespace chunkserver
@@ -0,0 +1,90 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-19
+ * Author: agent
+ */
+
+#include <gtest/gtest.h>
+
+#include "src/common/concurrent/concurrent.h"
+#include "src/common/timeutility.h"
+#include "src/chunkserver/hash_throttle.h"
+
+namespace curve {
+namespace chunkserver {
+
+using curve::common::Thread;
+using curve::common::TimeUtility;
+
+TEST(HashThrottleTest, basic) {
+    // 不限速时直接返回
+    {
+        HashThrottle throttle(0);
+        uint64_t startUs = TimeUtility::GetTimeofDayUs();
+        for (int i = 0; i < 100; ++i) {
+            throttle.Acquire(16 * 1024 * 1024);
+        }
+        ASSERT_LT(TimeUtility::GetTimeofDayUs() - startUs, 100 * 1000);
+    }
+
+    // 桶里的令牌用完之后按照速率等待
+    {
+        const uint64_t kRate = 1024 * 1024;
+        HashThrottle throttle(kRate);
+        uint64_t startUs = TimeUtility::GetTimeofDayUs();
+        throttle.Acquire(kRate);
+        ASSERT_LT(TimeUtility::GetTimeofDayUs() - startUs, 100 * 1000);
+        throttle.Acquire(kRate / 2);
+        ASSERT_GE(TimeUtility::GetTimeofDayUs() - startUs, 400 * 1000);
+    }
+
+    // 单次读取的数据量超过速率时也可以获取，之后的请求等待补足
+    {
+        const uint64_t kRate = 1024 * 1024;
+        HashThrottle throttle(kRate);
+        uint64_t startUs = TimeUtility::GetTimeofDayUs();
+        throttle.Acquire(kRate * 2);
+        throttle.Acquire(kRate / 4);
+        ASSERT_GE(TimeUtility::GetTimeofDayUs() - startUs, 1200 * 1000);
+    }
+}
+
+TEST(HashThrottleTest, shared) {
+    // 多个请求共享同一个速率
+    const uint64_t kRate = 1024 * 1024;
+    HashThrottle throttle(kRate);
+    throttle.Acquire(kRate);
+
+    auto func = [&] {
+        for (int i = 0; i < 4; ++i) {
+            throttle.Acquire(kRate / 8);
+        }
+    };
+    uint64_t startUs = TimeUtility::GetTimeofDayUs();
+    Thread t1(func);
+    Thread t2(func);
+    t1.join();
+    t2.join();
+    // 两个线程一共需要kRate的令牌，至少需要1s
+    ASSERT_GE(TimeUtility::GetTimeofDayUs() - startUs, 900 * 1000);
+}
+
+}  // namespace chunkserver
+}  // namespace curve
@@ -195,6 +195,17 @@ TEST_F(CSMetricTest, CopysetMetricTest) {
     copysetMetric = metric_->GetCopysetMetric(logicId, copysetId);
     ASSERT_NE(copysetMetric, nullptr);
 
+    // 记录copyset的加载时间，重复记录时覆盖
+    ASSERT_EQ(0, copysetMetric->GetLoadTime());
+    copysetMetric->SetLoadTime(100);
+    ASSERT_EQ(100, copysetMetric->GetLoadTime());
+    ASSERT_STREQ("100", bvar::Variable::describe_exposed(
+        "copyset_" + std::to_string(logicId) + "_" +
+        std::to_string(copysetId) + "_load_time_ms").c_str());
+    copysetMetric->SetLoadTime(200);
+    ASSERT_EQ(200, copysetMetric->GetLoadTime());
+    copysetMetric = nullptr;
+
     // 删除copyset metric后，再去获取返回nullptr
     rc = metric_->RemoveCopysetMetric(logicId, copysetId);
     ASSERT_EQ(rc, 0);
@@ -42,6 +42,8 @@ class MockCopysetNode : public CopysetNode {
     MOCK_METHOD0(Fini, void());
     MOCK_CONST_METHOD0(IsLeaderTerm, bool());
     MOCK_CONST_METHOD0(GetLeaderId, PeerId());
+    MOCK_CONST_METHOD0(IsLeaseValid, bool());
+    MOCK_CONST_METHOD0(IsFollowerReadEnabled, bool());
     MOCK_CONST_METHOD0(GetConfEpoch, uint64_t());
     MOCK_METHOD1(UpdateAppliedIndex, void(uint64_t));
     MOCK_CONST_METHOD0(GetAppliedIndex, uint64_t());
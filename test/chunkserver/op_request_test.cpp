@@ -27,6 +27,8 @@
 
 #include <string>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include "proto/chunk.pb.h"
 #include "src/chunkserver/copyset_node.h"
@@ -325,6 +327,71 @@ TEST(ChunkOpRequestTest, encode) {
     }
 }
 
+TEST(ChunkOpRequestTest, encode_batch) {
+    LogicPoolID logicPoolId = 1;
+    CopysetID copysetId = 10001;
+    const int opNum = 3;
+    uint32_t size = 4096;
+
+    std::vector<ChunkRequest> requests(opNum);
+    std::vector<butil::IOBuf> datas(opNum);
+    std::vector<std::pair<const ChunkRequest *, const butil::IOBuf *>> ops;
+    for (int i = 0; i < opNum; ++i) {
+        requests[i].set_optype(CHUNK_OP_TYPE::CHUNK_OP_WRITE);
+        requests[i].set_logicpoolid(logicPoolId);
+        requests[i].set_copysetid(copysetId);
+        requests[i].set_chunkid(i + 1);
+        requests[i].set_offset(i * size);
+        requests[i].set_size(size);
+        datas[i].append(std::string(size, 'a' + i));
+        ops.emplace_back(&requests[i], &datas[i]);
+    }
+
+    // 单个op的log entry不是batch log
+    {
+        butil::IOBuf log;
+        ASSERT_EQ(0, ChunkOpRequest::Encode(&requests[0], &datas[0], &log));
+        ASSERT_FALSE(ChunkOpRequest::IsBatchLog(log));
+        std::vector<butil::IOBuf> opLogs;
+        ASSERT_EQ(-1, ChunkOpRequest::DecodeBatch(log, &opLogs));
+    }
+
+    // 多个op合并的log entry拆分之后可以逐个反序列化
+    {
+        butil::IOBuf log;
+        ASSERT_EQ(0, ChunkOpRequest::EncodeBatch(ops, &log));
+        ASSERT_TRUE(ChunkOpRequest::IsBatchLog(log));
+
+        std::vector<butil::IOBuf> opLogs;
+        ASSERT_EQ(0, ChunkOpRequest::DecodeBatch(log, &opLogs));
+        ASSERT_EQ(opNum, opLogs.size());
+        for (int i = 0; i < opNum; ++i) {
+            ChunkRequest request;
+            butil::IOBuf data;
+            auto req = ChunkOpRequest::Decode(opLogs[i], &request, &data);
+            ASSERT_TRUE(
+                dynamic_cast<WriteChunkRequest*>(req.get()) != nullptr);
+            ASSERT_EQ(CHUNK_OP_TYPE::CHUNK_OP_WRITE, request.optype());
+            ASSERT_EQ(logicPoolId, request.logicpoolid());
+            ASSERT_EQ(copysetId, request.copysetid());
+            ASSERT_EQ(i + 1, request.chunkid());
+            ASSERT_EQ(i * size, request.offset());
+            ASSERT_EQ(size, request.size());
+            ASSERT_EQ(std::string(size, 'a' + i), data.to_string());
+        }
+    }
+
+    // 截断的batch log反序列化失败
+    {
+        butil::IOBuf log;
+        ASSERT_EQ(0, ChunkOpRequest::EncodeBatch(ops, &log));
+        butil::IOBuf truncated;
+        log.cutn(&truncated, log.size() - 1);
+        std::vector<butil::IOBuf> opLogs;
+        ASSERT_EQ(-1, ChunkOpRequest::DecodeBatch(truncated, &opLogs));
+    }
+}
+
 TEST(ChunkOpRequestTest, OnApplyErrorTest) {
     LogicPoolID logicPoolId = 1;
     CopysetID copysetId = 10001;
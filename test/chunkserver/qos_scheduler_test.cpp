@@ -0,0 +1,217 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>   //NOLINT
+#include <thread>   //NOLINT
+
+#include "src/chunkserver/qos_scheduler.h"
+
+namespace curve {
+namespace chunkserver {
+
+const uint32_t kIOSize = 4096;
+
+class QosSchedulerTest : public testing::Test {
+ protected:
+    void SetUp() {
+        options_.enable = true;
+    }
+
+    void TearDown() {
+        scheduler_.Fini();
+    }
+
+    void Submit(QosIOType type, GroupNid groupId, uint64_t clientId,
+                int count, std::atomic<int>* done) {
+        for (int i = 0; i < count; ++i) {
+            scheduler_.Submit(type, groupId, clientId, kIOSize,
+                              [done] { done->fetch_add(1); });
+        }
+    }
+
+    // 等待条件满足，超时返回false
+    template <typename Pred>
+    static bool WaitFor(Pred pred, int timeoutMs) {
+        for (int i = 0; i < timeoutMs / 10; ++i) {
+            if (pred()) {
+                return true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return pred();
+    }
+
+    QosOptions options_;
+    QosScheduler scheduler_;
+};
+
+TEST_F(QosSchedulerTest, DisableTest) {
+    options_.enable = false;
+    options_.limit.chunkserverIops = 1;
+    ASSERT_EQ(0, scheduler_.Init(options_));
+    ASSERT_EQ(0, scheduler_.Run());
+
+    // 未开启时请求直接执行，不受限制
+    std::atomic<int> done(0);
+    Submit(QosIOType::FOREGROUND, 1, 1, 10, &done);
+    ASSERT_EQ(10, done.load());
+    ASSERT_EQ(0, scheduler_.GetQueuedCount());
+
+    options_.enable = true;
+    options_.quantumBytes = 0;
+    ASSERT_EQ(-1, scheduler_.Init(options_));
+}
+
+TEST_F(QosSchedulerTest, NoLimitTest) {
+    ASSERT_EQ(0, scheduler_.Init(options_));
+    ASSERT_EQ(0, scheduler_.Run());
+
+    // 令牌充足时直接在提交的线程中执行
+    std::atomic<int> done(0);
+    Submit(QosIOType::FOREGROUND, 1, 1, 100, &done);
+    Submit(QosIOType::SNAPSHOT, 2, 2, 100, &done);
+    ASSERT_EQ(200, done.load());
+    ASSERT_EQ(0, scheduler_.GetQueuedCount());
+}
+
+TEST_F(QosSchedulerTest, CopysetLimitTest) {
+    options_.limit.copysetIops = 20;
+    ASSERT_EQ(0, scheduler_.Init(options_));
+    ASSERT_EQ(0, scheduler_.Run());
+
+    // 桶中初始有20个令牌，超出的请求排队等待
+    std::atomic<int> limited(0);
+    Submit(QosIOType::FOREGROUND, 1, 1, 40, &limited);
+    ASSERT_LT(limited.load(), 40);
+    ASSERT_GT(scheduler_.GetQueuedCount(), 0);
+
+    // 其他copyset的请求不受影响
+    std::atomic<int> other(0);
+    Submit(QosIOType::FOREGROUND, 2, 1, 10, &other);
+    ASSERT_TRUE(WaitFor([&] { return other.load() == 10; }, 200));
+    ASSERT_LT(limited.load(), 40);
+
+    ASSERT_TRUE(WaitFor([&] { return limited.load() == 40; }, 3000));
+    ASSERT_EQ(0, scheduler_.GetQueuedCount());
+}
+
+TEST_F(QosSchedulerTest, BlockedTaskTest) {
+    options_.limit.copysetIops = 1;
+    ASSERT_EQ(0, scheduler_.Init(options_));
+    ASSERT_EQ(0, scheduler_.Run());
+
+    // copyset1的请求被调度后阻塞，不能影响copyset2的请求
+    std::atomic<bool> release(false);
+    std::atomic<int> blocked(0);
+    std::atomic<int> other(0);
+    Submit(QosIOType::FOREGROUND, 1, 1, 1, &blocked);
+    Submit(QosIOType::FOREGROUND, 2, 1, 1, &other);
+    scheduler_.Submit(QosIOType::FOREGROUND, 1, 1, kIOSize,
+                      [&] {
+                          while (!release.load()) {
+                              std::this_thread::sleep_for(
+                                  std::chrono::milliseconds(1));
+                          }
+                          blocked.fetch_add(1);
+                      });
+    Submit(QosIOType::FOREGROUND, 2, 1, 3, &other);
+    ASSERT_TRUE(WaitFor([&] { return other.load() == 4; }, 5000));
+    ASSERT_EQ(1, blocked.load());
+
+    release.store(true);
+    ASSERT_TRUE(WaitFor([&] { return blocked.load() == 2; }, 3000));
+}
+
+TEST_F(QosSchedulerTest, ClientFairnessTest) {
+    options_.limit.chunkserverIops = 100;
+    ASSERT_EQ(0, scheduler_.Init(options_));
+    ASSERT_EQ(0, scheduler_.Run());
+
+    // client1先提交了大量请求，client2后提交少量请求，
+    // 按照DRR调度client2不需要等待client1的请求全部完成
+    std::atomic<int> client1(0);
+    std::atomic<int> client2(0);
+    Submit(QosIOType::FOREGROUND, 1, 1, 300, &client1);
+    Submit(QosIOType::FOREGROUND, 1, 2, 20, &client2);
+    ASSERT_TRUE(WaitFor([&] { return client2.load() == 20; }, 2000));
+    ASSERT_LT(client1.load(), 300);
+    ASSERT_TRUE(WaitFor([&] { return client1.load() == 300; }, 4000));
+}
+
+TEST_F(QosSchedulerTest, TypeBudgetTest) {
+    options_.snapshotBps = 10 * kIOSize;
+    ASSERT_EQ(0, scheduler_.Init(options_));
+    ASSERT_EQ(0, scheduler_.Run());
+
+    // 快照读受带宽预算限制，前台IO不受影响
+    std::atomic<int> snapshot(0);
+    std::atomic<int> foreground(0);
+    Submit(QosIOType::SNAPSHOT, 1, 1, 30, &snapshot);
+    Submit(QosIOType::FOREGROUND, 1, 1, 30, &foreground);
+    ASSERT_TRUE(WaitFor([&] { return foreground.load() == 30; }, 200));
+    ASSERT_LT(snapshot.load(), 30);
+    ASSERT_TRUE(WaitFor([&] { return snapshot.load() == 30; }, 4000));
+}
+
+TEST_F(QosSchedulerTest, UpdateLimitTest) {
+    options_.limit.clientIops = 1;
+    ASSERT_EQ(0, scheduler_.Init(options_));
+    ASSERT_EQ(0, scheduler_.Run());
+
+    std::atomic<int> done(0);
+    Submit(QosIOType::FOREGROUND, 1, 1, 20, &done);
+    ASSERT_LT(done.load(), 20);
+
+    // 取消限制之后排队的请求很快被调度
+    QosLimit limit;
+    scheduler_.UpdateLimit(limit);
+    ASSERT_TRUE(scheduler_.GetLimit() == limit);
+    ASSERT_TRUE(WaitFor([&] { return done.load() == 20; }, 1000));
+
+    limit.copysetBps = 1024;
+    scheduler_.UpdateLimit(limit);
+    ASSERT_EQ(1024, scheduler_.GetLimit().copysetBps);
+}
+
+TEST_F(QosSchedulerTest, FiniTest) {
+    options_.limit.chunkserverIops = 1;
+    ASSERT_EQ(0, scheduler_.Init(options_));
+    ASSERT_EQ(0, scheduler_.Run());
+
+    std::atomic<int> done(0);
+    Submit(QosIOType::RECOVER, 1, 1, 10, &done);
+    ASSERT_LT(done.load(), 10);
+
+    // 停止时排队的请求全部执行，之后的请求直接执行
+    ASSERT_EQ(0, scheduler_.Fini());
+    ASSERT_EQ(10, done.load());
+    ASSERT_EQ(0, scheduler_.GetQueuedCount());
+    Submit(QosIOType::RECOVER, 1, 1, 10, &done);
+    ASSERT_EQ(20, done.load());
+}
+
+}  // namespace chunkserver
+}  // namespace curve
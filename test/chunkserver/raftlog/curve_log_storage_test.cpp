@@ -0,0 +1,164 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include <gtest/gtest.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "src/chunkserver/raftlog/curve_log_storage.h"
+
+namespace curve {
+namespace chunkserver {
+
+const char kLogPath[] = "./curve_log_storage_test";
+
+class CurveLogStorageTest : public testing::Test {
+ protected:
+    void SetUp() {
+        ::system("rm -rf curve_log_storage_test");
+        // 每个数据文件可以存放两条大日志
+        CurveLogStorage::set_inline_threshold(4096);
+        CurveLogStorage::set_data_segment_size(16 * 1024);
+    }
+
+    void TearDown() {
+        ::system("rm -rf curve_log_storage_test");
+        CurveLogStorage::set_inline_threshold(16 * 1024);
+        CurveLogStorage::set_data_segment_size(64 * 1024 * 1024);
+    }
+
+    // 偶数index的日志超过inline阈值，数据写入数据文件
+    static std::string MakeData(int64_t index, int64_t term) {
+        size_t size = (index % 2 == 0) ? 5000 : 100;
+        return std::string(size, 'a' + (index + term) % 26);
+    }
+
+    static int AppendEntries(CurveLogStorage* storage,
+                             int64_t begin, int64_t end, int64_t term) {
+        std::vector<braft::LogEntry*> entries;
+        for (int64_t i = begin; i <= end; ++i) {
+            braft::LogEntry* entry = new braft::LogEntry();
+            entry->AddRef();
+            entry->type = braft::ENTRY_TYPE_DATA;
+            entry->id = braft::LogId(i, term);
+            entry->data.append(MakeData(i, term));
+            entries.push_back(entry);
+        }
+        braft::IOMetric metric;
+        int ret = storage->append_entries(entries, &metric);
+        for (auto entry : entries) {
+            entry->Release();
+        }
+        return ret;
+    }
+
+    static void CheckEntry(CurveLogStorage* storage,
+                           int64_t index, int64_t term) {
+        braft::LogEntry* entry = storage->get_entry(index);
+        ASSERT_NE(nullptr, entry);
+        ASSERT_EQ(index, entry->id.index);
+        ASSERT_EQ(term, entry->id.term);
+        ASSERT_EQ(MakeData(index, term), entry->data.to_string());
+        ASSERT_EQ(term, storage->get_term(index));
+        entry->Release();
+    }
+
+    braft::ConfigurationManager configurationManager_;
+};
+
+TEST_F(CurveLogStorageTest, AppendTruncateAndReopen) {
+    std::unique_ptr<CurveLogStorage> storage(new CurveLogStorage(kLogPath));
+    ASSERT_EQ(0, storage->init(&configurationManager_));
+
+    // 大日志2,4,6,8,10分别写入data_2,data_6,data_10
+    ASSERT_EQ(10, AppendEntries(storage.get(), 1, 10, 1));
+    ASSERT_EQ(1, storage->first_log_index());
+    ASSERT_EQ(10, storage->last_log_index());
+    for (int64_t i = 1; i <= 10; ++i) {
+        CheckEntry(storage.get(), i, 1);
+    }
+    ASSERT_EQ(3, storage->GetDataSegmentNum());
+    ASSERT_EQ(0, access("./curve_log_storage_test/data/data_10", F_OK));
+
+    // 截断之后data_10不再被引用，重新写入的数据使用新的文件
+    ASSERT_EQ(0, storage->truncate_suffix(7));
+    ASSERT_EQ(7, storage->last_log_index());
+    ASSERT_EQ(2, storage->GetDataSegmentNum());
+    ASSERT_NE(0, access("./curve_log_storage_test/data/data_10", F_OK));
+    ASSERT_EQ(2, AppendEntries(storage.get(), 8, 9, 2));
+    ASSERT_EQ(3, storage->GetDataSegmentNum());
+    ASSERT_EQ(0, access("./curve_log_storage_test/data/data_8", F_OK));
+    CheckEntry(storage.get(), 6, 1);
+    CheckEntry(storage.get(), 8, 2);
+    CheckEntry(storage.get(), 9, 2);
+
+    // 重启之后可以从数据文件中读取数据
+    storage.reset(new CurveLogStorage(kLogPath));
+    ASSERT_EQ(0, storage->init(&configurationManager_));
+    ASSERT_EQ(1, storage->first_log_index());
+    ASSERT_EQ(9, storage->last_log_index());
+    ASSERT_EQ(3, storage->GetDataSegmentNum());
+    for (int64_t i = 1; i <= 7; ++i) {
+        CheckEntry(storage.get(), i, 1);
+    }
+    CheckEntry(storage.get(), 8, 2);
+    CheckEntry(storage.get(), 9, 2);
+
+    // 重启之后的数据写入新的文件
+    ASSERT_EQ(1, AppendEntries(storage.get(), 10, 10, 2));
+    ASSERT_EQ(4, storage->GetDataSegmentNum());
+    CheckEntry(storage.get(), 10, 2);
+
+    // data_2覆盖[2, 5]，在快照之后删除
+    ASSERT_EQ(0, storage->truncate_prefix(7));
+    ASSERT_EQ(7, storage->first_log_index());
+    ASSERT_EQ(3, storage->GetDataSegmentNum());
+    ASSERT_NE(0, access("./curve_log_storage_test/data/data_2", F_OK));
+    CheckEntry(storage.get(), 7, 1);
+    CheckEntry(storage.get(), 8, 2);
+
+    ASSERT_EQ(0, storage->reset(100));
+    ASSERT_EQ(100, storage->first_log_index());
+    ASSERT_EQ(99, storage->last_log_index());
+    ASSERT_EQ(0, storage->GetDataSegmentNum());
+}
+
+TEST_F(CurveLogStorageTest, DataCorruption) {
+    std::unique_ptr<CurveLogStorage> storage(new CurveLogStorage(kLogPath));
+    ASSERT_EQ(0, storage->init(&configurationManager_));
+    ASSERT_EQ(2, AppendEntries(storage.get(), 1, 2, 1));
+
+    // 修改数据文件之后crc校验失败，小日志不受影响
+    int fd = open("./curve_log_storage_test/data/data_2", O_RDWR);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(1, pwrite(fd, "x", 1, 0));
+    close(fd);
+    CheckEntry(storage.get(), 1, 1);
+    ASSERT_EQ(nullptr, storage->get_entry(2));
+}
+
+}  // namespace chunkserver
+}  // namespace curve
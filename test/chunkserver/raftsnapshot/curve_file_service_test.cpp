@@ -90,6 +90,104 @@ TEST_F(CurveFileServiceTest, success_normal_file) {
     kCurveFileService.remove_reader(reader_id);
 }
 
+TEST_F(CurveFileServiceTest, success_skip_zero_page) {
+    int64_t reader_id;
+    ASSERT_EQ(0, kCurveFileService.add_reader(reader_, &reader_id));
+    kCurveFileService.set_skip_zero_page(true);
+    // 数据布局：4KB零 | 4KB'a' | 4KB零 | 2KB'b'
+    std::string data(4096, 0);
+    data.append(4096, 'a');
+    data.append(4096, 0);
+    data.append(2048, 'b');
+    butil::IOBuf buf;
+    buf.append(data);
+    EXPECT_CALL(*reader_, read_file(_, "../data/chunk_1", _, _, _, _, _))
+        .Times(2)
+        .WillRepeatedly(DoAll(SetArgPointee<0>(buf),
+                              SetArgPointee<5>(buf.size()),
+                              Return(0)));
+    EXPECT_CALL(*reader_, read_file(_, "test", _, _, _, _, _))
+        .WillOnce(DoAll(SetArgPointee<0>(buf),
+                              SetArgPointee<5>(buf.size()),
+                              Return(0)));
+    std::string path = "/test";
+    EXPECT_CALL(*reader_, path())
+        .WillRepeatedly(ReturnRef(path));
+    brpc::Channel channel;
+    ASSERT_EQ(channel.Init(serverAddr, nullptr), 0);
+    braft::FileService_Stub stub(&channel);
+
+    // 1. follower标明已清零的chunk文件只传输非零的数据
+    {
+        brpc::Controller cntl;
+        braft::GetFileRequest request;
+        request.set_reader_id(reader_id);
+        request.set_filename(std::string("../data/chunk_1") +
+                             SKIP_ZERO_PAGE_SUFFIX);
+        request.set_count(buf.size());
+        request.set_offset(8192);
+        braft::GetFileResponse response;
+        stub.get_file(&cntl, &request, &response, nullptr);
+        ASSERT_FALSE(cntl.Failed());
+        ASSERT_EQ(buf.size(), response.read_size());
+
+        braft::FileSegData segData(cntl.response_attachment());
+        uint64_t segOffset = 0;
+        butil::IOBuf seg;
+        ASSERT_EQ(4096, segData.next(&segOffset, &seg));
+        ASSERT_EQ(8192 + 4096, segOffset);
+        ASSERT_EQ(std::string(4096, 'a'), seg.to_string());
+        seg.clear();
+        ASSERT_EQ(2048, segData.next(&segOffset, &seg));
+        ASSERT_EQ(8192 + 12288, segOffset);
+        ASSERT_EQ(std::string(2048, 'b'), seg.to_string());
+        seg.clear();
+        ASSERT_EQ(0, segData.next(&segOffset, &seg));
+    }
+
+    // 2. follower没有标明已清零的chunk文件完整传输
+    {
+        brpc::Controller cntl;
+        braft::GetFileRequest request;
+        request.set_reader_id(reader_id);
+        request.set_filename("../data/chunk_1");
+        request.set_count(buf.size());
+        request.set_offset(0);
+        braft::GetFileResponse response;
+        stub.get_file(&cntl, &request, &response, nullptr);
+        ASSERT_FALSE(cntl.Failed());
+
+        braft::FileSegData segData(cntl.response_attachment());
+        uint64_t segOffset = 0;
+        butil::IOBuf seg;
+        ASSERT_EQ(data.size(), segData.next(&segOffset, &seg));
+        ASSERT_EQ(0, segOffset);
+        ASSERT_EQ(data, seg.to_string());
+    }
+
+    // 3. 非chunk文件完整传输
+    {
+        brpc::Controller cntl;
+        braft::GetFileRequest request;
+        request.set_reader_id(reader_id);
+        request.set_filename(std::string("test") + SKIP_ZERO_PAGE_SUFFIX);
+        request.set_count(buf.size());
+        request.set_offset(0);
+        braft::GetFileResponse response;
+        stub.get_file(&cntl, &request, &response, nullptr);
+        ASSERT_FALSE(cntl.Failed());
+
+        braft::FileSegData segData(cntl.response_attachment());
+        uint64_t segOffset = 0;
+        butil::IOBuf seg;
+        ASSERT_EQ(data.size(), segData.next(&segOffset, &seg));
+        ASSERT_EQ(0, segOffset);
+        ASSERT_EQ(data, seg.to_string());
+    }
+    kCurveFileService.set_skip_zero_page(false);
+    kCurveFileService.remove_reader(reader_id);
+}
+
 TEST_F(CurveFileServiceTest, success_attach_file) {
     int64_t reader_id;
     ASSERT_EQ(0, kCurveFileService.add_reader(reader_, &reader_id));
@@ -112,6 +210,35 @@ TEST_F(CurveFileServiceTest, success_attach_file) {
     braft::GetFileResponse response;
     stub.get_file(&cntl, &request, &response, nullptr);
     ASSERT_FALSE(cntl.Failed());
+    // 没有开启跳过全零page时不通告该能力
+    CurveSnapshotAttachMetaTable attachMetaTable;
+    uint64_t segOffset = 0;
+    butil::IOBuf seg;
+    {
+        braft::FileSegData segData(cntl.response_attachment());
+        ASSERT_LT(0, segData.next(&segOffset, &seg));
+    }
+    ASSERT_EQ(0, attachMetaTable.load_from_iobuf_as_remote(seg));
+    std::vector<std::string> attachFiles;
+    attachMetaTable.list_files(&attachFiles);
+    ASSERT_EQ(files, attachFiles);
+    ASSERT_FALSE(attachMetaTable.skip_zero_page());
+
+    // 开启后在attach meta中通告
+    kCurveFileService.set_skip_zero_page(true);
+    EXPECT_CALL(*attachment_, list_attach_files(_, _))
+        .WillOnce(SetArgPointee<0>(files));
+    cntl.Reset();
+    stub.get_file(&cntl, &request, &response, nullptr);
+    ASSERT_FALSE(cntl.Failed());
+    seg.clear();
+    {
+        braft::FileSegData segData(cntl.response_attachment());
+        ASSERT_LT(0, segData.next(&segOffset, &seg));
+    }
+    ASSERT_EQ(0, attachMetaTable.load_from_iobuf_as_remote(seg));
+    ASSERT_TRUE(attachMetaTable.skip_zero_page());
+    kCurveFileService.set_skip_zero_page(false);
     kCurveFileService.remove_reader(reader_id);
     kCurveFileService.set_snapshot_attachment(NULL);
 }
@@ -24,6 +24,8 @@
 #include <gmock/gmock.h>
 #include <braft/snapshot.h>
 #include <butil/memory/ref_counted.h>
+#include <fcntl.h>
+#include <linux/falloc.h>
 
 #include <memory>
 
@@ -234,5 +236,46 @@ TEST_F(RaftSnapshotFilesystemAdaptorMockTest, rename_mock_test) {
     ASSERT_TRUE(ret);
 }
 
+TEST_F(RaftSnapshotFilesystemAdaptorMockTest, zero_new_chunk_file_mock_test) {
+    std::string path = "./12";
+    butil::File::Error e;
+    EXPECT_CALL(*lfs, Close(_)).WillRepeatedly(Return(0));
+    EXPECT_CALL(*lfs, FileExists(_)).WillRepeatedly(Return(true));
+
+    // 1. 没有与leader协商跳过全零page，截断已有的chunk文件时不清零
+    int fd = ::open("/dev/null", O_RDONLY);
+    ASSERT_GE(fd, 0);
+    EXPECT_CALL(*lfs, Open(_, _)).WillRepeatedly(Return(fd));
+    EXPECT_CALL(*lfs, Fallocate(_, _, _, _)).Times(0);
+    braft::FileAdaptor* fa = fsadaptor->open(
+                        path, O_WRONLY | O_CREAT | O_TRUNC, nullptr, &e);
+    ASSERT_NE(nullptr, fa);
+    delete fa;
+
+    // 2. 协商之后截断已有的chunk文件时用zero range清零
+    rfa->SetZeroNewChunkFile(true);
+    fd = ::open("/dev/null", O_RDONLY);
+    ASSERT_GE(fd, 0);
+    EXPECT_CALL(*lfs, Open(_, _)).WillRepeatedly(Return(fd));
+    EXPECT_CALL(*lfs, Fallocate(fd, FALLOC_FL_ZERO_RANGE, 0, 8192))
+        .WillOnce(Return(0));
+    fa = fsadaptor->open(path, O_WRONLY | O_CREAT | O_TRUNC, nullptr, &e);
+    ASSERT_NE(nullptr, fa);
+    delete fa;
+
+    // 3. zero range和写零都失败时open失败
+    fd = ::open("/dev/null", O_RDONLY);
+    ASSERT_GE(fd, 0);
+    EXPECT_CALL(*lfs, Open(_, _)).WillRepeatedly(Return(fd));
+    EXPECT_CALL(*lfs, Fallocate(fd, FALLOC_FL_ZERO_RANGE, 0, 8192))
+        .WillOnce(Return(-1));
+    EXPECT_CALL(*lfs, Write(fd, _, 0, 8192)).WillOnce(Return(-1));
+    fa = fsadaptor->open(path, O_WRONLY | O_CREAT | O_TRUNC, nullptr, &e);
+    ASSERT_EQ(nullptr, fa);
+    ASSERT_EQ(butil::File::FILE_ERROR_IO, e);
+    ::close(fd);
+    rfa->SetZeroNewChunkFile(false);
+}
+
 }   // namespace chunkserver
 }   // namespace curve
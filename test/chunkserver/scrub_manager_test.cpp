@@ -0,0 +1,241 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "src/chunkserver/scrub_manager.h"
+#include "src/chunkserver/copyset_node_manager.h"
+#include "test/chunkserver/datastore/mock_datastore.h"
+
+using ::testing::_;
+using ::testing::Return;
+using ::testing::DoAll;
+using ::testing::SetArgPointee;
+
+namespace curve {
+namespace chunkserver {
+
+class MockScrubManager : public ScrubManager {
+ public:
+    MOCK_METHOD7(GetPeerChunkHash, int(const PeerId&,
+                                       const LogicPoolID&,
+                                       const CopysetID&,
+                                       ChunkID,
+                                       ChunkID,
+                                       uint64_t,
+                                       std::map<ChunkID, std::string>*));
+    MOCK_METHOD2(GetAppliedIndex, uint64_t(const LogicPoolID&,
+                                           const CopysetID&));
+    MOCK_METHOD0(GetForegroundLatencyUs, int64_t());
+};
+
+class ScrubManagerTest : public ::testing::Test {
+ protected:
+    void SetUp() {
+        datastore_ = std::make_shared<MockDataStore>();
+        ScrubOptions options;
+        // 不限速
+        options.maxBytesPerSec = 0;
+        options.minBytesPerSec = 0;
+        options.chunkSize = 4096;
+        options.copysetNodeManager = &CopysetNodeManager::GetInstance();
+        ASSERT_EQ(0, scrub_.Init(options));
+        ASSERT_EQ(0, peer_.parse("127.0.0.1:9201:0"));
+        EXPECT_CALL(scrub_, GetForegroundLatencyUs())
+            .WillRepeatedly(Return(0));
+    }
+
+    std::shared_ptr<MockDataStore> datastore_;
+    MockScrubManager scrub_;
+    PeerId peer_;
+};
+
+TEST(ScrubThrottleTest, AdjustTest) {
+    ScrubThrottle throttle(100, 10, 1000);
+    ASSERT_EQ(100, throttle.GetBytesPerSec());
+    ASSERT_EQ(500000, throttle.GetCostUs(50));
+
+    // 前台IO延时超过阈值，速率减半，但不低于最小速率
+    throttle.Adjust(2000);
+    ASSERT_EQ(50, throttle.GetBytesPerSec());
+    throttle.Adjust(2000);
+    throttle.Adjust(2000);
+    ASSERT_EQ(12, throttle.GetBytesPerSec());
+    throttle.Adjust(2000);
+    ASSERT_EQ(10, throttle.GetBytesPerSec());
+
+    // 延时恢复之后逐步增加速率，但不超过最大速率
+    throttle.Adjust(500);
+    ASSERT_EQ(20, throttle.GetBytesPerSec());
+    for (int i = 0; i < 20; ++i) {
+        throttle.Adjust(500);
+    }
+    ASSERT_EQ(100, throttle.GetBytesPerSec());
+
+    // 最大速率为0表示不限速
+    ScrubThrottle unlimited(0, 10, 1000);
+    ASSERT_EQ(0, unlimited.GetCostUs(4096));
+}
+
+TEST_F(ScrubManagerTest, CompareChunksTest) {
+    std::vector<ChunkID> chunkIds = {1, 2, 3};
+    std::map<ChunkID, std::string> peerHashes = {{1, "a"}, {2, "b"}};
+    std::map<ChunkID, std::string> badHashes = {{1, "a"}, {2, "x"}};
+    std::map<ChunkID, std::string> badHash2 = {{2, "x"}};
+    std::map<ChunkID, std::string> goodHash2 = {{2, "b"}};
+
+    EXPECT_CALL(*datastore_, GetChunkHash(1, 0, 4096, _))
+        .WillRepeatedly(DoAll(SetArgPointee<3>("a"),
+                              Return(CSErrorCode::Success)));
+    EXPECT_CALL(*datastore_, GetChunkHash(2, 0, 4096, _))
+        .WillRepeatedly(DoAll(SetArgPointee<3>("b"),
+                              Return(CSErrorCode::Success)));
+    // 巡检过程中被删除的chunk不参与比较
+    EXPECT_CALL(*datastore_, GetChunkHash(3, 0, 4096, _))
+        .WillRepeatedly(Return(CSErrorCode::ChunkNotExistError));
+
+    // 1、所有chunk一致，第一次比较不要求applied index
+    std::set<ChunkID> inconsistent;
+    EXPECT_CALL(scrub_, GetPeerChunkHash(_, 1, 100, 1, 4, 0, _))
+        .WillOnce(DoAll(SetArgPointee<6>(peerHashes), Return(0)));
+    ASSERT_EQ(0, scrub_.CompareChunks(1, 100, datastore_, {peer_},
+                                      chunkIds, &inconsistent));
+    ASSERT_TRUE(inconsistent.empty());
+
+    // 2、chunk正在写入，第一次比较不一致，在固定的applied index上比较时一致
+    EXPECT_CALL(scrub_, GetAppliedIndex(1, 100))
+        .WillRepeatedly(Return(10));
+    EXPECT_CALL(scrub_, GetPeerChunkHash(_, 1, 100, 1, 4, 0, _))
+        .WillOnce(DoAll(SetArgPointee<6>(badHashes), Return(0)));
+    EXPECT_CALL(scrub_, GetPeerChunkHash(_, 1, 100, 2, 3, 10, _))
+        .WillOnce(DoAll(SetArgPointee<6>(goodHash2), Return(0)));
+    ASSERT_EQ(0, scrub_.CompareChunks(1, 100, datastore_, {peer_},
+                                      chunkIds, &inconsistent));
+    ASSERT_TRUE(inconsistent.empty());
+
+    // 3、在固定的applied index上仍然不一致
+    EXPECT_CALL(scrub_, GetPeerChunkHash(_, 1, 100, 1, 4, 0, _))
+        .WillOnce(DoAll(SetArgPointee<6>(badHashes), Return(0)));
+    EXPECT_CALL(scrub_, GetPeerChunkHash(_, 1, 100, 2, 3, 10, _))
+        .WillOnce(DoAll(SetArgPointee<6>(badHash2), Return(0)));
+    ASSERT_EQ(0, scrub_.CompareChunks(1, 100, datastore_, {peer_},
+                                      chunkIds, &inconsistent));
+    ASSERT_EQ(std::set<ChunkID>({2}), inconsistent);
+
+    // 4、副本上缺少chunk也认为不一致
+    inconsistent.clear();
+    std::map<ChunkID, std::string> missHashes = {{1, "a"}};
+    EXPECT_CALL(scrub_, GetPeerChunkHash(_, 1, 100, 1, 4, 0, _))
+        .WillOnce(DoAll(SetArgPointee<6>(missHashes), Return(0)));
+    EXPECT_CALL(scrub_, GetPeerChunkHash(_, 1, 100, 2, 3, 10, _))
+        .WillOnce(Return(0));
+    ASSERT_EQ(0, scrub_.CompareChunks(1, 100, datastore_, {peer_},
+                                      chunkIds, &inconsistent));
+    ASSERT_EQ(std::set<ChunkID>({2}), inconsistent);
+
+    // 5、副本一直没有apply到指定的位置，无法确认的chunk不认为不一致
+    inconsistent.clear();
+    EXPECT_CALL(scrub_, GetPeerChunkHash(_, 1, 100, 1, 4, 0, _))
+        .WillOnce(DoAll(SetArgPointee<6>(badHashes), Return(0)));
+    EXPECT_CALL(scrub_, GetPeerChunkHash(_, 1, 100, 2, 3, 10, _))
+        .Times(3)
+        .WillRepeatedly(Return(1));
+    ASSERT_EQ(0, scrub_.CompareChunks(1, 100, datastore_, {peer_},
+                                      chunkIds, &inconsistent));
+    ASSERT_TRUE(inconsistent.empty());
+
+    // 6、本地读取期间有新的apply，换到新的applied index上重新比较
+    EXPECT_CALL(scrub_, GetAppliedIndex(1, 100))
+        .WillOnce(Return(10))
+        .WillRepeatedly(Return(11));
+    EXPECT_CALL(scrub_, GetPeerChunkHash(_, 1, 100, 1, 4, 0, _))
+        .WillOnce(DoAll(SetArgPointee<6>(badHashes), Return(0)));
+    EXPECT_CALL(scrub_, GetPeerChunkHash(_, 1, 100, 2, 3, 11, _))
+        .WillOnce(DoAll(SetArgPointee<6>(badHash2), Return(0)));
+    ASSERT_EQ(0, scrub_.CompareChunks(1, 100, datastore_, {peer_},
+                                      chunkIds, &inconsistent));
+    ASSERT_EQ(std::set<ChunkID>({2}), inconsistent);
+
+    // 7、本地巡检过程中删除的chunk，副本上在固定的applied index上也已删除
+    inconsistent.clear();
+    std::map<ChunkID, std::string> moreHashes = {{1, "a"}, {2, "b"},
+                                                 {3, "c"}};
+    std::map<ChunkID, std::string> hash3 = {{3, "c"}};
+    EXPECT_CALL(scrub_, GetPeerChunkHash(_, 1, 100, 1, 4, 0, _))
+        .WillOnce(DoAll(SetArgPointee<6>(moreHashes), Return(0)));
+    EXPECT_CALL(scrub_, GetPeerChunkHash(_, 1, 100, 3, 4, 11, _))
+        .WillOnce(Return(0));
+    ASSERT_EQ(0, scrub_.CompareChunks(1, 100, datastore_, {peer_},
+                                      chunkIds, &inconsistent));
+    ASSERT_TRUE(inconsistent.empty());
+
+    // 8、chunk只在副本上存在，在固定的applied index上仍然存在
+    EXPECT_CALL(scrub_, GetPeerChunkHash(_, 1, 100, 1, 4, 0, _))
+        .WillOnce(DoAll(SetArgPointee<6>(moreHashes), Return(0)));
+    EXPECT_CALL(scrub_, GetPeerChunkHash(_, 1, 100, 3, 4, 11, _))
+        .WillOnce(DoAll(SetArgPointee<6>(hash3), Return(0)));
+    ASSERT_EQ(0, scrub_.CompareChunks(1, 100, datastore_, {peer_},
+                                      chunkIds, &inconsistent));
+    ASSERT_EQ(std::set<ChunkID>({3}), inconsistent);
+
+    // 请求范围内但不属于本批次的chunk由其所在的批次比较
+    inconsistent.clear();
+    std::map<ChunkID, std::string> rangeHashes = {{1, "a"}, {2, "b"},
+                                                  {4, "d"}};
+    EXPECT_CALL(*datastore_, GetChunkHash(5, 0, 4096, _))
+        .WillOnce(Return(CSErrorCode::ChunkNotExistError));
+    EXPECT_CALL(scrub_, GetPeerChunkHash(_, 1, 100, 1, 6, 0, _))
+        .WillOnce(DoAll(SetArgPointee<6>(rangeHashes), Return(0)));
+    ASSERT_EQ(0, scrub_.CompareChunks(1, 100, datastore_, {peer_},
+                                      {1, 2, 5}, &inconsistent));
+    ASSERT_TRUE(inconsistent.empty());
+
+    // 9、rpc失败
+    inconsistent.clear();
+    EXPECT_CALL(scrub_, GetPeerChunkHash(_, 1, 100, 1, 4, 0, _))
+        .WillOnce(Return(-1));
+    ASSERT_EQ(-1, scrub_.CompareChunks(1, 100, datastore_, {peer_},
+                                       chunkIds, &inconsistent));
+    ASSERT_TRUE(inconsistent.empty());
+
+    // 10、本地读取失败
+    EXPECT_CALL(*datastore_, GetChunkHash(1, 0, 4096, _))
+        .WillOnce(Return(CSErrorCode::InternalError));
+    ASSERT_EQ(-1, scrub_.CompareChunks(1, 100, datastore_, {peer_},
+                                       chunkIds, &inconsistent));
+
+    // 没有巡检过的copyset不会上报
+    std::vector<ChunkID> reported;
+    scrub_.GetInconsistentChunks(1, 100, &reported);
+    ASSERT_TRUE(reported.empty());
+    ASSERT_EQ(4096 * 28, scrub_.GetScrubbedBytes());
+}
+
+}  // namespace chunkserver
+}  // namespace curve
@@ -34,6 +34,7 @@
 #include <chrono>   //NOLINT
 #include <vector>
 #include <algorithm>
+#include <memory>
 
 #include "src/client/client_common.h"
 #include "src/client/file_instance.h"
@@ -45,6 +46,9 @@
 #include "src/client/client_config.h"
 #include "src/client/service_helper.h"
 #include "src/client/mds_client.h"
+#include "src/client/lease_excutor.h"
+#include "src/client/lease_refresh_batcher.h"
+#include "src/client/iomanager4file.h"
 #include "src/client/config_info.h"
 #include "test/client/fake/fakeMDS.h"
 #include "src/client/metacache_struct.h"
@@ -2379,6 +2383,14 @@ static void MockRefreshSession(::google::protobuf::RpcController* controller,
     response->set_sessionid("");
 }
 
+static void MockBatchRefreshSession(
+    ::google::protobuf::RpcController* controller,
+    const curve::mds::BatchRefreshSessionRequest* request,
+    curve::mds::BatchRefreshSessionResponse* response,
+    ::google::protobuf::Closure* done) {
+    brpc::ClosureGuard guard(done);
+}
+
 class MDSClientRefreshSessionTest : public ::testing::Test {
  public:
     void SetUp() override {
@@ -2456,5 +2468,180 @@ TEST_F(MDSClientRefreshSessionTest, NoStartDummyServerTest) {
     ASSERT_FALSE(request.has_clientip());
 }
 
+TEST_F(MDSClientRefreshSessionTest, BatchRefreshSessionTest) {
+    curve::client::ClientDummyServerInfo::GetInstance().SetRegister(false);
+
+    MDSClient mdsClient;
+    MetaServerOption opt;
+    opt.metaaddrvec.push_back(kServerAddress);
+    ASSERT_EQ(0, mdsClient.Initialize(opt));
+
+    UserInfo userInfo;
+    userInfo.owner = "test";
+    std::vector<LeaseRefreshItem_t> items(3);
+    for (int i = 0; i < 3; ++i) {
+        items[i].filename = "/file" + std::to_string(i);
+        items[i].fileId = i + 10;
+        items[i].parentId = 1;
+        items[i].sessionId = "";
+    }
+
+    // 每个文件的续约结果分别为成功、文件不存在、认证失败
+    curve::mds::BatchRefreshSessionRequest request;
+    curve::mds::BatchRefreshSessionResponse response;
+    response.set_statuscode(curve::mds::StatusCode::kOK);
+    auto result = response.add_results();
+    result->set_statuscode(curve::mds::StatusCode::kOK);
+    result->set_sessionid("");
+    curve::mds::FileInfo* fileInfo = result->mutable_fileinfo();
+    fileInfo->set_id(10);
+    fileInfo->set_seqnum(3);
+    result = response.add_results();
+    result->set_statuscode(curve::mds::StatusCode::kFileNotExists);
+    result->set_sessionid("");
+    result = response.add_results();
+    result->set_statuscode(curve::mds::StatusCode::kOwnerAuthFail);
+    result->set_sessionid("");
+    EXPECT_CALL(curveFsService_, BatchRefreshSession(_, _, _, _))
+        .WillOnce(DoAll(SaveArgPointee<1>(&request),
+                        SetArgPointee<2>(response),
+                        Invoke(MockBatchRefreshSession)));
+
+    std::vector<LIBCURVE_ERROR> retCodes;
+    std::vector<LeaseRefreshResult> results;
+    ASSERT_EQ(LIBCURVE_ERROR::OK, mdsClient.BatchRefreshSession(
+        userInfo, items, &retCodes, &results));
+    ASSERT_EQ(3, request.items_size());
+    ASSERT_EQ("test", request.owner());
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_EQ(items[i].filename, request.items(i).filename());
+        ASSERT_EQ(items[i].fileId, request.items(i).fileid());
+        ASSERT_EQ(items[i].parentId, request.items(i).parentid());
+    }
+    ASSERT_EQ(3, retCodes.size());
+    ASSERT_EQ(LIBCURVE_ERROR::OK, retCodes[0]);
+    ASSERT_EQ(LeaseRefreshResult::Status::OK, results[0].status);
+    ASSERT_EQ(3, results[0].finfo.seqnum);
+    ASSERT_EQ(LIBCURVE_ERROR::OK, retCodes[1]);
+    ASSERT_EQ(LeaseRefreshResult::Status::NOT_EXIST, results[1].status);
+    ASSERT_EQ(LIBCURVE_ERROR::AUTHFAIL, retCodes[2]);
+
+    // 整个请求认证失败
+    response.Clear();
+    response.set_statuscode(curve::mds::StatusCode::kOwnerAuthFail);
+    EXPECT_CALL(curveFsService_, BatchRefreshSession(_, _, _, _))
+        .WillOnce(DoAll(SetArgPointee<2>(response),
+                        Invoke(MockBatchRefreshSession)));
+    ASSERT_EQ(LIBCURVE_ERROR::AUTHFAIL, mdsClient.BatchRefreshSession(
+        userInfo, items, &retCodes, &results));
+}
+
+TEST_F(MDSClientRefreshSessionTest, LeaseRefreshBatcherTest) {
+    curve::client::ClientDummyServerInfo::GetInstance().SetRegister(false);
+
+    MDSClient mdsClient;
+    MetaServerOption opt;
+    opt.metaaddrvec.push_back(kServerAddress);
+    ASSERT_EQ(0, mdsClient.Initialize(opt));
+
+    UserInfo userInfo;
+    userInfo.owner = "test";
+    LeaseOption leaseOpt;
+    leaseOpt.enableBatchRefresh = true;
+    leaseOpt.batchRefreshMaxNum = 2;
+
+    // 续约间隔足够长，续约线程不会执行，由测试调用RefreshAll
+    const int fileNum = 3;
+    std::vector<std::unique_ptr<curve::client::IOManager4File>> iomanagers;
+    std::vector<std::unique_ptr<curve::client::LeaseExcutor>> excutors;
+    for (int i = 0; i < fileNum; ++i) {
+        std::string filename = "/file" + std::to_string(i);
+        iomanagers.emplace_back(new curve::client::IOManager4File());
+        ASSERT_TRUE(iomanagers[i]->Initialize(filename,
+            curve::client::IOOption_t(), &mdsClient));
+        excutors.emplace_back(new curve::client::LeaseExcutor(
+            leaseOpt, userInfo, &mdsClient, iomanagers[i].get()));
+        FInfo fi;
+        fi.fullPathName = filename;
+        fi.id = 10 + i;
+        fi.parentid = 1;
+        LeaseSession lease;
+        lease.sessionID = "session" + std::to_string(i);
+        lease.leaseTime = 1000 * 1000 * 1000;
+        ASSERT_TRUE(excutors[i]->Start(fi, lease));
+    }
+
+    // /file1已经被删除，其他文件续约成功并返回新的token
+    std::vector<int> batchSizes;
+    auto batchRefresh = [&batchSizes](
+        ::google::protobuf::RpcController* controller,
+        const curve::mds::BatchRefreshSessionRequest* request,
+        curve::mds::BatchRefreshSessionResponse* response,
+        ::google::protobuf::Closure* done) {
+        brpc::ClosureGuard guard(done);
+        batchSizes.push_back(request->items_size());
+        response->set_statuscode(curve::mds::StatusCode::kOK);
+        for (const auto& item : request->items()) {
+            auto result = response->add_results();
+            result->set_sessionid(item.sessionid());
+            if (item.filename() == "/file1") {
+                result->set_statuscode(curve::mds::StatusCode::kFileNotExists);
+                continue;
+            }
+            result->set_statuscode(curve::mds::StatusCode::kOK);
+            result->mutable_fileinfo()->set_id(item.fileid());
+            result->set_filetoken("token" + item.filename());
+        }
+    };
+    EXPECT_CALL(curveFsService_, BatchRefreshSession(_, _, _, _))
+        .Times(2)
+        .WillRepeatedly(Invoke(batchRefresh));
+    curve::client::LeaseRefreshBatcher::GetInstance().RefreshAll();
+    std::sort(batchSizes.begin(), batchSizes.end());
+    ASSERT_EQ(std::vector<int>({1, 2}), batchSizes);
+    ASSERT_TRUE(excutors[0]->LeaseValid());
+    ASSERT_FALSE(excutors[1]->LeaseValid());
+    ASSERT_TRUE(excutors[2]->LeaseValid());
+    ASSERT_EQ("token/file0",
+              iomanagers[0]->GetFileInfo()->fileToken.Get());
+    ASSERT_EQ("token/file2",
+              iomanagers[2]->GetFileInfo()->fileToken.Get());
+
+    // 文件不存在之后不再续约，剩余的两个文件在一个rpc中续约
+    batchSizes.clear();
+    curve::mds::BatchRefreshSessionRequest request;
+    EXPECT_CALL(curveFsService_, BatchRefreshSession(_, _, _, _))
+        .WillOnce(DoAll(SaveArgPointee<1>(&request), Invoke(batchRefresh)));
+    curve::client::LeaseRefreshBatcher::GetInstance().RefreshAll();
+    ASSERT_EQ(std::vector<int>({2}), batchSizes);
+    for (const auto& item : request.items()) {
+        ASSERT_NE("/file1", item.filename());
+        ASSERT_EQ("token" + item.filename(), item.filetoken());
+    }
+
+    // mds不支持批量续约时退回到逐个文件续约
+    EXPECT_CALL(curveFsService_, BatchRefreshSession(_, _, _, _))
+        .WillOnce(Invoke([](::google::protobuf::RpcController* controller,
+                            const curve::mds::BatchRefreshSessionRequest*,
+                            curve::mds::BatchRefreshSessionResponse*,
+                            ::google::protobuf::Closure* done) {
+            brpc::ClosureGuard guard(done);
+            controller->SetFailed(brpc::ENOMETHOD, "no method");
+        }));
+    curve::mds::ReFreshSessionResponse response;
+    response.set_statuscode(curve::mds::StatusCode::kOK);
+    response.mutable_fileinfo()->set_id(10);
+    EXPECT_CALL(curveFsService_, RefreshSession(_, _, _, _))
+        .Times(2)
+        .WillRepeatedly(DoAll(SetArgPointee<2>(response),
+                              Invoke(MockRefreshSession)));
+    curve::client::LeaseRefreshBatcher::GetInstance().RefreshAll();
+
+    for (int i = 0; i < fileNum; ++i) {
+        excutors[i]->Stop();
+        iomanagers[i]->UnInitialize();
+    }
+}
+
 }  // namespace client
 }  // namespace curve
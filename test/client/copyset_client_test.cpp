@@ -1846,6 +1846,184 @@ TEST_F(CopysetClientTest, read_error_test) {
     scheduler.Fini();
 }
 
+TEST_F(CopysetClientTest, follower_read_test) {
+    // leader为server_，另外两个副本各启动一个server
+    MockChunkServiceImpl leaderService;
+    MockChunkServiceImpl followerService1;
+    MockChunkServiceImpl followerService2;
+    brpc::Server follower1;
+    brpc::Server follower2;
+    std::string followerStr1 = "127.0.0.1:9113";
+    std::string followerStr2 = "127.0.0.1:9114";
+    ASSERT_EQ(0, server_->AddService(&leaderService,
+                                     brpc::SERVER_DOESNT_OWN_SERVICE));
+    ASSERT_EQ(0, server_->Start(listenAddr_.c_str(), nullptr));
+    ASSERT_EQ(0, follower1.AddService(&followerService1,
+                                      brpc::SERVER_DOESNT_OWN_SERVICE));
+    ASSERT_EQ(0, follower1.Start(followerStr1.c_str(), nullptr));
+    ASSERT_EQ(0, follower2.AddService(&followerService2,
+                                      brpc::SERVER_DOESNT_OWN_SERVICE));
+    ASSERT_EQ(0, follower2.Start(followerStr2.c_str(), nullptr));
+
+    IOSenderOption_t ioSenderOpt;
+    ioSenderOpt.failRequestOpt.chunkserverRPCTimeoutMS = 1000;
+    ioSenderOpt.failRequestOpt.chunkserverOPMaxRetry = 3;
+    // 重定向之后如果不是直接重试，会睡眠100ms
+    ioSenderOpt.failRequestOpt.chunkserverOPRetryIntervalUS = 1000000;
+    ioSenderOpt.failRequestOpt.chunkserverMaxRPCTimeoutMS = 3500;
+    ioSenderOpt.failRequestOpt.chunkserverMaxRetrySleepIntervalUS = 3500000;
+    ioSenderOpt.chunkserverEnableAppliedIndexRead = 1;
+    ioSenderOpt.chunkserverEnableFollowerRead = true;
+
+    RequestScheduleOption_t reqopt;
+    reqopt.ioSenderOpt = ioSenderOpt;
+
+    CopysetClient copysetClient;
+    MockMetaCache mockMetaCache;
+    mockMetaCache.DelegateToFake();
+
+    RequestScheduler scheduler;
+    scheduler.Init(reqopt, &mockMetaCache);
+    scheduler.Run();
+
+    copysetClient.Init(&mockMetaCache, ioSenderOpt, &scheduler);
+
+    LogicPoolID logicPoolId = 1;
+    CopysetID copysetId = 100001;
+    ChunkID chunkId = 1;
+    uint64_t sn = 1;
+    size_t len = 8;
+    char buff[8 + 1];
+    memset(buff, 'a', 8);
+    buff[8] = '\0';
+    off_t offset = 0;
+    uint64_t appliedIndex = 1;
+
+    // fake metacache中的leader为10000，副本按照follower1、leader、
+    // follower2的顺序加入copyset
+    ChunkServerID leaderId = 10000;
+    ChunkServerID followerId1 = 10001;
+    ChunkServerID followerId2 = 10002;
+    butil::EndPoint leaderAddr;
+    butil::EndPoint followerAddr1;
+    butil::EndPoint followerAddr2;
+    butil::str2endpoint(listenAddr_.c_str(), &leaderAddr);
+    butil::str2endpoint(followerStr1.c_str(), &followerAddr1);
+    butil::str2endpoint(followerStr2.c_str(), &followerAddr2);
+    CopysetInfo cpinfo;
+    cpinfo.AddCopysetPeerInfo(
+        CopysetPeerInfo(followerId1, ChunkServerAddr(followerAddr1)));
+    cpinfo.AddCopysetPeerInfo(
+        CopysetPeerInfo(leaderId, ChunkServerAddr(leaderAddr)));
+    cpinfo.AddCopysetPeerInfo(
+        CopysetPeerInfo(followerId2, ChunkServerAddr(followerAddr2)));
+    mockMetaCache.UpdateCopysetInfo(logicPoolId, copysetId, cpinfo);
+
+    FileMetric fm("test");
+    IOTracker iot(nullptr, nullptr, nullptr, &fm);
+
+    ChunkResponse success;
+    success.set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS);
+    ChunkResponse redirected;
+    redirected.set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_REDIRECTED);
+
+    auto readChunk = [&](uint64_t appliedindex,
+                         RequestClosure** done) {
+        RequestContext *reqCtx = new FakeRequestContext();
+        reqCtx->optype_ = OpType::READ;
+        reqCtx->idinfo_ = ChunkIDInfo(chunkId, logicPoolId, copysetId);
+        reqCtx->seq_ = sn;
+        reqCtx->readBuffer_ = buff;
+        reqCtx->offset_ = 0;
+        reqCtx->rawlength_ = len;
+
+        curve::common::CountDownEvent cond(1);
+        RequestClosure *reqDone = new FakeRequestClosure(&cond, reqCtx);
+        reqDone->SetFileMetric(&fm);
+        reqDone->SetIOTracker(&iot);
+        reqCtx->done_ = reqDone;
+        copysetClient.ReadChunk(reqCtx->idinfo_, sn, offset, len,
+                                appliedindex, {}, reqDone);
+        cond.Wait();
+        *done = reqDone;
+    };
+
+    /* 携带appliedindex的读请求轮流发往copyset的各个副本 */
+    {
+        EXPECT_CALL(followerService1, ReadChunk(_, _, _, _)).Times(2)
+            .WillRepeatedly(DoAll(SetArgPointee<2>(success),
+                                  Invoke(ReadChunkFunc)));
+        EXPECT_CALL(leaderService, ReadChunk(_, _, _, _)).Times(2)
+            .WillRepeatedly(DoAll(SetArgPointee<2>(success),
+                                  Invoke(ReadChunkFunc)));
+        EXPECT_CALL(followerService2, ReadChunk(_, _, _, _)).Times(2)
+            .WillRepeatedly(DoAll(SetArgPointee<2>(success),
+                                  Invoke(ReadChunkFunc)));
+        for (int i = 0; i < 6; ++i) {
+            RequestClosure* reqDone = nullptr;
+            readChunk(appliedIndex, &reqDone);
+            ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS,
+                      reqDone->GetErrorCode());
+        }
+        ASSERT_TRUE(::testing::Mock::VerifyAndClearExpectations(
+            &followerService1));
+        ASSERT_TRUE(::testing::Mock::VerifyAndClearExpectations(
+            &leaderService));
+        ASSERT_TRUE(::testing::Mock::VerifyAndClearExpectations(
+            &followerService2));
+    }
+    /* 不携带appliedindex的读请求只发往leader */
+    {
+        EXPECT_CALL(leaderService, ReadChunk(_, _, _, _)).Times(3)
+            .WillRepeatedly(DoAll(SetArgPointee<2>(success),
+                                  Invoke(ReadChunkFunc)));
+        for (int i = 0; i < 3; ++i) {
+            RequestClosure* reqDone = nullptr;
+            readChunk(0, &reqDone);
+            ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS,
+                      reqDone->GetErrorCode());
+        }
+        ASSERT_TRUE(::testing::Mock::VerifyAndClearExpectations(
+            &leaderService));
+    }
+    /* follower返回redirect，leader没有变化时不睡眠，直接重试到leader */
+    {
+        EXPECT_CALL(followerService1, ReadChunk(_, _, _, _)).Times(1)
+            .WillOnce(DoAll(SetArgPointee<2>(redirected),
+                            Invoke(ReadChunkFunc)));
+        EXPECT_CALL(leaderService, ReadChunk(_, _, _, _)).Times(1)
+            .WillOnce(DoAll(SetArgPointee<2>(success),
+                            Invoke(ReadChunkFunc)));
+        uint64_t start = TimeUtility::GetTimeofDayUs();
+        RequestClosure* reqDone = nullptr;
+        readChunk(appliedIndex, &reqDone);
+        ASSERT_LT(TimeUtility::GetTimeofDayUs() - start, 50000);
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS,
+                  reqDone->GetErrorCode());
+        ASSERT_EQ(2, reqDone->GetRetriedTimes());
+    }
+    /* leader返回redirect时刷新leader信息，睡眠之后重试 */
+    {
+        EXPECT_CALL(leaderService, ReadChunk(_, _, _, _)).Times(2)
+            .WillOnce(DoAll(SetArgPointee<2>(redirected),
+                            Invoke(ReadChunkFunc)))
+            .WillOnce(DoAll(SetArgPointee<2>(success),
+                            Invoke(ReadChunkFunc)));
+        uint64_t start = TimeUtility::GetTimeofDayUs();
+        RequestClosure* reqDone = nullptr;
+        readChunk(0, &reqDone);
+        ASSERT_GE(TimeUtility::GetTimeofDayUs() - start, 100000);
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS,
+                  reqDone->GetErrorCode());
+    }
+
+    scheduler.Fini();
+    follower1.Stop(0);
+    follower1.Join();
+    follower2.Stop(0);
+    follower2.Join();
+}
+
 /**
  * read snapshot error testing
  */
@@ -45,6 +45,7 @@ int Schedule::ScheduleRequest(
         int processed = 0;
         int totallength = 0;
         std::vector<datastruct> datavec;
+        std::vector<char*> vecdata;
         LOG(ERROR) << size;
 
         if (enableScheduleFailed) {
@@ -72,7 +73,12 @@ int Schedule::ScheduleRequest(
                 req->chunkinfodetail_->chunkSn.push_back(2222);
             }
 
-            if (iter->optype_ == curve::client::OpType::READ) {
+            if (iter->optype_ == curve::client::OpType::READ &&
+                !iter->readIov_.empty()) {
+                for (auto& iov : iter->readIov_) {
+                    memset(iov.iov_base, fakedate[processed%10], iov.iov_len);
+                }
+            } else if (iter->optype_ == curve::client::OpType::READ) {
                 memset(iter->readBuffer_,
                         fakedate[processed%10],
                         iter->rawlength_);
@@ -89,7 +95,14 @@ int Schedule::ScheduleRequest(
                 type = curve::client::OpType::WRITE;
                 datastruct datas;
                 datas.length = iter->rawlength_;
-                datas.data = const_cast<char*>(iter->writeBuffer_);
+                if (!iter->writeData_.empty()) {
+                    // 向量写的数据拷贝出来，在request释放之后依然可以校验
+                    datas.data = new char[iter->rawlength_];
+                    iter->writeData_.copy_to(datas.data, iter->rawlength_);
+                    vecdata.push_back(datas.data);
+                } else {
+                    datas.data = const_cast<char*>(iter->writeBuffer_);
+                }
                 totallength += iter->rawlength_;
                 datavec.push_back(datas);
             }
@@ -112,6 +125,9 @@ int Schedule::ScheduleRequest(
                         memcpy(writebuffer + tempoffert, it.data, it.length);
                         tempoffert += it.length;
                     }
+                    for (auto it : vecdata) {
+                        delete[] it;
+                    }
                 }
                 iter->done_->SetFailed(0);
                 iter->done_->Run();
@@ -0,0 +1,161 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-19
+ * Author: agent
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>   // NOLINT
+#include <thread>   // NOLINT
+#include <vector>
+
+#include "src/client/file_throttle.h"
+#include "src/common/timeutility.h"
+
+namespace curve {
+namespace client {
+
+using curve::common::TimeUtility;
+
+TEST(FileThrottleTest, NoLimit) {
+    FileThrottle throttle;
+    ASSERT_FALSE(throttle.Enabled());
+
+    uint64_t start = TimeUtility::GetTimeofDayMs();
+    for (int i = 0; i < 10000; ++i) {
+        throttle.Add(4096);
+    }
+    ASSERT_LT(TimeUtility::GetTimeofDayMs() - start, 100);
+}
+
+TEST(FileThrottleTest, IopsLimit) {
+    FileThrottle throttle;
+    FileThrottleOption_t params;
+    params.iopsTotal = 100;
+    params.iopsBurst = 10;
+    throttle.UpdateThrottleParams(params);
+    ASSERT_TRUE(throttle.Enabled());
+
+    // 突发的10个之外，50个IO至少需要400ms
+    uint64_t start = TimeUtility::GetTimeofDayMs();
+    for (int i = 0; i < 60; ++i) {
+        throttle.Add(4096);
+    }
+    uint64_t cost = TimeUtility::GetTimeofDayMs() - start;
+    ASSERT_GE(cost, 400);
+    ASSERT_LT(cost, 1000);
+}
+
+TEST(FileThrottleTest, TryAdd) {
+    FileThrottle throttle;
+    ASSERT_EQ(0, throttle.TryAdd(4096));
+
+    FileThrottleOption_t params;
+    params.iopsTotal = 10;
+    params.iopsBurst = 1;
+    throttle.UpdateThrottleParams(params);
+
+    // 令牌不足时不等待，返回需要等待的时间
+    ASSERT_EQ(0, throttle.TryAdd(4096));
+    uint64_t waitUs = throttle.TryAdd(4096);
+    ASSERT_GT(waitUs, 0);
+    ASSERT_LE(waitUs, 100 * 1000);
+
+    std::this_thread::sleep_for(std::chrono::microseconds(waitUs));
+    ASSERT_EQ(0, throttle.TryAdd(4096));
+}
+
+TEST(FileThrottleTest, BpsLimitMultiThread) {
+    FileThrottle throttle;
+    FileThrottleOption_t params;
+    params.bpsTotal = 1024 * 1024;
+    params.bpsBurst = 128 * 1024;
+    throttle.UpdateThrottleParams(params);
+
+    // 4个线程共写入640KB，突发之外的512KB至少需要400ms
+    uint64_t start = TimeUtility::GetTimeofDayMs();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&throttle]() {
+            for (int j = 0; j < 40; ++j) {
+                throttle.Add(4096);
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    uint64_t cost = TimeUtility::GetTimeofDayMs() - start;
+    ASSERT_GE(cost, 400);
+    ASSERT_LT(cost, 1000);
+}
+
+TEST(FileThrottleTest, UpdateParams) {
+    FileThrottle throttle;
+    FileThrottleOption_t params;
+    params.iopsTotal = 10;
+    throttle.UpdateThrottleParams(params);
+    ASSERT_TRUE(throttle.Enabled());
+    ASSERT_EQ(10, throttle.GetThrottleParams().iopsTotal);
+
+    // 关闭限制之后IO不再等待
+    throttle.UpdateThrottleParams(FileThrottleOption_t());
+    ASSERT_FALSE(throttle.Enabled());
+    uint64_t start = TimeUtility::GetTimeofDayMs();
+    for (int i = 0; i < 100; ++i) {
+        throttle.Add(4096);
+    }
+    ASSERT_LT(TimeUtility::GetTimeofDayMs() - start, 100);
+}
+
+TEST(FileThrottleTest, UpdateParamsWhileWaiting) {
+    FileThrottle throttle;
+    FileThrottleOption_t params;
+    params.iopsTotal = 1;
+    params.iopsBurst = 1;
+    throttle.UpdateThrottleParams(params);
+    throttle.Add(4096);
+
+    // 令牌用完，下一个IO需要等待约1s
+    std::atomic<bool> done(false);
+    std::thread waiter([&throttle, &done]() {
+        throttle.Add(4096);
+        done.store(true);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_FALSE(done.load());
+
+    // 等待中的IO不持有锁，更新参数不会被阻塞
+    uint64_t start = TimeUtility::GetTimeofDayMs();
+    throttle.UpdateThrottleParams(params);
+    ASSERT_EQ(1, throttle.GetThrottleParams().iopsTotal);
+    throttle.UpdateThrottleParams(FileThrottleOption_t());
+    ASSERT_LT(TimeUtility::GetTimeofDayMs() - start, 50);
+
+    // 关闭限制之后等待中的IO在一个等待周期内返回
+    waiter.join();
+    ASSERT_TRUE(done.load());
+    ASSERT_LT(TimeUtility::GetTimeofDayMs() - start, 500);
+}
+
+}   // namespace client
+}   // namespace curve
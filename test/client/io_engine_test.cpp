@@ -0,0 +1,236 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "src/client/io_engine.h"
+#include "src/client/iomanager4file.h"
+#include "src/client/request_scheduler.h"
+#include "src/client/inflight_controller.h"
+#include "test/client/mock_request_context.h"
+#include "src/common/concurrent/count_down_event.h"
+
+namespace curve {
+namespace client {
+
+using curve::common::CountDownEvent;
+using curve::common::TaskThreadPool;
+
+class IOEngineTest : public ::testing::Test {
+ protected:
+    void SetUp() {
+        opt_.scheduleQueueCapacity = 4096;
+        opt_.scheduleThreadpoolSize = 2;
+        engineOpt_.enable = true;
+        engineOpt_.workerNum = 2;
+        engineOpt_.quantum = 4;
+        ASSERT_EQ(0, IOEngine::GetInstance().Start(engineOpt_));
+    }
+
+    void TearDown() {
+        IOEngine::GetInstance().Stop();
+        ASSERT_EQ(0, IOEngine::GetInstance().GetWorkerNum());
+    }
+
+    // 未知类型的请求在下发时直接失败返回，用于验证调度
+    void Schedule(RequestScheduler* scheduler, CountDownEvent* cond,
+                  int num) {
+        for (int i = 0; i < num; ++i) {
+            RequestContext* ctx = new FakeRequestContext();
+            ctx->optype_ = OpType::UNKNOWN;
+            ctx->done_ = new FakeRequestClosure(cond, ctx);
+            contexts_.emplace_back(ctx);
+            closures_.emplace_back(ctx->done_);
+            ASSERT_EQ(0, scheduler->ScheduleRequest(ctx));
+        }
+    }
+
+    RequestScheduleOption_t opt_;
+    IOEngineOption_t engineOpt_;
+    MetaCache metaCache_;
+    std::vector<std::unique_ptr<RequestContext>> contexts_;
+    std::vector<std::unique_ptr<RequestClosure>> closures_;
+};
+
+TEST_F(IOEngineTest, RefCountTest) {
+    ASSERT_EQ(2, IOEngine::GetInstance().GetWorkerNum());
+    ASSERT_NE(nullptr, IOEngine::GetInstance().GetTaskPool());
+    ASSERT_NE(nullptr, IOEngine::GetInstance().GetTimerTaskWorker());
+
+    // 已经启动时忽略新的配置
+    IOEngineOption_t other;
+    other.workerNum = 8;
+    ASSERT_EQ(0, IOEngine::GetInstance().Start(other));
+    ASSERT_EQ(2, IOEngine::GetInstance().GetWorkerNum());
+    IOEngine::GetInstance().Stop();
+    ASSERT_EQ(2, IOEngine::GetInstance().GetWorkerNum());
+}
+
+TEST_F(IOEngineTest, SharedSchedulerTest) {
+    const int fileNum = 5;
+    const int reqNum = 100;
+    std::vector<std::unique_ptr<RequestScheduler>> schedulers;
+    FileMetric fm("io_engine_test");
+    for (int i = 0; i < fileNum; ++i) {
+        schedulers.emplace_back(new RequestScheduler());
+        ASSERT_EQ(0, schedulers.back()->Init(opt_, &metaCache_, &fm));
+        schedulers.back()->SetIOEngine(&IOEngine::GetInstance(), nullptr);
+        ASSERT_EQ(0, schedulers.back()->Run());
+    }
+
+    // 所有文件的请求都由引擎的两个线程下发
+    CountDownEvent cond(fileNum * reqNum);
+    for (auto& scheduler : schedulers) {
+        Schedule(scheduler.get(), &cond, reqNum);
+    }
+    cond.Wait();
+
+    // lease续约失败时不下发，续约成功之后继续下发
+    CountDownEvent blockCond(reqNum);
+    schedulers[0]->LeaseTimeoutBlockIO();
+    Schedule(schedulers[0].get(), &blockCond, reqNum);
+    ASSERT_FALSE(blockCond.WaitFor(200));
+    schedulers[0]->RefeshSuccAndResumeIO();
+    blockCond.Wait();
+
+    // 关闭文件时即使lease失效也需要将队列中的请求下发
+    CountDownEvent exitCond(reqNum);
+    schedulers[1]->LeaseTimeoutBlockIO();
+    Schedule(schedulers[1].get(), &exitCond, reqNum);
+    schedulers[1]->WakeupBlockQueueAtExit();
+    exitCond.Wait();
+
+    for (auto& scheduler : schedulers) {
+        ASSERT_EQ(0, scheduler->Fini());
+        ASSERT_EQ(0, scheduler->Fini());
+    }
+
+    // Fini之后不再接收请求
+    RequestContext ctx;
+    ASSERT_EQ(-1, schedulers[0]->ScheduleRequest(&ctx));
+}
+
+TEST_F(IOEngineTest, InflightLimitTest) {
+    FileMetric fm("io_engine_test");
+    InflightControl inflightCntl;
+    inflightCntl.SetMaxInflightNum(1);
+    RequestScheduler scheduler;
+    ASSERT_EQ(0, scheduler.Init(opt_, &metaCache_, &fm));
+    scheduler.SetIOEngine(&IOEngine::GetInstance(), &inflightCntl);
+    ASSERT_EQ(0, scheduler.Run());
+
+    // inflight达到上限时跳过该文件，令牌释放之后继续下发
+    inflightCntl.GetInflightToken();
+    CountDownEvent cond(10);
+    Schedule(&scheduler, &cond, 10);
+    ASSERT_FALSE(cond.WaitFor(200));
+    inflightCntl.ReleaseInflightToken();
+    scheduler.OnInflightRpcTokenReleased();
+    cond.Wait();
+
+    ASSERT_EQ(0, scheduler.Fini());
+}
+
+TEST_F(IOEngineTest, DelayReScheduleTest) {
+    FileMetric fm("io_engine_test");
+    RequestScheduleOption_t opt = opt_;
+    opt.ioSenderOpt.failRequestOpt.chunkserverOPMaxRetry = 3;
+    opt.ioSenderOpt.failRequestOpt.chunkserverOPRetryIntervalUS = 500000;
+
+    // 按轮转分配调度线程，scheduler 0和2共用一个调度线程
+    std::vector<std::unique_ptr<RequestScheduler>> schedulers;
+    for (int i = 0; i < 3; ++i) {
+        schedulers.emplace_back(new RequestScheduler());
+        ASSERT_EQ(0, schedulers.back()->Init(opt, &metaCache_, &fm));
+        schedulers.back()->SetIOEngine(&IOEngine::GetInstance(), nullptr);
+        ASSERT_EQ(0, schedulers.back()->Run());
+    }
+
+    // metacache中没有copyset信息，获取leader失败
+    const int reqNum = 10;
+    CountDownEvent failCond(reqNum);
+    for (int i = 0; i < reqNum; ++i) {
+        RequestContext* ctx = new FakeRequestContext();
+        ctx->optype_ = OpType::GET_CHUNK_INFO;
+        ctx->idinfo_ = ChunkIDInfo(1, 1, 1);
+        ctx->done_ = new FakeRequestClosure(&failCond, ctx);
+        contexts_.emplace_back(ctx);
+        closures_.emplace_back(ctx->done_);
+        ASSERT_EQ(0, schedulers[0]->ScheduleRequest(ctx));
+    }
+
+    // 等待重试的请求不占用调度线程，共用线程的其他文件可以正常下发
+    CountDownEvent cond(reqNum);
+    Schedule(schedulers[2].get(), &cond, reqNum);
+    ASSERT_TRUE(cond.WaitFor(400));
+
+    failCond.Wait();
+    for (int i = 0; i < reqNum; ++i) {
+        ASSERT_EQ(3, closures_[i]->GetRetriedTimes());
+    }
+
+    for (auto& scheduler : schedulers) {
+        ASSERT_EQ(0, scheduler->Fini());
+    }
+}
+
+TEST_F(IOEngineTest, ThrottleDelayTest) {
+    IOOption_t ioopt;
+    ioopt.engineOpt = engineOpt_;
+    ioopt.throttleOpt.iopsTotal = 10;
+    ioopt.throttleOpt.iopsBurst = 1;
+    MDSClient mdsclient;
+    IOManager4File iomanager;
+    ASSERT_TRUE(iomanager.Initialize("/throttle", ioopt, &mdsclient));
+
+    // 突发之外的IO每个需要等待100ms，数量超过线程池的线程数
+    const int throttledNum = 6;
+    CountDownEvent throttledCond(throttledNum);
+    std::atomic<int> throttledDone(0);
+    for (int i = 0; i < throttledNum; ++i) {
+        iomanager.EnqueueAioTask(4096, [&throttledCond, &throttledDone]() {
+            throttledDone.fetch_add(1);
+            throttledCond.Signal();
+        });
+    }
+
+    // 等待令牌的IO不占用共享线程池，其他文件的任务可以正常执行
+    const int otherNum = 10;
+    CountDownEvent otherCond(otherNum);
+    TaskThreadPool* taskPool = IOEngine::GetInstance().GetTaskPool();
+    for (int i = 0; i < otherNum; ++i) {
+        taskPool->Enqueue([&otherCond]() { otherCond.Signal(); });
+    }
+    ASSERT_TRUE(otherCond.WaitFor(50));
+    ASSERT_LT(throttledDone.load(), throttledNum);
+
+    throttledCond.Wait();
+    iomanager.UnInitialize();
+}
+
+}   // namespace client
+}   // namespace curve
@@ -356,6 +356,107 @@ TEST_F(IOTrackerSplitorTest, AsyncStartWrite) {
     delete[] data;
 }
 
+TEST_F(IOTrackerSplitorTest, AsyncStartReadv) {
+    MockRequestScheduler* mockschuler = new MockRequestScheduler;
+    mockschuler->DelegateToFake();
+
+    curve::client::IOManager4File* iomana = fileinstance_->GetIOManager4File();
+    iomana->SetRequestScheduler(mockschuler);
+
+    // 三个iovec，第二个iovec跨越了chunk边界
+    uint64_t length = 4 * 1024 * 1024 + 8 * 1024;
+    char* buf0 = new char[4 * 1024];
+    char* buf1 = new char[4 * 1024 * 1024];
+    char* buf2 = new char[4 * 1024];
+    struct iovec iov[3] = {
+        {buf0, 4 * 1024},
+        {buf1, 4 * 1024 * 1024},
+        {buf2, 4 * 1024}
+    };
+
+    CurveAioVContext vctx;
+    CurveAioContext& aioctx = vctx.ctx;
+    aioctx.offset = 4 * 1024 * 1024 - 4 * 1024;
+    aioctx.length = length;
+    aioctx.ret = LIBCURVE_ERROR::OK;
+    aioctx.cb = readcallback;
+    aioctx.buf = nullptr;
+    aioctx.op = LIBCURVE_OP::LIBCURVE_OP_READ;
+    vctx.iov = iov;
+    vctx.iovcnt = 3;
+
+    ioreadflag = false;
+    iomana->AioReadv(&vctx, &mdsclient_);
+
+    {
+        std::unique_lock<std::mutex> lk(readmtx);
+        readcv.wait(lk, []()->bool{return ioreadflag;});
+    }
+    ASSERT_EQ(static_cast<int>(length), aioctx.ret);
+    ASSERT_EQ('a', buf0[0]);
+    ASSERT_EQ('a', buf0[4 * 1024 - 1]);
+    ASSERT_EQ('b', buf1[0]);
+    ASSERT_EQ('e', buf1[chunk_size - 1]);
+    ASSERT_EQ('f', buf2[0]);
+    ASSERT_EQ('f', buf2[4 * 1024 - 1]);
+
+    delete[] buf0;
+    delete[] buf1;
+    delete[] buf2;
+}
+
+TEST_F(IOTrackerSplitorTest, AsyncStartWritev) {
+    MockRequestScheduler* mockschuler = new MockRequestScheduler;
+    mockschuler->DelegateToFake();
+
+    curve::client::IOManager4File* iomana = fileinstance_->GetIOManager4File();
+    iomana->SetRequestScheduler(mockschuler);
+
+    uint64_t length = 4 * 1024 * 1024 + 8 * 1024;
+    char* buf0 = new char[4 * 1024];
+    char* buf1 = new char[4 * 1024 * 1024];
+    char* buf2 = new char[4 * 1024];
+    memset(buf0, 'a', 4 * 1024);
+    memset(buf1, 'b', 4 * 1024 * 1024);
+    memset(buf2, 'c', 4 * 1024);
+    struct iovec iov[3] = {
+        {buf0, 4 * 1024},
+        {buf1, 4 * 1024 * 1024},
+        {buf2, 4 * 1024}
+    };
+
+    CurveAioVContext vctx;
+    CurveAioContext& aioctx = vctx.ctx;
+    aioctx.offset = 4 * 1024 * 1024 - 4 * 1024;
+    aioctx.length = length;
+    aioctx.ret = LIBCURVE_ERROR::OK;
+    aioctx.cb = writecallback;
+    aioctx.buf = nullptr;
+    aioctx.op = LIBCURVE_OP::LIBCURVE_OP_WRITE;
+    vctx.iov = iov;
+    vctx.iovcnt = 3;
+
+    iowriteflag = false;
+    iomana->AioWritev(&vctx, &mdsclient_);
+
+    {
+        std::unique_lock<std::mutex> lk(writemtx);
+        writecv.wait(lk, []()->bool{return iowriteflag;});
+    }
+
+    ASSERT_EQ(static_cast<int>(length), aioctx.ret);
+    ASSERT_EQ('a', writebuffer[0]);
+    ASSERT_EQ('a', writebuffer[4 * 1024 - 1]);
+    ASSERT_EQ('b', writebuffer[4 * 1024]);
+    ASSERT_EQ('b', writebuffer[4 * 1024 + chunk_size - 1]);
+    ASSERT_EQ('c', writebuffer[4 * 1024 + chunk_size]);
+    ASSERT_EQ('c', writebuffer[length - 1]);
+
+    delete[] buf0;
+    delete[] buf1;
+    delete[] buf2;
+}
+
 TEST_F(IOTrackerSplitorTest, StartRead) {
     MockRequestScheduler* mockschuler = new MockRequestScheduler;
     mockschuler->DelegateToFake();
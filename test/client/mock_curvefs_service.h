@@ -39,6 +39,12 @@ class MockCurveFsService : public ::curve::mds::CurveFSService {
                       const curve::mds::ReFreshSessionRequest* request,
                       curve::mds::ReFreshSessionResponse* response,
                       ::google::protobuf::Closure* done));
+
+    MOCK_METHOD4(BatchRefreshSession,
+                 void(::google::protobuf::RpcController* controller,
+                      const curve::mds::BatchRefreshSessionRequest* request,
+                      curve::mds::BatchRefreshSessionResponse* response,
+                      ::google::protobuf::Closure* done));
 };
 
 }  // namespace client
@@ -0,0 +1,175 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "src/client/request_merger.h"
+#include "src/common/concurrent/bounded_blocking_queue.h"
+
+namespace curve {
+namespace client {
+
+using curve::common::BBQItem;
+using curve::common::BoundedBlockingDeque;
+
+class RequestMergerTest : public ::testing::Test {
+ protected:
+    void TearDown() override {
+        for (auto req : reqs_) {
+            delete req->done_;
+            delete req;
+        }
+        reqs_.clear();
+    }
+
+    RequestContext* NewRequest(OpType type, ChunkID cid,
+                               off_t offset, size_t len, char* buf) {
+        RequestContext* req = new RequestContext();
+        req->optype_ = type;
+        req->idinfo_ = ChunkIDInfo(cid, 1, 1);
+        req->offset_ = offset;
+        req->rawlength_ = len;
+        req->seq_ = 1;
+        if (type == OpType::WRITE) {
+            req->writeBuffer_ = buf;
+        } else {
+            req->readBuffer_ = buf;
+        }
+        req->done_ = new RequestClosure(req);
+        reqs_.push_back(req);
+        return req;
+    }
+
+    std::vector<RequestContext*> reqs_;
+};
+
+TEST_F(RequestMergerTest, IsAdjacentTest) {
+    char buf[8192];
+    RequestContext* w1 = NewRequest(OpType::WRITE, 1, 0, 4096, buf);
+    RequestContext* w2 = NewRequest(OpType::WRITE, 1, 4096, 4096, buf);
+    // 地址不连续
+    RequestContext* w3 = NewRequest(OpType::WRITE, 1, 12288, 4096, buf);
+    // 不同chunk
+    RequestContext* w4 = NewRequest(OpType::WRITE, 2, 4096, 4096, buf);
+    // 不同类型
+    RequestContext* r1 = NewRequest(OpType::READ, 1, 4096, 4096, buf);
+    // 非读写请求
+    RequestContext* g1 = NewRequest(OpType::GET_CHUNK_INFO, 1, 4096, 0, buf);
+    // 不同版本号
+    RequestContext* w5 = NewRequest(OpType::WRITE, 1, 4096, 4096, buf);
+    w5->seq_ = 2;
+
+    ASSERT_TRUE(RequestMerger::IsAdjacent(w1, w2));
+    ASSERT_FALSE(RequestMerger::IsAdjacent(w2, w1));
+    ASSERT_FALSE(RequestMerger::IsAdjacent(w2, w3));
+    ASSERT_FALSE(RequestMerger::IsAdjacent(w1, w4));
+    ASSERT_FALSE(RequestMerger::IsAdjacent(w1, r1));
+    ASSERT_FALSE(RequestMerger::IsAdjacent(w1, g1));
+    ASSERT_FALSE(RequestMerger::IsAdjacent(w1, w5));
+    ASSERT_FALSE(RequestMerger::IsMergeable(g1));
+
+    // 重试之后重新进队的请求
+    w2->done_->IncremRetriedTimes();
+    ASSERT_FALSE(RequestMerger::IsMergeable(w2));
+    ASSERT_FALSE(RequestMerger::IsAdjacent(w1, w2));
+}
+
+TEST_F(RequestMergerTest, MergeWriteTest) {
+    char buf1[4096];
+    char buf2[8192];
+    memset(buf1, 'a', sizeof(buf1));
+    memset(buf2, 'b', sizeof(buf2));
+
+    RequestContext* w1 = NewRequest(OpType::WRITE, 1, 4096, 4096, buf1);
+    RequestContext* w2 = NewRequest(OpType::WRITE, 1, 8192, 8192, buf2);
+    w1->appliedindex_ = 10;
+    w2->appliedindex_ = 20;
+
+    std::unique_ptr<RequestContext> merged(RequestMerger::Merge({w1, w2}));
+    ASSERT_NE(nullptr, merged);
+    std::unique_ptr<RequestClosure> done(merged->done_);
+
+    ASSERT_EQ(OpType::WRITE, merged->optype_);
+    ASSERT_EQ(4096, merged->offset_);
+    ASSERT_EQ(12288, merged->rawlength_);
+    ASSERT_EQ(20, merged->appliedindex_);
+    ASSERT_EQ(12288, merged->writeData_.size());
+
+    std::string data = merged->writeData_.to_string();
+    ASSERT_EQ(std::string(4096, 'a'), data.substr(0, 4096));
+    ASSERT_EQ(std::string(8192, 'b'), data.substr(4096));
+
+    // 合并之后的请求不会再次参与合并
+    ASSERT_FALSE(RequestMerger::IsMergeable(merged.get()));
+    auto mergedDone = dynamic_cast<MergedRequestClosure*>(done.get());
+    ASSERT_NE(nullptr, mergedDone);
+    ASSERT_EQ(2, mergedDone->GetMergedRequests().size());
+}
+
+TEST_F(RequestMergerTest, MergeReadTest) {
+    char buf1[4096];
+    char buf2[4096];
+    RequestContext* r1 = NewRequest(OpType::READ, 1, 0, 4096, buf1);
+    RequestContext* r2 = NewRequest(OpType::READ, 1, 4096, 4096, buf2);
+
+    std::unique_ptr<RequestContext> merged(RequestMerger::Merge({r1, r2}));
+    ASSERT_NE(nullptr, merged);
+    std::unique_ptr<RequestClosure> done(merged->done_);
+
+    ASSERT_EQ(OpType::READ, merged->optype_);
+    ASSERT_EQ(0, merged->offset_);
+    ASSERT_EQ(8192, merged->rawlength_);
+    ASSERT_EQ(2, merged->readIov_.size());
+    ASSERT_EQ(buf1, merged->readIov_[0].iov_base);
+    ASSERT_EQ(4096, merged->readIov_[0].iov_len);
+    ASSERT_EQ(buf2, merged->readIov_[1].iov_base);
+    ASSERT_EQ(4096, merged->readIov_[1].iov_len);
+}
+
+TEST(BoundedBlockingDequeTest, TakeFrontIfTest) {
+    BoundedBlockingDeque<BBQItem<int>> queue;
+    ASSERT_EQ(0, queue.Init(4));
+
+    auto isEven = [](const BBQItem<int>& item) {
+        return !item.IsStop() && item.Item() % 2 == 0;
+    };
+
+    BBQItem<int> out(-1);
+    // 队列为空时直接返回
+    ASSERT_FALSE(queue.TakeFrontIf(isEven, &out));
+
+    queue.PutBack(BBQItem<int>(2));
+    queue.PutBack(BBQItem<int>(3));
+    ASSERT_TRUE(queue.TakeFrontIf(isEven, &out));
+    ASSERT_EQ(2, out.Item());
+    // 队首元素不满足条件，不取出
+    ASSERT_FALSE(queue.TakeFrontIf(isEven, &out));
+    ASSERT_EQ(3, queue.TakeFront().Item());
+    ASSERT_TRUE(queue.Empty());
+}
+
+}   // namespace client
+}   // namespace curve
@@ -0,0 +1,67 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include <gtest/gtest.h>
+#include <bvar/bvar.h>
+
+#include "src/common/latency_tracer.h"
+
+namespace curve {
+namespace common {
+
+TEST(Common, latency_tracer_test) {
+    LatencyTracer tracer("latency_tracer_test", {"queue", "io"});
+    ASSERT_EQ("io", tracer.GetStageName(1));
+
+    // 未设置阈值时不记录慢请求
+    ASSERT_FALSE(tracer.RecordTotal(1000000));
+
+    tracer.SetSlowRequestOption(1000, 2);
+    tracer.RecordStage(0, 100);
+    tracer.RecordStage(1, 200);
+    // 不存在的阶段及负数的耗时被忽略
+    tracer.RecordStage(2, 100);
+    tracer.RecordStage(0, -1);
+    ASSERT_FALSE(tracer.RecordTotal(999));
+    ASSERT_TRUE(tracer.RecordTotal(1000));
+    ASSERT_TRUE(tracer.DumpSlowRequests().empty());
+
+    // 只保留最近的两个慢请求
+    tracer.AddSlowRequest("traceId=1");
+    tracer.AddSlowRequest("traceId=2");
+    tracer.AddSlowRequest("traceId=3");
+    ASSERT_EQ("traceId=2\ntraceId=3\n", tracer.DumpSlowRequests());
+
+    // 慢请求通过bvar导出
+    std::string value;
+    ASSERT_EQ(0, bvar::Variable::describe_exposed(
+        "latency_tracer_test_slow_requests", &value));
+    ASSERT_EQ("traceId=2\ntraceId=3\n", value);
+    ASSERT_EQ(0, bvar::Variable::describe_exposed(
+        "latency_tracer_test_queue_count", &value));
+
+    tracer.SetSlowRequestOption(1000, 1);
+    ASSERT_EQ("traceId=3\n", tracer.DumpSlowRequests());
+}
+
+}  // namespace common
+}  // namespace curve
@@ -0,0 +1,93 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include <gtest/gtest.h>
+
+#include "src/common/token_bucket.h"
+
+namespace curve {
+namespace common {
+
+TEST(TokenBucketTest, UnlimitedTest) {
+    TokenBucket bucket;
+    ASSERT_TRUE(bucket.Unlimited());
+    ASSERT_EQ(0, bucket.GetWaitUs(UINT32_MAX, 0));
+    bucket.Consume(UINT32_MAX, 0);
+    ASSERT_EQ(0, bucket.GetWaitUs(UINT32_MAX, 0));
+}
+
+TEST(TokenBucketTest, ConsumeAndRefillTest) {
+    uint64_t nowUs = 1000000;
+    // 每秒100个令牌，初始时桶是满的
+    TokenBucket bucket(100);
+    ASSERT_FALSE(bucket.Unlimited());
+    ASSERT_EQ(0, bucket.GetWaitUs(100, nowUs));
+    bucket.Consume(100, nowUs);
+
+    // 令牌用完之后需要等待补充，1个令牌需要10ms
+    uint64_t waitUs = bucket.GetWaitUs(1, nowUs);
+    ASSERT_GT(waitUs, 9000);
+    ASSERT_LE(waitUs, 10001);
+    ASSERT_EQ(0, bucket.GetWaitUs(1, nowUs + waitUs));
+    ASSERT_NE(0, bucket.GetWaitUs(10, nowUs + waitUs));
+
+    // 补充的令牌不会超过桶的容量
+    nowUs += 10 * 1000000;
+    ASSERT_EQ(0, bucket.GetWaitUs(100, nowUs));
+    bucket.Consume(100, nowUs);
+    ASSERT_NE(0, bucket.GetWaitUs(1, nowUs));
+}
+
+TEST(TokenBucketTest, LargeRequestTest) {
+    uint64_t nowUs = 1000000;
+    TokenBucket bucket(100, 50);
+    // 超过桶容量的请求在桶满时可以获取，之后令牌数为负
+    ASSERT_EQ(0, bucket.GetWaitUs(200, nowUs));
+    bucket.Consume(200, nowUs);
+    // 需要补齐150个令牌之后才能再获取1个令牌
+    uint64_t waitUs = bucket.GetWaitUs(1, nowUs);
+    ASSERT_GT(waitUs, 1500000);
+    ASSERT_LE(waitUs, 1510001);
+    ASSERT_EQ(0, bucket.GetWaitUs(1, nowUs + waitUs));
+}
+
+TEST(TokenBucketTest, SetRateTest) {
+    uint64_t nowUs = 1000000;
+    TokenBucket bucket(1000);
+    ASSERT_EQ(0, bucket.GetWaitUs(1000, nowUs));
+
+    // 调小容量之后已有的令牌数不超过新的容量
+    bucket.SetRate(10);
+    ASSERT_EQ(10, bucket.GetRate());
+    ASSERT_EQ(0, bucket.GetWaitUs(10, nowUs));
+    bucket.Consume(10, nowUs);
+    ASSERT_NE(0, bucket.GetWaitUs(1, nowUs));
+
+    // 调整为不限制
+    bucket.SetRate(0);
+    ASSERT_TRUE(bucket.Unlimited());
+    ASSERT_EQ(0, bucket.GetWaitUs(1, nowUs));
+}
+
+}  // namespace common
+}  // namespace curve
@@ -104,6 +104,37 @@ uint32_t FakeSnapshotCloneMetaStore::GetSnapshotCount() {
     return snapInfos_.size();
 }
 
+int FakeSnapshotCloneMetaStore::GetSnapshotPage(const SnapshotFilter &filter,
+    const UUID &cursor,
+    uint64_t limit,
+    std::vector<SnapshotInfo> *list,
+    UUID *nextCursor,
+    uint64_t *total) {
+    std::lock_guard<std::mutex> guard(snapInfos_mutex);
+    list->clear();
+    nextCursor->clear();
+    *total = 0;
+    for (auto it = snapInfos_.begin(); it != snapInfos_.end(); it++) {
+        const SnapshotInfo &info = it->second;
+        if ((!filter.user.empty() && info.GetUser() != filter.user) ||
+            (!filter.fileName.empty() &&
+                info.GetFileName() != filter.fileName) ||
+            (filter.filterStatus && info.GetStatus() != filter.status)) {
+            continue;
+        }
+        ++(*total);
+        if (!cursor.empty() && it->first <= cursor) {
+            continue;
+        }
+        if (list->size() < limit) {
+            list->push_back(info);
+        } else {
+            *nextCursor = list->back().GetUuid();
+        }
+    }
+    return 0;
+}
+
 int FakeSnapshotCloneMetaStore::AddCloneInfo(const CloneInfo &info) {
     fiu_return_on(
         "test/integration/snapshotcloneserver/FakeSnapshotCloneMetaStore.AddCloneInfo", -1);  // NOLINT
@@ -164,6 +195,37 @@ int FakeSnapshotCloneMetaStore::GetCloneInfoList(
     return -1;
 }
 
+int FakeSnapshotCloneMetaStore::GetCloneInfoPage(
+    const CloneInfoFilter &filter,
+    const TaskIdType &cursor,
+    uint64_t limit,
+    std::vector<CloneInfo> *list,
+    TaskIdType *nextCursor,
+    uint64_t *total) {
+    curve::common::ReadLockGuard guard(cloneInfos_lock_);
+    list->clear();
+    nextCursor->clear();
+    *total = 0;
+    for (auto it = cloneInfos_.begin(); it != cloneInfos_.end(); it++) {
+        const CloneInfo &info = it->second;
+        if ((!filter.user.empty() && info.GetUser() != filter.user) ||
+            (!filter.fileName.empty() && info.GetDest() != filter.fileName) ||
+            (filter.filterStatus && info.GetStatus() != filter.status)) {
+            continue;
+        }
+        ++(*total);
+        if (!cursor.empty() && it->first <= cursor) {
+            continue;
+        }
+        if (list->size() < limit) {
+            list->push_back(info);
+        } else {
+            *nextCursor = list->back().GetTaskId();
+        }
+    }
+    return 0;
+}
+
 
 
 }  // namespace snapshotcloneserver
@@ -42,6 +42,12 @@ class FakeSnapshotCloneMetaStore : public SnapshotCloneMetaStore {
                         std::vector<SnapshotInfo> *v) override;
     int GetSnapshotList(std::vector<SnapshotInfo> *list) override;
     uint32_t GetSnapshotCount() override;
+    int GetSnapshotPage(const SnapshotFilter &filter,
+                        const UUID &cursor,
+                        uint64_t limit,
+                        std::vector<SnapshotInfo> *list,
+                        UUID *nextCursor,
+                        uint64_t *total) override;
 
     int AddCloneInfo(const CloneInfo &cloneInfo) override;
 
@@ -56,6 +62,13 @@ class FakeSnapshotCloneMetaStore : public SnapshotCloneMetaStore {
 
     int GetCloneInfoList(std::vector<CloneInfo> *list) override;
 
+    int GetCloneInfoPage(const CloneInfoFilter &filter,
+                         const TaskIdType &cursor,
+                         uint64_t limit,
+                         std::vector<CloneInfo> *list,
+                         TaskIdType *nextCursor,
+                         uint64_t *total) override;
+
  private:
     std::map<UUID, SnapshotInfo> snapInfos_;
     std::mutex snapInfos_mutex;
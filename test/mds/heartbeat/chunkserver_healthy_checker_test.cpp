@@ -22,6 +22,7 @@
 
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include <thread>  //NOLINT
 #include "src/mds/heartbeat/chunkserver_healthy_checker.h"
 #include "src/mds/topology/topology_item.h"
 #include "test/mds/mock/mock_topology.h"
@@ -30,6 +31,7 @@ using ::testing::Return;
 using ::testing::SetArgPointee;
 using ::testing::DoAll;
 using ::testing::_;
+using ::testing::Invoke;
 using ::curve::mds::topology::MockTopology;
 
 using ::curve::mds::topology::ChunkServer;
@@ -137,6 +139,40 @@ TEST(ChunkserverHealthyChecker, test_checkHeartBeat_interval) {
         ASSERT_EQ(OnlineState::ONLINE, info.state);
     }
 }
+
+TEST(ChunkserverHealthyChecker, test_heartbeat_not_blocked_by_check) {
+    HeartbeatOption option;
+    option.heartbeatIntervalMs = 1000;
+    option.heartbeatMissTimeOutMs = 3000;
+    option.offLineTimeOutMs = 5000;
+    std::shared_ptr<MockTopology> topology = std::make_shared<MockTopology>();
+    std::shared_ptr<ChunkserverHealthyChecker> checker =
+        std::make_shared<ChunkserverHealthyChecker>(option, topology);
+
+    ChunkserverHealthyChecker *rawChecker = checker.get();
+    checker->UpdateLastReceivedHeartbeatTime(1, steady_clock::now());
+    // 更新topology期间收到已有和新的chunkserver的心跳，不会被阻塞
+    EXPECT_CALL(*topology, UpdateChunkServerOnlineState(OnlineState::ONLINE, 1))
+        .WillOnce(Invoke([rawChecker](const OnlineState &,
+                                      ChunkServerIdType) {
+            std::thread t([rawChecker] {
+                rawChecker->UpdateLastReceivedHeartbeatTime(
+                    1, steady_clock::now());
+                rawChecker->UpdateLastReceivedHeartbeatTime(
+                    2, steady_clock::now());
+            });
+            t.join();
+            return kTopoErrCodeSuccess;
+        }));
+    checker->CheckHeartBeatInterval();
+
+    HeartbeatInfo info;
+    ASSERT_TRUE(checker->GetHeartBeatInfo(1, &info));
+    ASSERT_EQ(OnlineState::ONLINE, info.state);
+    ASSERT_TRUE(checker->GetHeartBeatInfo(2, &info));
+    ASSERT_EQ(OnlineState::UNSTABLE, info.state);
+}
+
 }  // namespace heartbeat
 }  // namespace mds
 }  // namespace curve
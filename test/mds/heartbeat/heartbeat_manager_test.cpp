@@ -915,8 +915,40 @@ TEST_F(TestHeartbeatManager, test_patrol_copySetInfo_return_order) {
     ASSERT_EQ(TRANSFER_LEADER, response.needupdatecopysets(0).type());
     ASSERT_EQ(3, response.needupdatecopysets(0).peers_size());
 }
+TEST_F(TestHeartbeatManager, test_chunkserver_qos_conf) {
+    auto request = GetChunkServerHeartbeatRequestForTest();
+    request.clear_copysetinfos();
+    ::curve::mds::topology::ChunkServer chunkServer(
+        1, "hello", "", 1, "192.168.10.1", 9000, "",
+        ::curve::mds::topology::ChunkServerStatus::READWRITE);
+
+    // 1. 未开启qos，心跳回复中不下发qos配置
+    ChunkServerHeartbeatResponse response;
+    EXPECT_CALL(*topology_, GetChunkServer(_, _))
+        .WillOnce(DoAll(SetArgPointee<1>(chunkServer), Return(true)));
+    heartbeatManager_->ChunkServerHeartbeat(request, &response);
+    ASSERT_FALSE(response.has_qosconf());
+
+    // 2. 开启qos，心跳回复中携带qos配置
+    HeartbeatOption option;
+    option.heartbeatMissTimeOutMs = 10000;
+    option.offLineTimeOutMs = 30000;
+    option.mdsStartTime = steady_clock::now();
+    option.enableChunkServerQos = true;
+    option.copysetQosIops = 100;
+    option.clientQosBps = 4 * 1024 * 1024;
+    auto manager = std::make_shared<HeartbeatManager>(
+        option, topology_, topologyStat_, coordinator_);
+    response.Clear();
+    EXPECT_CALL(*topology_, GetChunkServer(_, _))
+        .WillOnce(DoAll(SetArgPointee<1>(chunkServer), Return(true)));
+    manager->ChunkServerHeartbeat(request, &response);
+    ASSERT_TRUE(response.has_qosconf());
+    ASSERT_EQ(0, response.qosconf().chunkserveriops());
+    ASSERT_EQ(100, response.qosconf().copysetiops());
+    ASSERT_EQ(4 * 1024 * 1024, response.qosconf().clientbps());
+}
+
 }  // namespace heartbeat
 }  // namespace mds
 }  // namespace curve
-
-
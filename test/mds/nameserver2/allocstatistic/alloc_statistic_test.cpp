@@ -224,5 +224,32 @@ TEST_F(AllocStatisticTest, test_PeriodicPersist_CalculateSegmentAlloc) {
     allocStatistic_->Stop();
 }
 
+TEST_F(AllocStatisticTest, test_FileAlloc) {
+    std::map<PoolIdType, int64_t> alloc;
+    // 1. 未加载的文件查询失败，更新被忽略
+    ASSERT_FALSE(allocStatistic_->GetAllocByFile(1, &alloc));
+    allocStatistic_->UpdateFileAlloc(1, 1, 1024);
+    ASSERT_FALSE(allocStatistic_->GetAllocByFile(1, &alloc));
+
+    // 2. 加载之后增量更新
+    allocStatistic_->SetFileAlloc(1, {{1, 1024}});
+    allocStatistic_->UpdateFileAlloc(1, 1, 1024);
+    allocStatistic_->UpdateFileAlloc(1, 2, 2048);
+    ASSERT_TRUE(allocStatistic_->GetAllocByFile(1, &alloc));
+    ASSERT_EQ(2, alloc.size());
+    ASSERT_EQ(2048, alloc[1]);
+    ASSERT_EQ(2048, alloc[2]);
+
+    // 3. 逻辑池上的空间全部释放后不再返回该逻辑池
+    allocStatistic_->UpdateFileAlloc(1, 2, -2048);
+    ASSERT_TRUE(allocStatistic_->GetAllocByFile(1, &alloc));
+    ASSERT_EQ(1, alloc.size());
+    ASSERT_EQ(2048, alloc[1]);
+
+    // 4. 删除之后需要重新加载
+    allocStatistic_->RemoveFileAlloc(1);
+    ASSERT_FALSE(allocStatistic_->GetAllocByFile(1, &alloc));
+}
+
 }  // namespace mds
 }  // namespace curve
@@ -43,6 +43,7 @@ using ::testing::Return;
 using ::testing::ReturnArg;
 using ::testing::DoAll;
 using ::testing::SetArgPointee;
+using ::testing::SaveArg;
 using curve::common::Authenticator;
 
 using curve::common::TimeUtility;
@@ -275,6 +276,91 @@ TEST_F(CurveFSTest, testGetFileInfo) {
     }
 }
 
+TEST_F(CurveFSTest, testWalkPathWithDentryCache) {
+    // 打开dentry缓存重新初始化
+    curvefs_->Uninit();
+    curveFSOptions_.dentryCacheSize = 100;
+    FileInfo recycleBinInfo;
+    recycleBinInfo.set_parentid(ROOTINODEID);
+    recycleBinInfo.set_id(RECYCLEBININODEID);
+    recycleBinInfo.set_filename(RECYCLEBINDIRNAME);
+    recycleBinInfo.set_filetype(FileType::INODE_DIRECTORY);
+    recycleBinInfo.set_owner(authOptions_.rootOwner);
+    EXPECT_CALL(*storage_, GetFile(_, _, _))
+        .WillOnce(DoAll(SetArgPointee<2>(recycleBinInfo),
+            Return(StoreStatus::OK)));
+    ASSERT_TRUE(curvefs_->Init(storage_, inodeIdGenerator_,
+                               mockChunkAllocator_, mockcleanManager_,
+                               fileRecordManager_, allocStatistic_,
+                               curveFSOptions_, topology_));
+    curvefs_->Run();
+
+    FileInfo dir1;
+    dir1.set_id(1);
+    dir1.set_parentid(ROOTINODEID);
+    dir1.set_filename("dir1");
+    dir1.set_filetype(FileType::INODE_DIRECTORY);
+    FileInfo dir2;
+    dir2.set_id(2);
+    dir2.set_parentid(1);
+    dir2.set_filename("dir2");
+    dir2.set_filetype(FileType::INODE_DIRECTORY);
+    FileInfo dir3;
+    dir3.set_id(3);
+    dir3.set_parentid(2);
+    dir3.set_filename("dir3");
+    dir3.set_filetype(FileType::INODE_DIRECTORY);
+    FileInfo file1;
+    file1.set_id(4);
+    file1.set_parentid(2);
+    file1.set_filename("file1");
+    file1.set_filetype(FileType::INODE_PAGEFILE);
+
+    // 中间目录在缓存失效前后各查询一次
+    EXPECT_CALL(*storage_, GetFile(ROOTINODEID, "dir1", _))
+        .Times(2)
+        .WillRepeatedly(DoAll(SetArgPointee<2>(dir1),
+            Return(StoreStatus::OK)));
+    EXPECT_CALL(*storage_, GetFile(1, "dir2", _))
+        .Times(2)
+        .WillRepeatedly(DoAll(SetArgPointee<2>(dir2),
+            Return(StoreStatus::OK)));
+    EXPECT_CALL(*storage_, GetFile(1, "file3", _))
+        .Times(1)
+        .WillOnce(Return(StoreStatus::KeyNotExist));
+    EXPECT_CALL(*storage_, GetFile(2, "dir3", _))
+        .Times(1)
+        .WillOnce(DoAll(SetArgPointee<2>(dir3),
+            Return(StoreStatus::OK)));
+    // 路径的最后一级不缓存
+    EXPECT_CALL(*storage_, GetFile(2, "file1", _))
+        .Times(3)
+        .WillRepeatedly(DoAll(SetArgPointee<2>(file1),
+            Return(StoreStatus::OK)));
+
+    FileInfo fileInfo;
+    ASSERT_EQ(StatusCode::kOK,
+              curvefs_->GetFileInfo("/dir1/dir2/file1", &fileInfo));
+    ASSERT_EQ(4, fileInfo.id());
+    ASSERT_EQ(StatusCode::kOK,
+              curvefs_->GetFileInfo("/dir1/dir2/file1", &fileInfo));
+    ASSERT_EQ(4, fileInfo.id());
+    ASSERT_EQ(StatusCode::kFileNotExists,
+              curvefs_->GetFileInfo("/dir1/file3", &fileInfo));
+
+    // 删除目录之后缓存失效
+    EXPECT_CALL(*storage_, ListFile(3, 4, _))
+        .WillOnce(Return(StoreStatus::KeyNotExist));
+    EXPECT_CALL(*storage_, DeleteFile(2, "dir3"))
+        .WillOnce(Return(StoreStatus::OK));
+    ASSERT_EQ(StatusCode::kOK,
+              curvefs_->DeleteFile("/dir1/dir2/dir3", kUnitializedFileID,
+                                   false));
+    ASSERT_EQ(StatusCode::kOK,
+              curvefs_->GetFileInfo("/dir1/dir2/file1", &fileInfo));
+    ASSERT_EQ(4, fileInfo.id());
+}
+
 TEST_F(CurveFSTest, testDeleteFile) {
     // test remove root
     ASSERT_EQ(curvefs_->DeleteFile("/", kUnitializedFileID, false),
@@ -586,10 +672,11 @@ TEST_F(CurveFSTest, testGetAllocatedSize) {
     fileInfo.set_id(0);
     fileInfo.set_filetype(FileType::INODE_PAGEFILE);
     fileInfo.set_segmentsize(segmentSize);
+    // 两个segment在逻辑池1，一个segment在逻辑池2
     std::vector<PageFileSegment> segments;
     for (int i = 0; i < 3; ++i) {
         PageFileSegment segment;
-        segment.set_logicalpoolid(1);
+        segment.set_logicalpoolid(i == 0 ? 2 : 1);
         segment.set_segmentsize(segmentSize);
         segment.set_chunksize(curvefs_->GetDefaultChunkSize());
         segment.set_startoffset(i);
@@ -615,23 +702,41 @@ TEST_F(CurveFSTest, testGetAllocatedSize) {
         .Times(1)
         .WillOnce(DoAll(SetArgPointee<1>(segments),
             Return(StoreStatus::OK)));
-        EXPECT_CALL(*topology_, GetLogicalPool(_, _)).Times(3)
-        .WillOnce(
-            DoAll(SetArgPointee<1>(lgPool1), Return(true)))
-        .WillRepeatedly(
-            DoAll(SetArgPointee<1>(lgPool2), Return(true)));
+        EXPECT_CALL(*topology_, GetLogicalPool(1, _)).Times(1)
+        .WillOnce(DoAll(SetArgPointee<1>(lgPool1), Return(true)));
+        EXPECT_CALL(*topology_, GetLogicalPool(2, _)).Times(1)
+        .WillOnce(DoAll(SetArgPointee<1>(lgPool2), Return(true)));
+        ASSERT_EQ(StatusCode::kOK,
+                    curvefs_->GetAllocatedSize("/tests", &allocSize));
+        ASSERT_EQ(3 * segmentSize, allocSize.allocatedSize);
+        ASSERT_EQ(11 * segmentSize, allocSize.physicalAllocatedSize);
+    }
+    // test page file again, 使用缓存的统计值，不再list segment
+    {
+        EXPECT_CALL(*storage_, GetFile(_, _, _))
+        .Times(1)
+        .WillOnce(DoAll(SetArgPointee<2>(fileInfo),
+            Return(StoreStatus::OK)));
+        EXPECT_CALL(*storage_, ListSegment(_, _))
+        .Times(0);
+        EXPECT_CALL(*topology_, GetLogicalPool(1, _)).Times(1)
+        .WillOnce(DoAll(SetArgPointee<1>(lgPool1), Return(true)));
+        EXPECT_CALL(*topology_, GetLogicalPool(2, _)).Times(1)
+        .WillOnce(DoAll(SetArgPointee<1>(lgPool2), Return(true)));
         ASSERT_EQ(StatusCode::kOK,
                     curvefs_->GetAllocatedSize("/tests", &allocSize));
         ASSERT_EQ(3 * segmentSize, allocSize.allocatedSize);
-        ASSERT_EQ(10 * segmentSize, allocSize.physicalAllocatedSize);
+        ASSERT_EQ(11 * segmentSize, allocSize.physicalAllocatedSize);
     }
     // test directory normal
     {
         FileInfo dirInfo;
         dirInfo.set_filetype(FileType::INODE_DIRECTORY);
         std::vector<FileInfo> files;
-        for (int i = 0; i < 3; ++i) {
-            files.emplace_back(fileInfo);
+        for (int i = 1; i <= 3; ++i) {
+            FileInfo file = fileInfo;
+            file.set_id(i);
+            files.emplace_back(file);
         }
         EXPECT_CALL(*storage_, GetFile(_, _, _))
         .Times(2)
@@ -645,14 +750,14 @@ TEST_F(CurveFSTest, testGetAllocatedSize) {
         .Times(3)
         .WillRepeatedly(DoAll(SetArgPointee<1>(segments),
             Return(StoreStatus::OK)));
-        EXPECT_CALL(*topology_, GetLogicalPool(_, _)).Times(9)
-        .WillOnce(DoAll(SetArgPointee<1>(lgPool1), Return(true)))
-        .WillRepeatedly(
-            DoAll(SetArgPointee<1>(lgPool2), Return(true)));
+        EXPECT_CALL(*topology_, GetLogicalPool(1, _)).Times(3)
+        .WillRepeatedly(DoAll(SetArgPointee<1>(lgPool1), Return(true)));
+        EXPECT_CALL(*topology_, GetLogicalPool(2, _)).Times(3)
+        .WillRepeatedly(DoAll(SetArgPointee<1>(lgPool2), Return(true)));
         ASSERT_EQ(StatusCode::kOK,
                     curvefs_->GetAllocatedSize("/tests", &allocSize));
         ASSERT_EQ(9 * segmentSize, allocSize.allocatedSize);
-        ASSERT_EQ(28 * segmentSize, allocSize.physicalAllocatedSize);
+        ASSERT_EQ(33 * segmentSize, allocSize.physicalAllocatedSize);
     }
     // test GetFile fail
     {
@@ -675,9 +780,11 @@ TEST_F(CurveFSTest, testGetAllocatedSize) {
     }
     // test list segment fail
     {
+        FileInfo newFileInfo = fileInfo;
+        newFileInfo.set_id(10);
         EXPECT_CALL(*storage_, GetFile(_, _, _))
         .Times(1)
-        .WillOnce(DoAll(SetArgPointee<2>(fileInfo),
+        .WillOnce(DoAll(SetArgPointee<2>(newFileInfo),
             Return(StoreStatus::OK)));
         EXPECT_CALL(*storage_, ListSegment(_, _))
         .Times(1)
@@ -706,9 +813,7 @@ TEST_F(CurveFSTest, testGetAllocatedSize) {
         .WillOnce(DoAll(SetArgPointee<2>(fileInfo),
             Return(StoreStatus::OK)));
         EXPECT_CALL(*storage_, ListSegment(_, _))
-        .Times(1)
-        .WillOnce(DoAll(SetArgPointee<1>(segments),
-            Return(StoreStatus::OK)));
+        .Times(0);
         EXPECT_CALL(*topology_, GetLogicalPool(_, _)).Times(1)
         .WillOnce(Return(false));
         ASSERT_EQ(StatusCode::KInternalError,
@@ -1271,6 +1376,88 @@ TEST_F(CurveFSTest, testExtendFile) {
     }
 }
 
+TEST_F(CurveFSTest, testUpdateFileThrottleParams) {
+    FileThrottleParams params;
+    params.set_iopstotal(1000);
+    params.set_bpstotal(1024);
+
+    // 设置限制
+    {
+        FileInfo fileInfo1;
+        fileInfo1.set_filetype(FileType::INODE_PAGEFILE);
+        EXPECT_CALL(*storage_, GetFile(_, _, _))
+        .Times(1)
+        .WillRepeatedly(DoAll(SetArgPointee<2>(fileInfo1),
+                        Return(StoreStatus::OK)));
+
+        FileInfo putInfo;
+        EXPECT_CALL(*storage_, PutFile(_))
+        .WillOnce(DoAll(SaveArg<0>(&putInfo), Return(StoreStatus::OK)));
+
+        ASSERT_EQ(StatusCode::kOK,
+                  curvefs_->UpdateFileThrottleParams("/file1", &params));
+        ASSERT_EQ(1000, putInfo.throttleparams().iopstotal());
+        ASSERT_EQ(1024, putInfo.throttleparams().bpstotal());
+    }
+
+    // 清除限制
+    {
+        FileInfo fileInfo1;
+        fileInfo1.set_filetype(FileType::INODE_PAGEFILE);
+        fileInfo1.mutable_throttleparams()->CopyFrom(params);
+        EXPECT_CALL(*storage_, GetFile(_, _, _))
+        .Times(1)
+        .WillRepeatedly(DoAll(SetArgPointee<2>(fileInfo1),
+                        Return(StoreStatus::OK)));
+
+        FileInfo putInfo;
+        EXPECT_CALL(*storage_, PutFile(_))
+        .WillOnce(DoAll(SaveArg<0>(&putInfo), Return(StoreStatus::OK)));
+
+        ASSERT_EQ(StatusCode::kOK,
+                  curvefs_->UpdateFileThrottleParams("/file1", nullptr));
+        ASSERT_FALSE(putInfo.has_throttleparams());
+    }
+
+    // 目录不支持设置限制
+    {
+        FileInfo dirInfo;
+        dirInfo.set_filetype(FileType::INODE_DIRECTORY);
+        EXPECT_CALL(*storage_, GetFile(_, _, _))
+        .Times(1)
+        .WillRepeatedly(DoAll(SetArgPointee<2>(dirInfo),
+                        Return(StoreStatus::OK)));
+
+        ASSERT_EQ(StatusCode::kNotSupported,
+                  curvefs_->UpdateFileThrottleParams("/dir1", &params));
+    }
+
+    // 文件不存在
+    {
+        EXPECT_CALL(*storage_, GetFile(_, _, _))
+        .Times(1)
+        .WillOnce(Return(StoreStatus::KeyNotExist));
+
+        ASSERT_EQ(StatusCode::kFileNotExists,
+                  curvefs_->UpdateFileThrottleParams("/file1", &params));
+    }
+
+    // 存储失败
+    {
+        FileInfo fileInfo1;
+        fileInfo1.set_filetype(FileType::INODE_PAGEFILE);
+        EXPECT_CALL(*storage_, GetFile(_, _, _))
+        .Times(1)
+        .WillRepeatedly(DoAll(SetArgPointee<2>(fileInfo1),
+                        Return(StoreStatus::OK)));
+        EXPECT_CALL(*storage_, PutFile(_))
+        .WillOnce(Return(StoreStatus::InternalError));
+
+        ASSERT_EQ(StatusCode::kStorageError,
+                  curvefs_->UpdateFileThrottleParams("/file1", &params));
+    }
+}
+
 TEST_F(CurveFSTest, testChangeOwner) {
     // test changeOwner ok
     {
@@ -2584,6 +2771,210 @@ TEST_F(CurveFSTest, testRefreshSession) {
     }
 }
 
+TEST_F(CurveFSTest, testRefreshSessionById) {
+    uint64_t date = TimeUtility::GetTimeofDayUs();
+
+    // owner为空或者date过期
+    {
+        ASSERT_EQ(curvefs_->CheckRefreshSessionOwner("", "", date),
+                  StatusCode::kOwnerAuthFail);
+        ASSERT_EQ(curvefs_->CheckRefreshSessionOwner("user1", "",
+                    date + 15 * 2000 * 2000),
+                  StatusCode::kOwnerAuthFail);
+        ASSERT_EQ(curvefs_->CheckRefreshSessionOwner("user1", "", date),
+                  StatusCode::kOK);
+    }
+
+    // root用户签名不匹配
+    {
+        ASSERT_EQ(curvefs_->CheckRefreshSessionOwner(authOptions_.rootOwner,
+                    "wrongpass", date),
+                  StatusCode::kOwnerAuthFail);
+    }
+
+    FileInfo storedInfo;
+    storedInfo.set_id(10);
+    storedInfo.set_parentid(1);
+    storedInfo.set_owner("user1");
+    storedInfo.set_filetype(FileType::INODE_PAGEFILE);
+
+    // 文件不存在
+    {
+        FileInfo fileInfo;
+        EXPECT_CALL(*storage_, GetFile(1, "file1", _))
+            .WillOnce(Return(StoreStatus::KeyNotExist));
+        ASSERT_EQ(curvefs_->RefreshSessionById(10, 1, "/file1", "user1",
+                    "127.0.0.1", 1234, "", &fileInfo),
+                  StatusCode::kFileNotExists);
+    }
+
+    // storage出错
+    {
+        FileInfo fileInfo;
+        EXPECT_CALL(*storage_, GetFile(1, "file1", _))
+            .WillOnce(Return(StoreStatus::InternalError));
+        ASSERT_EQ(curvefs_->RefreshSessionById(10, 1, "/file1", "user1",
+                    "127.0.0.1", 1234, "", &fileInfo),
+                  StatusCode::kStorageError);
+    }
+
+    // 文件被删除后重新创建，inode id不一致
+    {
+        FileInfo fileInfo;
+        EXPECT_CALL(*storage_, GetFile(1, "file1", _))
+            .WillOnce(DoAll(SetArgPointee<2>(storedInfo),
+                            Return(StoreStatus::OK)));
+        ASSERT_EQ(curvefs_->RefreshSessionById(11, 1, "/file1", "user1",
+                    "127.0.0.1", 1234, "", &fileInfo),
+                  StatusCode::kFileNotExists);
+    }
+
+    // owner不一致
+    {
+        FileInfo fileInfo;
+        EXPECT_CALL(*storage_, GetFile(1, "file1", _))
+            .WillOnce(DoAll(SetArgPointee<2>(storedInfo),
+                            Return(StoreStatus::OK)));
+        ASSERT_EQ(curvefs_->RefreshSessionById(10, 1, "/file1", "user2",
+                    "127.0.0.1", 1234, "", &fileInfo),
+                  StatusCode::kOwnerAuthFail);
+    }
+
+    // 执行成功，root用户可以续约其他用户的文件
+    {
+        FileInfo fileInfo;
+        EXPECT_CALL(*storage_, GetFile(1, "file1", _))
+            .Times(2)
+            .WillRepeatedly(DoAll(SetArgPointee<2>(storedInfo),
+                                  Return(StoreStatus::OK)));
+        ASSERT_EQ(curvefs_->RefreshSessionById(10, 1, "/file1", "user1",
+                    "127.0.0.1", 1234, "", &fileInfo),
+                  StatusCode::kOK);
+        ASSERT_EQ(10, fileInfo.id());
+        ASSERT_EQ(curvefs_->RefreshSessionById(10, 1, "/file1",
+                    authOptions_.rootOwner, "127.0.0.1", 1234, "", &fileInfo),
+                  StatusCode::kOK);
+    }
+}
+
+TEST_F(CurveFSTest, testFileToken) {
+    std::string token = curvefs_->GetFileToken(1, 2, "/dir/file1", "owner1");
+    ASSERT_FALSE(token.empty());
+    ASSERT_EQ(StatusCode::kOK,
+              curvefs_->CheckFileToken(1, 2, "/dir/file1", "owner1", token));
+    // 文件、父目录、路径或owner不一致时校验失败
+    ASSERT_EQ(StatusCode::kOwnerAuthFail,
+              curvefs_->CheckFileToken(3, 2, "/dir/file1", "owner1", token));
+    ASSERT_EQ(StatusCode::kOwnerAuthFail,
+              curvefs_->CheckFileToken(1, 3, "/dir/file1", "owner1", token));
+    ASSERT_EQ(StatusCode::kOwnerAuthFail,
+              curvefs_->CheckFileToken(1, 2, "/dir2/file1", "owner1", token));
+    ASSERT_EQ(StatusCode::kOwnerAuthFail,
+              curvefs_->CheckFileToken(1, 2, "/dir/file1", "owner2", token));
+    // token为空或格式错误
+    ASSERT_EQ(StatusCode::kOwnerAuthFail,
+              curvefs_->CheckFileToken(1, 2, "/dir/file1", "owner1", ""));
+    ASSERT_EQ(StatusCode::kOwnerAuthFail,
+              curvefs_->CheckFileToken(1, 2, "/dir/file1", "owner1",
+                                       "invalid"));
+    // root签名不能作为token使用
+    std::string rootSig = Authenticator::CalcString2Signature(
+        "1:owner1", authOptions_.rootPassword);
+    ASSERT_EQ(StatusCode::kOwnerAuthFail,
+              curvefs_->CheckFileToken(1, 2, "/dir/file1", "owner1",
+                                       rootSig));
+
+    // 修改token中的过期时间，签名校验失败
+    size_t pos = token.find(':');
+    ASSERT_NE(std::string::npos, pos);
+    uint64_t expiredTime = std::stoull(token.substr(0, pos));
+    std::string extended = std::to_string(expiredTime + 3600)
+                           + token.substr(pos);
+    ASSERT_EQ(StatusCode::kOwnerAuthFail,
+              curvefs_->CheckFileToken(1, 2, "/dir/file1", "owner1",
+                                       extended));
+
+    // 签名正确但已过期的token校验失败
+    uint64_t pastTime = TimeUtility::GetTimeofDaySec() - 1;
+    std::string key = Authenticator::CalcString2Signature(
+        "curve_file_token_key", authOptions_.rootPassword);
+    std::string expired = std::to_string(pastTime) + ":"
+        + Authenticator::CalcString2Signature("file_token:1:2:"
+            + std::to_string(pastTime) + ":owner1:/dir/file1", key);
+    ASSERT_EQ(StatusCode::kOwnerAuthFail,
+              curvefs_->CheckFileToken(1, 2, "/dir/file1", "owner1",
+                                       expired));
+}
+
+TEST_F(CurveFSTest, testGetOrAllocateSegmentById) {
+    FileInfo fileInfo;
+    fileInfo.set_id(10);
+    fileInfo.set_parentid(5);
+    fileInfo.set_filename("file1");
+    fileInfo.set_owner("owner1");
+    fileInfo.set_filetype(FileType::INODE_PAGEFILE);
+    fileInfo.set_length(kMiniFileLength);
+    fileInfo.set_segmentsize(DefaultSegmentSize);
+
+    // 1. 不遍历路径，直接通过parentId和文件名获取文件
+    {
+        PageFileSegment segment;
+        EXPECT_CALL(*storage_, GetFile(5, "file1", _))
+        .WillOnce(DoAll(SetArgPointee<2>(fileInfo),
+                        Return(StoreStatus::OK)));
+        EXPECT_CALL(*storage_, GetSegment(10, 0, _))
+        .WillOnce(Return(StoreStatus::OK));
+        ASSERT_EQ(StatusCode::kOK, curvefs_->GetOrAllocateSegmentById(
+            10, 5, "/dir1/file1", "owner1", 0, false, &segment));
+    }
+    // 2. 同名文件被重新创建，inode id不一致
+    {
+        PageFileSegment segment;
+        FileInfo newFileInfo = fileInfo;
+        newFileInfo.set_id(11);
+        EXPECT_CALL(*storage_, GetFile(5, "file1", _))
+        .WillOnce(DoAll(SetArgPointee<2>(newFileInfo),
+                        Return(StoreStatus::OK)));
+        ASSERT_EQ(StatusCode::kFileNotExists,
+            curvefs_->GetOrAllocateSegmentById(
+                10, 5, "/dir1/file1", "owner1", 0, false, &segment));
+    }
+    // 3. owner不一致
+    {
+        PageFileSegment segment;
+        EXPECT_CALL(*storage_, GetFile(5, "file1", _))
+        .WillOnce(DoAll(SetArgPointee<2>(fileInfo),
+                        Return(StoreStatus::OK)));
+        ASSERT_EQ(StatusCode::kOwnerAuthFail,
+            curvefs_->GetOrAllocateSegmentById(
+                10, 5, "/dir1/file1", "owner2", 0, false, &segment));
+    }
+    // 4. storage出错
+    {
+        PageFileSegment segment;
+        EXPECT_CALL(*storage_, GetFile(5, "file1", _))
+        .WillOnce(Return(StoreStatus::InternalError));
+        ASSERT_EQ(StatusCode::kStorageError,
+            curvefs_->GetOrAllocateSegmentById(
+                10, 5, "/dir1/file1", "owner1", 0, false, &segment));
+    }
+    // 5. 分配segment
+    {
+        PageFileSegment segment;
+        EXPECT_CALL(*storage_, GetFile(5, "file1", _))
+        .WillOnce(DoAll(SetArgPointee<2>(fileInfo),
+                        Return(StoreStatus::OK)));
+        EXPECT_CALL(*storage_, GetSegment(10, 0, _))
+        .WillOnce(Return(StoreStatus::KeyNotExist));
+        EXPECT_CALL(*mockChunkAllocator_, AllocateChunkSegment(_, _, _, _, _))
+        .WillOnce(Return(true));
+        EXPECT_CALL(*storage_, PutSegment(10, 0, _, _))
+        .WillOnce(Return(StoreStatus::OK));
+        ASSERT_EQ(StatusCode::kOK, curvefs_->GetOrAllocateSegmentById(
+            10, 5, "/dir1/file1", "root", 0, true, &segment));
+    }
+}
+
 TEST_F(CurveFSTest, testCheckRenameNewfilePathOwner) {
     uint64_t date = TimeUtility::GetTimeofDayUs();
 
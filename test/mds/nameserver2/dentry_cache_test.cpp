@@ -0,0 +1,111 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include <gtest/gtest.h>
+#include "src/mds/nameserver2/dentry_cache.h"
+
+namespace curve {
+namespace mds {
+
+static FileInfo MakeDir(uint64_t id, uint64_t parentId,
+                        const std::string &name) {
+    FileInfo info;
+    info.set_id(id);
+    info.set_parentid(parentId);
+    info.set_filename(name);
+    info.set_filetype(FileType::INODE_DIRECTORY);
+    return info;
+}
+
+TEST(DentryCacheTest, test_disabled) {
+    DentryCache cache;
+    FileInfo info;
+    uint64_t generation = cache.GetGeneration();
+    cache.PutDentry(0, "dir1", MakeDir(1, 0, "dir1"), generation);
+    cache.PutPath("/dir1", MakeDir(1, 0, "dir1"), generation);
+    ASSERT_FALSE(cache.GetDentry(0, "dir1", &info));
+    ASSERT_FALSE(cache.GetPath("/dir1", &info));
+}
+
+TEST(DentryCacheTest, test_put_get) {
+    DentryCache cache(100);
+    FileInfo info;
+    uint64_t generation = cache.GetGeneration();
+
+    // 只缓存目录
+    FileInfo file = MakeDir(2, 0, "file1");
+    file.set_filetype(FileType::INODE_PAGEFILE);
+    cache.PutDentry(0, "file1", file, generation);
+    ASSERT_FALSE(cache.GetDentry(0, "file1", &info));
+
+    cache.PutDentry(0, "dir1", MakeDir(1, 0, "dir1"), generation);
+    cache.PutPath("/dir1", MakeDir(1, 0, "dir1"), generation);
+    ASSERT_TRUE(cache.GetDentry(0, "dir1", &info));
+    ASSERT_EQ(1, info.id());
+    ASSERT_TRUE(cache.GetPath("/dir1", &info));
+    ASSERT_EQ(1, info.id());
+    ASSERT_FALSE(cache.GetDentry(1, "dir1", &info));
+    ASSERT_FALSE(cache.GetPath("/dir2", &info));
+}
+
+TEST(DentryCacheTest, test_invalidate) {
+    DentryCache cache(100);
+    FileInfo info;
+    uint64_t generation = cache.GetGeneration();
+    cache.PutDentry(0, "dir1", MakeDir(1, 0, "dir1"), generation);
+    cache.PutPath("/dir1", MakeDir(1, 0, "dir1"), generation);
+
+    // 失效之后缓存被清空
+    cache.Invalidate();
+    ASSERT_FALSE(cache.GetDentry(0, "dir1", &info));
+    ASSERT_FALSE(cache.GetPath("/dir1", &info));
+
+    // 失效之前开始的解析结果不再写入缓存
+    cache.PutDentry(0, "dir1", MakeDir(1, 0, "dir1"), generation);
+    cache.PutPath("/dir1", MakeDir(1, 0, "dir1"), generation);
+    ASSERT_FALSE(cache.GetDentry(0, "dir1", &info));
+    ASSERT_FALSE(cache.GetPath("/dir1", &info));
+
+    generation = cache.GetGeneration();
+    cache.PutDentry(0, "dir1", MakeDir(1, 0, "dir1"), generation);
+    ASSERT_TRUE(cache.GetDentry(0, "dir1", &info));
+}
+
+TEST(DentryCacheTest, test_max_count) {
+    DentryCache cache(2);
+    FileInfo info;
+    uint64_t generation = cache.GetGeneration();
+    cache.PutDentry(0, "dir1", MakeDir(1, 0, "dir1"), generation);
+    cache.PutPath("/dir1", MakeDir(1, 0, "dir1"), generation);
+    ASSERT_TRUE(cache.GetDentry(0, "dir1", &info));
+
+    // 超过上限时清空已有的缓存项
+    cache.PutDentry(0, "dir2", MakeDir(2, 0, "dir2"), generation);
+    ASSERT_FALSE(cache.GetDentry(0, "dir1", &info));
+    ASSERT_FALSE(cache.GetPath("/dir1", &info));
+    ASSERT_TRUE(cache.GetDentry(0, "dir2", &info));
+    ASSERT_EQ(2, info.id());
+}
+
+}  // namespace mds
+}  // namespace curve
@@ -24,6 +24,9 @@
 #include <gtest/gtest.h>
 #include <brpc/channel.h>
 #include <brpc/server.h>
+#include <string>
+#include <tuple>
+#include <vector>
 #include "src/mds/nameserver2/namespace_service.h"
 #include "src/mds/nameserver2/curvefs.h"
 #include "src/mds/nameserver2/chunk_allocator.h"
@@ -533,6 +536,69 @@ TEST_F(NameSpaceServiceTest, test1) {
         ASSERT_EQ(DefaultSegmentSize * 3, response.physicalallocatedsize());
     }
 
+    // test update file throttle params
+    {
+        cntl.Reset();
+        UpdateFileThrottleParamsRequest request;
+        UpdateFileThrottleParamsResponse response;
+        uint64_t date = TimeUtility::GetTimeofDayUs();
+        std::string str2sig = Authenticator::GetString2Signature(date,
+                                                    authOptions.rootOwner);
+        std::string sig = Authenticator::CalcString2Signature(str2sig,
+                                                    authOptions.rootPassword);
+        request.set_filename("/file1");
+        request.mutable_throttleparams()->set_iopstotal(1000);
+        request.mutable_throttleparams()->set_bpstotal(100 * 1024 * 1024);
+        request.set_rootowner(authOptions.rootOwner);
+        request.set_signature(sig);
+        request.set_date(date);
+        stub.UpdateFileThrottleParams(&cntl, &request, &response, NULL);
+        ASSERT_FALSE(cntl.Failed());
+        ASSERT_EQ(StatusCode::kOK, response.statuscode());
+
+        cntl.Reset();
+        GetFileInfoRequest getRequest;
+        GetFileInfoResponse getResponse;
+        getRequest.set_filename("/file1");
+        getRequest.set_owner("owner1");
+        getRequest.set_date(TimeUtility::GetTimeofDayUs());
+        stub.GetFileInfo(&cntl, &getRequest, &getResponse, NULL);
+        ASSERT_FALSE(cntl.Failed());
+        ASSERT_EQ(StatusCode::kOK, getResponse.statuscode());
+        ASSERT_TRUE(getResponse.fileinfo().has_throttleparams());
+        ASSERT_EQ(1000, getResponse.fileinfo().throttleparams().iopstotal());
+        ASSERT_EQ(100 * 1024 * 1024,
+                  getResponse.fileinfo().throttleparams().bpstotal());
+
+        // 不设置throttleParams时清除限制
+        cntl.Reset();
+        request.clear_throttleparams();
+        stub.UpdateFileThrottleParams(&cntl, &request, &response, NULL);
+        ASSERT_FALSE(cntl.Failed());
+        ASSERT_EQ(StatusCode::kOK, response.statuscode());
+
+        cntl.Reset();
+        stub.GetFileInfo(&cntl, &getRequest, &getResponse, NULL);
+        ASSERT_FALSE(cntl.Failed());
+        ASSERT_EQ(StatusCode::kOK, getResponse.statuscode());
+        ASSERT_FALSE(getResponse.fileinfo().has_throttleparams());
+
+        // 目录不支持设置限制
+        cntl.Reset();
+        request.set_filename("/dir");
+        stub.UpdateFileThrottleParams(&cntl, &request, &response, NULL);
+        ASSERT_FALSE(cntl.Failed());
+        ASSERT_EQ(StatusCode::kNotSupported, response.statuscode());
+
+        // 非root用户不能设置
+        cntl.Reset();
+        request.set_filename("/file1");
+        request.set_rootowner("owner1");
+        stub.UpdateFileThrottleParams(&cntl, &request, &response, NULL);
+        ASSERT_FALSE(cntl.Failed());
+        ASSERT_EQ(StatusCode::kOwnerAuthFail, response.statuscode());
+    }
+
     // test change owner
     {
         // 当前有文件 /file1(owner1) , /file2(owner2), /dir/file3(owner3)
@@ -896,6 +962,62 @@ TEST_F(NameSpaceServiceTest, test1) {
         ASSERT_TRUE(false);
     }
 
+    // 使用打开文件时返回的token，通过inode id获取segment
+    {
+        ASSERT_TRUE(response10.has_filetoken());
+        cntl.Reset();
+        GetOrAllocateSegmentRequest request;
+        GetOrAllocateSegmentResponse response;
+        request.set_filename("/file1");
+        request.set_owner("owner1");
+        request.set_date(TimeUtility::GetTimeofDayUs());
+        request.set_offset(DefaultSegmentSize);
+        request.set_allocateifnotexist(true);
+        request.set_fileid(response10.fileinfo().id());
+        request.set_parentid(response10.fileinfo().parentid());
+        request.set_filetoken(response10.filetoken());
+        stub.GetOrAllocateSegment(&cntl, &request, &response, NULL);
+        ASSERT_FALSE(cntl.Failed());
+        ASSERT_EQ(StatusCode::kOK, response.statuscode());
+        ASSERT_EQ(DefaultSegmentSize,
+                  response.pagefilesegment().startoffset());
+
+        // token与文件名不匹配，不能用其他文件的token访问
+        cntl.Reset();
+        request.set_filename("/file2");
+        stub.GetOrAllocateSegment(&cntl, &request, &response, NULL);
+        ASSERT_FALSE(cntl.Failed());
+        ASSERT_EQ(StatusCode::kOwnerAuthFail, response.statuscode());
+
+        // token与owner不匹配
+        cntl.Reset();
+        request.set_filename("/file1");
+        request.set_owner("owner2");
+        stub.GetOrAllocateSegment(&cntl, &request, &response, NULL);
+        ASSERT_FALSE(cntl.Failed());
+        ASSERT_EQ(StatusCode::kOwnerAuthFail, response.statuscode());
+
+        // 续约时返回新的token
+        cntl.Reset();
+        ReFreshSessionRequest refreshRequest;
+        ReFreshSessionResponse refreshResponse;
+        refreshRequest.set_filename("/file1");
+        refreshRequest.set_owner("owner1");
+        refreshRequest.set_sessionid(response10.protosession().sessionid());
+        refreshRequest.set_date(TimeUtility::GetTimeofDayUs());
+        stub.RefreshSession(&cntl, &refreshRequest, &refreshResponse, NULL);
+        ASSERT_FALSE(cntl.Failed());
+        ASSERT_EQ(StatusCode::kOK, refreshResponse.statuscode());
+        ASSERT_TRUE(refreshResponse.has_filetoken());
+
+        cntl.Reset();
+        request.set_owner("owner1");
+        request.set_filetoken(refreshResponse.filetoken());
+        stub.GetOrAllocateSegment(&cntl, &request, &response, NULL);
+        ASSERT_FALSE(cntl.Failed());
+        ASSERT_EQ(StatusCode::kOK, response.statuscode());
+    }
+
     // openFile case3, 文件名不符合规范
     OpenFileRequest request11;
     OpenFileResponse response11;
@@ -1922,6 +2044,154 @@ TEST_F(NameSpaceServiceTest, listAllClientTest) {
     server.Join();
 }
 
+TEST_F(NameSpaceServiceTest, BatchRefreshSessionTest) {
+    brpc::Server server;
+
+    // start server
+    NameSpaceService namespaceService(new FileLockManager(8));
+    ASSERT_EQ(
+        server.AddService(&namespaceService, brpc::SERVER_DOESNT_OWN_SERVICE),
+        0);
+
+    brpc::ServerOptions option;
+    option.idle_timeout_sec = -1;
+    ASSERT_EQ(0, server.Start("127.0.0.1", {8900, 8999}, &option));
+
+    // init client
+    brpc::Channel channel;
+    ASSERT_EQ(channel.Init(server.listen_address(), nullptr), 0);
+
+    CurveFSService_Stub stub(&channel);
+    brpc::Controller cntl;
+
+    // 创建/a/vol(owner1)和/b/vol(owner2)
+    std::vector<std::tuple<std::string, std::string, FileType>> files = {
+        std::make_tuple("/a", "owner1", INODE_DIRECTORY),
+        std::make_tuple("/a/vol", "owner1", INODE_PAGEFILE),
+        std::make_tuple("/b", "owner2", INODE_DIRECTORY),
+        std::make_tuple("/b/vol", "owner2", INODE_PAGEFILE),
+    };
+    for (const auto& file : files) {
+        CreateFileRequest request;
+        CreateFileResponse response;
+        cntl.Reset();
+        request.set_filename(std::get<0>(file));
+        request.set_owner(std::get<1>(file));
+        request.set_date(TimeUtility::GetTimeofDayUs());
+        request.set_filetype(std::get<2>(file));
+        request.set_filelength(
+            std::get<2>(file) == INODE_PAGEFILE ? kMiniFileLength : 0);
+        stub.CreateFile(&cntl, &request, &response, NULL);
+        ASSERT_FALSE(cntl.Failed());
+        ASSERT_EQ(StatusCode::kOK, response.statuscode());
+    }
+
+    // owner1打开/a/vol
+    OpenFileRequest openRequest;
+    OpenFileResponse openResponse;
+    cntl.Reset();
+    openRequest.set_filename("/a/vol");
+    openRequest.set_owner("owner1");
+    openRequest.set_date(TimeUtility::GetTimeofDayUs());
+    stub.OpenFile(&cntl, &openRequest, &openResponse, NULL);
+    ASSERT_FALSE(cntl.Failed());
+    ASSERT_EQ(StatusCode::kOK, openResponse.statuscode());
+    ASSERT_TRUE(openResponse.has_filetoken());
+    const FileInfo& volInfo = openResponse.fileinfo();
+    std::string sessionId = openResponse.protosession().sessionid();
+
+    BatchRefreshSessionRequest request;
+    BatchRefreshSessionResponse response;
+    request.set_owner("owner1");
+    request.set_date(TimeUtility::GetTimeofDayUs());
+
+    // 1、token有效，通过parentId续约并返回新的token
+    RefreshSessionItem* item = request.add_items();
+    item->set_filename("/a/vol");
+    item->set_fileid(volInfo.id());
+    item->set_parentid(volInfo.parentid());
+    item->set_sessionid(sessionId);
+    item->set_filetoken(openResponse.filetoken());
+    // 2、没有token，遍历路径续约
+    item = request.add_items();
+    item->set_filename("/a/vol");
+    item->set_fileid(volInfo.id());
+    item->set_parentid(volInfo.parentid());
+    item->set_sessionid(sessionId);
+    // 3、用/a的id和/a/vol的token续约其他用户的/b/vol，
+    //    token校验失败后遍历路径，owner校验失败
+    item = request.add_items();
+    item->set_filename("/b/vol");
+    item->set_fileid(volInfo.id());
+    item->set_parentid(volInfo.parentid());
+    item->set_sessionid(sessionId);
+    item->set_filetoken(openResponse.filetoken());
+    // 4、没有token时文件id不一致，认为文件已经被重新创建
+    item = request.add_items();
+    item->set_filename("/a/vol");
+    item->set_fileid(volInfo.id() + 100);
+    item->set_parentid(volInfo.parentid());
+    item->set_sessionid(sessionId);
+    // 5、文件名不符合规范
+    item = request.add_items();
+    item->set_filename("/a/vol/");
+    item->set_fileid(volInfo.id());
+    item->set_parentid(volInfo.parentid());
+    item->set_sessionid(sessionId);
+
+    cntl.Reset();
+    stub.BatchRefreshSession(&cntl, &request, &response, NULL);
+    ASSERT_FALSE(cntl.Failed());
+    ASSERT_EQ(StatusCode::kOK, response.statuscode());
+    ASSERT_EQ(5, response.results_size());
+
+    ASSERT_EQ(StatusCode::kOK, response.results(0).statuscode());
+    ASSERT_EQ(sessionId, response.results(0).sessionid());
+    ASSERT_EQ(volInfo.id(), response.results(0).fileinfo().id());
+    ASSERT_TRUE(response.results(0).has_filetoken());
+
+    ASSERT_EQ(StatusCode::kOK, response.results(1).statuscode());
+    ASSERT_EQ(volInfo.id(), response.results(1).fileinfo().id());
+    ASSERT_TRUE(response.results(1).has_filetoken());
+
+    ASSERT_EQ(StatusCode::kOwnerAuthFail, response.results(2).statuscode());
+    ASSERT_FALSE(response.results(2).has_fileinfo());
+    ASSERT_FALSE(response.results(2).has_filetoken());
+    ClientIpPortType ipPort;
+    ASSERT_FALSE(fileRecordManager_->FindFileMountPoint("/b/vol", &ipPort));
+
+    ASSERT_EQ(StatusCode::kFileNotExists, response.results(3).statuscode());
+    ASSERT_EQ(StatusCode::kParaError, response.results(4).statuscode());
+
+    // 续约返回的token可以用于下一次续约
+    request.clear_items();
+    item = request.add_items();
+    item->set_filename("/a/vol");
+    item->set_fileid(volInfo.id());
+    item->set_parentid(volInfo.parentid());
+    item->set_sessionid(sessionId);
+    item->set_filetoken(response.results(0).filetoken());
+    cntl.Reset();
+    response.Clear();
+    stub.BatchRefreshSession(&cntl, &request, &response, NULL);
+    ASSERT_FALSE(cntl.Failed());
+    ASSERT_EQ(StatusCode::kOK, response.statuscode());
+    ASSERT_EQ(StatusCode::kOK, response.results(0).statuscode());
+
+    // root用户签名错误，整个请求失败
+    request.set_owner(authOptions.rootOwner);
+    request.set_signature("wrong signature");
+    cntl.Reset();
+    response.Clear();
+    stub.BatchRefreshSession(&cntl, &request, &response, NULL);
+    ASSERT_FALSE(cntl.Failed());
+    ASSERT_EQ(StatusCode::kOwnerAuthFail, response.statuscode());
+    ASSERT_EQ(0, response.results_size());
+
+    server.Stop(10);
+    server.Join();
+}
+
 TEST_F(NameSpaceServiceTest, FindFileMountPointTest) {
     brpc::Server server;
 
@@ -23,6 +23,9 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <thread>  //NOLINT
+#include <vector>
+
 
 #include "test/mds/mock/mock_topology.h"
 
@@ -125,6 +128,49 @@ TEST_F(TestTopologyStat, TestUpdateAndGetChunkServerStat) {
 
 
 
+TEST_F(TestTopologyStat, TestConcurrentUpdateAndGetChunkServerStat) {
+    const int kChunkServerNum = 4;
+    const int kUpdateTimes = 1000;
+    std::vector<std::thread> threads;
+    // 每个chunkserver一个心跳线程，每次更新的统计数据内部是一致的
+    for (int cs = 1; cs <= kChunkServerNum; cs++) {
+        threads.emplace_back([this, cs, kUpdateTimes] {
+            for (int i = 1; i <= kUpdateTimes; i++) {
+                ChunkServerStat stat;
+                stat.leaderCount = i;
+                stat.copysetCount = i;
+                stat.copysetStats.resize(i % 10);
+                testObj_->UpdateChunkServerStat(cs, stat);
+            }
+        });
+    }
+    // 读取线程读到的数据不会是多次更新混合的结果
+    for (int r = 0; r < 2; r++) {
+        threads.emplace_back([this, kChunkServerNum, kUpdateTimes] {
+            for (int i = 0; i < kUpdateTimes; i++) {
+                ChunkServerStat stat;
+                ChunkServerIdType cs = i % kChunkServerNum + 1;
+                if (testObj_->GetChunkServerStat(cs, &stat)) {
+                    ASSERT_EQ(stat.leaderCount, stat.copysetCount);
+                    ASSERT_EQ(stat.leaderCount % 10,
+                              stat.copysetStats.size());
+                }
+            }
+        });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+
+    for (int cs = 1; cs <= kChunkServerNum; cs++) {
+        ChunkServerStat stat;
+        ASSERT_TRUE(testObj_->GetChunkServerStat(cs, &stat));
+        ASSERT_EQ(kUpdateTimes, stat.leaderCount);
+    }
+    ChunkServerStat stat;
+    ASSERT_FALSE(testObj_->GetChunkServerStat(kChunkServerNum + 1, &stat));
+}
+
 }  // namespace topology
 }  // namespace mds
 }  // namespace curve
@@ -72,6 +72,14 @@ class MockSnapshotCore : public SnapshotCore {
     MOCK_METHOD1(GetSnapshotList,
         int(std::vector<SnapshotInfo> *list));
 
+    MOCK_METHOD6(GetSnapshotPage,
+        int(const SnapshotFilter &filter,
+        const UUID &cursor,
+        uint64_t limit,
+        std::vector<SnapshotInfo> *list,
+        UUID *nextCursor,
+        uint64_t *total));
+
     MOCK_METHOD2(GetSnapshotInfo,
         int(const UUID uuid, SnapshotInfo *info));
 
@@ -93,6 +101,13 @@ class MockSnapshotCloneMetaStore : public SnapshotCloneMetaStore {
         int(std::vector<SnapshotInfo> *list));
     MOCK_METHOD0(GetSnapshotCount,
         uint32_t());
+    MOCK_METHOD6(GetSnapshotPage,
+        int(const SnapshotFilter &filter,
+            const UUID &cursor,
+            uint64_t limit,
+            std::vector<SnapshotInfo> *list,
+            UUID *nextCursor,
+            uint64_t *total));
     MOCK_METHOD1(AddCloneInfo, int(const CloneInfo &info));
     MOCK_METHOD1(DeleteCloneInfo, int(const std::string &taskID));
     MOCK_METHOD1(UpdateCloneInfo, int(const CloneInfo &info));
@@ -102,6 +117,13 @@ class MockSnapshotCloneMetaStore : public SnapshotCloneMetaStore {
         int(const std::string &fileName, std::vector<CloneInfo> *list));
     MOCK_METHOD1(GetCloneInfoList,
         int(std::vector<CloneInfo> *list));
+    MOCK_METHOD6(GetCloneInfoPage,
+        int(const CloneInfoFilter &filter,
+            const TaskIdType &cursor,
+            uint64_t limit,
+            std::vector<CloneInfo> *list,
+            TaskIdType *nextCursor,
+            uint64_t *total));
 };
 
 class MockSnapshotDataStore : public SnapshotDataStore {
@@ -285,6 +307,15 @@ class MockSnapshotServiceManager : public SnapshotServiceManager {
         const UUID &uuid,
         std::vector<FileSnapshotInfo> *info));
 
+    MOCK_METHOD7(GetFileSnapshotInfoPage,
+        int(const std::string &file,
+        const std::string &user,
+        const UUID &cursor,
+        uint64_t limit,
+        std::vector<FileSnapshotInfo> *info,
+        UUID *nextCursor,
+        uint64_t *total));
+
     MOCK_METHOD3(CancelSnapshot,
         int(const UUID &uuid,
         const std::string &user,
@@ -331,6 +362,15 @@ class MockCloneServiceManager : public CloneServiceManager {
         const std::string &fileName,
         std::vector<TaskCloneInfo> *info));
 
+    MOCK_METHOD7(GetCloneTaskInfoPage,
+        int(const std::string &user,
+        const std::string &fileName,
+        const TaskIdType &cursor,
+        uint64_t limit,
+        std::vector<TaskCloneInfo> *info,
+        TaskIdType *nextCursor,
+        uint64_t *total));
+
     MOCK_METHOD2(CleanCloneTask,
         int(const std::string &user,
         const TaskIdType &taskId));
@@ -371,6 +411,14 @@ class MockCloneCore : public CloneCore {
     MOCK_METHOD2(GetCloneInfoByFileName,
         int(const std::string &fileName, std::vector<CloneInfo> *list));
 
+    MOCK_METHOD6(GetCloneInfoPage,
+        int(const CloneInfoFilter &filter,
+        const TaskIdType &cursor,
+        uint64_t limit,
+        std::vector<CloneInfo> *list,
+        TaskIdType *nextCursor,
+        uint64_t *total));
+
     MOCK_METHOD0(GetSnapshotRef,
         std::shared_ptr<SnapshotReference>());
 
@@ -642,8 +642,144 @@ TEST_F(TestSnapshotCloneMetaStoreEtcd,
     ASSERT_EQ(-1, ret);
 }
 
+TEST_F(TestSnapshotCloneMetaStoreEtcd,
+    TestGetSnapshotPageSuccess) {
+    EXPECT_CALL(*kvStorageClient_, Put(_, _))
+        .WillRepeatedly(Return(EtcdErrCode::EtcdOK));
+    EXPECT_CALL(*kvStorageClient_, Delete(_))
+        .WillRepeatedly(Return(EtcdErrCode::EtcdOK));
+
+    // uuid0~uuid9，奇数属于user1，前5个属于file1
+    for (int i = 0; i < 10; i++) {
+        SnapshotInfo snapInfo("uuid" + std::to_string(i),
+                            (i % 2) ? "user1" : "user2",
+                            (i < 5) ? "file1" : "file2",
+                            "snapxxx", 100, 1024, 2048, 4096, 0,
+                            Status::pending);
+        ASSERT_EQ(0, metaStore_->AddSnapshot(snapInfo));
+    }
+    SnapshotInfo doneInfo("uuid3", "user1", "file1", "snapxxx", 100,
+                        1024, 2048, 4096, 0, Status::done);
+    ASSERT_EQ(0, metaStore_->UpdateSnapshot(doneInfo));
+    ASSERT_EQ(0, metaStore_->DeleteSnapshot("uuid9"));
+
+    // 按用户分页
+    SnapshotFilter filter;
+    filter.user = "user1";
+    std::vector<SnapshotInfo> list;
+    UUID nextCursor;
+    uint64_t total = 0;
+    ASSERT_EQ(0, metaStore_->GetSnapshotPage(filter, "", 2,
+        &list, &nextCursor, &total));
+    ASSERT_EQ(4, total);
+    ASSERT_EQ(2, list.size());
+    ASSERT_EQ("uuid1", list[0].GetUuid());
+    ASSERT_EQ("uuid3", list[1].GetUuid());
+    ASSERT_EQ(Status::done, list[1].GetStatus());
+    ASSERT_EQ("uuid3", nextCursor);
+    ASSERT_EQ(0, metaStore_->GetSnapshotPage(filter, nextCursor, 2,
+        &list, &nextCursor, &total));
+    ASSERT_EQ(2, list.size());
+    ASSERT_EQ("uuid5", list[0].GetUuid());
+    ASSERT_EQ("uuid7", list[1].GetUuid());
+    ASSERT_TRUE(nextCursor.empty());
+
+    // 按用户和文件分页
+    filter.fileName = "file1";
+    ASSERT_EQ(0, metaStore_->GetSnapshotPage(filter, "", 1,
+        &list, &nextCursor, &total));
+    ASSERT_EQ(2, total);
+    ASSERT_EQ(1, list.size());
+    ASSERT_EQ("uuid1", list[0].GetUuid());
+    ASSERT_EQ("uuid1", nextCursor);
+
+    // 按状态过滤，更新之后的状态生效
+    SnapshotFilter statusFilter;
+    statusFilter.filterStatus = true;
+    statusFilter.status = Status::done;
+    ASSERT_EQ(0, metaStore_->GetSnapshotPage(statusFilter, "", 10,
+        &list, &nextCursor, &total));
+    ASSERT_EQ(1, total);
+    ASSERT_EQ(1, list.size());
+    ASSERT_EQ("uuid3", list[0].GetUuid());
+    ASSERT_TRUE(nextCursor.empty());
+
+    // 不过滤
+    ASSERT_EQ(0, metaStore_->GetSnapshotPage(SnapshotFilter(), "uuid7", 10,
+        &list, &nextCursor, &total));
+    ASSERT_EQ(9, total);
+    ASSERT_EQ(1, list.size());
+    ASSERT_EQ("uuid8", list[0].GetUuid());
+
+    // 没有满足条件的快照
+    filter.user = "user3";
+    ASSERT_EQ(0, metaStore_->GetSnapshotPage(filter, "", 10,
+        &list, &nextCursor, &total));
+    ASSERT_EQ(0, total);
+    ASSERT_EQ(0, list.size());
+
+    // 按文件获取快照列表使用索引
+    std::vector<SnapshotInfo> v;
+    ASSERT_EQ(0, metaStore_->GetSnapshotList("file2", &v));
+    ASSERT_EQ(4, v.size());
+}
 
+TEST_F(TestSnapshotCloneMetaStoreEtcd,
+    TestGetCloneInfoPageSuccess) {
+    EXPECT_CALL(*kvStorageClient_, Put(_, _))
+        .WillRepeatedly(Return(EtcdErrCode::EtcdOK));
+
+    for (int i = 0; i < 6; i++) {
+        CloneInfo cloneInfo("task" + std::to_string(i),
+            (i % 2) ? "user1" : "user2",
+            CloneTaskType::kClone, "src",
+            "dest" + std::to_string(i % 3),
+            CloneFileType::kSnapshot, false);
+        ASSERT_EQ(0, metaStore_->AddCloneInfo(cloneInfo));
+    }
 
+    // 按用户和目标文件分页
+    CloneInfoFilter filter;
+    filter.user = "user1";
+    std::vector<CloneInfo> list;
+    TaskIdType nextCursor;
+    uint64_t total = 0;
+    ASSERT_EQ(0, metaStore_->GetCloneInfoPage(filter, "", 2,
+        &list, &nextCursor, &total));
+    ASSERT_EQ(3, total);
+    ASSERT_EQ(2, list.size());
+    ASSERT_EQ("task1", list[0].GetTaskId());
+    ASSERT_EQ("task3", list[1].GetTaskId());
+    ASSERT_EQ("task3", nextCursor);
+    ASSERT_EQ(0, metaStore_->GetCloneInfoPage(filter, nextCursor, 2,
+        &list, &nextCursor, &total));
+    ASSERT_EQ(1, list.size());
+    ASSERT_EQ("task5", list[0].GetTaskId());
+    ASSERT_TRUE(nextCursor.empty());
+
+    filter.fileName = "dest0";
+    ASSERT_EQ(0, metaStore_->GetCloneInfoPage(filter, "", 2,
+        &list, &nextCursor, &total));
+    ASSERT_EQ(1, total);
+    ASSERT_EQ("task3", list[0].GetTaskId());
+
+    // 更新状态之后索引随之更新
+    CloneInfo info;
+    ASSERT_EQ(0, metaStore_->GetCloneInfo("task3", &info));
+    info.SetStatus(CloneStatus::error);
+    ASSERT_EQ(0, metaStore_->UpdateCloneInfo(info));
+    CloneInfoFilter statusFilter;
+    statusFilter.filterStatus = true;
+    statusFilter.status = CloneStatus::error;
+    ASSERT_EQ(0, metaStore_->GetCloneInfoPage(statusFilter, "", 10,
+        &list, &nextCursor, &total));
+    ASSERT_EQ(1, total);
+    ASSERT_EQ("task3", list[0].GetTaskId());
+
+    std::vector<CloneInfo> v;
+    ASSERT_EQ(0, metaStore_->GetCloneInfoByFileName("dest1", &v));
+    ASSERT_EQ(2, v.size());
+}
 
 }  // namespace snapshotcloneserver
 }  // namespace curve
@@ -458,6 +458,73 @@ TEST_F(TestSnapshotCloneServiceImpl, TestCancelSnapShotMissingParam) {
     LOG(ERROR) << cntl.response_attachment();
 }
 
+TEST_F(TestSnapshotCloneServiceImpl,
+    TestGetFileSnapshotInfoUseCursorSuccess) {
+    std::string file = "test";
+    std::string user = "test";
+
+    std::vector<FileSnapshotInfo> infoVec;
+    FileSnapshotInfo info1, info2;
+    SnapshotInfo sinfo1, sinfo2;
+    sinfo1.SetUuid("2");
+    sinfo2.SetUuid("3");
+    info1.SetSnapshotInfo(sinfo1);
+    info2.SetSnapshotInfo(sinfo2);
+    infoVec.push_back(info1);
+    infoVec.push_back(info2);
+
+    UUID nextCursor = "3";
+    uint64_t total = 5;
+    EXPECT_CALL(*snapshotManager_,
+        GetFileSnapshotInfoPage(file, user, "1", 2, _, _, _))
+        .WillOnce(DoAll(
+                    SetArgPointee<4>(infoVec),
+                    SetArgPointee<5>(nextCursor),
+                    SetArgPointee<6>(total),
+                    Return(kErrCodeSuccess)));
+
+    brpc::Channel channel;
+    brpc::ChannelOptions option;
+    option.protocol = "http";
+
+    std::string url = std::string("http://127.0.0.1:")
+                    + std::to_string(listenAddr_.port)
+                    + "/" + kServiceName + "?"
+                    + kActionStr + "=" + kGetFileSnapshotInfoAction + "&"
+                    + kVersionStr + "=1&"
+                    + kUserStr + "=" + user + "&"
+                    + kFileStr + "=" + file + "&"
+                    + kLimitStr + "=2&"
+                    + kCursorStr + "=1";
+
+    if (channel.Init(url.c_str(), "", &option) != 0) {
+        FAIL() << "Fail to init channel"
+               << std::endl;
+    }
+
+    brpc::Controller cntl;
+    cntl.http_request().uri() = url.c_str();
+
+    channel.CallMethod(NULL, &cntl, NULL, NULL, NULL);
+    if (cntl.Failed()) {
+        LOG(ERROR) << cntl.ErrorText();
+    }
+    std::stringstream ss;
+    ss << cntl.response_attachment();
+    std::string data = ss.str();
+    Json::Reader jsonReader;
+    Json::Value jsonObj;
+    if (!jsonReader.parse(data, jsonObj)) {
+        FAIL() << "parse json fail, data = " << data;
+    }
+    ASSERT_STREQ("0", jsonObj["Code"].asCString());
+    ASSERT_EQ(5, jsonObj["TotalCount"].asInt());
+    ASSERT_STREQ("3", jsonObj["NextCursor"].asCString());
+    ASSERT_EQ(2, jsonObj["Snapshots"].size());
+    ASSERT_STREQ("2", jsonObj["Snapshots"][0]["UUID"].asCString());
+    ASSERT_STREQ("3", jsonObj["Snapshots"][1]["UUID"].asCString());
+}
+
 TEST_F(TestSnapshotCloneServiceImpl, TestGetFileSnapshotInfoMissingParam) {
     std::string file = "test";
     std::string user = "test";
@@ -29,11 +29,16 @@
 #include "test/tools/mock_chunkserver_client.h"
 
 DECLARE_bool(check_hash);
+DECLARE_bool(check_copyset_hash);
+DECLARE_uint32(hash_leaf_chunk_num);
 
 using ::testing::_;
 using ::testing::Return;
 using ::testing::DoAll;
 using ::testing::SetArgPointee;
+using ::testing::Invoke;
+using curve::tool::GetCopysetHashRequest;
+using curve::tool::GetCopysetHashResponse;
 
 extern uint32_t segment_size;
 extern uint32_t chunk_size;
@@ -44,11 +49,32 @@ class ConsistencyCheckTest : public ::testing::Test {
         nameSpaceTool_ =
                 std::make_shared<curve::tool::MockNameSpaceToolCore>();
         csClient_ = std::make_shared<curve::tool::MockChunkServerClient>();
+        // 默认用例逐个检查chunk的hash
+        FLAGS_check_copyset_hash = false;
     }
 
     void TearDown() {
         nameSpaceTool_ = nullptr;
         csClient_ = nullptr;
+        FLAGS_check_copyset_hash = true;
+    }
+
+    void GetCopysetHashForTest(GetCopysetHashResponse* response,
+                               const std::string& hash,
+                               const std::map<uint64_t, std::string>& chunks) {
+        response->set_status(
+            curve::chunkserver::CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS);
+        response->set_hash(hash);
+        response->set_chunkcount(chunks.size());
+        if (!chunks.empty()) {
+            response->set_minchunkid(chunks.begin()->first);
+            response->set_maxchunkid(chunks.rbegin()->first);
+        }
+        for (const auto& item : chunks) {
+            auto chunkHash = response->add_chunkhashes();
+            chunkHash->set_chunkid(item.first);
+            chunkHash->set_hash(item.second);
+        }
     }
 
     void GetSegmentForTest(PageFileSegment* segment) {
@@ -313,3 +339,119 @@ TEST_F(ConsistencyCheckTest, CheckError) {
         .WillOnce(Return(-1));
     ASSERT_EQ(-1, cfc.RunCommand("check-consistency"));
 }
+
+TEST_F(ConsistencyCheckTest, CopysetRangeHash) {
+    PageFileSegment segment;
+    segment.set_logicalpoolid(1);
+    segment.set_segmentsize(segment_size);
+    segment.set_chunksize(chunk_size);
+    segment.set_startoffset(0);
+    auto chunk = segment.add_chunks();
+    chunk->set_copysetid(1000);
+    chunk->set_chunkid(2000);
+    std::vector<PageFileSegment> segments = {segment};
+    std::vector<ChunkServerLocation> csLocs;
+    for (uint64_t i = 1; i <= 3; ++i) {
+        ChunkServerLocation csLoc;
+        GetCsLocForTest(&csLoc, i);
+        csLocs.emplace_back(csLoc);
+    }
+    CopysetStatusResponse response;
+    GetCopysetStatusForTest(&response);
+
+    EXPECT_CALL(*nameSpaceTool_, Init(_))
+        .WillRepeatedly(Return(0));
+    EXPECT_CALL(*nameSpaceTool_, GetFileSegments(_, _))
+        .Times(3)
+        .WillRepeatedly(DoAll(SetArgPointee<1>(segments),
+                        Return(0)));
+    EXPECT_CALL(*nameSpaceTool_, GetChunkServerListInCopySet(_, _, _))
+        .Times(3)
+        .WillRepeatedly(DoAll(SetArgPointee<2>(csLocs),
+                        Return(0)));
+    EXPECT_CALL(*csClient_, Init(_))
+        .Times(9)
+        .WillRepeatedly(Return(0));
+    EXPECT_CALL(*csClient_, GetCopysetStatus(_, _))
+        .Times(9)
+        .WillRepeatedly(DoAll(SetArgPointee<1>(response),
+                        Return(0)));
+    EXPECT_CALL(*csClient_, GetChunkHash(_, _))
+        .Times(0);
+    FLAGS_check_hash = true;
+    FLAGS_check_copyset_hash = true;
+
+    // 各个副本上的chunk，第三个副本上chunk 3000的数据不一致
+    std::map<uint64_t, std::string> chunks = {{2000, "a"}, {3000, "b"}};
+    std::map<uint64_t, std::string> badChunks = {{2000, "a"}, {3000, "c"}};
+    std::vector<GetCopysetHashRequest> requests;
+    auto fakeGetCopysetHash = [&](const std::vector<std::string>& csAddrs,
+                                  const GetCopysetHashRequest& request,
+                                  std::vector<GetCopysetHashResponse>* resps) {
+        requests.emplace_back(request);
+        resps->clear();
+        for (size_t i = 0; i < csAddrs.size(); ++i) {
+            const auto& all = (i == 2) ? badChunks : chunks;
+            std::map<uint64_t, std::string> inRange;
+            for (const auto& item : all) {
+                if (item.first >= request.beginchunkid() &&
+                    item.first < request.endchunkid()) {
+                    inRange.emplace(item);
+                }
+            }
+            // 用chunk hash拼接出来的字符串模拟范围hash
+            std::string hash;
+            for (const auto& item : inRange) {
+                hash += item.second;
+            }
+            GetCopysetHashResponse resp;
+            if (request.withchunkhash()) {
+                GetCopysetHashForTest(&resp, hash, inRange);
+            } else {
+                GetCopysetHashForTest(&resp, hash, {});
+                resp.set_chunkcount(inRange.size());
+                if (!inRange.empty()) {
+                    resp.set_minchunkid(inRange.begin()->first);
+                    resp.set_maxchunkid(inRange.rbegin()->first);
+                }
+            }
+            resps->emplace_back(resp);
+        }
+        return 0;
+    };
+    EXPECT_CALL(*csClient_, GetCopysetHash(_, _, _))
+        .WillRepeatedly(Invoke(fakeGetCopysetHash));
+
+    // 1、副本一致，只需要一次rpc
+    badChunks = chunks;
+    curve::tool::ConsistencyCheck cfc1(nameSpaceTool_, csClient_);
+    ASSERT_EQ(0, cfc1.RunCommand("check-consistency"));
+    ASSERT_EQ(1, requests.size());
+    ASSERT_EQ(0, requests[0].beginchunkid());
+    ASSERT_FALSE(requests[0].withchunkhash());
+
+    // 2、chunk个数较少，直接比较每个chunk的hash
+    requests.clear();
+    badChunks = {{2000, "a"}, {3000, "c"}};
+    curve::tool::ConsistencyCheck cfc2(nameSpaceTool_, csClient_);
+    ASSERT_EQ(-1, cfc2.RunCommand("check-consistency"));
+    ASSERT_EQ(2, requests.size());
+    ASSERT_TRUE(requests[1].withchunkhash());
+    ASSERT_EQ(2000, requests[1].beginchunkid());
+    ASSERT_EQ(3001, requests[1].endchunkid());
+
+    // 3、范围二分之后只对不一致的一半继续检查
+    requests.clear();
+    FLAGS_hash_leaf_chunk_num = 1;
+    curve::tool::ConsistencyCheck cfc3(nameSpaceTool_, csClient_);
+    ASSERT_EQ(-1, cfc3.RunCommand("check-consistency"));
+    ASSERT_EQ(4, requests.size());
+    ASSERT_EQ(2000, requests[1].beginchunkid());
+    ASSERT_EQ(2501, requests[1].endchunkid());
+    ASSERT_EQ(2501, requests[2].beginchunkid());
+    ASSERT_EQ(3001, requests[2].endchunkid());
+    ASSERT_TRUE(requests[3].withchunkhash());
+    ASSERT_EQ(3000, requests[3].beginchunkid());
+    ASSERT_EQ(3001, requests[3].endchunkid());
+    FLAGS_hash_leaf_chunk_num = 16;
+}
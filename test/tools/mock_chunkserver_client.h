@@ -41,6 +41,9 @@ class MockChunkServerClient : public ChunkServerClient {
     MOCK_METHOD2(GetCopysetStatus, int(const CopysetStatusRequest& request,
                                  CopysetStatusResponse* response));
     MOCK_METHOD2(GetChunkHash, int(const Chunk&, std::string*));
+    MOCK_METHOD3(GetCopysetHash, int(const std::vector<std::string>&,
+                                     const GetCopysetHashRequest&,
+                                     std::vector<GetCopysetHashResponse>*));
 };
 }  // namespace tool
 }  // namespace curve